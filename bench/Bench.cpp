@@ -0,0 +1,375 @@
+#include "ArrayList.h"
+#include "Bench.h"
+#include "PhxMath.h"
+#include "PhxMemory.h"
+#include "PhxString.h"
+#include "TimeStamp.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+struct BenchDef {
+  cstr name;
+  int64 param;
+  uint64 bytesPerOp;
+  BenchSetupFn setup;
+  BenchRunFn run;
+  BenchTeardownFn teardown;
+};
+
+struct BenchCheck {
+  cstr name;
+  BenchCheckFn fn;
+};
+
+struct BenchResult {
+  cstr name;
+  uint64 iterations;
+  double mean;
+  double stddev;
+  double min;
+  double median;
+  double max;
+  double mbps;
+};
+
+struct BenchOptions {
+  cstr filter;
+  cstr jsonPath;
+  cstr csvPath;
+  cstr comparePath;
+  int reps;
+  int warmup;
+  double targetTime;
+  double threshold;
+  bool list;
+  bool check;
+};
+
+struct Bench {
+  ArrayList(BenchDef, def);
+  ArrayList(BenchCheck, check);
+  ArrayList(BenchResult, result);
+  BenchOptions opts;
+} static self;
+
+static volatile uint64 sink;
+
+void Bench_Add (
+  cstr name, int64 param, uint64 bytesPerOp,
+  BenchSetupFn setup, BenchRunFn run, BenchTeardownFn teardown)
+{
+  BenchDef def = {
+    param ? StrFormat("%s/%lld", name, (long long)param) : StrDup(name),
+    param, bytesPerOp, setup, run, teardown };
+  ArrayList_Append(self.def, def);
+}
+
+void Bench_AddCheck (cstr name, BenchCheckFn fn) {
+  BenchCheck check = { name, fn };
+  ArrayList_Append(self.check, check);
+}
+
+void Bench_Consume (uint64 value) {
+  sink += value;
+}
+
+static int Bench_CompareDouble (void const* a, void const* b) {
+  double x = *(double const*)a;
+  double y = *(double const*)b;
+  return x < y ? -1 : x > y ? 1 : 0;
+}
+
+inline static double Bench_Time (BenchDef const* def, void* ctx, uint64 n) {
+  TimeStamp start = TimeStamp_Get();
+  def->run(ctx, n);
+  return TimeStamp_GetDifference(start, TimeStamp_Get());
+}
+
+static void Bench_Run (BenchDef const* def) {
+  void* ctx = def->setup ? def->setup(def->param) : 0;
+
+  /* Calibrate: grow the iteration count until a single repetition reaches the
+   * target time. This doubles as the first part of the warmup. */
+  uint64 n = 1;
+  for (;;) {
+    double t = Bench_Time(def, ctx, n);
+    if (t >= self.opts.targetTime || n >= (1ULL << 40))
+      break;
+    n *= t < self.opts.targetTime / 16.0 ? 8 : 2;
+  }
+
+  for (int i = 0; i < self.opts.warmup; ++i)
+    Bench_Time(def, ctx, n);
+
+  int reps = self.opts.reps;
+  double* sample = (double*)malloc(sizeof(double) * reps);
+  double sum = 0;
+  for (int i = 0; i < reps; ++i) {
+    sample[i] = 1e9 * Bench_Time(def, ctx, n) / (double)n;
+    sum += sample[i];
+  }
+
+  if (def->teardown)
+    def->teardown(ctx);
+
+  qsort(sample, reps, sizeof(double), Bench_CompareDouble);
+  BenchResult r;
+  r.name = def->name;
+  r.iterations = n;
+  r.mean = sum / reps;
+  r.min = sample[0];
+  r.max = sample[reps - 1];
+  r.median = (reps & 1)
+    ? sample[reps / 2]
+    : 0.5 * (sample[reps / 2 - 1] + sample[reps / 2]);
+
+  double var = 0;
+  for (int i = 0; i < reps; ++i)
+    var += (sample[i] - r.mean) * (sample[i] - r.mean);
+  r.stddev = reps > 1 ? Sqrt(var / (reps - 1)) : 0.0;
+  r.mbps = def->bytesPerOp ? (double)def->bytesPerOp * 1e3 / r.median : 0.0;
+  free(sample);
+
+  printf("%-40s %12llu %12.2f %10.2f %12.2f %12.2f %12.2f",
+    r.name, (unsigned long long)r.iterations,
+    r.mean, r.stddev, r.min, r.median, r.max);
+  if (r.mbps > 0)
+    printf(" %10.1f MB/s", r.mbps);
+  printf("\n");
+  fflush(stdout);
+
+  ArrayList_Append(self.result, r);
+}
+
+static bool Bench_WriteJSON (cstr path) {
+  FILE* file = fopen(path, "wb");
+  if (!file) {
+    Warn("Bench_WriteJSON: Failed to open <%s>", path);
+    return false;
+  }
+
+  /* One result per line, so that compare mode can read it back without a
+   * JSON parser. */
+  fprintf(file, "[\n");
+  for (int i = 0; i < self.result_size; ++i) {
+    BenchResult const* r = self.result_data + i;
+    fprintf(file,
+      "  {\"name\": \"%s\", \"iterations\": %llu, \"mean\": %.4f, "
+      "\"stddev\": %.4f, \"min\": %.4f, \"median\": %.4f, \"max\": %.4f, "
+      "\"mbps\": %.2f}%s\n",
+      r->name, (unsigned long long)r->iterations, r->mean, r->stddev,
+      r->min, r->median, r->max, r->mbps,
+      i + 1 < self.result_size ? "," : "");
+  }
+  fprintf(file, "]\n");
+  fclose(file);
+  return true;
+}
+
+static bool Bench_WriteCSV (cstr path) {
+  FILE* file = fopen(path, "wb");
+  if (!file) {
+    Warn("Bench_WriteCSV: Failed to open <%s>", path);
+    return false;
+  }
+
+  fprintf(file, "name,iterations,mean_ns,stddev_ns,min_ns,median_ns,max_ns,mbps\n");
+  for (int i = 0; i < self.result_size; ++i) {
+    BenchResult const* r = self.result_data + i;
+    fprintf(file, "%s,%llu,%.4f,%.4f,%.4f,%.4f,%.4f,%.2f\n",
+      r->name, (unsigned long long)r->iterations, r->mean, r->stddev,
+      r->min, r->median, r->max, r->mbps);
+  }
+  fclose(file);
+  return true;
+}
+
+/* Returns the number of regressions, or -1 if the baseline can't be read. */
+static int Bench_Compare (cstr path) {
+  FILE* file = fopen(path, "rb");
+  if (!file) {
+    Warn("Bench_Compare: Failed to open baseline <%s>", path);
+    return -1;
+  }
+
+  printf("\nComparing against <%s> (threshold %.1f%%)\n", path, self.opts.threshold);
+  printf("%-40s %12s %12s %9s\n", "Benchmark", "Base (ns)", "Curr (ns)", "Delta");
+
+  int regressions = 0;
+  int matched = 0;
+  char line[1024];
+  while (fgets(line, sizeof(line), file)) {
+    cstr name = StrFind(line, "\"name\": \"");
+    cstr median = StrFind(line, "\"median\": ");
+    if (!name || !median)
+      continue;
+
+    name += 9;
+    cstr nameEnd = StrFind(name, "\"");
+    if (!nameEnd)
+      continue;
+
+    double base;
+    if (sscanf(median + 10, "%lf", &base) != 1 || base <= 0)
+      continue;
+
+    size_t nameLen = (size_t)(nameEnd - name);
+    for (int i = 0; i < self.result_size; ++i) {
+      BenchResult const* r = self.result_data + i;
+      if (StrLen(r->name) != nameLen || strncmp(r->name, name, nameLen) != 0)
+        continue;
+
+      double delta = 100.0 * (r->median - base) / base;
+      cstr verdict = "";
+      if (delta > self.opts.threshold) {
+        verdict = "  REGRESSION";
+        regressions++;
+      } else if (delta < -self.opts.threshold) {
+        verdict = "  improved";
+      }
+      printf("%-40s %12.2f %12.2f %+8.1f%%%s\n",
+        r->name, base, r->median, delta, verdict);
+      matched++;
+      break;
+    }
+  }
+  fclose(file);
+
+  printf("%d benchmarks compared, %d regressed\n", matched, regressions);
+  return regressions;
+}
+
+/* Returns the number of failed checks. */
+static int Bench_RunChecks () {
+  int failed = 0;
+  int ran = 0;
+  for (int i = 0; i < self.check_size; ++i) {
+    BenchCheck const* check = self.check_data + i;
+    if (self.opts.filter && !StrMatch(check->name, self.opts.filter))
+      continue;
+    bool ok = check->fn();
+    printf("%-40s %s\n", check->name, ok ? "ok" : "FAILED");
+    fflush(stdout);
+    failed += ok ? 0 : 1;
+    ran++;
+  }
+
+  printf("%d checks run, %d failed\n", ran, failed);
+  return failed;
+}
+
+static void Bench_Usage (cstr exe) {
+  printf(
+    "Usage: %s [options]\n"
+    "  --list               List benchmarks and exit\n"
+    "  --check              Run the self-checks instead of the benchmarks\n"
+    "  --filter <pattern>   Run only benchmarks matching the pattern (* wildcards)\n"
+    "  --reps <n>           Measured repetitions per benchmark (default 10)\n"
+    "  --warmup <n>         Warmup repetitions after calibration (default 2)\n"
+    "  --time <ms>          Target duration of one repetition (default 20)\n"
+    "  --json <path>        Write results as JSON\n"
+    "  --csv <path>         Write results as CSV\n"
+    "  --compare <path>     Compare medians against a baseline JSON\n"
+    "  --threshold <pct>    Regression threshold for --compare (default 10)\n",
+    exe);
+}
+
+int main (int argc, char** argv) {
+  self.opts.filter = 0;
+  self.opts.jsonPath = 0;
+  self.opts.csvPath = 0;
+  self.opts.comparePath = 0;
+  self.opts.reps = 10;
+  self.opts.warmup = 2;
+  self.opts.targetTime = 0.02;
+  self.opts.threshold = 10.0;
+  self.opts.list = false;
+  self.opts.check = false;
+
+  for (int i = 1; i < argc; ++i) {
+    cstr arg = argv[i];
+    cstr next = i + 1 < argc ? argv[i + 1] : 0;
+    if (StrEqual(arg, "--list")) {
+      self.opts.list = true;
+      continue;
+    }
+    if (StrEqual(arg, "--check")) {
+      self.opts.check = true;
+      continue;
+    }
+    if (StrEqual(arg, "--help") || StrEqual(arg, "-h")) {
+      Bench_Usage(argv[0]);
+      return 0;
+    }
+    if (!next) {
+      Bench_Usage(argv[0]);
+      return 2;
+    }
+
+    if      (StrEqual(arg, "--filter"))    self.opts.filter = next;
+    else if (StrEqual(arg, "--reps"))      self.opts.reps = Max(atoi(next), 1);
+    else if (StrEqual(arg, "--warmup"))    self.opts.warmup = Max(atoi(next), 0);
+    else if (StrEqual(arg, "--time"))      self.opts.targetTime = Max(atof(next), 0.1) / 1000.0;
+    else if (StrEqual(arg, "--json"))      self.opts.jsonPath = next;
+    else if (StrEqual(arg, "--csv"))       self.opts.csvPath = next;
+    else if (StrEqual(arg, "--compare"))   self.opts.comparePath = next;
+    else if (StrEqual(arg, "--threshold")) self.opts.threshold = atof(next);
+    else {
+      Bench_Usage(argv[0]);
+      return 2;
+    }
+    ++i;
+  }
+
+  ArrayList_Init(self.def);
+  ArrayList_Init(self.check);
+  ArrayList_Init(self.result);
+  Bench_RegisterContainers();
+  Bench_RegisterMemory();
+  Bench_RegisterHash();
+  Bench_RegisterRNG();
+  Bench_RegisterMath();
+  Bench_RegisterIntersect();
+  Bench_RegisterMesh();
+  Bench_RegisterBytes();
+  Bench_RegisterLua();
+
+  if (self.opts.list) {
+    for (int i = 0; i < self.def_size; ++i)
+      printf("%s\n", self.def_data[i].name);
+    for (int i = 0; i < self.check_size; ++i)
+      printf("%s (check)\n", self.check_data[i].name);
+    return 0;
+  }
+
+  if (self.opts.check)
+    return Bench_RunChecks() != 0 ? 1 : 0;
+
+  printf("%-40s %12s %12s %10s %12s %12s %12s\n",
+    "Benchmark (ns/op)", "Iterations", "Mean", "StdDev", "Min", "Median", "Max");
+  for (int i = 0; i < self.def_size; ++i) {
+    BenchDef const* def = self.def_data + i;
+    if (self.opts.filter && !StrMatch(def->name, self.opts.filter))
+      continue;
+    Bench_Run(def);
+  }
+
+  if (self.opts.jsonPath)
+    Bench_WriteJSON(self.opts.jsonPath);
+  if (self.opts.csvPath)
+    Bench_WriteCSV(self.opts.csvPath);
+
+  int status = 0;
+  if (self.opts.comparePath) {
+    int regressions = Bench_Compare(self.opts.comparePath);
+    status = regressions != 0 ? 1 : 0;
+  }
+
+  for (int i = 0; i < self.def_size; ++i)
+    StrFree(self.def_data[i].name);
+  ArrayList_Free(self.def);
+  ArrayList_Free(self.check);
+  ArrayList_Free(self.result);
+  return status;
+}
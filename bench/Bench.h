@@ -0,0 +1,57 @@
+#ifndef PHX_Bench
+#define PHX_Bench
+
+#include "Common.h"
+
+/* --- Bench -------------------------------------------------------------------
+ *
+ *   Microbenchmark harness for phx_bench. A benchmark is registered with a
+ *   setup function that builds its working set from 'param', a run function
+ *   that performs 'iterations' operations on it, and a teardown function.
+ *   Setup and teardown are not timed; run is called repeatedly on the same
+ *   context, so it must leave the context reusable.
+ *
+ *   For each benchmark the harness doubles the iteration count until one
+ *   run takes at least the target time (which also warms caches and
+ *   branch predictors), performs the warmup runs, and then times the
+ *   requested number of repetitions. Results are reported per operation.
+ *   'bytesPerOp', if nonzero, adds a throughput column.
+ *
+ *   Results are written to stdout and, optionally, to JSON or CSV. Given a
+ *   baseline JSON from an earlier run, compare mode flags every benchmark
+ *   whose median regressed by more than the threshold and exits with
+ *   status 1 if any did. Run phx_bench --help for the command line.
+ *
+ *   Bench_Consume feeds a value into a global sink so that the compiler
+ *   cannot discard the work that produced it.
+ *
+ *   A module may also register self-checks, which verify results rather
+ *   than time them (say, a SIMD kernel against its scalar reference).
+ *   phx_bench --check runs them instead of the benchmarks; each check
+ *   prints what it finds wrong and returns false, and phx_bench then exits
+ *   with status 1.
+ *
+ * -------------------------------------------------------------------------- */
+
+typedef void* (*BenchSetupFn)    (int64 param);
+typedef void  (*BenchRunFn)      (void* context, uint64 iterations);
+typedef void  (*BenchTeardownFn) (void* context);
+typedef bool  (*BenchCheckFn)    ();
+
+void  Bench_Add      (cstr name, int64 param, uint64 bytesPerOp,
+                      BenchSetupFn, BenchRunFn, BenchTeardownFn);
+void  Bench_AddCheck (cstr name, BenchCheckFn);
+void  Bench_Consume  (uint64 value);
+
+/* Per-module registration, called from main. */
+void  Bench_RegisterContainers  ();
+void  Bench_RegisterMemory      ();
+void  Bench_RegisterHash        ();
+void  Bench_RegisterRNG         ();
+void  Bench_RegisterMath        ();
+void  Bench_RegisterIntersect   ();
+void  Bench_RegisterMesh        ();
+void  Bench_RegisterBytes       ();
+void  Bench_RegisterLua         ();
+
+#endif
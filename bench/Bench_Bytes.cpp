@@ -0,0 +1,87 @@
+#include "Bench.h"
+#include "Bytes.h"
+#include "PhxMemory.h"
+#include "RNG.h"
+
+/* Compression of 'param' bytes of semi-redundant data: a small alphabet with
+ * frequent runs, roughly what serialized game state looks like to LZ4. */
+struct BytesBench {
+  Bytes* raw;
+  Bytes* packed;
+};
+
+static void* BytesBench_Setup (int64 param) {
+  BytesBench* self = MemNew(BytesBench);
+  uint32 size = (uint32)param;
+  self->raw = Bytes_Create(size);
+
+  RNG* rng = RNG_Create(9);
+  uint8 value = 0;
+  for (uint32 i = 0; i < size; ++i) {
+    if (RNG_Get32(rng) % 8 == 0)
+      value = (uint8)(RNG_Get32(rng) % 16);
+    Bytes_WriteU8(self->raw, value);
+  }
+  RNG_Free(rng);
+
+  self->packed = Bytes_Compress(self->raw);
+  return self;
+}
+
+static void BytesBench_Teardown (void* ctx) {
+  BytesBench* self = (BytesBench*)ctx;
+  Bytes_Free(self->raw);
+  Bytes_Free(self->packed);
+  MemFree(self);
+}
+
+static void BytesBench_Compress (void* ctx, uint64 n) {
+  BytesBench* self = (BytesBench*)ctx;
+  uint64 sum = 0;
+  for (uint64 i = 0; i < n; ++i) {
+    Bytes* out = Bytes_Compress(self->raw);
+    sum += Bytes_GetSize(out);
+    Bytes_Free(out);
+  }
+  Bench_Consume(sum);
+}
+
+static void BytesBench_Decompress (void* ctx, uint64 n) {
+  BytesBench* self = (BytesBench*)ctx;
+  uint64 sum = 0;
+  for (uint64 i = 0; i < n; ++i) {
+    Bytes* out = Bytes_Decompress(self->packed);
+    sum += Bytes_GetSize(out);
+    Bytes_Free(out);
+  }
+  Bench_Consume(sum);
+}
+
+/* Serialize a stream of mixed scalar fields, then read it back. */
+static void BytesBench_WriteRead (void* ctx, uint64 n) {
+  BytesBench* self = (BytesBench*)ctx;
+  Bytes* buf = self->raw;
+  uint32 capacity = Bytes_GetSize(buf) / 16;
+  uint64 sum = 0;
+  for (uint64 i = 0; i < n; i += capacity) {
+    Bytes_Rewind(buf);
+    for (uint32 j = 0; j < capacity; ++j) {
+      Bytes_WriteU32(buf, j);
+      Bytes_WriteF32(buf, (float)j);
+      Bytes_WriteU64(buf, (uint64)j << 32);
+    }
+    Bytes_Rewind(buf);
+    for (uint32 j = 0; j < capacity; ++j) {
+      sum += Bytes_ReadU32(buf);
+      sum += (uint64)Bytes_ReadF32(buf);
+      sum += Bytes_ReadU64(buf);
+    }
+  }
+  Bench_Consume(sum);
+}
+
+void Bench_RegisterBytes () {
+  Bench_Add("Bytes.Compress",   1 << 16, 1 << 16, BytesBench_Setup, BytesBench_Compress,   BytesBench_Teardown);
+  Bench_Add("Bytes.Decompress", 1 << 16, 1 << 16, BytesBench_Setup, BytesBench_Decompress, BytesBench_Teardown);
+  Bench_Add("Bytes.WriteRead",  1 << 16, 16,      BytesBench_Setup, BytesBench_WriteRead,  BytesBench_Teardown);
+}
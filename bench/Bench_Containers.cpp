@@ -0,0 +1,304 @@
+#include "Bench.h"
+#include "Box3.h"
+#include "HashGrid.h"
+#include "HashMap.h"
+#include "PhxMath.h"
+#include "PhxMemory.h"
+#include "PhxString.h"
+#include "RNG.h"
+#include "StrMap.h"
+#include "Vec3.h"
+
+#include <stdio.h>
+
+/* --- HashMap -------------------------------------------------------------- */
+
+/* The table is created at a fixed capacity and filled to 'param' percent of
+ * it, so that the probe behavior at each load factor can be compared between
+ * the Robin Hood and Swiss (ENABLE_HASHMAP_SWISS) builds. */
+#define HASHMAP_CAPACITY (1 << 16)
+
+struct HashMapBench {
+  HashMap* map;
+  uint64* keys;
+  uint64* misses;
+  uint32 count;
+  uint32 cursor;
+};
+
+static void* HashMapBench_Setup (int64 param) {
+  HashMapBench* self = MemNew(HashMapBench);
+  self->map = HashMap_Create(sizeof(uint64), HASHMAP_CAPACITY);
+  HashMap_SetMaxLoad(self->map, 0.95f);
+  self->count = (uint32)(HASHMAP_CAPACITY * param / 100);
+  self->keys = MemNewArray(uint64, self->count);
+  self->misses = MemNewArray(uint64, self->count);
+  self->cursor = 0;
+
+  RNG* rng = RNG_Create(1);
+  for (uint32 i = 0; i < self->count; ++i) {
+    self->keys[i] = RNG_Get64(rng);
+    self->misses[i] = RNG_Get64(rng);
+    HashMap_Set(self->map, self->keys + i, (void*)(size_t)(i + 1));
+  }
+  RNG_Free(rng);
+  return self;
+}
+
+static void HashMapBench_Teardown (void* ctx) {
+  HashMapBench* self = (HashMapBench*)ctx;
+  if (self->map)
+    HashMap_Free(self->map);
+  MemFree(self->keys);
+  MemFree(self->misses);
+  MemFree(self);
+}
+
+static void HashMapBench_GetHit (void* ctx, uint64 n) {
+  HashMapBench* self = (HashMapBench*)ctx;
+  uint64 sum = 0;
+  uint32 j = self->cursor;
+  for (uint64 i = 0; i < n; ++i) {
+    sum += (size_t)HashMap_Get(self->map, self->keys + j);
+    if (++j == self->count) j = 0;
+  }
+  self->cursor = j;
+  Bench_Consume(sum);
+}
+
+static void HashMapBench_GetMiss (void* ctx, uint64 n) {
+  HashMapBench* self = (HashMapBench*)ctx;
+  uint64 sum = 0;
+  uint32 j = self->cursor;
+  for (uint64 i = 0; i < n; ++i) {
+    sum += (size_t)HashMap_Get(self->map, self->misses + j);
+    if (++j == self->count) j = 0;
+  }
+  self->cursor = j;
+  Bench_Consume(sum);
+}
+
+/* Remove and re-insert, keeping the load factor constant. */
+static void HashMapBench_Churn (void* ctx, uint64 n) {
+  HashMapBench* self = (HashMapBench*)ctx;
+  uint32 j = self->cursor;
+  for (uint64 i = 0; i < n; ++i) {
+    void* value = HashMap_Remove(self->map, self->keys + j);
+    HashMap_Set(self->map, self->keys + j, value);
+    if (++j == self->count) j = 0;
+  }
+  self->cursor = j;
+}
+
+/* Build a map of 'param' entries from empty, including every resize. */
+static void* HashMapBench_SetupInsert (int64 param) {
+  HashMapBench* self = MemNew(HashMapBench);
+  self->map = 0;
+  self->count = (uint32)param;
+  self->keys = MemNewArray(uint64, self->count);
+  self->misses = 0;
+  self->cursor = 0;
+  RNG* rng = RNG_Create(2);
+  for (uint32 i = 0; i < self->count; ++i)
+    self->keys[i] = RNG_Get64(rng);
+  RNG_Free(rng);
+  return self;
+}
+
+static void HashMapBench_Insert (void* ctx, uint64 n) {
+  HashMapBench* self = (HashMapBench*)ctx;
+  uint32 j = self->cursor;
+  for (uint64 i = 0; i < n; ++i) {
+    if (j == 0) {
+      if (self->map)
+        HashMap_Free(self->map);
+      self->map = HashMap_Create(sizeof(uint64), 0);
+    }
+    HashMap_SetRaw(self->map, self->keys[j], (void*)1);
+    if (++j == self->count) j = 0;
+  }
+  self->cursor = j;
+}
+
+/* --- StrMap --------------------------------------------------------------- */
+
+struct StrMapBench {
+  StrMap* map;
+  cstr* keys;
+  uint32 count;
+  uint32 cursor;
+};
+
+static void* StrMapBench_Setup (int64 param) {
+  StrMapBench* self = MemNew(StrMapBench);
+  self->map = StrMap_Create(16);
+  self->count = (uint32)param;
+  self->keys = MemNewArray(cstr, self->count);
+  self->cursor = 0;
+  for (uint32 i = 0; i < self->count; ++i) {
+    self->keys[i] = StrFormat("object.component.field_%u", i * 2654435761u);
+    StrMap_Set(self->map, self->keys[i], (void*)(size_t)(i + 1));
+  }
+  return self;
+}
+
+static void StrMapBench_Teardown (void* ctx) {
+  StrMapBench* self = (StrMapBench*)ctx;
+  StrMap_Free(self->map);
+  for (uint32 i = 0; i < self->count; ++i)
+    StrFree(self->keys[i]);
+  MemFree(self->keys);
+  MemFree(self);
+}
+
+static void StrMapBench_Get (void* ctx, uint64 n) {
+  StrMapBench* self = (StrMapBench*)ctx;
+  uint64 sum = 0;
+  uint32 j = self->cursor;
+  for (uint64 i = 0; i < n; ++i) {
+    sum += (size_t)StrMap_Get(self->map, self->keys[j]);
+    if (++j == self->count) j = 0;
+  }
+  self->cursor = j;
+  Bench_Consume(sum);
+}
+
+static void StrMapBench_Set (void* ctx, uint64 n) {
+  StrMapBench* self = (StrMapBench*)ctx;
+  uint32 j = self->cursor;
+  for (uint64 i = 0; i < n; ++i) {
+    StrMap_Set(self->map, self->keys[j], (void*)(size_t)(i + 1));
+    if (++j == self->count) j = 0;
+  }
+  self->cursor = j;
+}
+
+/* --- HashGrid ------------------------------------------------------------- */
+
+/* 'param' unit-sized boxes scattered through a cube sized for roughly one
+ * object per cell. Updates move each box by less than a cell, as objects do
+ * from one frame to the next; the grid's cost grows with the distance moved. */
+struct HashGridBench {
+  HashGrid* grid;
+  HashGridElem** elems;
+  Box3f* boxes;
+  Box3f* moved;
+  Box3f* queries;
+  Vec3f* points;
+  uint32 count;
+  uint32 cursor;
+};
+
+static Box3f HashGridBench_RandomBox (RNG* rng, float extent, float size) {
+  Vec3f p;
+  RNG_GetVec3(rng, &p, 0.0, extent);
+  return Box3f_Create(p, Vec3f_Add(p, Vec3f_Create(size, size, size)));
+}
+
+static void* HashGridBench_Setup (int64 param) {
+  HashGridBench* self = MemNew(HashGridBench);
+  self->count = (uint32)param;
+  self->grid = HashGrid_Create(2.0f, 4 * self->count);
+  self->elems = MemNewArray(HashGridElem*, self->count);
+  self->boxes = MemNewArray(Box3f, self->count);
+  self->moved = MemNewArray(Box3f, self->count);
+  self->queries = MemNewArray(Box3f, self->count);
+  self->points = MemNewArray(Vec3f, self->count);
+  self->cursor = 0;
+
+  float extent = 2.0f * (float)Pow((double)self->count, 1.0 / 3.0);
+  RNG* rng = RNG_Create(3);
+  for (uint32 i = 0; i < self->count; ++i) {
+    self->boxes[i] = HashGridBench_RandomBox(rng, extent, 1.0f);
+    self->queries[i] = HashGridBench_RandomBox(rng, extent, 2.0f);
+
+    Vec3f offset;
+    RNG_GetVec3(rng, &offset, -0.75, 0.75);
+    self->moved[i] = Box3f_Create(
+      Vec3f_Add(self->boxes[i].lower, offset),
+      Vec3f_Add(self->boxes[i].upper, offset));
+    RNG_GetVec3(rng, self->points + i, 0.0, extent);
+    self->elems[i] = HashGrid_Add(self->grid, (void*)(size_t)(i + 1), self->boxes + i);
+  }
+  RNG_Free(rng);
+  return self;
+}
+
+static void HashGridBench_Teardown (void* ctx) {
+  HashGridBench* self = (HashGridBench*)ctx;
+  HashGrid_Free(self->grid);
+  MemFree(self->elems);
+  MemFree(self->boxes);
+  MemFree(self->moved);
+  MemFree(self->queries);
+  MemFree(self->points);
+  MemFree(self);
+}
+
+static void HashGridBench_QueryBox (void* ctx, uint64 n) {
+  HashGridBench* self = (HashGridBench*)ctx;
+  uint64 sum = 0;
+  uint32 j = self->cursor;
+  for (uint64 i = 0; i < n; ++i) {
+    sum += HashGrid_QueryBox(self->grid, self->queries + j);
+    if (++j == self->count) j = 0;
+  }
+  self->cursor = j;
+  Bench_Consume(sum);
+}
+
+static void HashGridBench_QueryPoint (void* ctx, uint64 n) {
+  HashGridBench* self = (HashGridBench*)ctx;
+  uint64 sum = 0;
+  uint32 j = self->cursor;
+  for (uint64 i = 0; i < n; ++i) {
+    sum += HashGrid_QueryPoint(self->grid, self->points + j);
+    if (++j == self->count) j = 0;
+  }
+  self->cursor = j;
+  Bench_Consume(sum);
+}
+
+/* Move each object back and forth between two positions. */
+static void HashGridBench_Update (void* ctx, uint64 n) {
+  HashGridBench* self = (HashGridBench*)ctx;
+  uint32 j = self->cursor;
+  for (uint64 i = 0; i < n; ++i) {
+    Box3f tmp = self->boxes[j];
+    self->boxes[j] = self->moved[j];
+    self->moved[j] = tmp;
+    HashGrid_Update(self->grid, self->elems[j], self->boxes + j);
+    if (++j == self->count) j = 0;
+  }
+  self->cursor = j;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Bench_RegisterContainers () {
+  static int64 const loads[] = { 25, 50, 75, 90 };
+  for (int i = 0; i < (int)(sizeof(loads) / sizeof(loads[0])); ++i) {
+    Bench_Add("HashMap.GetHit.Load", loads[i], 0,
+      HashMapBench_Setup, HashMapBench_GetHit, HashMapBench_Teardown);
+    Bench_Add("HashMap.GetMiss.Load", loads[i], 0,
+      HashMapBench_Setup, HashMapBench_GetMiss, HashMapBench_Teardown);
+    Bench_Add("HashMap.Churn.Load", loads[i], 0,
+      HashMapBench_Setup, HashMapBench_Churn, HashMapBench_Teardown);
+  }
+  Bench_Add("HashMap.Insert", 1 << 16, 0,
+    HashMapBench_SetupInsert, HashMapBench_Insert, HashMapBench_Teardown);
+
+  Bench_Add("StrMap.Get", 1 << 10, 0,
+    StrMapBench_Setup, StrMapBench_Get, StrMapBench_Teardown);
+  Bench_Add("StrMap.Get", 1 << 16, 0,
+    StrMapBench_Setup, StrMapBench_Get, StrMapBench_Teardown);
+  Bench_Add("StrMap.Set", 1 << 16, 0,
+    StrMapBench_Setup, StrMapBench_Set, StrMapBench_Teardown);
+
+  Bench_Add("HashGrid.QueryBox", 1 << 14, 0,
+    HashGridBench_Setup, HashGridBench_QueryBox, HashGridBench_Teardown);
+  Bench_Add("HashGrid.QueryPoint", 1 << 14, 0,
+    HashGridBench_Setup, HashGridBench_QueryPoint, HashGridBench_Teardown);
+  Bench_Add("HashGrid.Update", 1 << 14, 0,
+    HashGridBench_Setup, HashGridBench_Update, HashGridBench_Teardown);
+}
@@ -0,0 +1,64 @@
+#include "Bench.h"
+#include "Hash.h"
+#include "PhxMemory.h"
+#include "RNG.h"
+
+/* Every hash is run over a 'param'-byte buffer of random data. Short inputs
+ * measure per-call overhead (typical of hash map keys), long ones measure
+ * bulk throughput. */
+struct HashBench {
+  uint8* data;
+  int len;
+};
+
+static void* HashBench_Setup (int64 param) {
+  HashBench* self = MemNew(HashBench);
+  self->len = (int)param;
+  self->data = MemNewArray(uint8, self->len);
+  RNG* rng = RNG_Create(5);
+  for (int i = 0; i < self->len; ++i)
+    self->data[i] = (uint8)RNG_Get32(rng);
+  RNG_Free(rng);
+  return self;
+}
+
+static void HashBench_Teardown (void* ctx) {
+  HashBench* self = (HashBench*)ctx;
+  MemFree(self->data);
+  MemFree(self);
+}
+
+/* Feed each hash back into the first byte so calls can't be overlapped or
+ * hoisted out of the loop. */
+#define HASH_BENCH(name, expr)                                                 \
+  static void HashBench_##name (void* ctx, uint64 n) {                        \
+    HashBench* self = (HashBench*)ctx;                                         \
+    uint8* buf = self->data;                                                   \
+    int len = self->len;                                                       \
+    uint64 h = 0;                                                              \
+    for (uint64 i = 0; i < n; ++i) {                                           \
+      h += (uint64)(expr);                                                     \
+      buf[0] = (uint8)h;                                                       \
+    }                                                                          \
+    Bench_Consume(h);                                                          \
+  }
+
+HASH_BENCH(FNV32,   Hash_FNV32(buf, len))
+HASH_BENCH(FNV64,   Hash_FNV64(buf, len))
+HASH_BENCH(Murmur3, Hash_Murmur3(buf, len))
+HASH_BENCH(XX64,    Hash_XX64(buf, len, 0))
+HASH_BENCH(XXH3,    Hash_XXH3(buf, len, 0))
+
+#undef HASH_BENCH
+
+void Bench_RegisterHash () {
+  static int64 const sizes[] = { 8, 32, 256, 4096, 1 << 20 };
+  for (int i = 0; i < (int)(sizeof(sizes) / sizeof(sizes[0])); ++i) {
+    uint64 bytes = (uint64)sizes[i];
+    Bench_Add("Hash.FNV32",   sizes[i], bytes, HashBench_Setup, HashBench_FNV32,   HashBench_Teardown);
+    Bench_Add("Hash.FNV64",   sizes[i], bytes, HashBench_Setup, HashBench_FNV64,   HashBench_Teardown);
+    Bench_Add("Hash.Murmur3", sizes[i], bytes, HashBench_Setup, HashBench_Murmur3, HashBench_Teardown);
+    Bench_Add("Hash.XX64",    sizes[i], bytes, HashBench_Setup, HashBench_XX64,    HashBench_Teardown);
+    Bench_Add("Hash.XXH3",    sizes[i], bytes, HashBench_Setup, HashBench_XXH3,    HashBench_Teardown);
+  }
+}
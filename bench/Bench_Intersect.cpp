@@ -0,0 +1,533 @@
+#include "Bench.h"
+#include "Box3.h"
+#include "Intersect.h"
+#include "PhxMath.h"
+#include "PhxMemory.h"
+#include "Plane.h"
+#include "Ray.h"
+#include "RNG.h"
+#include "Sphere.h"
+#include "Triangle.h"
+#include "Vec3.h"
+#include "Vec4.h"
+
+#include <float.h>
+#include <stdio.h>
+
+/* 'param' random triangles in a unit cube, paired with rays fired from
+ * outside it towards random points, so that roughly half the tests hit. */
+struct IntersectBench {
+  Triangle* tri;
+  Ray* ray;
+  Sphere* sphere;
+  Vec4f* rect;
+  uint32 count;
+};
+
+static void* IntersectBench_Setup (int64 param) {
+  IntersectBench* self = MemNew(IntersectBench);
+  self->count = (uint32)param;
+  self->tri = MemNewArray(Triangle, self->count);
+  self->ray = MemNewArray(Ray, self->count);
+  self->sphere = MemNewArray(Sphere, self->count);
+  self->rect = MemNewArray(Vec4f, self->count);
+
+  RNG* rng = RNG_Create(8);
+  for (uint32 i = 0; i < self->count; ++i) {
+    for (int k = 0; k < 3; ++k)
+      RNG_GetVec3(rng, self->tri[i].vertices + k, 0.0, 1.0);
+
+    Vec3f target;
+    RNG_GetVec3(rng, &target, 0.0, 1.0);
+    RNG_GetDir3(rng, &self->ray[i].p);
+    self->ray[i].p = Vec3f_Add(Vec3f_Muls(self->ray[i].p, 4.0f), Vec3f_Create(0.5f, 0.5f, 0.5f));
+    self->ray[i].dir = Vec3f_Normalize(Vec3f_Sub(target, self->ray[i].p));
+    self->ray[i].tMin = 0.0f;
+    self->ray[i].tMax = 1e30f;
+
+    RNG_GetVec3(rng, &self->sphere[i].p, 0.0, 1.0);
+    self->sphere[i].r = (float)RNG_GetUniformRange(rng, 0.05, 0.3);
+    RNG_GetVec4(rng, self->rect + i, 0.0, 1.0);
+  }
+  RNG_Free(rng);
+  return self;
+}
+
+static void IntersectBench_Teardown (void* ctx) {
+  IntersectBench* self = (IntersectBench*)ctx;
+  MemFree(self->tri);
+  MemFree(self->ray);
+  MemFree(self->sphere);
+  MemFree(self->rect);
+  MemFree(self);
+}
+
+/* 'body' tests pair (j, k) and sets 'hit'. Ray / sphere index k advances
+ * every 8 iterations so the ray set isn't a lockstep copy of the primitive
+ * set. */
+#define INTERSECT_BENCH(name, body)                                            \
+  static void IntersectBench_##name (void* ctx, uint64 n) {                   \
+    IntersectBench* self = (IntersectBench*)ctx;                               \
+    uint32 mask = self->count - 1;                                             \
+    uint64 hits = 0;                                                           \
+    for (uint64 i = 0; i < n; ++i) {                                           \
+      uint32 j = (uint32)i & mask;                                             \
+      uint32 k = (uint32)(i >> 3) & mask;                                      \
+      bool hit;                                                                \
+      body;                                                                    \
+      hits += hit ? 1 : 0;                                                     \
+    }                                                                          \
+    Bench_Consume(hits);                                                       \
+  }
+
+INTERSECT_BENCH(RayTriangleBarycentric, {
+  float t;
+  hit = Intersect_RayTriangle_Barycentric(self->ray + k, self->tri + j, 1e-6f, &t);
+})
+
+INTERSECT_BENCH(RayTriangleMoller1, {
+  float t;
+  hit = Intersect_RayTriangle_Moller1(self->ray + k, self->tri + j, &t);
+})
+
+INTERSECT_BENCH(RayTriangleMoller2, {
+  float t;
+  hit = Intersect_RayTriangle_Moller2(self->ray + k, self->tri + j, &t);
+})
+
+INTERSECT_BENCH(SphereTriangle, {
+  Vec3f p;
+  hit = Intersect_SphereTriangle(self->sphere + k, self->tri + j, &p);
+})
+
+INTERSECT_BENCH(RectRect, {
+  hit = Intersect_RectRect(self->rect + k, self->rect + j);
+})
+
+INTERSECT_BENCH(RectRectFast, {
+  hit = Intersect_RectRectFast(self->rect + k, self->rect + j);
+})
+
+#undef INTERSECT_BENCH
+
+/* --- Wide Ray Tests ------------------------------------------------------- */
+
+/* A leaf of 'param' triangles and boxes from the same unit cube, tested
+ * against a stream of rays. Times are per primitive (per ray for packets),
+ * so the scalar loops and the packed kernels compare directly. */
+#define WIDE_RAYS 1024
+
+struct WideBench {
+  Triangle* tri;
+  TrianglePack* triPack;
+  Box3f* box;
+  BoxPack* boxPack;
+  Ray* ray;
+  RayPacket* packet;
+  float* tEnter;
+  int count;
+  uint32 cursor;
+};
+
+static void* WideBench_Setup (int64 param) {
+  WideBench* self = MemNew(WideBench);
+  self->count = (int)param;
+  int packs = (self->count + 7) / 8;
+  self->tri = MemNewArray(Triangle, self->count);
+  self->triPack = MemNewArray(TrianglePack, packs);
+  self->box = MemNewArray(Box3f, self->count);
+  self->boxPack = MemNewArray(BoxPack, packs);
+  self->ray = MemNewArray(Ray, WIDE_RAYS);
+  self->packet = MemNewArray(RayPacket, WIDE_RAYS / 8);
+  self->tEnter = MemNewArray(float, self->count);
+  self->cursor = 0;
+
+  RNG* rng = RNG_Create(9);
+  for (int i = 0; i < self->count; ++i) {
+    for (int k = 0; k < 3; ++k)
+      RNG_GetVec3(rng, self->tri[i].vertices + k, 0.0, 1.0);
+    Vec3f c, e;
+    RNG_GetVec3(rng, &c, 0.0, 1.0);
+    RNG_GetVec3(rng, &e, 0.02, 0.2);
+    self->box[i] = Box3f_Create(Vec3f_Sub(c, e), Vec3f_Add(c, e));
+  }
+
+  for (int i = 0; i < WIDE_RAYS; ++i) {
+    Vec3f target;
+    RNG_GetVec3(rng, &target, 0.0, 1.0);
+    RNG_GetDir3(rng, &self->ray[i].p);
+    self->ray[i].p = Vec3f_Add(Vec3f_Muls(self->ray[i].p, 4.0f), Vec3f_Create(0.5f, 0.5f, 0.5f));
+    self->ray[i].dir = Vec3f_Normalize(Vec3f_Sub(target, self->ray[i].p));
+    self->ray[i].tMin = 0.0f;
+    self->ray[i].tMax = 1e30f;
+  }
+  RNG_Free(rng);
+
+  Intersect_PackTriangles(self->tri, self->count, self->triPack);
+  Intersect_PackBoxes(self->box, self->count, self->boxPack);
+  for (int i = 0; i < WIDE_RAYS / 8; ++i)
+    Intersect_PackRays(self->ray + 8 * i, 8, self->packet + i);
+  return self;
+}
+
+static void WideBench_Teardown (void* ctx) {
+  WideBench* self = (WideBench*)ctx;
+  MemFree(self->tri);
+  MemFree(self->triPack);
+  MemFree(self->box);
+  MemFree(self->boxPack);
+  MemFree(self->ray);
+  MemFree(self->packet);
+  MemFree(self->tEnter);
+  MemFree(self);
+}
+
+/* 'body' tests ray 'ray' against the whole leaf and adds to 'hits'. */
+#define WIDE_BENCH(name, body)                                                 \
+  static void WideBench_##name (void* ctx, uint64 n) {                        \
+    WideBench* self = (WideBench*)ctx;                                         \
+    uint64 hits = 0;                                                           \
+    uint32 r = self->cursor;                                                   \
+    for (uint64 i = 0; i < n; i += self->count) {                              \
+      Ray const* ray = self->ray + r;                                          \
+      body;                                                                    \
+      r = (r + 1) & (WIDE_RAYS - 1);                                           \
+    }                                                                          \
+    self->cursor = r;                                                          \
+    Bench_Consume(hits);                                                       \
+  }
+
+WIDE_BENCH(RayTrianglesLoop, {
+  int best = -1;
+  float bestT = 0;
+  for (int j = 0; j < self->count; ++j) {
+    float t;
+    if (Intersect_RayTriangle_Moller1(ray, self->tri + j, &t) && (best < 0 || t < bestT)) {
+      best = j;
+      bestT = t;
+    }
+  }
+  hits += best + 1;
+})
+
+WIDE_BENCH(RayTriangles, {
+  float t;
+  hits += Intersect_RayTriangles(ray, self->triPack, self->count, &t) + 1;
+})
+
+WIDE_BENCH(RayBoxesLoop, {
+  Vec3f rd = Vec3f_Rcp(ray->dir);
+  for (int j = 0; j < self->count; ++j)
+    hits += Box3f_IntersectsRay(self->box[j], ray->p, rd) ? 1 : 0;
+})
+
+WIDE_BENCH(RayBoxes, {
+  hits += Intersect_RayBoxes(ray, self->boxPack, self->count, self->tEnter);
+})
+
+#undef WIDE_BENCH
+
+/* Eight rays against one box per iteration, reported per ray. */
+static void WideBench_RayPacketBoxLoop (void* ctx, uint64 n) {
+  WideBench* self = (WideBench*)ctx;
+  uint64 hits = 0;
+  uint32 r = self->cursor;
+  for (uint64 i = 0; i < n; i += 8) {
+    Box3f const* box = self->box + (i >> 3) % self->count;
+    for (int k = 0; k < 8; ++k) {
+      Ray const* ray = self->ray + r + k;
+      hits += Box3f_IntersectsRay(*box, ray->p, Vec3f_Rcp(ray->dir)) ? 1 : 0;
+    }
+    r = (r + 8) & (WIDE_RAYS - 1);
+  }
+  self->cursor = r;
+  Bench_Consume(hits);
+}
+
+static void WideBench_RayPacketBox (void* ctx, uint64 n) {
+  WideBench* self = (WideBench*)ctx;
+  uint64 hits = 0;
+  uint32 r = self->cursor;
+  for (uint64 i = 0; i < n; i += 8) {
+    Box3f const* box = self->box + (i >> 3) % self->count;
+    hits += Intersect_RayPacketBox(self->packet + (r >> 3), box);
+    r = (r + 8) & (WIDE_RAYS - 1);
+  }
+  self->cursor = r;
+  Bench_Consume(hits);
+}
+
+/* --- Self-Check ----------------------------------------------------------- */
+
+/* Every wide kernel available must agree with the scalar one: exactly in
+ * which primitives and rays hit and in the boxes' entry t, and to within
+ * CHECK_ULPS in a triangle's t, which -ffast-math may compute in a different
+ * order (see Intersect.cpp). Every count up to CHECK_PRIMS is tested twice: packed to
+ * exactly 'count', so that padding lanes are live, and packed in full, so
+ * that real primitives past 'count' must be masked off. The exact packs are
+ * also run on the count rounded up to a multiple of 8, where the padding
+ * itself must never hit. Some primitives are
+ * duplicated across the SSE and AVX group boundaries, and some rays aimed
+ * right at them, so that ties must resolve to the first index. */
+#define CHECK_PRIMS 40
+#define CHECK_RAYS 256
+#define CHECK_REPORTS 10
+#define CHECK_ULPS 4
+
+static int const kCheckKernel[] = { Intersect_WideSSE, Intersect_WideAVX };
+static cstr const kCheckKernelName[] = { "SSE", "AVX" };
+static int const kCheckDup[] = { 3, 4, 7, 8, 15, 16, 33 };
+
+struct IntersectCheck {
+  Triangle tri[CHECK_PRIMS];
+  Box3f box[CHECK_PRIMS];
+  Ray ray[CHECK_RAYS];
+  TrianglePack triFull[CHECK_PRIMS / 8];
+  TrianglePack triExact[CHECK_PRIMS / 8];
+  BoxPack boxFull[CHECK_PRIMS / 8];
+  BoxPack boxExact[CHECK_PRIMS / 8];
+  int failures;
+  int ties;
+};
+
+static void IntersectCheck_Setup (IntersectCheck* self) {
+  RNG* rng = RNG_Create(10);
+  for (int i = 0; i < CHECK_PRIMS; ++i) {
+    for (int k = 0; k < 3; ++k)
+      RNG_GetVec3(rng, self->tri[i].vertices + k, 0.0, 1.0);
+    Vec3f c, e;
+    RNG_GetVec3(rng, &c, 0.0, 1.0);
+    RNG_GetVec3(rng, &e, 0.02, 0.2);
+    self->box[i] = Box3f_Create(Vec3f_Sub(c, e), Vec3f_Add(c, e));
+  }
+
+  int const dups = (int)(sizeof(kCheckDup) / sizeof(kCheckDup[0]));
+  for (int i = 1; i < dups; ++i) {
+    self->tri[kCheckDup[i]] = self->tri[kCheckDup[0]];
+    self->box[kCheckDup[i]] = self->box[kCheckDup[0]];
+  }
+
+  /* A quarter of the rays aim at the duplicated triangle's centroid, and a
+   * quarter run along an axis (so that the slab tests see infinite
+   * reciprocals); the rest aim at random points. */
+  Vec3f const* dv = self->tri[kCheckDup[0]].vertices;
+  Vec3f centroid = Vec3f_Muls(Vec3f_Add(Vec3f_Add(dv[0], dv[1]), dv[2]), 1.0f / 3.0f);
+  for (int i = 0; i < CHECK_RAYS; ++i) {
+    Ray* ray = self->ray + i;
+    Vec3f target;
+    RNG_GetVec3(rng, &target, 0.0, 1.0);
+    RNG_GetDir3(rng, &ray->p);
+    ray->p = Vec3f_Add(Vec3f_Muls(ray->p, 4.0f), Vec3f_Create(0.5f, 0.5f, 0.5f));
+    if (i % 4 == 0)
+      target = centroid;
+    ray->dir = Vec3f_Normalize(Vec3f_Sub(target, ray->p));
+    if (i % 4 == 1) {
+      float const* d = &ray->dir.x;
+      int axis = Abs(d[0]) > Abs(d[1]) ? (Abs(d[0]) > Abs(d[2]) ? 0 : 2)
+                                       : (Abs(d[1]) > Abs(d[2]) ? 1 : 2);
+      float sign = d[axis] < 0.0f ? -1.0f : 1.0f;
+      ray->dir = Vec3f_Create(axis == 0 ? sign : 0, axis == 1 ? sign : 0, axis == 2 ? sign : 0);
+    }
+    ray->tMin = 0.0f;
+    ray->tMax = 1e30f;
+
+    /* Some rays are unbounded and run along a diagonal, which meets every
+     * slab of a far corner (such as padding at FLT_MAX) at the same t. */
+    if (i % 8 == 2) {
+      ray->dir = Vec3f_Create(
+        ray->dir.x < 0.0f ? -1.0f : 1.0f,
+        ray->dir.y < 0.0f ? -1.0f : 1.0f,
+        ray->dir.z < 0.0f ? -1.0f : 1.0f);
+      ray->tMax = FLT_MAX;
+    }
+  }
+  RNG_Free(rng);
+
+  Intersect_PackTriangles(self->tri, CHECK_PRIMS, self->triFull);
+  Intersect_PackBoxes(self->box, CHECK_PRIMS, self->boxFull);
+}
+
+static void IntersectCheck_Report (IntersectCheck* self, cstr kernel, cstr test,
+                                   int count, int ray, double got, double want)
+{
+  if (self->failures++ < CHECK_REPORTS)
+    printf("  %s %s: count %d, ray %d: got %.9g, want %.9g\n",
+      kernel, test, count, ray, got, want);
+}
+
+/* One ray against the first 'count' primitives of the given packs. The
+ * element just past 'count' in tEnter must be left alone. */
+static void IntersectCheck_Ray (IntersectCheck* self, TrianglePack const* tp,
+                                BoxPack const* bp, int count, int r)
+{
+  Ray const* ray = self->ray + r;
+  float refEnter[CHECK_PRIMS + 1];
+  float refT;
+  refEnter[count] = -1.0f;
+  Intersect_SetWideKernel(Intersect_WideScalar);
+  int ref = Intersect_RayTriangles(ray, tp, count, &refT);
+  int refHits = Intersect_RayBoxes(ray, bp, count, refEnter);
+  if (ref >= count)
+    IntersectCheck_Report(self, "scalar", "RayTriangles index", count, r, ref, count - 1);
+  if (refEnter[count] != -1.0f)
+    IntersectCheck_Report(self, "scalar", "RayBoxes overrun", count, r, refEnter[count], -1.0);
+  if (ref == kCheckDup[0] && count > kCheckDup[1])
+    self->ties++;
+
+  for (int k = 0; k < (int)(sizeof(kCheckKernel) / sizeof(kCheckKernel[0])); ++k) {
+    if (!Intersect_SetWideKernel(kCheckKernel[k]))
+      continue;
+    cstr name = kCheckKernelName[k];
+
+    float t;
+    int hit = Intersect_RayTriangles(ray, tp, count, &t);
+    if (hit != ref)
+      IntersectCheck_Report(self, name, "RayTriangles index", count, r, hit, ref);
+    else if (hit >= 0 && Abs(t - refT) > CHECK_ULPS * FLT_EPSILON * Abs(refT))
+      IntersectCheck_Report(self, name, "RayTriangles t", count, r, t, refT);
+
+    float enter[CHECK_PRIMS + 1];
+    enter[count] = -1.0f;
+    int hits = Intersect_RayBoxes(ray, bp, count, enter);
+    if (hits != refHits)
+      IntersectCheck_Report(self, name, "RayBoxes hits", count, r, hits, refHits);
+    if (enter[count] != -1.0f)
+      IntersectCheck_Report(self, name, "RayBoxes overrun", count, r, enter[count], -1.0);
+    for (int i = 0; i < count; ++i) {
+      if (enter[i] != refEnter[i]) {
+        IntersectCheck_Report(self, name, "RayBoxes tEnter", count, r, enter[i], refEnter[i]);
+        break;
+      }
+    }
+  }
+}
+
+/* One ray against the exact packs for 'count', run on the padded count. Every
+ * kernel must report the same as the scalar one does on 'count' alone. */
+static void IntersectCheck_Padded (IntersectCheck* self, int count, int r) {
+  Ray const* ray = self->ray + r;
+  int padded = (count + 7) / 8 * 8;
+  float refEnter[CHECK_PRIMS];
+  float refT;
+  Intersect_SetWideKernel(Intersect_WideScalar);
+  int ref = Intersect_RayTriangles(ray, self->triExact, count, &refT);
+  int refHits = Intersect_RayBoxes(ray, self->boxExact, count, refEnter);
+
+  for (int k = -1; k < (int)(sizeof(kCheckKernel) / sizeof(kCheckKernel[0])); ++k) {
+    if (!Intersect_SetWideKernel(k < 0 ? Intersect_WideScalar : kCheckKernel[k]))
+      continue;
+    cstr name = k < 0 ? "scalar" : kCheckKernelName[k];
+
+    float t;
+    int hit = Intersect_RayTriangles(ray, self->triExact, padded, &t);
+    if (hit != ref)
+      IntersectCheck_Report(self, name, "padded RayTriangles index", count, r, hit, ref);
+
+    float enter[CHECK_PRIMS];
+    int hits = Intersect_RayBoxes(ray, self->boxExact, padded, enter);
+    if (hits != refHits)
+      IntersectCheck_Report(self, name, "padded RayBoxes hits", count, r, hits, refHits);
+    for (int i = count; i < padded; ++i) {
+      if (enter[i] != FLT_MAX) {
+        IntersectCheck_Report(self, name, "padded RayBoxes tEnter", count, r, enter[i], FLT_MAX);
+        break;
+      }
+    }
+  }
+}
+
+/* Packets of 1 to 8 rays (the rest padding) against every box. */
+static void IntersectCheck_Packets (IntersectCheck* self) {
+  for (int n = 1; n <= 8; ++n) {
+    for (int r = 0; r + 8 <= CHECK_RAYS; r += 8) {
+      RayPacket packet;
+      Intersect_PackRays(self->ray + r, n, &packet);
+      for (int b = 0; b < CHECK_PRIMS; ++b) {
+        Intersect_SetWideKernel(Intersect_WideScalar);
+        int ref = Intersect_RayPacketBox(&packet, self->box + b);
+        if (ref >> n)
+          IntersectCheck_Report(self, "scalar", "RayPacketBox padding", n, r, ref, ref & ((1 << n) - 1));
+
+        for (int k = 0; k < (int)(sizeof(kCheckKernel) / sizeof(kCheckKernel[0])); ++k) {
+          if (!Intersect_SetWideKernel(kCheckKernel[k]))
+            continue;
+          int mask = Intersect_RayPacketBox(&packet, self->box + b);
+          if (mask != ref)
+            IntersectCheck_Report(self, kCheckKernelName[k], "RayPacketBox mask", n, r, mask, ref);
+        }
+      }
+    }
+  }
+}
+
+static bool IntersectCheck_Wide () {
+  IntersectCheck* self = MemNew(IntersectCheck);
+  IntersectCheck_Setup(self);
+  self->failures = 0;
+  self->ties = 0;
+
+  for (int k = 0; k < (int)(sizeof(kCheckKernel) / sizeof(kCheckKernel[0])); ++k)
+    if (!Intersect_SetWideKernel(kCheckKernel[k]))
+      printf("  %s kernel not available; skipped\n", kCheckKernelName[k]);
+
+  for (int count = 1; count <= CHECK_PRIMS; ++count) {
+    Intersect_PackTriangles(self->tri, count, self->triExact);
+    Intersect_PackBoxes(self->box, count, self->boxExact);
+    for (int r = 0; r < CHECK_RAYS; ++r) {
+      IntersectCheck_Ray(self, self->triExact, self->boxExact, count, r);
+      IntersectCheck_Ray(self, self->triFull, self->boxFull, count, r);
+      if (count % 8)
+        IntersectCheck_Padded(self, count, r);
+    }
+  }
+  IntersectCheck_Packets(self);
+  Intersect_SetWideKernel(Intersect_WideAuto);
+
+  /* Guard against the data drifting into never exercising ties. */
+  if (self->ties == 0) {
+    printf("  no ray resolved a tie between duplicated triangles\n");
+    self->failures++;
+  }
+
+  bool ok = self->failures == 0;
+  if (!ok)
+    printf("  %d mismatches\n", self->failures);
+  MemFree(self);
+  return ok;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Bench_RegisterIntersect () {
+  int64 const count = 1024;
+  Bench_Add("Intersect.RayTriangle.Barycentric", count, 0,
+    IntersectBench_Setup, IntersectBench_RayTriangleBarycentric, IntersectBench_Teardown);
+  Bench_Add("Intersect.RayTriangle.Moller1", count, 0,
+    IntersectBench_Setup, IntersectBench_RayTriangleMoller1, IntersectBench_Teardown);
+  Bench_Add("Intersect.RayTriangle.Moller2", count, 0,
+    IntersectBench_Setup, IntersectBench_RayTriangleMoller2, IntersectBench_Teardown);
+  Bench_Add("Intersect.SphereTriangle", count, 0,
+    IntersectBench_Setup, IntersectBench_SphereTriangle, IntersectBench_Teardown);
+  Bench_Add("Intersect.RectRect", count, 0,
+    IntersectBench_Setup, IntersectBench_RectRect, IntersectBench_Teardown);
+  Bench_Add("Intersect.RectRectFast", count, 0,
+    IntersectBench_Setup, IntersectBench_RectRectFast, IntersectBench_Teardown);
+
+  static int64 const leaves[] = { 8, 32 };
+  for (int i = 0; i < (int)(sizeof(leaves) / sizeof(leaves[0])); ++i) {
+    Bench_Add("Intersect.Wide.RayTrianglesLoop", leaves[i], 0,
+      WideBench_Setup, WideBench_RayTrianglesLoop, WideBench_Teardown);
+    Bench_Add("Intersect.Wide.RayTriangles", leaves[i], 0,
+      WideBench_Setup, WideBench_RayTriangles, WideBench_Teardown);
+    Bench_Add("Intersect.Wide.RayBoxesLoop", leaves[i], 0,
+      WideBench_Setup, WideBench_RayBoxesLoop, WideBench_Teardown);
+    Bench_Add("Intersect.Wide.RayBoxes", leaves[i], 0,
+      WideBench_Setup, WideBench_RayBoxes, WideBench_Teardown);
+  }
+  Bench_Add("Intersect.Wide.RayPacketBoxLoop", 64, 0,
+    WideBench_Setup, WideBench_RayPacketBoxLoop, WideBench_Teardown);
+  Bench_Add("Intersect.Wide.RayPacketBox", 64, 0,
+    WideBench_Setup, WideBench_RayPacketBox, WideBench_Teardown);
+
+  Bench_AddCheck("Intersect.Wide.Kernels", IntersectCheck_Wide);
+}
@@ -0,0 +1,94 @@
+#include "Bench.h"
+#include "Lua.h"
+#include "PhxMemory.h"
+#include "RNG.h"
+
+/* --- LuaScheduler --------------------------------------------------------- */
+
+/* A Lua state with 'param' calls scheduled between one and two million
+ * seconds out, so that none of them ever wakes. Each benchmark then measures
+ * one scheduler operation against that backlog through the script-facing
+ * globals, as a game frame would issue them. */
+struct SchedulerBench {
+  Lua* lua;
+};
+
+static int SchedulerBench_Noop (Lua*) {
+  return 0;
+}
+
+static double SchedulerBench_Schedule (Lua* L, double delay) {
+  Lua_PushGlobal(L, "Schedule");
+  Lua_PushGlobal(L, "SchedulerBench_Noop");
+  Lua_PushNumber(L, 0);
+  Lua_PushNumber(L, delay);
+  Lua_Call(L, 3, 1, 0);
+  double handle = lua_tonumber(L, -1);
+  lua_pop(L, 1);
+  return handle;
+}
+
+static void SchedulerBench_Call (Lua* L, cstr name, double arg) {
+  Lua_PushGlobal(L, name);
+  Lua_PushNumber(L, arg);
+  Lua_Call(L, 1, 0, 0);
+}
+
+static void* SchedulerBench_Setup (int64 param) {
+  SchedulerBench* self = MemNew(SchedulerBench);
+  self->lua = Lua_Create();
+  Lua_SetFn(self->lua, "SchedulerBench_Noop", SchedulerBench_Noop);
+
+  RNG* rng = RNG_Create(5);
+  for (int64 i = 0; i < param; ++i)
+    SchedulerBench_Schedule(self->lua, 1e6 * (1.0 + RNG_GetUniform(rng)));
+  RNG_Free(rng);
+  return self;
+}
+
+static void SchedulerBench_Teardown (void* ctx) {
+  SchedulerBench* self = (SchedulerBench*)ctx;
+  SchedulerBench_Call(self->lua, "SchedulerClear", 0);
+  Lua_Free(self->lua);
+  MemFree(self);
+}
+
+/* An update with nothing due. */
+static void SchedulerBench_Idle (void* ctx, uint64 n) {
+  SchedulerBench* self = (SchedulerBench*)ctx;
+  for (uint64 i = 0; i < n; ++i)
+    SchedulerBench_Call(self->lua, "SchedulerUpdate", 0);
+}
+
+/* Schedule a call with no delay and run it in the next update. */
+static void SchedulerBench_Fire (void* ctx, uint64 n) {
+  SchedulerBench* self = (SchedulerBench*)ctx;
+  for (uint64 i = 0; i < n; ++i) {
+    SchedulerBench_Schedule(self->lua, 0);
+    SchedulerBench_Call(self->lua, "SchedulerUpdate", 0);
+  }
+}
+
+/* Schedule a call somewhere within the backlog and cancel it again. */
+static void SchedulerBench_Cancel (void* ctx, uint64 n) {
+  SchedulerBench* self = (SchedulerBench*)ctx;
+  for (uint64 i = 0; i < n; ++i) {
+    double delay = 1e6 * (1.0 + (double)(i & 1023) / 1024.0);
+    double handle = SchedulerBench_Schedule(self->lua, delay);
+    SchedulerBench_Call(self->lua, "SchedulerCancel", handle);
+  }
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Bench_RegisterLua () {
+  static int64 const counts[] = { 10000, 100000 };
+  for (int i = 0; i < (int)(sizeof(counts) / sizeof(counts[0])); ++i) {
+    Bench_Add("Lua.Scheduler.Idle", counts[i], 0,
+      SchedulerBench_Setup, SchedulerBench_Idle, SchedulerBench_Teardown);
+    Bench_Add("Lua.Scheduler.Fire", counts[i], 0,
+      SchedulerBench_Setup, SchedulerBench_Fire, SchedulerBench_Teardown);
+    Bench_Add("Lua.Scheduler.Cancel", counts[i], 0,
+      SchedulerBench_Setup, SchedulerBench_Cancel, SchedulerBench_Teardown);
+  }
+}
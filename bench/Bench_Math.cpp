@@ -0,0 +1,505 @@
+#include "Bench.h"
+#include "Box3.h"
+#include "FastMath.h"
+#include "Matrix.h"
+#include "MatrixDef.h"
+#include "PhxMath.h"
+#include "PhxMemory.h"
+#include "Quat.h"
+#include "RNG.h"
+#include "Vec3.h"
+#include "Vertex.h"
+
+#include <math.h>
+#include <stdio.h>
+
+/* A working set of 'param' random transforms, rotations and points. The
+ * allocating Matrix functions are measured alongside their IO / Set
+ * counterparts, so the cost of the heap round trip stays visible. */
+struct MathBench {
+  Matrix** m;
+  Quat* q;
+  Vec3f* v;
+  Box3f* box;
+  uint32 count;
+};
+
+static void* MathBench_Setup (int64 param) {
+  MathBench* self = MemNew(MathBench);
+  self->count = (uint32)param;
+  self->m = MemNewArray(Matrix*, self->count);
+  self->q = MemNewArray(Quat, self->count);
+  self->v = MemNewArray(Vec3f, self->count);
+  self->box = MemNewArray(Box3f, self->count);
+
+  RNG* rng = RNG_Create(7);
+  for (uint32 i = 0; i < self->count; ++i) {
+    Vec3f pos;
+    RNG_GetVec3(rng, &pos, -100.0, 100.0);
+    RNG_GetQuat(rng, self->q + i);
+    self->m[i] = Matrix_FromPosRotScale(&pos, self->q + i, (float)RNG_GetUniformRange(rng, 0.5, 2.0));
+    RNG_GetVec3(rng, self->v + i, -10.0, 10.0);
+    self->box[i] = Box3f_Create(self->v[i], Vec3f_Add(self->v[i], Vec3f_Create(1, 2, 3)));
+  }
+  RNG_Free(rng);
+  return self;
+}
+
+static void MathBench_Teardown (void* ctx) {
+  MathBench* self = (MathBench*)ctx;
+  for (uint32 i = 0; i < self->count; ++i)
+    Matrix_Free(self->m[i]);
+  MemFree(self->m);
+  MemFree(self->q);
+  MemFree(self->v);
+  MemFree(self->box);
+  MemFree(self);
+}
+
+#define MATH_BENCH(name, init, body, result)                                   \
+  static void MathBench_##name (void* ctx, uint64 n) {                        \
+    MathBench* self = (MathBench*)ctx;                                         \
+    uint32 mask = self->count - 1;                                             \
+    init;                                                                      \
+    for (uint64 i = 0; i < n; ++i) {                                           \
+      uint32 j = (uint32)i & mask;                                             \
+      uint32 k = (j + 1) & mask;                                               \
+      body;                                                                    \
+    }                                                                          \
+    Bench_Consume((uint64)(result));                                           \
+  }
+
+MATH_BENCH(MatrixProduct, float acc = 0, {
+  Matrix* r = Matrix_Product(self->m[j], self->m[k]);
+  acc += r->m[3];
+  Matrix_Free(r);
+}, acc)
+
+MATH_BENCH(MatrixInverse, float acc = 0, {
+  Matrix* r = Matrix_Inverse(self->m[j]);
+  acc += r->m[3];
+  Matrix_Free(r);
+}, acc)
+
+MATH_BENCH(MatrixIOProduct, float acc = 0, {
+  Matrix r;
+  Matrix_IOProduct(self->m[j], self->m[k], &r);
+  acc += r.m[3];
+}, acc)
+
+MATH_BENCH(MatrixIOInverse, float acc = 0, {
+  Matrix r;
+  Matrix_IOInverse(self->m[j], &r);
+  acc += r.m[3];
+}, acc)
+
+MATH_BENCH(MatrixIOTranspose, float acc = 0, {
+  Matrix r;
+  Matrix_IOTranspose(self->m[j], &r);
+  acc += r.m[3];
+}, acc)
+
+MATH_BENCH(MatrixMulPoint, Vec3f acc = Vec3f_Create(0, 0, 0), {
+  Vec3f r;
+  Matrix_MulPoint(self->m[j], &r, self->v[k].x, self->v[k].y, self->v[k].z);
+  acc = Vec3f_Add(acc, r);
+}, acc.x)
+
+MATH_BENCH(MatrixMulBox, float acc = 0, {
+  Box3f r;
+  Matrix_MulBox(self->m[j], &r, self->box + k);
+  acc += r.upper.x;
+}, acc)
+
+MATH_BENCH(MatrixFromPosRot, float acc = 0, {
+  Matrix* r = Matrix_FromPosRot(self->v + k, self->q + j);
+  acc += r->m[0];
+  Matrix_Free(r);
+}, acc)
+
+MATH_BENCH(MatrixSetFromPosRot, float acc = 0, {
+  Matrix r;
+  Matrix_SetFromPosRot(&r, self->v + k, self->q + j);
+  acc += r.m[0];
+}, acc)
+
+MATH_BENCH(QuatMul, float acc = 0, {
+  Quat r;
+  Quat_Mul(self->q + j, self->q + k, &r);
+  acc += r.w;
+}, acc)
+
+MATH_BENCH(QuatMulV, Vec3f acc = Vec3f_Create(0, 0, 0), {
+  Vec3f r;
+  Quat_MulV(self->q + j, self->v + k, &r);
+  acc = Vec3f_Add(acc, r);
+}, acc.x)
+
+MATH_BENCH(QuatSlerp, float acc = 0, {
+  Quat r;
+  Quat_Slerp(self->q + j, self->q + k, 0.3f, &r);
+  acc += r.w;
+}, acc)
+
+#undef MATH_BENCH
+
+/* --- Batch Transforms ----------------------------------------------------- */
+
+/* 'param' points stored as Vec3f, as SoA arrays and as Vertex positions,
+ * transformed in place. Times are per point; per-element loops over MulPoint
+ * and MulV are the baseline that the batch kernels replace. */
+struct BatchBench {
+  Matrix m;
+  Quat q;
+  Vec3f* v;
+  float* x;
+  float* y;
+  float* z;
+  Vertex* vertex;
+  int count;
+};
+
+static void* BatchBench_Setup (int64 param) {
+  BatchBench* self = MemNew(BatchBench);
+  self->count = (int)param;
+  self->v = MemNewArray(Vec3f, self->count);
+  self->x = MemNewArray(float, self->count);
+  self->y = MemNewArray(float, self->count);
+  self->z = MemNewArray(float, self->count);
+  self->vertex = MemNewArrayZero(Vertex, self->count);
+
+  /* A rotation only, so that repeated in-place transforms stay bounded. */
+  RNG* rng = RNG_Create(8);
+  Vec3f pos = Vec3f_Create(0, 0, 0);
+  RNG_GetQuat(rng, &self->q);
+  Matrix_SetFromPosRot(&self->m, &pos, &self->q);
+  for (int i = 0; i < self->count; ++i) {
+    RNG_GetVec3(rng, self->v + i, -10.0, 10.0);
+    self->x[i] = self->v[i].x;
+    self->y[i] = self->v[i].y;
+    self->z[i] = self->v[i].z;
+    self->vertex[i].p = self->v[i];
+  }
+  RNG_Free(rng);
+  return self;
+}
+
+static void BatchBench_Teardown (void* ctx) {
+  BatchBench* self = (BatchBench*)ctx;
+  MemFree(self->v);
+  MemFree(self->x);
+  MemFree(self->y);
+  MemFree(self->z);
+  MemFree(self->vertex);
+  MemFree(self);
+}
+
+#define BATCH_BENCH(name, body)                                                \
+  static void BatchBench_##name (void* ctx, uint64 n) {                       \
+    BatchBench* self = (BatchBench*)ctx;                                       \
+    for (uint64 i = 0; i < n; i += self->count) {                              \
+      uint64 left = n - i;                                                     \
+      int count = left < (uint64)self->count ? (int)left : self->count;        \
+      body;                                                                    \
+    }                                                                          \
+    Bench_Consume((uint64)self->v[0].x);                                       \
+  }
+
+BATCH_BENCH(MulPoint, {
+  for (int j = 0; j < count; ++j) {
+    Vec3f* p = self->v + j;
+    Matrix_MulPoint(&self->m, p, p->x, p->y, p->z);
+  }
+})
+
+BATCH_BENCH(MulPoints, {
+  Matrix_MulPoints(&self->m, self->v, self->v, count);
+})
+
+BATCH_BENCH(MulPointsSoA, {
+  Matrix_MulPointsSoA(&self->m, self->x, self->y, self->z, count);
+})
+
+BATCH_BENCH(MulPointVertex, {
+  for (int j = 0; j < count; ++j) {
+    Vec3f* p = &self->vertex[j].p;
+    Matrix_MulPoint(&self->m, p, p->x, p->y, p->z);
+  }
+})
+
+BATCH_BENCH(MulPointsStrided, {
+  Matrix_MulPointsStrided(&self->m, &self->vertex->p, &self->vertex->p,
+    count, sizeof(Vertex));
+})
+
+BATCH_BENCH(QuatMulV, {
+  for (int j = 0; j < count; ++j) {
+    Vec3f r;
+    Quat_MulV(&self->q, self->v + j, &r);
+    self->v[j] = r;
+  }
+})
+
+BATCH_BENCH(QuatRotateVectors, {
+  Quat_RotateVectors(&self->q, self->v, self->v, count);
+})
+
+#undef BATCH_BENCH
+
+/* --- Scalar Functions ----------------------------------------------------- */
+
+/* Each PhxMath function next to its FastMath approximation, over inputs in
+ * the range a typical caller would use. Results are summed rather than
+ * chained, so the times are throughput, not latency. */
+#define SCALAR_COUNT 4096
+
+struct ScalarBench {
+  float* angle;
+  float* exponent;
+  float* positive;
+  float* unit;
+  float* slope;
+};
+
+static void* ScalarBench_Setup (int64) {
+  ScalarBench* self = MemNew(ScalarBench);
+  self->angle = MemNewArray(float, SCALAR_COUNT);
+  self->exponent = MemNewArray(float, SCALAR_COUNT);
+  self->positive = MemNewArray(float, SCALAR_COUNT);
+  self->unit = MemNewArray(float, SCALAR_COUNT);
+  self->slope = MemNewArray(float, SCALAR_COUNT);
+
+  RNG* rng = RNG_Create(10);
+  for (int i = 0; i < SCALAR_COUNT; ++i) {
+    self->angle[i] = (float)RNG_GetUniformRange(rng, -8.0 * Tau, 8.0 * Tau);
+    self->exponent[i] = (float)RNG_GetUniformRange(rng, -20.0, 20.0);
+    self->positive[i] = (float)RNG_GetUniformRange(rng, 1e-3, 1e3);
+    self->unit[i] = (float)RNG_GetUniformRange(rng, 1e-3, 1.0);
+    self->slope[i] = (float)RNG_GetUniformRange(rng, -1.0, 1.0);
+  }
+  RNG_Free(rng);
+  return self;
+}
+
+static void ScalarBench_Teardown (void* ctx) {
+  ScalarBench* self = (ScalarBench*)ctx;
+  MemFree(self->angle);
+  MemFree(self->exponent);
+  MemFree(self->positive);
+  MemFree(self->unit);
+  MemFree(self->slope);
+  MemFree(self);
+}
+
+#define SCALAR_BENCH(name, expr)                                               \
+  static void ScalarBench_##name (void* ctx, uint64 n) {                      \
+    ScalarBench* self = (ScalarBench*)ctx;                                     \
+    float acc = 0;                                                             \
+    for (uint64 i = 0; i < n; ++i) {                                           \
+      uint32 j = (uint32)i & (SCALAR_COUNT - 1);                               \
+      acc += expr;                                                             \
+    }                                                                          \
+    Bench_Consume((uint64)acc);                                                \
+  }
+
+SCALAR_BENCH(Sin,       Sin(self->angle[j]))
+SCALAR_BENCH(FastSin,   FastSin(self->angle[j]))
+SCALAR_BENCH(Cos,       Cos(self->angle[j]))
+SCALAR_BENCH(FastCos,   FastCos(self->angle[j]))
+SCALAR_BENCH(Exp,       Exp(self->exponent[j]))
+SCALAR_BENCH(FastExp,   FastExp(self->exponent[j]))
+SCALAR_BENCH(Log,       Log(self->positive[j]))
+SCALAR_BENCH(FastLog,   FastLog(self->positive[j]))
+SCALAR_BENCH(Pow,       Pow(self->unit[j], 1.0f / 2.2f))
+SCALAR_BENCH(FastPow,   FastPow(self->unit[j], 1.0f / 2.2f))
+SCALAR_BENCH(Rsqrt,     1.0f / Sqrt(self->positive[j]))
+SCALAR_BENCH(FastRsqrt, FastRsqrt(self->positive[j]))
+SCALAR_BENCH(Atan2,     Atan(self->slope[j], self->slope[(j + 1) & (SCALAR_COUNT - 1)]))
+SCALAR_BENCH(FastAtan2, FastAtan(self->slope[j], self->slope[(j + 1) & (SCALAR_COUNT - 1)]))
+
+#undef SCALAR_BENCH
+
+/* --- FastMath Error Bounds ------------------------------------------------ */
+
+/* Reproduces the error table in FastMath.h against double libm, with the
+ * same -ffast-math build as the library, and fails if any function exceeds
+ * the bound documented there. One-argument functions are swept over every
+ * FASTMATH_STRIDE-th float of their domain (both signs where the domain is
+ * symmetric); the two-argument ones over FASTMATH_PAIRS random pairs. Takes
+ * several seconds. */
+#define FASTMATH_STRIDE 16
+#define FASTMATH_PAIRS 30000000
+
+/* Runs 'body' with float x for every FASTMATH_STRIDE-th bit pattern in
+ * [lo, hi]. */
+#define FASTMATH_SWEEP(lo, hi, body)                                           \
+  for (uint64 bits = (lo); bits <= (uint64)(hi); bits += FASTMATH_STRIDE) {    \
+    float x = FastMath_FromBits((uint32)bits);                                 \
+    body;                                                                      \
+  }
+
+static bool FastMathCheck_Bound (cstr name, double error, double bound) {
+  bool ok = error <= bound;
+  printf("  %-20s %10.4g  (bound %.2g)%s\n", name, error, bound, ok ? "" : "  EXCEEDED");
+  return ok;
+}
+
+/* A random finite float. This tests the bits, as -ffast-math lets the
+ * compiler assume that every float is finite. */
+inline static float FastMathCheck_Random (RNG* rng) {
+  uint32 bits;
+  do {
+    bits = RNG_Get32(rng);
+  } while (((bits >> 23) & 0xFF) == 0xFF);
+  return FastMath_FromBits(bits);
+}
+
+static bool FastMathCheck_Errors () {
+  uint32 const neg = 0x80000000U;
+  uint32 const maxNormal = 0x7F7FFFFFU;
+  uint32 const minNormal = 0x00800000U;
+  bool ok = true;
+
+  double sinAbs = 0, cosAbs = 0;
+  FASTMATH_SWEEP(0, FastMath_ToBits(8192.0f), {
+    sinAbs = Max(sinAbs, Abs(FastSin( x) - sin( (double)x)));
+    sinAbs = Max(sinAbs, Abs(FastSin(-x) - sin(-(double)x)));
+    cosAbs = Max(cosAbs, Abs(FastCos( x) - cos( (double)x)));
+    cosAbs = Max(cosAbs, Abs(FastCos(-x) - cos(-(double)x)));
+  })
+  ok &= FastMathCheck_Bound("FastSin abs", sinAbs, 1.7e-7);
+  ok &= FastMathCheck_Bound("FastCos abs", cosAbs, 1.7e-7);
+
+  double expRel = 0, exp2Rel = 0;
+  FASTMATH_SWEEP(0, FastMath_ToBits(88.0f),
+    expRel = Max(expRel, Abs(FastExp(x) / exp((double)x) - 1.0)))
+  FASTMATH_SWEEP(neg, FastMath_ToBits(-87.0f),
+    expRel = Max(expRel, Abs(FastExp(x) / exp((double)x) - 1.0)))
+  FASTMATH_SWEEP(0, FastMath_ToBits(127.0f),
+    exp2Rel = Max(exp2Rel, Abs(FastExp2(x) / exp2((double)x) - 1.0)))
+  FASTMATH_SWEEP(neg, FastMath_ToBits(-126.0f),
+    exp2Rel = Max(exp2Rel, Abs(FastExp2(x) / exp2((double)x) - 1.0)))
+  ok &= FastMathCheck_Bound("FastExp rel", expRel, 2.3e-7);
+  ok &= FastMathCheck_Bound("FastExp2 rel", exp2Rel, 2.4e-7);
+
+  /* Relative error where |log(x)| >= 1, absolute error elsewhere. */
+  double logAbs = 0, logRel = 0, log2Abs = 0, log2Rel = 0;
+  FASTMATH_SWEEP(minNormal, maxNormal, {
+    double ref = log((double)x);
+    double ref2 = log2((double)x);
+    if (Abs(ref) < 1.0) {
+      logAbs = Max(logAbs, Abs(FastLog(x) - ref));
+      log2Abs = Max(log2Abs, Abs(FastLog2(x) - ref2));
+    } else {
+      logRel = Max(logRel, Abs(FastLog(x) / ref - 1.0));
+      log2Rel = Max(log2Rel, Abs(FastLog2(x) / ref2 - 1.0));
+    }
+  })
+  ok &= FastMathCheck_Bound("FastLog abs", logAbs, 1.2e-7);
+  ok &= FastMathCheck_Bound("FastLog rel", logRel, 1.5e-7);
+  ok &= FastMathCheck_Bound("FastLog2 abs", log2Abs, 1.8e-7);
+  ok &= FastMathCheck_Bound("FastLog2 rel", log2Rel, 1.3e-7);
+
+  double rsqrtRel = 0;
+  FASTMATH_SWEEP(FastMath_ToBits(1e-37f), FastMath_ToBits(1e37f),
+    rsqrtRel = Max(rsqrtRel, Abs(FastRsqrt(x) * sqrt((double)x) - 1.0)))
+#if defined(__SSE__) || defined(_M_X64)
+  ok &= FastMathCheck_Bound("FastRsqrt rel", rsqrtRel, 2.8e-7);
+#else
+  ok &= FastMathCheck_Bound("FastRsqrt rel", rsqrtRel, 4.8e-6);
+#endif
+
+  double atanAbs = 0;
+  FASTMATH_SWEEP(0, maxNormal, {
+    atanAbs = Max(atanAbs, Abs(FastAtan( x) - atan( (double)x)));
+    atanAbs = Max(atanAbs, Abs(FastAtan(-x) - atan(-(double)x)));
+  })
+  ok &= FastMathCheck_Bound("FastAtan abs", atanAbs, 1.9e-6);
+
+  /* FastAtan (y, x) ignores the sign of a zero y, so zeros are made
+   * positive. Under -ffast-math denormals compare equal to zero, so they
+   * count as zeros here. FastPow takes x over the positive normals and p so that
+   * |p * log2(x)| <= 16. */
+  RNG* rng = RNG_Create(11);
+  double atan2Abs = 0, powRel = 0;
+  for (int i = 0; i < FASTMATH_PAIRS; ++i) {
+    float y = FastMathCheck_Random(rng);
+    float x = FastMathCheck_Random(rng);
+    if (x == 0.0f && y == 0.0f)
+      continue;
+    if (y == 0.0f)
+      y = Abs(y);
+    atan2Abs = Max(atan2Abs, Abs(FastAtan(y, x) - atan2((double)y, (double)x)));
+
+    float t = FastMath_FromBits(minNormal + RNG_Get32(rng) % (maxNormal - minNormal + 1));
+    double l = log2((double)t);
+    float p = (float)RNG_GetUniformRange(rng, -16.0, 16.0);
+    if (Abs(p * l) > 16.0)
+      p = (float)(p / Abs(l));
+    if (Abs(p * l) > 16.0)
+      continue;
+    powRel = Max(powRel, Abs(FastPow(t, p) / pow((double)t, (double)p) - 1.0));
+  }
+  RNG_Free(rng);
+  ok &= FastMathCheck_Bound("FastAtan (y, x) abs", atan2Abs, 2.0e-6);
+  ok &= FastMathCheck_Bound("FastPow rel", powRel, 3.4e-6);
+  if (FastPow(0.0f, 2.0f) != 0.0f) {
+    printf("  FastPow (0, 2) is not 0\n");
+    ok = false;
+  }
+  return ok;
+}
+
+#undef FASTMATH_SWEEP
+
+/* -------------------------------------------------------------------------- */
+
+void Bench_RegisterMath () {
+  int64 const count = 256;
+  Bench_Add("Matrix.Product",       count, 0, MathBench_Setup, MathBench_MatrixProduct,       MathBench_Teardown);
+  Bench_Add("Matrix.IOProduct",     count, 0, MathBench_Setup, MathBench_MatrixIOProduct,     MathBench_Teardown);
+  Bench_Add("Matrix.Inverse",       count, 0, MathBench_Setup, MathBench_MatrixInverse,       MathBench_Teardown);
+  Bench_Add("Matrix.IOInverse",     count, 0, MathBench_Setup, MathBench_MatrixIOInverse,     MathBench_Teardown);
+  Bench_Add("Matrix.IOTranspose",   count, 0, MathBench_Setup, MathBench_MatrixIOTranspose,   MathBench_Teardown);
+  Bench_Add("Matrix.MulPoint",      count, 0, MathBench_Setup, MathBench_MatrixMulPoint,      MathBench_Teardown);
+  Bench_Add("Matrix.MulBox",        count, 0, MathBench_Setup, MathBench_MatrixMulBox,        MathBench_Teardown);
+  Bench_Add("Matrix.FromPosRot",    count, 0, MathBench_Setup, MathBench_MatrixFromPosRot,    MathBench_Teardown);
+  Bench_Add("Matrix.SetFromPosRot", count, 0, MathBench_Setup, MathBench_MatrixSetFromPosRot, MathBench_Teardown);
+  Bench_Add("Quat.Mul",             count, 0, MathBench_Setup, MathBench_QuatMul,             MathBench_Teardown);
+  Bench_Add("Quat.MulV",            count, 0, MathBench_Setup, MathBench_QuatMulV,            MathBench_Teardown);
+  Bench_Add("Quat.Slerp",           count, 0, MathBench_Setup, MathBench_QuatSlerp,           MathBench_Teardown);
+
+  static int64 const sizes[] = { 1 << 10, 1 << 20 };
+  for (int i = 0; i < (int)(sizeof(sizes) / sizeof(sizes[0])); ++i) {
+    int64 size = sizes[i];
+    uint64 bytes = sizeof(Vec3f);
+    Bench_Add("Batch.MulPoint",          size, bytes, BatchBench_Setup, BatchBench_MulPoint,          BatchBench_Teardown);
+    Bench_Add("Batch.MulPoints",         size, bytes, BatchBench_Setup, BatchBench_MulPoints,         BatchBench_Teardown);
+    Bench_Add("Batch.MulPointsSoA",      size, bytes, BatchBench_Setup, BatchBench_MulPointsSoA,      BatchBench_Teardown);
+    Bench_Add("Batch.MulPointVertex",    size, bytes, BatchBench_Setup, BatchBench_MulPointVertex,    BatchBench_Teardown);
+    Bench_Add("Batch.MulPointsStrided",  size, bytes, BatchBench_Setup, BatchBench_MulPointsStrided,  BatchBench_Teardown);
+    Bench_Add("Batch.QuatMulV",          size, bytes, BatchBench_Setup, BatchBench_QuatMulV,          BatchBench_Teardown);
+    Bench_Add("Batch.QuatRotateVectors", size, bytes, BatchBench_Setup, BatchBench_QuatRotateVectors, BatchBench_Teardown);
+  }
+
+  static struct { cstr name; BenchRunFn run; } const scalar[] = {
+    { "Scalar.Sin",       ScalarBench_Sin       },
+    { "Scalar.FastSin",   ScalarBench_FastSin   },
+    { "Scalar.Cos",       ScalarBench_Cos       },
+    { "Scalar.FastCos",   ScalarBench_FastCos   },
+    { "Scalar.Exp",       ScalarBench_Exp       },
+    { "Scalar.FastExp",   ScalarBench_FastExp   },
+    { "Scalar.Log",       ScalarBench_Log       },
+    { "Scalar.FastLog",   ScalarBench_FastLog   },
+    { "Scalar.Pow",       ScalarBench_Pow       },
+    { "Scalar.FastPow",   ScalarBench_FastPow   },
+    { "Scalar.Rsqrt",     ScalarBench_Rsqrt     },
+    { "Scalar.FastRsqrt", ScalarBench_FastRsqrt },
+    { "Scalar.Atan2",     ScalarBench_Atan2     },
+    { "Scalar.FastAtan2", ScalarBench_FastAtan2 },
+  };
+  for (int i = 0; i < (int)(sizeof(scalar) / sizeof(scalar[0])); ++i)
+    Bench_Add(scalar[i].name, 0, 0, ScalarBench_Setup, scalar[i].run, ScalarBench_Teardown);
+
+  Bench_AddCheck("FastMath.ErrorBounds", FastMathCheck_Errors);
+}
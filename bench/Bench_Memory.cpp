@@ -0,0 +1,248 @@
+#include "Bench.h"
+#include "MemArena.h"
+#include "MemPool.h"
+#include "MemPoolMT.h"
+#include "MemStack.h"
+#include "PhxMemory.h"
+#include "RNG.h"
+
+/* --- Allocation Traces ---------------------------------------------------- */
+
+/* Replays a synthetic allocation trace through the engine allocator
+ * (Memory_Alloc, which is MemHeap when ENABLE_MEMORY_HEAP is set) and through
+ * plain malloc. Each trace entry toggles one of 'param' live slots: an empty
+ * slot is allocated, a full one freed. Sizes follow a game-like mix of
+ * mostly small objects with an occasional large buffer. */
+#define TRACE_LENGTH (1 << 16)
+
+struct TraceEntry {
+  uint32 slot;
+  uint32 size;
+};
+
+struct TraceBench {
+  TraceEntry* trace;
+  void** slots;
+  uint32 slotCount;
+  uint32 cursor;
+};
+
+static uint32 TraceBench_RandomSize (RNG* rng) {
+  uint32 r = RNG_Get32(rng) % 100;
+  if (r < 60) return 8 + RNG_Get32(rng) % 57;
+  if (r < 90) return 64 + RNG_Get32(rng) % 193;
+  if (r < 99) return 256 + RNG_Get32(rng) % 1793;
+  return 2048 + RNG_Get32(rng) % 14337;
+}
+
+static void* TraceBench_Setup (int64 param) {
+  TraceBench* self = MemNew(TraceBench);
+  self->slotCount = (uint32)param;
+  self->trace = MemNewArray(TraceEntry, TRACE_LENGTH);
+  self->slots = MemNewArrayZero(void*, self->slotCount);
+  self->cursor = 0;
+
+  RNG* rng = RNG_Create(4);
+  for (uint32 i = 0; i < TRACE_LENGTH; ++i) {
+    self->trace[i].slot = RNG_Get32(rng) % self->slotCount;
+    self->trace[i].size = TraceBench_RandomSize(rng);
+  }
+  RNG_Free(rng);
+  return self;
+}
+
+static void TraceBench_TeardownMemory (void* ctx) {
+  TraceBench* self = (TraceBench*)ctx;
+  for (uint32 i = 0; i < self->slotCount; ++i)
+    if (self->slots[i])
+      Memory_Free(self->slots[i]);
+  MemFree(self->slots);
+  MemFree(self->trace);
+  MemFree(self);
+}
+
+static void TraceBench_TeardownMalloc (void* ctx) {
+  TraceBench* self = (TraceBench*)ctx;
+  for (uint32 i = 0; i < self->slotCount; ++i)
+    if (self->slots[i])
+      free(self->slots[i]);
+  MemFree(self->slots);
+  MemFree(self->trace);
+  MemFree(self);
+}
+
+static void TraceBench_Memory (void* ctx, uint64 n) {
+  TraceBench* self = (TraceBench*)ctx;
+  uint32 j = self->cursor;
+  for (uint64 i = 0; i < n; ++i) {
+    TraceEntry const* e = self->trace + j;
+    void** slot = self->slots + e->slot;
+    if (*slot) {
+      Memory_Free(*slot);
+      *slot = 0;
+    } else {
+      *slot = Memory_Alloc(e->size);
+      *(uint8*)*slot = 1;
+    }
+    j = (j + 1) & (TRACE_LENGTH - 1);
+  }
+  self->cursor = j;
+}
+
+static void TraceBench_Malloc (void* ctx, uint64 n) {
+  TraceBench* self = (TraceBench*)ctx;
+  uint32 j = self->cursor;
+  for (uint64 i = 0; i < n; ++i) {
+    TraceEntry const* e = self->trace + j;
+    void** slot = self->slots + e->slot;
+    if (*slot) {
+      free(*slot);
+      *slot = 0;
+    } else {
+      *slot = malloc(e->size);
+      *(uint8*)*slot = 1;
+    }
+    j = (j + 1) & (TRACE_LENGTH - 1);
+  }
+  self->cursor = j;
+}
+
+/* Allocate and immediately free a single 'param'-byte block. */
+static void* FixedBench_Setup (int64 param) {
+  return (void*)(size_t)param;
+}
+
+static void FixedBench_Memory (void* ctx, uint64 n) {
+  size_t size = (size_t)ctx;
+  for (uint64 i = 0; i < n; ++i) {
+    void* p = Memory_Alloc(size);
+    *(volatile uint8*)p = 1;
+    Memory_Free(p);
+  }
+}
+
+static void FixedBench_Malloc (void* ctx, uint64 n) {
+  size_t size = (size_t)ctx;
+  for (uint64 i = 0; i < n; ++i) {
+    void* p = malloc(size);
+    *(volatile uint8*)p = 1;
+    free(p);
+  }
+}
+
+/* --- Pools, Stacks & Arenas ----------------------------------------------- */
+
+/* Allocate 'param' cells, then free them in reverse, per 'param' operations. */
+struct PoolBench {
+  MemPool* pool;
+  MemPoolMT* poolMT;
+  MemPoolMTCache* cache;
+  MemStack* stack;
+  MemArena* arena;
+  void** cells;
+  uint32 count;
+};
+
+static void* PoolBench_Setup (int64 param) {
+  PoolBench* self = MemNewZero(PoolBench);
+  self->count = (uint32)param;
+  self->cells = MemNewArray(void*, self->count);
+  self->pool = MemPool_CreateAuto(64);
+  self->poolMT = MemPoolMT_Create(64, 0, false);
+  self->cache = MemPoolMTCache_Create(self->poolMT);
+  self->stack = MemStack_Create(64 * self->count);
+  self->arena = MemArena_Create(0x10000);
+  return self;
+}
+
+static void PoolBench_Teardown (void* ctx) {
+  PoolBench* self = (PoolBench*)ctx;
+  MemPool_Free(self->pool);
+  MemPoolMTCache_Free(self->cache);
+  MemPoolMT_Free(self->poolMT);
+  MemStack_Free(self->stack);
+  MemArena_Free(self->arena);
+  MemFree(self->cells);
+  MemFree(self);
+}
+
+static void PoolBench_MemPool (void* ctx, uint64 n) {
+  PoolBench* self = (PoolBench*)ctx;
+  for (uint64 i = 0; i < n; i += self->count) {
+    for (uint32 j = 0; j < self->count; ++j)
+      self->cells[j] = MemPool_Alloc(self->pool);
+    for (uint32 j = self->count; j-- > 0; )
+      MemPool_Dealloc(self->pool, self->cells[j]);
+  }
+}
+
+static void PoolBench_MemPoolMTCache (void* ctx, uint64 n) {
+  PoolBench* self = (PoolBench*)ctx;
+  for (uint64 i = 0; i < n; i += self->count) {
+    for (uint32 j = 0; j < self->count; ++j)
+      self->cells[j] = MemPoolMTCache_Alloc(self->cache);
+    for (uint32 j = self->count; j-- > 0; )
+      MemPoolMTCache_Dealloc(self->cache, self->cells[j]);
+  }
+}
+
+static void PoolBench_MemStack (void* ctx, uint64 n) {
+  PoolBench* self = (PoolBench*)ctx;
+  for (uint64 i = 0; i < n; i += self->count) {
+    for (uint32 j = 0; j < self->count; ++j)
+      self->cells[j] = MemStack_Alloc(self->stack, 64);
+    MemStack_Clear(self->stack);
+  }
+}
+
+static void PoolBench_MemArena (void* ctx, uint64 n) {
+  PoolBench* self = (PoolBench*)ctx;
+  for (uint64 i = 0; i < n; i += self->count) {
+    uint64 marker = MemArena_GetMarker(self->arena);
+    for (uint32 j = 0; j < self->count; ++j)
+      self->cells[j] = MemArena_Alloc(self->arena, 64);
+    MemArena_Rewind(self->arena, marker);
+  }
+}
+
+static void PoolBench_Malloc (void* ctx, uint64 n) {
+  PoolBench* self = (PoolBench*)ctx;
+  for (uint64 i = 0; i < n; i += self->count) {
+    for (uint32 j = 0; j < self->count; ++j)
+      self->cells[j] = malloc(64);
+    for (uint32 j = self->count; j-- > 0; )
+      free(self->cells[j]);
+  }
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Bench_RegisterMemory () {
+  Bench_Add("Memory.Trace.Memory_Alloc", 1 << 10, 0,
+    TraceBench_Setup, TraceBench_Memory, TraceBench_TeardownMemory);
+  Bench_Add("Memory.Trace.malloc", 1 << 10, 0,
+    TraceBench_Setup, TraceBench_Malloc, TraceBench_TeardownMalloc);
+  Bench_Add("Memory.Trace.Memory_Alloc", 1 << 16, 0,
+    TraceBench_Setup, TraceBench_Memory, TraceBench_TeardownMemory);
+  Bench_Add("Memory.Trace.malloc", 1 << 16, 0,
+    TraceBench_Setup, TraceBench_Malloc, TraceBench_TeardownMalloc);
+
+  static int64 const sizes[] = { 16, 128, 1024 };
+  for (int i = 0; i < (int)(sizeof(sizes) / sizeof(sizes[0])); ++i) {
+    Bench_Add("Memory.Fixed.Memory_Alloc", sizes[i], 0,
+      FixedBench_Setup, FixedBench_Memory, 0);
+    Bench_Add("Memory.Fixed.malloc", sizes[i], 0,
+      FixedBench_Setup, FixedBench_Malloc, 0);
+  }
+
+  Bench_Add("Memory.Cells64.MemPool", 1024, 0,
+    PoolBench_Setup, PoolBench_MemPool, PoolBench_Teardown);
+  Bench_Add("Memory.Cells64.MemPoolMTCache", 1024, 0,
+    PoolBench_Setup, PoolBench_MemPoolMTCache, PoolBench_Teardown);
+  Bench_Add("Memory.Cells64.MemStack", 1024, 0,
+    PoolBench_Setup, PoolBench_MemStack, PoolBench_Teardown);
+  Bench_Add("Memory.Cells64.MemArena", 1024, 0,
+    PoolBench_Setup, PoolBench_MemArena, PoolBench_Teardown);
+  Bench_Add("Memory.Cells64.malloc", 1024, 0,
+    PoolBench_Setup, PoolBench_Malloc, PoolBench_Teardown);
+}
@@ -0,0 +1,199 @@
+#include "Bench.h"
+#include "Mesh.h"
+#include "MeshClusters.h"
+#include "PhxMath.h"
+#include "Plane.h"
+#include "Vec3.h"
+#include "Vertex.h"
+
+#include <stdio.h>
+
+/* --- Self-Check ----------------------------------------------------------- */
+
+/* Mesh_BuildClusters and MeshClusters_Cull on a cube spanning [-1, 1]^3,
+ * each face a flat grid of CUBE_RES x CUBE_RES quads, so that the expected
+ * counts can be worked out by hand:
+ *
+ *   - With 2 triangles per cluster every quad is a cluster of its own, with
+ *     its center on a multiple of 1/8 and a radius of sqrt(2) / 8. The
+ *     plane x >= 0.5 then keeps the +x face and the 3 columns of each side
+ *     face whose centers lie at x >= 0.5 - sqrt(2) / 8.
+ *   - With 128 triangles per cluster every face is a cluster of its own,
+ *     with a radius of sqrt(2); the same plane removes only the -x face.
+ *   - Seen from outside, along +x, only the +x face faces the eye. Seen
+ *     from inside, every face of the cube faces away, while every face of
+ *     the inverted cube (a room, say) faces the eye.
+ *
+ * Every build is also checked to partition the index buffer: clusters hold
+ * consecutive triangles, in order and within the limits, and reference
+ * their vertices through their own ranges of the shared tables. */
+#define CUBE_RES 8
+#define CUBE_FACE_TRIS (2 * CUBE_RES * CUBE_RES)
+#define CUBE_TRIS (6 * CUBE_FACE_TRIS)
+
+/* Faces wind counterclockwise seen from outside, or from inside if
+ * 'inward'. */
+static Mesh* ClusterCheck_CreateCube (bool inward) {
+  Mesh* mesh = Mesh_Create();
+  for (int axis = 0; axis < 3; ++axis) {
+    for (int sign = -1; sign <= 1; sign += 2) {
+      /* Grid axes u and v with u x v = +/- the face normal. */
+      int ua = (axis + 1) % 3;
+      int va = (axis + 2) % 3;
+      if ((sign < 0) != inward) {
+        int t = ua; ua = va; va = t;
+      }
+
+      float n[3] = { 0, 0, 0 };
+      n[axis] = inward ? (float)-sign : (float)sign;
+
+      int base = Mesh_GetVertexCount(mesh);
+      for (int j = 0; j <= CUBE_RES; ++j) {
+        for (int i = 0; i <= CUBE_RES; ++i) {
+          float p[3];
+          p[axis] = (float)sign;
+          p[ua] = -1.0f + 2.0f * (float)i / CUBE_RES;
+          p[va] = -1.0f + 2.0f * (float)j / CUBE_RES;
+          Mesh_AddVertex(mesh, p[0], p[1], p[2], n[0], n[1], n[2], 0, 0);
+        }
+      }
+
+      for (int j = 0; j < CUBE_RES; ++j) {
+        for (int i = 0; i < CUBE_RES; ++i) {
+          int v = base + j * (CUBE_RES + 1) + i;
+          Mesh_AddQuad(mesh, v, v + 1, v + CUBE_RES + 2, v + CUBE_RES + 1);
+        }
+      }
+    }
+  }
+  return mesh;
+}
+
+static bool ClusterCheck_Partition (Mesh* mesh, int maxVertices, int maxTriangles) {
+  MeshClusters* clusters = Mesh_BuildClusters(mesh, maxVertices, maxTriangles);
+  int const* index = Mesh_GetIndexData(mesh);
+  Vertex const* vertex = Mesh_GetVertexData(mesh);
+  int32 const* clusterVertex = MeshClusters_GetVertexData(clusters);
+  uint8 const* clusterTri = MeshClusters_GetTriangleData(clusters);
+
+  int errors = 0;
+  int vertexOffset = 0;
+  int triangleOffset = 0;
+  for (int c = 0; c < MeshClusters_GetCount(clusters); ++c) {
+    MeshCluster cluster;
+    MeshClusters_Get(clusters, c, &cluster);
+    if (cluster.vertexOffset != vertexOffset || cluster.triangleOffset != triangleOffset ||
+        cluster.vertexCount > maxVertices || cluster.triangleCount > maxTriangles ||
+        cluster.triangleCount < 1)
+    {
+      if (errors++ < 4)
+        printf("  limits %d/%d: cluster %d has vertices %d+%d, triangles %d+%d\n",
+          maxVertices, maxTriangles, c, cluster.vertexOffset, cluster.vertexCount,
+          cluster.triangleOffset, cluster.triangleCount);
+    }
+
+    for (int t = 0; t < cluster.triangleCount; ++t) {
+      for (int k = 0; k < 3; ++k) {
+        int tri = cluster.triangleOffset + t;
+        int local = clusterTri[3 * tri + k];
+        int v = clusterVertex[cluster.vertexOffset + local];
+        if (local >= cluster.vertexCount || v != index[3 * tri + k]) {
+          if (errors++ < 4)
+            printf("  limits %d/%d: triangle %d maps to vertex %d, want %d\n",
+              maxVertices, maxTriangles, tri, v, index[3 * tri + k]);
+        }
+      }
+    }
+
+    for (int i = 0; i < cluster.vertexCount; ++i) {
+      Vec3f p = vertex[clusterVertex[cluster.vertexOffset + i]].p;
+      if (Vec3f_Distance(p, cluster.center) > cluster.radius * 1.0001f + 1e-6f) {
+        if (errors++ < 4)
+          printf("  limits %d/%d: cluster %d does not bound its vertex %d\n",
+            maxVertices, maxTriangles, c, i);
+      }
+    }
+
+    vertexOffset += cluster.vertexCount;
+    triangleOffset += cluster.triangleCount;
+  }
+
+  if (vertexOffset != MeshClusters_GetVertexCount(clusters) ||
+      triangleOffset != MeshClusters_GetTriangleCount(clusters) ||
+      3 * triangleOffset != Mesh_GetIndexCount(mesh))
+  {
+    printf("  limits %d/%d: clusters hold %d triangles, mesh has %d\n",
+      maxVertices, maxTriangles, triangleOffset, Mesh_GetIndexCount(mesh) / 3);
+    errors++;
+  }
+
+  MeshClusters_Free(clusters);
+  return errors == 0;
+}
+
+static bool ClusterCheck_Cull (Mesh* mesh, int maxTriangles, cstr name,
+                               Plane const* planes, int planeCount,
+                               Vec3f const* eye, int want)
+{
+  MeshClusters* clusters = Mesh_BuildClusters(mesh, 256, maxTriangles);
+  int32 visible[6 * CUBE_RES * CUBE_RES];
+  int triangles = -1;
+  MeshClusters_Cull(clusters, planes, planeCount, eye, visible, &triangles);
+  MeshClusters_Free(clusters);
+
+  bool ok = triangles == want;
+  if (!ok)
+    printf("  %d triangles per cluster, %s: %d visible, want %d\n",
+      maxTriangles, name, triangles, want);
+  return ok;
+}
+
+static bool ClusterCheck_Cube () {
+  Mesh* cube = ClusterCheck_CreateCube(false);
+  Mesh* room = ClusterCheck_CreateCube(true);
+  bool ok = true;
+
+  static int const limits[][2] = {
+    { 256, 2 }, { 256, 128 }, { 256, 1000 }, { 16, 64 }, { 64, 24 }, { 3, 1 },
+  };
+  for (int i = 0; i < (int)(sizeof(limits) / sizeof(limits[0])); ++i) {
+    ok &= ClusterCheck_Partition(cube, limits[i][0], limits[i][1]);
+    ok &= ClusterCheck_Partition(room, limits[i][0], limits[i][1]);
+  }
+
+  Plane planes[2];
+  planes[0].n = Vec3f_Create(1, 0, 0);
+  planes[0].d = 0.5f;
+  planes[1].n = Vec3f_Create(0, 1, 0);
+  planes[1].d = 0.5f;
+  Vec3f outside = Vec3f_Create(5, 0, 0);
+  Vec3f inside = Vec3f_Create(0.1f, -0.2f, 0.3f);
+  int const quad = 2;
+  int const column = CUBE_RES * quad;
+
+  ok &= ClusterCheck_Cull(cube, 2, "no culling", 0, 0, 0, CUBE_TRIS);
+  ok &= ClusterCheck_Cull(cube, 2, "x >= 0.5", planes, 1, 0,
+    CUBE_FACE_TRIS + 4 * 3 * column);
+  ok &= ClusterCheck_Cull(cube, 2, "x, y >= 0.5", planes, 2, 0,
+    2 * 3 * column + 2 * 3 * 3 * quad);
+  ok &= ClusterCheck_Cull(cube, 2, "eye at +x", 0, 0, &outside, CUBE_FACE_TRIS);
+  ok &= ClusterCheck_Cull(cube, 2, "eye at +x, x, y >= 0.5", planes, 2, &outside,
+    3 * column);
+  ok &= ClusterCheck_Cull(cube, 2, "eye inside", 0, 0, &inside, 0);
+  ok &= ClusterCheck_Cull(room, 2, "eye inside room", 0, 0, &inside, CUBE_TRIS);
+
+  ok &= ClusterCheck_Cull(cube, 128, "x >= 0.5", planes, 1, 0, 5 * CUBE_FACE_TRIS);
+  ok &= ClusterCheck_Cull(cube, 128, "eye at +x", 0, 0, &outside, CUBE_FACE_TRIS);
+  ok &= ClusterCheck_Cull(cube, 128, "eye inside", 0, 0, &inside, 0);
+  ok &= ClusterCheck_Cull(room, 128, "eye inside room", 0, 0, &inside, CUBE_TRIS);
+
+  Mesh_Free(cube);
+  Mesh_Free(room);
+  return ok;
+}
+
+/* -------------------------------------------------------------------------- */
+
+void Bench_RegisterMesh () {
+  Bench_AddCheck("Mesh.Clusters.Cube", ClusterCheck_Cube);
+}
@@ -0,0 +1,158 @@
+#include "Bench.h"
+#include "PhxMemory.h"
+#include "Quat.h"
+#include "RNG.h"
+#include "Vec3.h"
+
+static void* RNGBench_Setup (int64) {
+  return RNG_Create(6);
+}
+
+static void RNGBench_Teardown (void* ctx) {
+  RNG_Free((RNG*)ctx);
+}
+
+static void RNGBench_Get32 (void* ctx, uint64 n) {
+  RNG* rng = (RNG*)ctx;
+  uint64 sum = 0;
+  for (uint64 i = 0; i < n; ++i)
+    sum += RNG_Get32(rng);
+  Bench_Consume(sum);
+}
+
+static void RNGBench_Get64 (void* ctx, uint64 n) {
+  RNG* rng = (RNG*)ctx;
+  uint64 sum = 0;
+  for (uint64 i = 0; i < n; ++i)
+    sum += RNG_Get64(rng);
+  Bench_Consume(sum);
+}
+
+static void RNGBench_GetUniform (void* ctx, uint64 n) {
+  RNG* rng = (RNG*)ctx;
+  double sum = 0;
+  for (uint64 i = 0; i < n; ++i)
+    sum += RNG_GetUniform(rng);
+  Bench_Consume((uint64)sum);
+}
+
+static void RNGBench_GetInt (void* ctx, uint64 n) {
+  RNG* rng = (RNG*)ctx;
+  uint64 sum = 0;
+  for (uint64 i = 0; i < n; ++i)
+    sum += RNG_GetInt(rng, 0, 1000);
+  Bench_Consume(sum);
+}
+
+static void RNGBench_GetGaussian (void* ctx, uint64 n) {
+  RNG* rng = (RNG*)ctx;
+  double sum = 0;
+  for (uint64 i = 0; i < n; ++i)
+    sum += RNG_GetGaussian(rng);
+  Bench_Consume((uint64)(sum * 1e3));
+}
+
+static void RNGBench_GetDir3 (void* ctx, uint64 n) {
+  RNG* rng = (RNG*)ctx;
+  Vec3f sum = { 0, 0, 0 };
+  for (uint64 i = 0; i < n; ++i) {
+    Vec3f v;
+    RNG_GetDir3(rng, &v);
+    sum = Vec3f_Add(sum, v);
+  }
+  Bench_Consume((uint64)(sum.x * 1e3f));
+}
+
+static void RNGBench_GetQuat (void* ctx, uint64 n) {
+  RNG* rng = (RNG*)ctx;
+  float sum = 0;
+  for (uint64 i = 0; i < n; ++i) {
+    Quat q;
+    RNG_GetQuat(rng, &q);
+    sum += q.w;
+  }
+  Bench_Consume((uint64)(sum * 1e3f));
+}
+
+/* --- Bulk ---------------------------------------------------------------- */
+
+/* Fill a 'param'-element buffer per call; times are per element, so they
+ * compare directly with the single-value benchmarks above. */
+struct FillBench {
+  RNG* rng;
+  uint32* bits;
+  float* floats;
+  Vec3f* vecs;
+  int count;
+};
+
+static void* FillBench_Setup (int64 param) {
+  FillBench* self = MemNew(FillBench);
+  self->rng = RNG_Create(6);
+  self->count = (int)param;
+  self->bits = MemNewArray(uint32, self->count);
+  self->floats = MemNewArray(float, self->count);
+  self->vecs = MemNewArray(Vec3f, self->count);
+  return self;
+}
+
+static void FillBench_Teardown (void* ctx) {
+  FillBench* self = (FillBench*)ctx;
+  RNG_Free(self->rng);
+  MemFree(self->bits);
+  MemFree(self->floats);
+  MemFree(self->vecs);
+  MemFree(self);
+}
+
+/* 'body' fills 'count' elements. */
+#define FILL_BENCH(name, body, result)                                         \
+  static void FillBench_##name (void* ctx, uint64 n) {                        \
+    FillBench* self = (FillBench*)ctx;                                         \
+    for (uint64 i = 0; i < n; i += self->count) {                              \
+      uint64 left = n - i;                                                     \
+      int count = left < (uint64)self->count ? (int)left : self->count;       \
+      body;                                                                    \
+    }                                                                          \
+    Bench_Consume(result);                                                     \
+  }
+
+FILL_BENCH(Fill32,
+  RNG_Fill32(self->rng, self->bits, count),
+  self->bits[0])
+
+FILL_BENCH(FillUniform,
+  RNG_FillUniform(self->rng, self->floats, count),
+  (uint64)(self->floats[0] * 1e3f))
+
+FILL_BENCH(FillGaussian,
+  RNG_FillGaussian(self->rng, self->floats, count),
+  (uint64)(self->floats[0] * 1e3f))
+
+FILL_BENCH(FillDir3,
+  RNG_FillDir3(self->rng, self->vecs, count),
+  (uint64)(self->vecs[0].x * 1e3f))
+
+FILL_BENCH(FillSphere,
+  RNG_FillSphere(self->rng, self->vecs, count),
+  (uint64)(self->vecs[0].x * 1e3f))
+
+#undef FILL_BENCH
+
+/* -------------------------------------------------------------------------- */
+
+void Bench_RegisterRNG () {
+  Bench_Add("RNG.Get32",       0, 4, RNGBench_Setup, RNGBench_Get32,       RNGBench_Teardown);
+  Bench_Add("RNG.Get64",       0, 8, RNGBench_Setup, RNGBench_Get64,       RNGBench_Teardown);
+  Bench_Add("RNG.GetUniform",  0, 0, RNGBench_Setup, RNGBench_GetUniform,  RNGBench_Teardown);
+  Bench_Add("RNG.GetInt",      0, 0, RNGBench_Setup, RNGBench_GetInt,      RNGBench_Teardown);
+  Bench_Add("RNG.GetGaussian", 0, 0, RNGBench_Setup, RNGBench_GetGaussian, RNGBench_Teardown);
+  Bench_Add("RNG.GetDir3",     0, 0, RNGBench_Setup, RNGBench_GetDir3,     RNGBench_Teardown);
+  Bench_Add("RNG.GetQuat",     0, 0, RNGBench_Setup, RNGBench_GetQuat,     RNGBench_Teardown);
+
+  Bench_Add("RNG.Fill32",       1024, 4, FillBench_Setup, FillBench_Fill32,       FillBench_Teardown);
+  Bench_Add("RNG.FillUniform",  1024, 0, FillBench_Setup, FillBench_FillUniform,  FillBench_Teardown);
+  Bench_Add("RNG.FillGaussian", 1024, 0, FillBench_Setup, FillBench_FillGaussian, FillBench_Teardown);
+  Bench_Add("RNG.FillDir3",     1024, 0, FillBench_Setup, FillBench_FillDir3,     FillBench_Teardown);
+  Bench_Add("RNG.FillSphere",   1024, 0, FillBench_Setup, FillBench_FillSphere,   FillBench_Teardown);
+}
@@ -3,13 +3,30 @@
 
 #include "Common.h"
 
-PHX_API BoxMesh*  BoxMesh_Create   ();
-PHX_API void      BoxMesh_Free     (BoxMesh*);
-
-PHX_API void      BoxMesh_Add      (BoxMesh*, float px, float py, float pz,
-                                              float sx, float sy, float sz,
-                                              float rx, float ry, float rz,
-                                              float bx, float by, float bz);
-PHX_API Mesh*     BoxMesh_GetMesh  (BoxMesh*, int res);
+/* --- BoxMesh -----------------------------------------------------------------
+ *
+ *   Mesh generation reserves the exact vertex and index counts up front and
+ *   writes every box into its own fixed slice of those arrays, so no per-box
+ *   allocation takes place and disjoint ranges of boxes can be emitted in
+ *   parallel.
+ *
+ *     BoxMesh_GetMesh         : Picks a worker count automatically based on
+ *                               the number of boxes and available CPUs
+ *     BoxMesh_GetMeshThreaded : Uses at most the given number of workers;
+ *                               threads <= 1 emits on the calling thread
+ *
+ *   Both produce identical meshes.
+ *
+ * -------------------------------------------------------------------------- */
+
+PHX_API BoxMesh*  BoxMesh_Create           ();
+PHX_API void      BoxMesh_Free             (BoxMesh*);
+
+PHX_API void      BoxMesh_Add              (BoxMesh*, float px, float py, float pz,
+                                                      float sx, float sy, float sz,
+                                                      float rx, float ry, float rz,
+                                                      float bx, float by, float bz);
+PHX_API Mesh*     BoxMesh_GetMesh          (BoxMesh*, int res);
+PHX_API Mesh*     BoxMesh_GetMeshThreaded  (BoxMesh*, int res, int threads);
 
 #endif
@@ -94,9 +94,13 @@
   OPAQUE_T InputBinding;
   OPAQUE_T KDTree;
   OPAQUE_T LodMesh;
+  OPAQUE_T MemArena;
   OPAQUE_T MemPool;
+  OPAQUE_T MemPoolMT;
+  OPAQUE_T MemPoolMTCache;
   OPAQUE_T MemStack;
   OPAQUE_T Mesh;
+  OPAQUE_T MeshClusters;
   OPAQUE_T MidiDevice;
   OPAQUE_T Octree;
   OPAQUE_T Physics;
@@ -127,22 +131,28 @@
   STRUCT_T Box3i;
   STRUCT_T Box3d;
   STRUCT_T Box3f;
+  STRUCT_T BoxPack;
   STRUCT_T BSPNodeRef;
   STRUCT_T Collision;
   STRUCT_T Device;
+  STRUCT_T HashXX64State;
   STRUCT_T IntersectSphereProfiling;
   STRUCT_T InputEvent;
   STRUCT_T LineSegment;
   STRUCT_T Matrix;
+  STRUCT_T MeshCluster;
   STRUCT_T Plane;
   STRUCT_T Polygon;
+  STRUCT_T ProfilerStats;
   STRUCT_T Quat;
   STRUCT_T Ray;
   STRUCT_T RayCastResult;
+  STRUCT_T RayPacket;
   STRUCT_T ShapeCastResult;
   STRUCT_T Sphere;
   STRUCT_T Time;
   STRUCT_T Triangle;
+  STRUCT_T TrianglePack;
   STRUCT_T TriangleTest;
   STRUCT_T Vec2i;
   STRUCT_T Vec2d;
@@ -167,6 +177,7 @@
   ENUM_T typedef int32  DataFormat;
   ENUM_T typedef int32  DeviceType;
   ENUM_T typedef uint32 Error;
+  ENUM_T typedef int32  MemTag;
   ENUM_T typedef int32  Metric;
   ENUM_T typedef int32  Modifier;
   ENUM_T typedef int32  PixelFormat;
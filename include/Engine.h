@@ -12,9 +12,24 @@
  *                        the library's compilation
  *    Engine_Terminate  : Calls exit(0)  (graceful termination)
  *
+ *    Engine_InitHeadless : Initializes the engine without video, GL, audio or
+ *                          input devices, for servers and benchmarks. CPU-side
+ *                          systems (physics, Lua, spatial structures, meshes,
+ *                          resources) work as usual; windows, shaders and
+ *                          input do not. Engine_Update skips input polling.
+ *
+ *    Engine_MarkInitPhase : Ends the current startup phase, attributing the
+ *                           time since the previous mark to 'name'. Engine_Init
+ *                           marks its own phases; applications may append
+ *                           theirs (creating Lua, physics, loading resources)
+ *                           so that Engine_PrintInitReport covers the whole
+ *                           startup. Engine_GetInitTime is the sum of all
+ *                           phases so far.
+ *
  * -------------------------------------------------------------------------- */
 
 PHX_API void   Engine_Init          (int glVersionMajor, int glVersionMinor);
+PHX_API void   Engine_InitHeadless  ();
 PHX_API void   Engine_Free          ();
 
 PHX_API void   Engine_Abort         ();
@@ -25,4 +40,12 @@ PHX_API bool   Engine_IsInitialized ();
 PHX_API void   Engine_Terminate     ();
 PHX_API void   Engine_Update        ();
 
+PHX_API bool   Engine_IsHeadless        ();
+PHX_API void   Engine_MarkInitPhase     (cstr name);
+PHX_API int    Engine_GetInitPhaseCount ();
+PHX_API cstr   Engine_GetInitPhaseName  (int index);
+PHX_API double Engine_GetInitPhaseTime  (int index);
+PHX_API double Engine_GetInitTime       ();
+PHX_API void   Engine_PrintInitReport   ();
+
 #endif
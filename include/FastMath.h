@@ -0,0 +1,187 @@
+#ifndef PHX_FastMath
+#define PHX_FastMath
+
+#include "Common.h"
+#include "PhxMath.h"
+
+#include <string.h>
+
+#if defined(__SSE__) || defined(_M_X64)
+  #include <xmmintrin.h>
+#endif
+
+/* --- FastMath ----------------------------------------------------------------
+ *
+ *   Polynomial approximations of the float functions in PhxMath, for hot
+ *   loops that can trade a few ulps for speed. The PhxMath versions go
+ *   through double-precision libm; these stay in float and never branch on
+ *   the input beyond a clamp or a select.
+ *
+ *   Coefficients are minimax fits. Errors were measured against double
+ *   libm, with and without -ffast-math, over every 16th float of each
+ *   domain (random samples for the two-argument functions), and include
+ *   float rounding. Results outside a domain are not bounded, and NaN and
+ *   infinity are not handled.
+ *
+ *     FastSin, FastCos    abs 1.7e-7             |x| <= 8192
+ *     FastExp             rel 2.3e-7             clamps x to [-87, 88]
+ *     FastExp2            rel 2.4e-7             clamps x to [-126, 127]
+ *     FastLog             abs 1.2e-7, rel 1.5e-7 normal x > 0
+ *     FastLog2            abs 1.8e-7, rel 1.3e-7 normal x > 0
+ *     FastPow             rel 3.4e-6             x > 0, |p * log2(x)| <= 16
+ *                                                (0 for x = 0)
+ *     FastRsqrt           rel 2.8e-7 (SSE)       1e-37 <= x <= 1e37
+ *                         rel 4.8e-6 (scalar)
+ *     FastAtan            abs 1.9e-6             all finite x
+ *     FastAtan (y, x)     abs 2.0e-6             not both 0; ignores the
+ *                                                sign of a zero y
+ *
+ *   The relative error of FastLog and FastLog2 applies when |log(x)| >= 1,
+ *   the absolute error otherwise.
+ *
+ * -------------------------------------------------------------------------- */
+
+inline float  FastAtan   (float t);
+inline float  FastAtan   (float y, float x);
+inline float  FastCos    (float t);
+inline float  FastExp    (float t);
+inline float  FastExp2   (float t);
+inline float  FastLog    (float t);
+inline float  FastLog2   (float t);
+inline float  FastPow    (float t, float p);
+inline float  FastRsqrt  (float t);
+inline float  FastSin    (float t);
+
+/* -------------------------------------------------------------------------- */
+
+inline uint32 FastMath_ToBits (float t) {
+  uint32 i;
+  memcpy(&i, &t, sizeof(i));
+  return i;
+}
+
+inline float FastMath_FromBits (uint32 i) {
+  float t;
+  memcpy(&t, &i, sizeof(t));
+  return t;
+}
+
+/* Round to nearest for |t| < 2^22: adding 1.5 * 2^23 pushes the fraction out
+ * of the mantissa, leaving the integer in the low bits. */
+inline int FastMath_Round (float t) {
+  return (int)(FastMath_ToBits(t + 12582912.0f) - 0x4B400000U);
+}
+
+/* 2^n for n in [-126, 127]. */
+inline float FastMath_Exp2i (int n) {
+  return FastMath_FromBits((uint32)(n + 127) << 23);
+}
+
+/* sin(r) for r in [-Pi/2, Pi/2]. */
+inline float FastMath_SinKernel (float r) {
+  float s = r * r;
+  return r * (9.999999992e-01f + s * (-1.666666248e-01f + s * (8.333130778e-03f +
+         s * (-1.981342387e-04f + s * 2.612538035e-06f))));
+}
+
+/* atan(z) for z in [0, 1]. */
+inline float FastMath_AtanKernel (float z) {
+  float s = z * z;
+  return z * (9.999772191e-01f + s * (-3.326228278e-01f + s * (1.935403758e-01f +
+         s * (-1.164264812e-01f + s * (5.264735063e-02f + s * -1.171913541e-02f)))));
+}
+
+/* Natural log of the mantissa, reduced to [Sqrt(1/2), Sqrt(2)) by offsetting
+ * the bits so that the exponent rolls over at Sqrt(2), and the exponent.
+ * Uses log(m) = 2 atanh((m - 1) / (m + 1)). */
+inline float FastMath_LogKernel (float t, float* e) {
+  uint32 i = FastMath_ToBits(t) - 0x3F3504F3U;
+  *e = (float)((int32)i >> 23);
+  float m = FastMath_FromBits((i & 0x007FFFFFU) + 0x3F3504F3U);
+  float s = (m - 1.0f) / (m + 1.0f);
+  float s2 = s * s;
+  return s * (2.000000237e+00f + s2 * (6.665222379e-01f + s2 * 4.129637042e-01f));
+}
+
+/* NOTE : Argument reduction is done in double, where a single multiply-
+ *        subtract is exact enough for the stated domains. A float Cody-Waite
+ *        split would be folded back into one constant under -ffast-math. */
+
+inline float FastSin (float t) {
+  int q = FastMath_Round(t * (1.0f / Pi));
+  float r = (float)((double)t - (double)q * 3.14159265358979324);
+  uint32 bits = FastMath_ToBits(FastMath_SinKernel(r)) ^ ((uint32)q << 31);
+  return FastMath_FromBits(bits);
+}
+
+/* cos(t) = (-1)^q sin(Pi/2 - |t - q Pi|) */
+inline float FastCos (float t) {
+  int q = FastMath_Round(t * (1.0f / Pi));
+  double r = (double)t - (double)q * 3.14159265358979324;
+  float s = FastMath_SinKernel((float)(1.57079632679489662 - Abs(r)));
+  return FastMath_FromBits(FastMath_ToBits(s) ^ ((uint32)q << 31));
+}
+
+inline float FastExp (float t) {
+  t = Clamp(t, -87.0f, 88.0f);
+  int n = FastMath_Round(t * 1.44269504f);
+  float r = (float)((double)t - (double)n * 0.693147180559945309);
+  float p = 1.000000072e+00f + r * (9.999996920e-01f + r * (4.999889485e-01f +
+            r * (1.666757473e-01f + r * (4.191538199e-02f + r * 8.297655092e-03f))));
+  return p * FastMath_Exp2i(n);
+}
+
+inline float FastExp2 (float t) {
+  t = Clamp(t, -126.0f, 127.0f);
+  int n = FastMath_Round(t);
+  float f = t - (float)n;
+  float p = 1.000000072e+00f + f * (6.931469671e-01f + f * (2.402211972e-01f +
+            f * (5.550713273e-02f + f * (9.675541334e-03f + f * 1.327647200e-03f))));
+  return p * FastMath_Exp2i(n);
+}
+
+inline float FastLog (float t) {
+  float e;
+  float m = FastMath_LogKernel(t, &e);
+  return e * 0.693147181f + m;
+}
+
+inline float FastLog2 (float t) {
+  float e;
+  float m = FastMath_LogKernel(t, &e);
+  return e + m * 1.44269504f;
+}
+
+inline float FastPow (float t, float p) {
+  return t > 0.0f ? FastExp2(p * FastLog2(t)) : 0.0f;
+}
+
+inline float FastRsqrt (float t) {
+#if defined(__SSE__) || defined(_M_X64)
+  float y = _mm_cvtss_f32(_mm_rsqrt_ps(_mm_set1_ps(t)));
+  return y * (1.5f - 0.5f * t * y * y);
+#else
+  float y = FastMath_FromBits(0x5F375A86U - (FastMath_ToBits(t) >> 1));
+  y = y * (1.5f - 0.5f * t * y * y);
+  return y * (1.5f - 0.5f * t * y * y);
+#endif
+}
+
+inline float FastAtan (float t) {
+  float a = Abs(t);
+  float r = a > 1.0f ? Pi2 - FastMath_AtanKernel(1.0f / a) : FastMath_AtanKernel(a);
+  return t < 0.0f ? -r : r;
+}
+
+inline float FastAtan (float y, float x) {
+  float ax = Abs(x);
+  float ay = Abs(y);
+  float hi = Max(ax, ay);
+  float lo = Min(ax, ay);
+  float r = FastMath_AtanKernel(hi > 0.0f ? lo / hi : 0.0f);
+  if (ay > ax) r = Pi2 - r;
+  if (x < 0.0f) r = Pi - r;
+  return y < 0.0f ? -r : r;
+}
+
+#endif
@@ -11,6 +11,9 @@
  *                 : Returns 0 if file is empty
  *                 : Throws Fatal if filesize exceeds 2^32 - 1
  *                   (Bytes* does not support 64-bit capacities.)
+ *   File_Hash     : XX64 (seed 0) of the file's contents, computed in chunks
+ *                   without loading the whole file. Equal to Hash_XX64 over
+ *                   File_ReadBytes. Returns 0 if opening file fails
  *   File_Size     : Returns -1 if opening file fails
  *   File_Write*   : Write binary data, not ascii
  *   File_WriteStr : Does NOT write null-terminator
@@ -22,6 +25,7 @@ PHX_API File*   File_Open       (cstr path);
 PHX_API void    File_Close      (File*);
 
 PHX_API bool    File_Exists     (cstr path);
+PHX_API uint64  File_Hash       (cstr path);
 PHX_API bool    File_IsDir      (cstr path);
 PHX_API Bytes*  File_ReadBytes  (cstr path);
 PHX_API cstr    File_ReadCstr   (cstr path);
@@ -15,8 +15,32 @@
  *                   similar to memcpy. Why walk when you can ride? We make
  *                   a special trip, just for you.
  *
+ *   Hash_XX64_*   : Streaming XX64. Feed data in pieces of any size with
+ *                   Update; Digest returns exactly what Hash_XX64 would for
+ *                   the concatenated input with the same seed. Digest does
+ *                   not modify the state, so more data may follow.
+ *
+ *                     HashXX64State state;
+ *                     Hash_XX64_Init(&state, 0);
+ *                     Hash_XX64_Update(&state, chunk, chunkLen); ...
+ *                     uint64 hash = Hash_XX64_Digest(&state);
+ *
+ *   Hash_XXH3     : XXH3 (64-bit), bit-compatible with the reference
+ *                   XXH3_64bits_withSeed. Considerably faster than XX64 on
+ *                   short keys and, using SSE2, on large buffers. Prefer it
+ *                   for content hashes (cache keys for meshes, shaders, ...).
+ *                   NOTE : Its values differ from XX64; do not mix the two
+ *                   in one table.
+ *
  * -------------------------------------------------------------------------- */
 
+struct HashXX64State {
+  uint64 v[4];
+  uint64 total;
+  uint8  buffer[32];
+  uint32 bufferSize;
+};
+
 PHX_API uint32  Hash_FNV32     (void const* buf, int len);
 PHX_API uint64  Hash_FNV64     (void const* buf, int len);
 PHX_API uint32  Hash_FNVStr32  (cstr);
@@ -29,4 +53,10 @@ PHX_API uint32  Hash_Murmur3   (void const* buf, int len);
 
 PHX_API uint64  Hash_XX64      (void const* buf, int len, uint64 seed);
 
+PHX_API void    Hash_XX64_Init    (HashXX64State*, uint64 seed);
+PHX_API void    Hash_XX64_Update  (HashXX64State*, void const* buf, int len);
+PHX_API uint64  Hash_XX64_Digest  (HashXX64State const*);
+
+PHX_API uint64  Hash_XXH3      (void const* buf, int len, uint64 seed);
+
 #endif
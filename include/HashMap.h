@@ -18,22 +18,51 @@
  *             with another that has a different (hash-colliding) key. One can
  *             expect such an error to occur roughly once per 2^32 mappings.
  *
- *   NOTE : Remove is not yet implemented. It is very difficult to implement
- *          efficiently :) Besides, this map is so fast that you probably
- *          should just create and tear a new one down every time you need it.
+ *   The map uses Robin Hood open addressing, so lookups (including misses)
+ *   stay short and predictable even near the maximum load factor. When an
+ *   insertion would exceed the load factor (default 0.875, see
+ *   HashMap_SetMaxLoad), the capacity doubles. Capacities are powers of two.
+ *
+ *   A null value marks an empty slot: HashMap_Set with a null value removes
+ *   the key. Remove returns the removed value, or null if absent.
+ *
+ *   Iteration:
+ *
+ *     uint32 it = 0; uint64 hash; void* value;
+ *     while (HashMap_Next(map, &it, &hash, &value)) { ... }
+ *
+ *   The map must not be modified during iteration.
+ *
+ *   HashMap_GetProbeStats reports the mean and longest distance of an
+ *   element from its home slot (0 = found on first probe). It scans the
+ *   whole table and is meant for diagnostics.
+ *
+ *   With ENABLE_HASHMAP_SWISS (PhxConfig.h) the map is a Swiss table instead:
+ *   lookups compare 16 slot tags per SSE2 instruction, removal leaves a
+ *   marker that is purged on the next rehash, and probe stats count 16-slot
+ *   groups rather than slots.
  *
  * ---------------------------------------------------------------------------*/
 
 typedef void (*ValueForeach)(void* value, void* userData);
 
-PHX_API HashMap*  HashMap_Create   (uint32 keySize, uint32 capacity);
-PHX_API void      HashMap_Free     (HashMap*);
+PHX_API HashMap*  HashMap_Create         (uint32 keySize, uint32 capacity);
+PHX_API void      HashMap_Free           (HashMap*);
+
+PHX_API void      HashMap_Foreach        (HashMap*, ValueForeach, void* userData);
+PHX_API void*     HashMap_Get            (HashMap*, void const* key);
+PHX_API void*     HashMap_GetRaw         (HashMap*, uint64 keyHash);
+PHX_API bool      HashMap_Next           (HashMap*, uint32* iterator, uint64* keyHash, void** value);
+PHX_API void*     HashMap_Remove         (HashMap*, void const* key);
+PHX_API void*     HashMap_RemoveRaw      (HashMap*, uint64 keyHash);
+PHX_API void      HashMap_Resize         (HashMap*, uint32 capacity);
+PHX_API void      HashMap_Set            (HashMap*, void const* key, void* value);
+PHX_API void      HashMap_SetRaw         (HashMap*, uint64 keyHash, void* value);
 
-PHX_API void      HashMap_Foreach  (HashMap*, ValueForeach, void* userData);
-PHX_API void*     HashMap_Get      (HashMap*, void const* key);
-PHX_API void*     HashMap_GetRaw   (HashMap*, uint64 keyHash);
-PHX_API void      HashMap_Resize   (HashMap*, uint32 capacity);
-PHX_API void      HashMap_Set      (HashMap*, void const* key, void* value);
-PHX_API void      HashMap_SetRaw   (HashMap*, uint64 keyHash, void* value);
+PHX_API uint32    HashMap_GetCapacity    (HashMap*);
+PHX_API float     HashMap_GetMaxLoad     (HashMap*);
+PHX_API void      HashMap_GetProbeStats  (HashMap*, float* avgProbe, uint32* maxProbe);
+PHX_API uint32    HashMap_GetSize        (HashMap*);
+PHX_API void      HashMap_SetMaxLoad     (HashMap*, float maxLoad);
 
 #endif
@@ -17,6 +17,75 @@ const float POINT_INTERSECTION_EPSILON  = (2.0f*PLANE_THICKNESS_EPSILON);
 const float RAY_INTERSECTION_EPSILON    = (8.0f*PLANE_THICKNESS_EPSILON);
 const float SPHERE_INTERSECTION_EPSILON = (2.0f*PLANE_THICKNESS_EPSILON);
 
+/* --- Wide Ray Tests ----------------------------------------------------------
+ *
+ *   Eight-wide SoA formats for testing one ray against many primitives, or
+ *   many rays against one box, in the spirit of BSP leaves and BVH nodes.
+ *   The kernels run eight lanes with AVX or two groups of four with SSE2,
+ *   selected at runtime, with a scalar path elsewhere. Pack functions fill
+ *   (count + 7) / 8 packs and pad the unused lanes so that they never hit:
+ *   kernels may be run on the padded count, as long as the rays' tMin and
+ *   tMax are finite.
+ *
+ *   Intersect_RayTriangles : Intersect_RayTriangle_Moller1 against 'count'
+ *                            packed triangles. Returns the index of the
+ *                            nearest hit (the first on ties), or -1, and
+ *                            its t in tHit. As in Moller1, t is not clipped
+ *                            to the ray's [tMin, tMax].
+ *
+ *   Intersect_RayBoxes     : Slab test of one ray against 'count' packed
+ *                            boxes within [tMin, tMax]. Writes each box's
+ *                            entry t to tEnter, or FLT_MAX on a miss, and
+ *                            returns the number of boxes hit.
+ *
+ *   Intersect_RayPacketBox : Slab test of up to eight rays against one box.
+ *                            Returns a mask with bit i set if ray i hits.
+ *
+ *   Intersect_SetWideKernel : Forces the kernel used by the tests above, so
+ *                            that they can be checked against each other
+ *                            (see phx_bench --check). Returns false, keeping
+ *                            the current kernel, if this build or CPU lacks
+ *                            the one requested.
+ *
+ * -------------------------------------------------------------------------- */
+
+const int Intersect_WideAuto   = 0;
+const int Intersect_WideScalar = 1;
+const int Intersect_WideSSE    = 2;
+const int Intersect_WideAVX    = 3;
+
+struct TrianglePack {
+  float v0x[8];
+  float v0y[8];
+  float v0z[8];
+  float e1x[8];
+  float e1y[8];
+  float e1z[8];
+  float e2x[8];
+  float e2y[8];
+  float e2z[8];
+};
+
+struct BoxPack {
+  float lowerx[8];
+  float lowery[8];
+  float lowerz[8];
+  float upperx[8];
+  float uppery[8];
+  float upperz[8];
+};
+
+struct RayPacket {
+  float px[8];
+  float py[8];
+  float pz[8];
+  float rdx[8];
+  float rdy[8];
+  float rdz[8];
+  float tMin[8];
+  float tMax[8];
+};
+
 PHX_API bool  Intersect_PointBox                   (Matrix* t1, Matrix* t2);
 PHX_API bool  Intersect_PointTriangle_Barycentric  (Vec3f const*, Triangle const*);
 PHX_API bool  Intersect_RayPlane                   (Ray const*, Plane const*, Vec3f* pHit);
@@ -28,4 +97,12 @@ PHX_API bool  Intersect_RectRect                   (Vec4f const*, Vec4f const*);
 PHX_API bool  Intersect_RectRectFast               (Vec4f const*, Vec4f const*);
 PHX_API bool  Intersect_SphereTriangle             (Sphere const*, Triangle const*, Vec3f* pHit);
 
+PHX_API void  Intersect_PackBoxes                  (Box3f const*, int count, BoxPack*);
+PHX_API void  Intersect_PackRays                   (Ray const*, int count, RayPacket*);
+PHX_API void  Intersect_PackTriangles              (Triangle const*, int count, TrianglePack*);
+PHX_API int   Intersect_RayBoxes                   (Ray const*, BoxPack const*, int count, float* tEnter);
+PHX_API int   Intersect_RayPacketBox               (RayPacket const*, Box3f const*);
+PHX_API int   Intersect_RayTriangles               (Ray const*, TrianglePack const*, int count, float* tHit);
+PHX_API bool  Intersect_SetWideKernel              (int kernel);
+
 #endif
@@ -5,21 +5,71 @@
 
 /* --- LodMesh -----------------------------------------------------------------
  *
- *   A basic container for abstracting LOD rendering behavior. LodMesh consists
- *   of any number of (Mesh, distMin, distMax) tuples. Drawing a requires
- *   passing a *distance squared* argument that is used to determine which
- *   component(s) of the LodMesh to draw.
+ *   A basic container for abstracting LOD rendering behavior. All components
+ *   of a LodMesh are packed into a single vertex buffer and a single index
+ *   buffer (rebuilt lazily when any component mesh changes), so switching
+ *   between components never rebinds GL buffers.
+ *
+ *   Components can be selected in one of two ways:
+ *
+ *   Distance ranges : LodMesh_Add registers a (Mesh, distMin, distMax) tuple.
+ *                     LodMesh_Draw / LodMesh_Get take a *distance squared*
+ *                     argument and draw / return the component(s) whose range
+ *                     contains it.
+ *
+ *   Screen-space    : LodMesh_AddLevel registers a Mesh together with its
+ *   error             geometric error (in world units) relative to the full-
+ *                     detail surface. Levels are ordered from finest (0) to
+ *                     coarsest. LodMesh_SelectLevel picks the coarsest level
+ *                     whose error, projected to the screen, does not exceed
+ *                     maxError pixels:
+ *
+ *                       projected = error * pixelScale / distance
+ *                       pixelScale = viewportHeight / (2 * tan(fovY / 2))
+ *
+ *                     'current' is the level previously chosen for this
+ *                     instance (or -1). To avoid popping back and forth at a
+ *                     boundary, a coarser level is only adopted once its
+ *                     projected error falls below maxError * (1 - hysteresis).
+ *                     Returns -1 when no levels have been added.
+ *
+ *     LodMesh_SelectLevels : Batch version of SelectLevel for many instances
+ *                            sharing this LodMesh. 'levels' holds the current
+ *                            level of each instance on input and receives the
+ *                            selected level on output.
+ *
+ *   For drawing many instances, bind once and draw levels with the bound
+ *   variants, exactly as with Mesh_DrawBind / Mesh_DrawBound / Mesh_DrawUnbind.
+ *
+ *   Components added to a LodMesh are owned (freed) by it.
  *
  *   This type is REFERENCE-COUNTED. See ../doc/RefCounted.txt for details.
  *
  * -------------------------------------------------------------------------- */
 
-PHX_API LodMesh*  LodMesh_Create   ();
-PHX_API void      LodMesh_Acquire  (LodMesh*);
-PHX_API void      LodMesh_Free     (LodMesh*);
+PHX_API LodMesh*  LodMesh_Create          ();
+PHX_API void      LodMesh_Acquire         (LodMesh*);
+PHX_API void      LodMesh_Free            (LodMesh*);
+
+PHX_API void      LodMesh_Add             (LodMesh*, Mesh*, float distMin, float distMax);
+PHX_API void      LodMesh_Draw            (LodMesh*, float distanceSquared);
+PHX_API Mesh*     LodMesh_Get             (LodMesh*, float distanceSquared);
+
+PHX_API void      LodMesh_AddLevel        (LodMesh*, Mesh*, float error);
+PHX_API float     LodMesh_GetHysteresis   (LodMesh*);
+PHX_API Mesh*     LodMesh_GetLevel        (LodMesh*, int level);
+PHX_API int       LodMesh_GetLevelCount   (LodMesh*);
+PHX_API float     LodMesh_GetLevelError   (LodMesh*, int level);
+PHX_API void      LodMesh_SetHysteresis   (LodMesh*, float hysteresis);
+PHX_API int       LodMesh_SelectLevel     (LodMesh*, float distance, float pixelScale,
+                                           float maxError, int current);
+PHX_API void      LodMesh_SelectLevels    (LodMesh*, Vec3f const* eye, Vec3f const* positions,
+                                           int count, float pixelScale, float maxError,
+                                           int32* levels);
 
-PHX_API void      LodMesh_Add      (LodMesh*, Mesh*, float distMin, float distMax);
-PHX_API void      LodMesh_Draw     (LodMesh*, float distanceSquared);
-PHX_API Mesh*     LodMesh_Get      (LodMesh*, float distanceSquared);
+PHX_API void      LodMesh_DrawBind        (LodMesh*);
+PHX_API void      LodMesh_DrawBoundLevel  (LodMesh*, int level);
+PHX_API void      LodMesh_DrawUnbind      (LodMesh*);
+PHX_API void      LodMesh_DrawLevel       (LodMesh*, int level);
 
 #endif
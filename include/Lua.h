@@ -44,10 +44,60 @@ PHX_API void    Lua_GCStep             (Lua*);
 PHX_API void    Lua_Backtrace          ();
 PHX_API int     Lua_GetMemory          (Lua*);
 
+/* --- LuaProfiler -------------------------------------------------------------
+ *
+ *   A sampling profiler built on LuaJIT's profiler. While running, every
+ *   'intervalMs' milliseconds of Lua execution the current Lua function (or,
+ *   with 'lines', the current source line) is credited with that much time
+ *   via Profiler_AddSample under the scope name "[Lua] <function>". Time in
+ *   the garbage collector and JIT compiler is credited to "[Lua GC]" and
+ *   "[Lua JIT]". Samples thus appear alongside native scopes in the
+ *   Profiler's statistics and trace; they are only recorded while the
+ *   Profiler is enabled.
+ *
+ *   Each sample's stack is also counted in folded form: the open native
+ *   Profiler scopes followed by up to 'depth' Lua frames, outermost first,
+ *   separated by ';'. LuaProfiler_WriteFolded writes one "stack count" line
+ *   per distinct stack, as consumed by flamegraph.pl and compatible tools.
+ *   Counts accumulate across runs until LuaProfiler_Reset.
+ *
+ *   Overhead scales with the sampling rate and the stack depth; a depth of 0
+ *   skips stack collection entirely and records only per-function times.
+ *   Only one Lua state may be profiled at a time.
+ *
+ *   Scripts may use the globals ProfileStart(intervalMs = 1, depth = 64,
+ *   lines = false), ProfileStop() and ProfileWriteFolded(path).
+ *
+ * -------------------------------------------------------------------------- */
+
+PHX_API void    LuaProfiler_Start        (Lua*, int intervalMs, int depth, bool lines);
+PHX_API void    LuaProfiler_Stop         ();
+PHX_API void    LuaProfiler_Reset        ();
+PHX_API bool    LuaProfiler_WriteFolded  (cstr path);
+
+/* --- LuaScheduler -----------------------------------------------------------
+ *
+ *   Scripts may use the globals Schedule(fn, arg, delay), which calls
+ *   fn(dt, arg) during the first SchedulerUpdate at least 'delay' seconds
+ *   later and returns a handle; SchedulerCancel(handle), which returns
+ *   whether the call was still pending; SchedulerClear(); and
+ *   SchedulerUpdate(maxCalls = 0), which runs due calls in order of wake
+ *   time, at most 'maxCalls' of them if positive, and returns how many ran.
+ *   Calls scheduled during an update are not run until the next one.
+ *
+ *   The scheduler is global and belongs to the first Lua state created,
+ *   which alone receives these globals (threads of it share them). It is
+ *   reset when that state is freed.
+ *
+ * -------------------------------------------------------------------------- */
+
 /* --- Private API ---------------------------------------------------------- */
 
 PRIVATE void    LuaScheduler_Init      (Lua*);
+PRIVATE void    LuaScheduler_Free      (Lua*);
 PRIVATE void    LuaScheduler_Register  (Lua*);
+PRIVATE void    LuaProfiler_Free       (Lua*);
+PRIVATE void    LuaProfiler_Register   (Lua*);
 
 
 #endif
@@ -30,6 +30,18 @@
  *   Note that our storage order is transposed from OpenGL. In OpenGL bases are
  *   contiguous and translation is stored in 12, 13, 14.
  *
+ *   The functions returning Matrix* allocate and must be paired with
+ *   Matrix_Free. For per-frame math, use the IO and Set variants instead:
+ *   they write into caller-owned storage (typically a Matrix on the stack),
+ *   and 'out' may alias any input, so Matrix_IOProduct(&a, &b, &a) is fine.
+ *   Product, Inverse and Transpose use SSE2 where available.
+ *
+ *   The batch variants of MulDir / MulPoint transform 'count' vectors at once
+ *   with SSE2 or, when the CPU supports it, AVX kernels. SoA variants work in
+ *   place on separate x / y / z arrays. Strided variants read and write a
+ *   Vec3f every 'stride' bytes, e.g. the position of each Vertex. 'out' may
+ *   equal 'in' but must not otherwise overlap it.
+ *
  * -------------------------------------------------------------------------- */
 
 PHX_API Matrix*  Matrix_Clone               (Matrix const*);
@@ -43,6 +55,12 @@ PHX_API Matrix*  Matrix_Product             (Matrix const*, Matrix const*);
 PHX_API Matrix*  Matrix_Sum                 (Matrix const*, Matrix const*);
 PHX_API Matrix*  Matrix_Transpose           (Matrix const*);
 
+PHX_API void     Matrix_IOInverse           (Matrix const* in, Matrix* out);
+PHX_API void     Matrix_IOInverseTranspose  (Matrix const* in, Matrix* out);
+PHX_API void     Matrix_IOProduct           (Matrix const* a, Matrix const* b, Matrix* out);
+PHX_API void     Matrix_IOSum               (Matrix const* a, Matrix const* b, Matrix* out);
+PHX_API void     Matrix_IOTranspose         (Matrix const* in, Matrix* out);
+
 PHX_API void     Matrix_IInverse            (Matrix*);
 PHX_API void     Matrix_IScale              (Matrix*, float);
 PHX_API void     Matrix_ITranspose          (Matrix*);
@@ -61,11 +79,33 @@ PHX_API Matrix*  Matrix_SRT                 (float sx, float sy, float sz,
 PHX_API Matrix*  Matrix_Translation         (float tx, float ty, float tz);
 PHX_API Matrix*  Matrix_YawPitchRoll        (float yaw, float pitch, float roll);
 
+PHX_API void     Matrix_SetIdentity         (Matrix* out);
+PHX_API void     Matrix_SetLookAt           (Matrix* out, Vec3f const* pos, Vec3f const* at, Vec3f const* up);
+PHX_API void     Matrix_SetLookUp           (Matrix* out, Vec3f const* pos, Vec3f const* look, Vec3f const* up);
+PHX_API void     Matrix_SetPerspective      (Matrix* out, float degreesFovY, float aspect, float zNear, float zFar);
+PHX_API void     Matrix_SetRotationX        (Matrix* out, float rads);
+PHX_API void     Matrix_SetRotationY        (Matrix* out, float rads);
+PHX_API void     Matrix_SetRotationZ        (Matrix* out, float rads);
+PHX_API void     Matrix_SetScaling          (Matrix* out, float sx, float sy, float sz);
+PHX_API void     Matrix_SetSRT              (Matrix* out,
+                                             float sx, float sy, float sz,
+                                             float ry, float rp, float rr,
+                                             float tx, float ty, float tz);
+PHX_API void     Matrix_SetTranslation      (Matrix* out, float tx, float ty, float tz);
+PHX_API void     Matrix_SetYawPitchRoll     (Matrix* out, float yaw, float pitch, float roll);
+
 PHX_API void     Matrix_MulBox              (Matrix const*, Box3f* out, Box3f const* in);
 PHX_API void     Matrix_MulDir              (Matrix const*, Vec3f* out, float x, float y, float z);
 PHX_API void     Matrix_MulPoint            (Matrix const*, Vec3f* out, float x, float y, float z);
 PHX_API void     Matrix_MulVec              (Matrix const*, Vec4f* out, float x, float y, float z, float w);
 
+PHX_API void     Matrix_MulDirs             (Matrix const*, Vec3f* out, Vec3f const* in, int count);
+PHX_API void     Matrix_MulDirsSoA          (Matrix const*, float* x, float* y, float* z, int count);
+PHX_API void     Matrix_MulDirsStrided      (Matrix const*, void* out, void const* in, int count, int stride);
+PHX_API void     Matrix_MulPoints           (Matrix const*, Vec3f* out, Vec3f const* in, int count);
+PHX_API void     Matrix_MulPointsSoA        (Matrix const*, float* x, float* y, float* z, int count);
+PHX_API void     Matrix_MulPointsStrided    (Matrix const*, void* out, void const* in, int count, int stride);
+
 PHX_API void     Matrix_GetForward          (Matrix const*, Vec3f* out);
 PHX_API void     Matrix_GetRight            (Matrix const*, Vec3f* out);
 PHX_API void     Matrix_GetUp               (Matrix const*, Vec3f* out);
@@ -77,6 +117,13 @@ PHX_API Matrix*  Matrix_FromPosRot          (Vec3f const*, Quat const*);
 PHX_API Matrix*  Matrix_FromPosRotScale     (Vec3f const*, Quat const*, float);
 PHX_API Matrix*  Matrix_FromPosBasis        (Vec3f const* pos, Vec3f const* x, Vec3f const* y, Vec3f const* z);
 PHX_API Matrix*  Matrix_FromQuat            (Quat const*);
+
+PHX_API void     Matrix_SetFromBasis        (Matrix* out, Vec3f const* x, Vec3f const* y, Vec3f const* z);
+PHX_API void     Matrix_SetFromPosRot       (Matrix* out, Vec3f const*, Quat const*);
+PHX_API void     Matrix_SetFromPosRotScale  (Matrix* out, Vec3f const*, Quat const*, float);
+PHX_API void     Matrix_SetFromPosBasis     (Matrix* out, Vec3f const* pos, Vec3f const* x, Vec3f const* y, Vec3f const* z);
+PHX_API void     Matrix_SetFromQuat         (Matrix* out, Quat const*);
+
 PHX_API void     Matrix_ToQuat              (Matrix const*, Quat* out);
 
 PHX_API void     Matrix_Print               (Matrix const*);
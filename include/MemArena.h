@@ -0,0 +1,64 @@
+#ifndef PHX_MemArena
+#define PHX_MemArena
+
+#include "Common.h"
+
+/* --- MemArena ----------------------------------------------------------------
+ *
+ *   A growable bump allocator. Memory is carved out of a list of chunks; when
+ *   the current chunk is exhausted the arena moves on to the next one,
+ *   allocating it if necessary. Requests larger than the chunk size get a
+ *   chunk of their own. All allocations are 16-byte aligned.
+ *
+ *   Individual allocations are never freed. Instead, MemArena_GetMarker
+ *   records the current position and MemArena_Rewind releases everything
+ *   allocated since, which makes scoped temporaries nearly free:
+ *
+ *     uint64 marker = MemArena_GetMarker(arena);
+ *     float* tmp = MemArena_NewArray(arena, float, n);
+ *     ...
+ *     MemArena_Rewind(arena, marker);
+ *
+ *   Markers must be rewound in LIFO order, and a marker is invalidated by
+ *   rewinding (or clearing) to an earlier point. Each marker should be
+ *   rewound exactly once; the arena counts outstanding markers. MemArena_Clear rewinds to
+ *   the very beginning. Neither releases chunks to the system; they are kept
+ *   for reuse. MemArena_Trim frees the chunks beyond the current position.
+ *
+ *   MemArena_GetScratch returns the calling thread's scratch arena, created
+ *   on first use. Scratch arenas are cleared automatically at the start of
+ *   each frame (in Engine_Update), hence memory obtained from them is valid
+ *   until the end of the current frame at most. The clear happens lazily,
+ *   in the thread's first MemArena_GetScratch of the new frame, and is put
+ *   off while a marker on the arena is outstanding, so that a worker job
+ *   spanning the frame boundary may still rewind to its marker. Code that needs temporaries
+ *   only for the duration of a call should take a marker and rewind before
+ *   returning, so that the scratch arena does not grow over the frame.
+ *
+ *   A MemArena is not thread-safe; scratch arenas are safe by virtue of
+ *   being per-thread.
+ *
+ * -------------------------------------------------------------------------- */
+
+PHX_API MemArena*  MemArena_Create       (uint32 chunkSize);
+PHX_API void       MemArena_Free         (MemArena*);
+
+PHX_API void*      MemArena_Alloc        (MemArena*, uint32 size);
+PHX_API void       MemArena_Clear        (MemArena*);
+PHX_API uint64     MemArena_GetMarker    (MemArena*);
+PHX_API void       MemArena_Rewind       (MemArena*, uint64 marker);
+PHX_API void       MemArena_Trim         (MemArena*);
+
+PHX_API uint64     MemArena_GetCapacity  (MemArena*);
+PHX_API uint64     MemArena_GetSize      (MemArena*);
+
+PHX_API MemArena*  MemArena_GetScratch   ();
+
+#define MemArena_New(arena, x)          ((x*)MemArena_Alloc(arena, sizeof(x)))
+#define MemArena_NewArray(arena, x, s)  ((x*)MemArena_Alloc(arena, (uint32)(sizeof(x) * (s))))
+
+/* --- Private API ---------------------------------------------------------- */
+
+PRIVATE void       MemArena_NextFrame    ();
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef PHX_MemPoolMT
+#define PHX_MemPoolMT
+
+#include "Common.h"
+
+/* --- MemPoolMT ---------------------------------------------------------------
+ *
+ *   A thread-safe variant of MemPool. Cells live in blocks owned by a shared
+ *   pool; each worker thread allocates through its own MemPoolMTCache, which
+ *   keeps a private free list and exchanges cells with the shared pool in
+ *   batches. Hence the shared pool's lock is taken once per batch rather than
+ *   once per allocation.
+ *
+ *     cellSize   : Rounded up to a multiple of the alignment (and to at least
+ *                  pointer size)
+ *     alignment  : Power of two; every cell is aligned to it. 0 selects
+ *                  pointer alignment.
+ *     zeroMemory : If true, cells are zeroed on allocation, as MemPool does
+ *
+ *   MemPoolMT_Alloc / MemPoolMT_Dealloc bypass caches and lock the shared
+ *   pool on every call. They are intended for occasional use from threads
+ *   that do not own a cache.
+ *
+ *   A cache must only be used by one thread at a time. A cell may be freed
+ *   through any cache of the pool that allocated it, not just the one it came
+ *   from. Freeing a cache (or flushing it) returns all of its cells to the
+ *   shared pool. All caches must be freed before the pool.
+ *
+ *   MemPoolMT_Trim releases blocks that are entirely free in the shared pool
+ *   back to the system and returns the number of blocks released. Cells held
+ *   in caches keep their blocks alive, so caches should be flushed first.
+ *
+ *   MemPoolMT_GetSize is exact only when no other thread is using the pool.
+ *
+ * -------------------------------------------------------------------------- */
+
+PHX_API MemPoolMT*       MemPoolMT_Create         (uint32 cellSize, uint32 alignment, bool zeroMemory);
+PHX_API void             MemPoolMT_Free           (MemPoolMT*);
+
+PHX_API void*            MemPoolMT_Alloc          (MemPoolMT*);
+PHX_API void             MemPoolMT_Dealloc        (MemPoolMT*, void*);
+PHX_API uint32           MemPoolMT_Trim           (MemPoolMT*);
+
+PHX_API uint32           MemPoolMT_GetBlockCount  (MemPoolMT*);
+PHX_API uint32           MemPoolMT_GetCapacity    (MemPoolMT*);
+PHX_API uint32           MemPoolMT_GetCellSize    (MemPoolMT*);
+PHX_API uint32           MemPoolMT_GetSize        (MemPoolMT*);
+
+PHX_API MemPoolMTCache*  MemPoolMTCache_Create    (MemPoolMT*);
+PHX_API void             MemPoolMTCache_Free      (MemPoolMTCache*);
+
+PHX_API void*            MemPoolMTCache_Alloc     (MemPoolMTCache*);
+PHX_API void             MemPoolMTCache_Dealloc   (MemPoolMTCache*, void*);
+PHX_API void             MemPoolMTCache_Flush     (MemPoolMTCache*);
+
+#endif
@@ -16,9 +16,8 @@
  *    choice for intra-frame allocations, or any allocations with a bounded
  *    lifetime.
  *
- *    For a dynamically-sized version, use MemStackDynamic, which leverages
- *    multiple MemStacks to provide the same interface without requiring a
- *    pre-determined capacity.
+ *    For a dynamically-sized version, use MemArena, which grows in chunks
+ *    and replaces paired deallocation with markers.
  *
  * -------------------------------------------------------------------------- */
 
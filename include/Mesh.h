@@ -12,11 +12,14 @@
  *   internal buffers. Explicit binding should be used when the same mesh must
  *   be drawn many times. It is unnecessary when a mesh will be drawn only once.
  *
- *     Mesh_DrawBind   : Binds internal buffers
- *     Mesh_DrawBound  : Assumes buffers have already been bound with DrawBind
- *     Mesh_DrawUnbind : Unbinds internal buffers; must be paired with DrawBind
- *                       call after draw operations are finished
- *     Mesh_Draw       : Equivalent to DrawBind -> DrawBound -> DrawUnbind
+ *     Mesh_DrawBind       : Binds internal buffers
+ *     Mesh_DrawBound      : Assumes buffers have already been bound with
+ *                           DrawBind
+ *     Mesh_DrawBoundRange : As DrawBound, but draws only indexCount indices
+ *                           starting at indexOffset
+ *     Mesh_DrawUnbind     : Unbinds internal buffers; must be paired with
+ *                           DrawBind call after draw operations are finished
+ *     Mesh_Draw           : Equivalent to DrawBind -> DrawBound -> DrawUnbind
  *
  *   The following informational functions are computed lazily and cached
  *   according to the mesh version. Keeping an external cache is therefore
@@ -33,6 +36,10 @@
  *                             sphere radius; although usually a very good
  *                             approximation.
  *
+ *   Mesh_ResizeIndexData / Mesh_ResizeVertexData set the element count
+ *   directly, leaving any newly-exposed elements uninitialized. They allow
+ *   generators to fill the arrays in place (see BoxMesh).
+ *
  * -------------------------------------------------------------------------- */
 
 PHX_API Mesh*    Mesh_Create             ();
@@ -68,11 +75,14 @@ PHX_API int      Mesh_GetVertexCount     (Mesh*);
 PHX_API Vertex*  Mesh_GetVertexData      (Mesh*);
 PHX_API void     Mesh_ReserveIndexData   (Mesh*, int capacity);
 PHX_API void     Mesh_ReserveVertexData  (Mesh*, int capacity);
+PHX_API void     Mesh_ResizeIndexData    (Mesh*, int size);
+PHX_API void     Mesh_ResizeVertexData   (Mesh*, int size);
 PHX_API Error    Mesh_Validate           (Mesh*);
 
 PHX_API void     Mesh_Draw               (Mesh*);
 PHX_API void     Mesh_DrawBind           (Mesh*);
 PHX_API void     Mesh_DrawBound          (Mesh*);
+PHX_API void     Mesh_DrawBoundRange     (Mesh*, int indexOffset, int indexCount);
 PHX_API void     Mesh_DrawUnbind         (Mesh*);
 PHX_API void     Mesh_DrawNormals        (Mesh*, float scale);
 
@@ -87,6 +97,8 @@ PHX_API Mesh*    Mesh_ScaleUniform       (Mesh*, float);
 PHX_API Mesh*    Mesh_Transform          (Mesh*, Matrix*);
 PHX_API Mesh*    Mesh_Translate          (Mesh*, float x, float y, float z);
 
+PHX_API MeshClusters*  Mesh_BuildClusters  (Mesh*, int maxVertices, int maxTriangles);
+
 PHX_API void     Mesh_ComputeAO          (Mesh*, float radius);
 PHX_API void     Mesh_ComputeOcclusion   (Mesh*, Tex3D* sdf, float radius);
 PHX_API void     Mesh_ComputeNormals     (Mesh*);
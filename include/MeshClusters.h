@@ -0,0 +1,62 @@
+#ifndef PHX_MeshClusters
+#define PHX_MeshClusters
+
+#include "Common.h"
+#include "Vec3.h"
+
+/* --- MeshClusters ------------------------------------------------------------
+ *
+ *   A partition of a mesh's triangles into small, fixed-capacity clusters
+ *   ('meshlets'), built by Mesh_BuildClusters. Clusters are formed greedily
+ *   in index-buffer order, so meshes that have been optimized for vertex
+ *   cache locality produce tight clusters.
+ *
+ *   Each cluster references a contiguous range of the shared vertex table
+ *   (indices into the source mesh's vertex array) and a contiguous range of
+ *   the shared triangle table (three uint8 indices per triangle, local to the
+ *   cluster's vertex range). Hence a cluster may reference at most 256
+ *   vertices.
+ *
+ *   Every cluster carries culling data:
+ *
+ *     center, radius : Bounding sphere of the cluster's vertices
+ *     coneApex,      : Backface cone. The entire cluster faces away from any
+ *     coneAxis,        viewer for which
+ *     coneCutoff         Dot(Normalize(coneApex - eye), coneAxis) >= coneCutoff
+ *                      A cutoff of 1 marks a cluster whose normals are too
+ *                      divergent to ever be cone-culled.
+ *
+ *   MeshClusters_Cull tests every cluster against a set of planes (normals
+ *   pointing INTO the visible volume, as with Plane_ClassifyPoint) and,
+ *   optionally, the backface cone for the given eye position. The indices of
+ *   surviving clusters are written to 'visible', which must have room for
+ *   MeshClusters_GetCount entries. The return value is the number of visible
+ *   clusters; if 'triangles' is non-null it receives the number of triangles
+ *   they contain.
+ *
+ * -------------------------------------------------------------------------- */
+
+struct MeshCluster {
+  Vec3f center;
+  float radius;
+  Vec3f coneApex;
+  Vec3f coneAxis;
+  float coneCutoff;
+  int32 vertexOffset;
+  int32 vertexCount;
+  int32 triangleOffset;
+  int32 triangleCount;
+};
+
+PHX_API void     MeshClusters_Free              (MeshClusters*);
+
+PHX_API int      MeshClusters_Cull              (MeshClusters*, Plane const* planes, int planeCount,
+                                                 Vec3f const* eye, int32* visible, int* triangles);
+PHX_API void     MeshClusters_Get               (MeshClusters*, int index, MeshCluster* out);
+PHX_API int      MeshClusters_GetCount          (MeshClusters*);
+PHX_API int      MeshClusters_GetTriangleCount  (MeshClusters*);
+PHX_API uint8*   MeshClusters_GetTriangleData   (MeshClusters*);
+PHX_API int      MeshClusters_GetVertexCount    (MeshClusters*);
+PHX_API int32*   MeshClusters_GetVertexData     (MeshClusters*);
+
+#endif
@@ -7,16 +7,20 @@
  *
  *   The Metric API is a simple set of accumulators that engine functions may
  *   call to provide information relevent to performance profiling and
- *   debugging. Metrics are reset each frame in Engine_Update, hence provide
- *   only instantaneous information.
+ *   debugging. Metrics are reset each frame in Engine_Update; Metric_Get
+ *   returns the value accumulated so far in the current frame.
  *
  *   Metrics are quantities that only code internal to the engine can change
  *   (e.g., a Lua script cannot draw a polygon without passing through
  *   Draw_*, Mesh_Draw*, etc). Hence, all functions that modify metrics are
  *   private.
  *
- *   Metric_Reset is called automatically in Engine_Update, so that metrics
- *   are per-frame.
+ *   Metric_NextFrame is called automatically in Engine_Update, so that
+ *   metrics are per-frame. It records each metric's final value for the
+ *   frame into a history of the last 128 frames, from which Metric_GetLast,
+ *   Metric_GetMin, Metric_GetAvg and Metric_GetMax are computed.
+ *   Metric_GetHistory copies up to 'count' values, oldest first, and returns
+ *   the number copied.
  *
  *     DrawCalls  : # gl_Draw* calls. glBegin/glEnd does not count.
  *     Immediate  : # glBegin/glEnd pairs.
@@ -39,6 +43,27 @@
  *                  of validation-inducing bind calls, but this will only be
  *                  relevant once fbo caching is implemented.
  *
+ *     BSPNodes   : # BSP nodes and leaves visited by BSP_Intersect*.
+ *     GridCells  : # HashGrid cells touched by queries and updates.
+ *     RayCasts   : # Physics_RayCast, Physics_SphereCast and Physics_BoxCast
+ *                  calls.
+ *     Allocs     : # MemAlloc & friends during the frame. Only counted when
+ *                  ENABLE_MEMORY_TRACKING is set. Allocations happen on any
+ *                  thread, so the count is taken from the memory tracker at
+ *                  the frame boundary: Metric_Get always returns 0 for it,
+ *                  and it is valid only in the history (Metric_GetLast et
+ *                  al.).
+ *     LuaGCSteps : # Lua_GCStep calls.
+ *
+ *   Applications may register their own metrics with Metric_Register (up to
+ *   64 metrics in total, including the built-ins). A counter is reset every
+ *   frame, as the built-ins are; a gauge keeps its value until it is set
+ *   again. Unlike built-ins, registered metrics are changed through the
+ *   public Metric_Add and Metric_Set. Registering an existing name returns
+ *   the existing metric. Valid metrics are 1 .. Metric_GetCount().
+ *
+ *   Metrics are not synchronized and should be updated from the main thread.
+ *
  * -------------------------------------------------------------------------- */
 
 const Metric Metric_None       = 0x0;
@@ -49,18 +74,37 @@ const Metric Metric_TrisDrawn  = 0x4;
 const Metric Metric_VertsDrawn = 0x5;
 const Metric Metric_Flush      = 0x6;
 const Metric Metric_FBOSwap    = 0x7;
-const Metric Metric_SIZE       = 0x7;
+const Metric Metric_BSPNodes   = 0x8;
+const Metric Metric_GridCells  = 0x9;
+const Metric Metric_RayCasts   = 0xA;
+const Metric Metric_Allocs     = 0xB;
+const Metric Metric_LuaGCSteps = 0xC;
+const Metric Metric_SIZE       = 0xC;
+
+PHX_API int32   Metric_Get         (Metric);
+PHX_API cstr    Metric_GetName     (Metric);
+PHX_API int32   Metric_GetCount    ();
+PHX_API Metric  Metric_Find        (cstr name);
+
+PHX_API Metric  Metric_Register    (cstr name, bool gauge);
+PHX_API bool    Metric_IsGauge     (Metric);
+PHX_API void    Metric_Add         (Metric, int32 delta);
+PHX_API void    Metric_Set         (Metric, int32 value);
 
-PHX_API int32  Metric_Get         (Metric);
-PHX_API cstr   Metric_GetName     (Metric);
+PHX_API int32   Metric_GetLast     (Metric);
+PHX_API int32   Metric_GetMin      (Metric);
+PHX_API double  Metric_GetAvg      (Metric);
+PHX_API int32   Metric_GetMax      (Metric);
+PHX_API int     Metric_GetHistory  (Metric, int32* out, int count);
 
 /* --- Private API ---------------------------------------------------------- */
 
-PRIVATE void   Metric_Inc         (Metric);
-PRIVATE void   Metric_Mod         (Metric, int32);
-PRIVATE void   Metric_Reset       ();
+PRIVATE void    Metric_Inc         (Metric);
+PRIVATE void    Metric_Mod         (Metric, int32);
+PRIVATE void    Metric_NextFrame   ();
+PRIVATE void    Metric_Reset       ();
 
-PRIVATE void   Metric_AddDraw     (int32 polys, int32 tris, int32 verts);
-PRIVATE void   Metric_AddDrawImm  (int32 polys, int32 tris, int32 verts);
+PRIVATE void    Metric_AddDraw     (int32 polys, int32 tris, int32 verts);
+PRIVATE void    Metric_AddDrawImm  (int32 polys, int32 tris, int32 verts);
 
 #endif
@@ -6,6 +6,7 @@
 PHX_API cstr  OS_GetClipboard    ();
 PHX_API int   OS_GetCPUCount     ();
 PHX_API cstr  OS_GetVideoDriver  ();
+PHX_API bool  OS_HasAVX          ();
 PHX_API void  OS_SetClipboard    (cstr text);
 
 #endif
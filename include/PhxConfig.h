@@ -16,6 +16,25 @@
  * when the output is actually needed. */
 #define ENABLE_PROFILER_TRACE 0
 
+/* Routes MemAlloc & friends through an accounting layer that tags each
+ * allocation with the calling thread's current MemTag and keeps live / peak
+ * bytes, per-frame allocation counts and a size histogram (see PhxMemory.h).
+ * Costs a 16-byte header per allocation plus a spinlock per call. Every
+ * pointer passed to MemFree must then come from MemAlloc, not raw malloc. */
+#define ENABLE_MEMORY_TRACKING 0
+
+/* Serves MemAlloc requests of up to 2 KiB from a size-class heap with
+ * per-thread caches (MemHeap.cpp) instead of the system allocator. Larger
+ * requests and MemAllocAligned still go to the system. Memory held by the
+ * heap is reused but never returned to the system. MemFree accepts system
+ * memory, but memory from MemAlloc must never reach raw free(). */
+#define ENABLE_MEMORY_HEAP 0
+
+/* Selects the Swiss-table HashMap backend (HashMap_Swiss.cpp), which probes
+ * 16 control bytes per SSE2 compare, instead of the Robin Hood table in
+ * HashMap.cpp. Both implement the full HashMap API. */
+#define ENABLE_HASHMAP_SWISS 0
+
 /* TODO AB : Brief summary of this flag (hoisted from BSP.cpp) */
 #define ENABLE_BSP_PROFILING 0
 
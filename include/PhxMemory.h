@@ -6,14 +6,20 @@
 #include <stdlib.h>
 #include <string.h>
 
-inline void*  MemAlloc      (size_t size);
-inline void*  MemAllocZero  (size_t size);
-inline void   MemCpy        (void* dst, void const* src, size_t size);
-inline void   MemMove       (void* dst, void const* src, size_t size);
-inline void   MemFree       (void const* ptr);
-inline void*  MemRealloc    (void* ptr, size_t newSize);
-inline void   MemSet        (void* dst, int value, size_t size);
-inline void   MemZero       (void* dst, size_t size);
+#if WINDOWS
+  #include <malloc.h>
+#endif
+
+inline void*  MemAlloc         (size_t size);
+inline void*  MemAllocAligned  (size_t size, size_t alignment);
+inline void*  MemAllocZero     (size_t size);
+inline void   MemCpy           (void* dst, void const* src, size_t size);
+inline void   MemMove          (void* dst, void const* src, size_t size);
+inline void   MemFree          (void const* ptr);
+inline void   MemFreeAligned   (void const* ptr);
+inline void*  MemRealloc       (void* ptr, size_t newSize);
+inline void   MemSet           (void* dst, int value, size_t size);
+inline void   MemZero          (void* dst, size_t size);
 
 #define MemNew(x)             ((x*)MemAlloc(sizeof(x)))
 #define MemNewZero(x)         ((x*)MemAllocZero(sizeof(x)))
@@ -22,21 +28,132 @@ inline void   MemZero       (void* dst, size_t size);
 
 /* Exported versions for applications that need to ensure usage of the same
  * memory allocator as libphx. */
-PHX_API void*  Memory_Alloc    (size_t);
-PHX_API void*  Memory_Calloc   (size_t n, size_t size);
-PHX_API void   Memory_Free     (void* ptr);
-PHX_API void   Memory_MemCopy  (void* dst, void const* src, size_t size);
-PHX_API void   Memory_MemMove  (void* dst, void const* src, size_t size);
-PHX_API void*  Memory_Realloc  (void* ptr, size_t newSize);
+PHX_API void*   Memory_Alloc               (size_t);
+PHX_API void*   Memory_Calloc              (size_t n, size_t size);
+PHX_API void    Memory_Free                (void* ptr);
+PHX_API void    Memory_MemCopy             (void* dst, void const* src, size_t size);
+PHX_API void    Memory_MemMove             (void* dst, void const* src, size_t size);
+PHX_API void*   Memory_Realloc             (void* ptr, size_t newSize);
+
+/* --- Allocation Tracking -----------------------------------------------------
+ *
+ *   When ENABLE_MEMORY_TRACKING is set in PhxConfig.h, every allocation made
+ *   through MemAlloc & friends (and the Memory_* exports) is attributed to
+ *   the calling thread's current MemTag. Tags are pushed and popped around
+ *   subsystem entry points with Memory_PushTag / Memory_PopTag (or the
+ *   MEMTAG_BEGIN / MEMTAG_END macros internally, which compile away when
+ *   tracking is off); a reallocation or free is charged to the tag that
+ *   made the original allocation. Tags MemTag_User + [0, 8) are free for
+ *   application use. Passing MemTag_All to a query returns the total.
+ *
+ *     LiveBytes   : Bytes currently allocated (excluding tracking headers)
+ *     LiveCount   : Number of allocations currently live
+ *     PeakBytes   : Highest LiveBytes seen since start / Memory_ResetPeak
+ *     FrameAllocs : Allocations (including reallocs) during the last
+ *     FrameFrees    complete frame, and frees likewise. Frames are delimited
+ *     FrameBytes    by Engine_Update, as with Metric. FrameBytes is the sum of
+ *                   requested sizes.
+ *
+ *   The size histogram counts every allocation since startup by requested
+ *   size in power-of-two buckets: bucket 0 holds sizes <= 16, bucket i
+ *   holds sizes in (8 << i, 16 << i], and the last bucket is unbounded
+ *   (Memory_GetHistogramLimit returns 0 for it).
+ *
+ *   With tracking off, queries return 0 and Memory_IsTracking returns false.
+ *
+ * -------------------------------------------------------------------------- */
+
+const MemTag MemTag_All       = -1;
+const MemTag MemTag_Default   = 0;
+const MemTag MemTag_Collision = 1;
+const MemTag MemTag_Gui       = 2;
+const MemTag MemTag_Mesh      = 3;
+const MemTag MemTag_Render    = 4;
+const MemTag MemTag_User      = 8;
+const MemTag MemTag_SIZE      = 16;
+
+PHX_API bool    Memory_IsTracking          ();
+PHX_API void    Memory_PushTag             (MemTag);
+PHX_API void    Memory_PopTag              ();
+PHX_API MemTag  Memory_GetTag              ();
+PHX_API cstr    Memory_GetTagName          (MemTag);
+
+PHX_API uint64  Memory_GetLiveBytes        (MemTag);
+PHX_API uint64  Memory_GetLiveCount        (MemTag);
+PHX_API uint64  Memory_GetPeakBytes        (MemTag);
+PHX_API uint32  Memory_GetFrameAllocs      (MemTag);
+PHX_API uint64  Memory_GetFrameBytes       (MemTag);
+PHX_API uint32  Memory_GetFrameFrees       (MemTag);
+PHX_API uint64  Memory_GetHistogram        (int bucket);
+PHX_API uint64  Memory_GetHistogramLimit   (int bucket);
+PHX_API int     Memory_GetHistogramSize    ();
+PHX_API void    Memory_PrintReport         ();
+PHX_API void    Memory_ResetPeak           ();
+
+#if ENABLE_MEMORY_TRACKING
+  #define MEMTAG_BEGIN(tag) Memory_PushTag(tag)
+  #define MEMTAG_END Memory_PopTag()
+#else
+  #define MEMTAG_BEGIN(tag)
+  #define MEMTAG_END
+#endif
+
+/* --- Private API ---------------------------------------------------------- */
+
+PRIVATE void    Memory_NextFrame           ();
+
+#if ENABLE_MEMORY_TRACKING
+PRIVATE void*   Memory_TrackedAlloc        (size_t size, bool zero);
+PRIVATE void*   Memory_TrackedAllocAligned (size_t size, size_t alignment);
+PRIVATE void    Memory_TrackedFree         (void const* ptr);
+PRIVATE void    Memory_TrackedFreeAligned  (void const* ptr);
+PRIVATE void*   Memory_TrackedRealloc      (void* ptr, size_t newSize);
+#endif
+
+/* Small-object heap, see ENABLE_MEMORY_HEAP and MemHeap.cpp. MemHeap_Free and
+ * MemHeap_Realloc also accept memory from the system allocator. */
+#if ENABLE_MEMORY_HEAP
+PRIVATE void*   MemHeap_Alloc              (size_t size);
+PRIVATE void*   MemHeap_AllocZero          (size_t size);
+PRIVATE void    MemHeap_Free               (void const* ptr);
+PRIVATE void*   MemHeap_Realloc            (void* ptr, size_t newSize);
+#endif
 
 /* -------------------------------------------------------------------------- */
 
 inline void* MemAlloc (size_t size) {
+#if ENABLE_MEMORY_TRACKING
+  return Memory_TrackedAlloc(size, false);
+#elif ENABLE_MEMORY_HEAP
+  return MemHeap_Alloc(size);
+#else
   return malloc(size);
+#endif
+}
+
+/* Alignment must be a power of two. Memory from MemAllocAligned must be
+ * released with MemFreeAligned. */
+inline void* MemAllocAligned (size_t size, size_t alignment) {
+#if ENABLE_MEMORY_TRACKING
+  return Memory_TrackedAllocAligned(size, alignment);
+#elif WINDOWS
+  return _aligned_malloc(size, alignment);
+#else
+  void* p = 0;
+  if (alignment < sizeof(void*))
+    alignment = sizeof(void*);
+  return posix_memalign(&p, alignment, size) == 0 ? p : 0;
+#endif
 }
 
 inline void* MemAllocZero (size_t size) {
+#if ENABLE_MEMORY_TRACKING
+  return Memory_TrackedAlloc(size, true);
+#elif ENABLE_MEMORY_HEAP
+  return MemHeap_AllocZero(size);
+#else
   return calloc(1, size);
+#endif
 }
 
 inline void MemCpy (void* dst, void const* src, size_t size) {
@@ -48,11 +165,33 @@ inline void MemMove (void* dst, void const* src, size_t size) {
 }
 
 inline void MemFree (void const* ptr) {
+#if ENABLE_MEMORY_TRACKING
+  Memory_TrackedFree(ptr);
+#elif ENABLE_MEMORY_HEAP
+  MemHeap_Free(ptr);
+#else
   free((void*)ptr);
+#endif
+}
+
+inline void MemFreeAligned (void const* ptr) {
+#if ENABLE_MEMORY_TRACKING
+  Memory_TrackedFreeAligned(ptr);
+#elif WINDOWS
+  _aligned_free((void*)ptr);
+#else
+  free((void*)ptr);
+#endif
 }
 
 inline void* MemRealloc (void* ptr, size_t newSize) {
+#if ENABLE_MEMORY_TRACKING
+  return Memory_TrackedRealloc(ptr, newSize);
+#elif ENABLE_MEMORY_HEAP
+  return MemHeap_Realloc(ptr, newSize);
+#else
   return realloc(ptr, newSize);
+#endif
 }
 
 inline void MemSet (void* dst, int value, size_t size) {
@@ -2,6 +2,7 @@
 #define PHX_String
 
 #include "Common.h"
+#include "PhxMemory.h"
 
 #include <stdarg.h>
 #include <stdio.h>
@@ -34,12 +35,15 @@ inline cstr    StrUpper     (cstr s);
 
 /* -------------------------------------------------------------------------- */
 
+/* NOTE : Strings come from MemAlloc, so that they are tracked and served by
+ *        the small-object heap like any other allocation. Free them with
+ *        StrFree or MemFree, never with raw free(). */
 inline char* StrAlloc (size_t len) {
-  return (char*)malloc(len);
+  return (char*)MemAlloc(len);
 }
 
 inline void StrFree (cstr s) {
-  free((void*)s);
+  MemFree(s);
 }
 
 inline cstr StrAdd (cstr a, cstr b) {
@@ -5,16 +5,123 @@
 
 #define ENABLE_PROFILER 1
 
-PHX_API void  Profiler_Enable      ();
-PHX_API void  Profiler_Disable     ();
+/* --- Profiler ----------------------------------------------------------------
+ *
+ *   Scopes are tracked per thread: each thread has its own scope stack and
+ *   statistics, and may call Begin/End freely without contention. Threads
+ *   are registered on first use under the name "Thread" (the thread calling
+ *   Profiler_Enable is "Main"). Profiler_SetThreadName names the calling
+ *   thread; a thread registering under the name of one that has exited
+ *   takes over its record (and its trace row).
+ *
+ *   Profiler_LoopMarker ends a frame. The calling thread's frame times are
+ *   folded into its statistics immediately; other threads fold theirs the
+ *   next time they begin or end a scope.
+ *
+ *   Profiler_GetScopeStats reports a scope's per-frame times, in seconds,
+ *   for thread index 'thread' (0 .. Profiler_GetThreadCount() - 1) or, with
+ *   thread = -1, aggregated over all threads. Returns false if the scope
+ *   was never entered. Statistics of other threads are read without
+ *   synchronization and are exact only while those threads are idle.
+ *
+ *   Every scope also keeps a log-bucketed histogram of its per-frame times,
+ *   from which the p50 / p90 / p99 / p99.9 in ProfilerStats are taken
+ *   (accurate to about 6%). Profiler_GetScopePercentile reports any other
+ *   quantile, with p in [0, 1].
+ *
+ *   Profiler_SetScopeBudget sets a per-frame time budget, in seconds, for a
+ *   scope (0 removes it); frames in which the scope exceeds its budget are
+ *   counted in ProfilerStats::overBudget. Budgets persist across profiling
+ *   sessions. Profiler_SetFrameBudget does the same for the time between
+ *   consecutive Profiler_LoopMarker calls, whose statistics are returned by
+ *   Profiler_GetFrameStats. Profiler_GetFrameHistory copies up to 'count' of
+ *   the most recent frame times (at most 1024, oldest first) to 'out' and
+ *   returns the number copied.
+ *
+ *   Profiler_AddSample credits 'seconds' of the calling thread's time to
+ *   the scope 'name' without entering it, taking the time out of the
+ *   innermost open scope. It is how sampling profilers (see
+ *   LuaProfiler_Start) feed their estimates into the same statistics and
+ *   trace as measured scopes; in the trace, samples appear on a separate
+ *   row per thread.
+ *
+ *   Scopes are identified by name contents, not by pointer: the same name
+ *   passed through different strings enters the same scope. Each pointer
+ *   passed to Profiler_Begin is remembered for the session, so it must keep
+ *   naming the same string until Profiler_Disable (as literals and __func__
+ *   do); transient strings should be interned with Str_Intern first.
+ *
+ *   Profiler_Disable prints statistics per thread (when there is more than
+ *   one) and aggregated, followed by frame time statistics. It folds and
+ *   frees the records of every thread, so all other threads must be idle
+ *   -- outside any scope and making no profiler calls -- until it returns.
+ *
+ *   With ENABLE_PROFILER_TRACE, every Begin, End and SetValue is recorded
+ *   as a fixed-size event in a per-thread ring buffer. The trace has two
+ *   modes, chosen by Profiler_SetTraceWindow before Profiler_Enable:
+ *
+ *     0 (default) : Streaming. A background thread drains the rings to a
+ *                   binary log/trace.bin every 100 ms (or on
+ *                   Profiler_FlushTrace). A ring that fills up between
+ *                   drains drops events, and Profiler_Disable warns about
+ *                   it. On Profiler_Disable the file is converted to a
+ *                   Chrome trace at log/trace.json.
+ *     seconds > 0 : Capture. Nothing is written; each ring keeps its most
+ *                   recent events, and Profiler_DumpTrace writes the last
+ *                   'seconds' of them to a binary trace file.
+ *
+ *   Profiler_ConvertTrace converts a binary trace into Chrome's JSON trace
+ *   format (timestamps in microseconds from the first event). It is
+ *   available regardless of ENABLE_PROFILER_TRACE.
+ *
+ * -------------------------------------------------------------------------- */
 
-PHX_API void  Profiler_Begin       (cstr);
-PHX_API void  Profiler_End         ();
-PHX_API void  Profiler_SetValue    (cstr, int);
+struct ProfilerStats {
+  double total;
+  double count;
+  double mean;
+  double stddev;
+  double min;
+  double max;
+  double p50;
+  double p90;
+  double p99;
+  double p999;
+  double budget;
+  double overBudget;
+};
 
-PHX_API void  Profiler_LoopMarker  ();
+PHX_API void    Profiler_Enable              ();
+PHX_API void    Profiler_Disable             ();
 
-PHX_API void  Profiler_Backtrace   ();
+PHX_API void    Profiler_Begin               (cstr);
+PHX_API void    Profiler_End                 ();
+PHX_API void    Profiler_SetValue            (cstr, int);
+PHX_API void    Profiler_SetThreadName       (cstr);
+PHX_API void    Profiler_AddSample           (cstr, double seconds);
+
+PHX_API void    Profiler_LoopMarker          ();
+
+PHX_API int     Profiler_GetThreadCount      ();
+PHX_API cstr    Profiler_GetThreadName       (int thread);
+PHX_API bool    Profiler_GetScopeStats       (cstr scope, int thread, ProfilerStats*);
+PHX_API double  Profiler_GetScopePercentile  (cstr scope, int thread, double p);
+
+PHX_API void    Profiler_SetScopeBudget      (cstr scope, double seconds);
+PHX_API void    Profiler_SetFrameBudget      (double seconds);
+PHX_API bool    Profiler_GetFrameStats       (ProfilerStats*);
+PHX_API int     Profiler_GetFrameHistory     (double* out, int count);
+
+PHX_API void    Profiler_SetTraceWindow      (double seconds);
+PHX_API void    Profiler_FlushTrace          ();
+PHX_API bool    Profiler_DumpTrace           (cstr path);
+PHX_API bool    Profiler_ConvertTrace        (cstr src, cstr dst);
+
+PHX_API void    Profiler_Backtrace           ();
+
+/* --- Private API ---------------------------------------------------------- */
+
+PRIVATE int     Profiler_GetStack            (cstr* names, int capacity);
 
 #if ENABLE_PROFILER
   #define FRAME_BEGIN Profiler_Begin(__func__)
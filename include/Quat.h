@@ -43,6 +43,8 @@ PHX_API void   Quat_IMul                (Quat*, Quat const*);
 PHX_API void   Quat_MulV                (Quat const*, Vec3f const*, Vec3f* out);
 PHX_API void   Quat_Normalize           (Quat const*, Quat* out);
 PHX_API void   Quat_INormalize          (Quat*);
+PHX_API void   Quat_RotateVectors       (Quat const*, Vec3f* out, Vec3f const* in, int count);
+PHX_API void   Quat_RotateVectorsSoA    (Quat const*, float* x, float* y, float* z, int count);
 PHX_API void   Quat_Scale               (Quat const*, float, Quat* out);
 PHX_API void   Quat_IScale              (Quat*, float);
 PHX_API void   Quat_Slerp               (Quat const*, Quat const*, float, Quat* out);
@@ -7,6 +7,11 @@
  *
  *   This type is REFERENCE-COUNTED. See ../doc/RefCounted.txt for details.
  *
+ *   Shader_Set* look variables up by name, which interns the name on every
+ *   call. Code that sets the same variable repeatedly should intern the name
+ *   once with Str_InternId and use the Shader_Set*Id variants, which go
+ *   straight to the bound shader's cached uniform location.
+ *
  * -------------------------------------------------------------------------- */
 
 PHX_API Shader*       Shader_Create         (cstr vertCode, cstr fragCode);
@@ -35,6 +40,18 @@ PHX_API void          Shader_SetTex2D       (cstr, Tex2D*);
 PHX_API void          Shader_SetTex3D       (cstr, Tex3D*);
 PHX_API void          Shader_SetTexCube     (cstr, TexCube*);
 
+PHX_API void          Shader_SetFloatId     (uint32, float);
+PHX_API void          Shader_SetFloat2Id    (uint32, float, float);
+PHX_API void          Shader_SetFloat3Id    (uint32, float, float, float);
+PHX_API void          Shader_SetFloat4Id    (uint32, float, float, float, float);
+PHX_API void          Shader_SetIntId       (uint32, int);
+PHX_API void          Shader_SetMatrixId    (uint32, Matrix*);
+PHX_API void          Shader_SetMatrixTId   (uint32, Matrix*);
+PHX_API void          Shader_SetTex1DId     (uint32, Tex1D*);
+PHX_API void          Shader_SetTex2DId     (uint32, Tex2D*);
+PHX_API void          Shader_SetTex3DId     (uint32, Tex3D*);
+PHX_API void          Shader_SetTexCubeId   (uint32, TexCube*);
+
 PHX_API void          Shader_ISetFloat      (int, float);
 PHX_API void          Shader_ISetFloat2     (int, float, float);
 PHX_API void          Shader_ISetFloat3     (int, float, float, float);
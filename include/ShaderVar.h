@@ -3,20 +3,34 @@
 
 #include "Common.h"
 
-PHX_API void* ShaderVar_Get         (cstr, ShaderVarType);
-PHX_API void  ShaderVar_PushFloat   (cstr, float);
-PHX_API void  ShaderVar_PushFloat2  (cstr, float, float);
-PHX_API void  ShaderVar_PushFloat3  (cstr, float, float, float);
-PHX_API void  ShaderVar_PushFloat4  (cstr, float, float, float, float);
-PHX_API void  ShaderVar_PushInt     (cstr, int);
-PHX_API void  ShaderVar_PushMatrix  (cstr, Matrix*);
-PHX_API void  ShaderVar_PushTex1D   (cstr, Tex1D*);
-PHX_API void  ShaderVar_PushTex2D   (cstr, Tex2D*);
-PHX_API void  ShaderVar_PushTex3D   (cstr, Tex3D*);
-PHX_API void  ShaderVar_PushTexCube (cstr, TexCube*);
-PHX_API void  ShaderVar_Pop         (cstr);
+PHX_API void* ShaderVar_Get           (cstr, ShaderVarType);
+PHX_API void  ShaderVar_PushFloat     (cstr, float);
+PHX_API void  ShaderVar_PushFloat2    (cstr, float, float);
+PHX_API void  ShaderVar_PushFloat3    (cstr, float, float, float);
+PHX_API void  ShaderVar_PushFloat4    (cstr, float, float, float, float);
+PHX_API void  ShaderVar_PushInt       (cstr, int);
+PHX_API void  ShaderVar_PushMatrix    (cstr, Matrix*);
+PHX_API void  ShaderVar_PushTex1D     (cstr, Tex1D*);
+PHX_API void  ShaderVar_PushTex2D     (cstr, Tex2D*);
+PHX_API void  ShaderVar_PushTex3D     (cstr, Tex3D*);
+PHX_API void  ShaderVar_PushTexCube   (cstr, TexCube*);
+PHX_API void  ShaderVar_Pop           (cstr);
 
-PRIVATE void ShaderVar_Init ();
-PRIVATE void ShaderVar_Free ();
+/* As above, keyed by the Str_InternId of the variable name. */
+PHX_API void* ShaderVar_GetId         (uint32, ShaderVarType);
+PHX_API void  ShaderVar_PushFloatId   (uint32, float);
+PHX_API void  ShaderVar_PushFloat2Id  (uint32, float, float);
+PHX_API void  ShaderVar_PushFloat3Id  (uint32, float, float, float);
+PHX_API void  ShaderVar_PushFloat4Id  (uint32, float, float, float, float);
+PHX_API void  ShaderVar_PushIntId     (uint32, int);
+PHX_API void  ShaderVar_PushMatrixId  (uint32, Matrix*);
+PHX_API void  ShaderVar_PushTex1DId   (uint32, Tex1D*);
+PHX_API void  ShaderVar_PushTex2DId   (uint32, Tex2D*);
+PHX_API void  ShaderVar_PushTex3DId   (uint32, Tex3D*);
+PHX_API void  ShaderVar_PushTexCubeId (uint32, TexCube*);
+PHX_API void  ShaderVar_PopId         (uint32);
+
+PRIVATE void  ShaderVar_Init          ();
+PRIVATE void  ShaderVar_Free          ();
 
 #endif
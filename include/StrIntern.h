@@ -0,0 +1,37 @@
+#ifndef PHX_StrIntern
+#define PHX_StrIntern
+
+#include "Common.h"
+
+/* --- StrIntern ---------------------------------------------------------------
+ *
+ *   A global, thread-safe string interning table. Str_Intern returns the one
+ *   canonical copy of a string: two calls with equal strings return the same
+ *   pointer, so interned strings can be compared and hashed by address.
+ *   Interned strings live in an arena and are never freed; the pointers stay
+ *   valid for the lifetime of the process.
+ *
+ *   Every interned string also has a small integer ID. IDs are dense, start
+ *   at 1, and are assigned in order of first interning, so they are suitable
+ *   as indices into plain arrays. 0 is never a valid ID.
+ *
+ *     Str_InternId     : Interns the string and returns its ID
+ *     Str_GetInternId  : Returns the ID of an already interned string in O(1)
+ *                        without hashing. The argument MUST be a pointer
+ *                        returned by Str_Intern.
+ *     Str_GetInterned  : Maps an ID back to the interned string
+ *
+ *   Interning hashes the string once and takes a spinlock, so it is not free.
+ *   The benefit comes from doing it once (e.g. when parsing a shader) and
+ *   keying per-frame lookups on the pointer or ID thereafter.
+ *
+ * -------------------------------------------------------------------------- */
+
+PHX_API cstr    Str_Intern          (cstr);
+PHX_API uint32  Str_InternId        (cstr);
+
+PHX_API uint32  Str_GetInternCount  ();
+PHX_API uint32  Str_GetInternId     (cstr interned);
+PHX_API cstr    Str_GetInterned     (uint32 id);
+
+#endif
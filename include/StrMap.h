@@ -3,16 +3,39 @@
 
 #include "Common.h"
 
-PHX_API StrMap*  StrMap_Create   (uint32 initCapacity);
-PHX_API void     StrMap_Free     (StrMap*);
-PHX_API void     StrMap_FreeEx   (StrMap*, void (*freeFn)(cstr key, void* value));
+/* --- StrMap ------------------------------------------------------------------
+ *
+ *   An open-addressing map from strings to pointers. Keys are copied on
+ *   insertion and freed with the map. Each slot keeps the key's full 64-bit
+ *   hash, so lookups compare hashes before strings and growing never rehashes
+ *   a key. Capacity is always a power of two.
+ *
+ *   Setting an existing key replaces its value. Removing a key that is not in
+ *   the map is an error.
+ *
+ *   The *Hashed variants take the value of StrMap_Hash(key), allowing a
+ *   caller that looks up the same name repeatedly to hash it only once.
+ *
+ *   Iteration order is unspecified, and iterators are invalidated by Set and
+ *   Remove.
+ *
+ * -------------------------------------------------------------------------- */
 
-PHX_API void*    StrMap_Get      (StrMap*, cstr key);
-PHX_API uint32   StrMap_GetSize  (StrMap*);
-PHX_API void     StrMap_Remove   (StrMap*, cstr key);
-PHX_API void     StrMap_Set      (StrMap*, cstr key, void* val);
+PHX_API StrMap*  StrMap_Create        (uint32 initCapacity);
+PHX_API void     StrMap_Free          (StrMap*);
+PHX_API void     StrMap_FreeEx        (StrMap*, void (*freeFn)(cstr key, void* value));
 
-PHX_API void     StrMap_Dump     (StrMap*);
+PHX_API void*    StrMap_Get           (StrMap*, cstr key);
+PHX_API uint32   StrMap_GetSize       (StrMap*);
+PHX_API void     StrMap_Remove        (StrMap*, cstr key);
+PHX_API void     StrMap_Set           (StrMap*, cstr key, void* val);
+
+PHX_API uint64   StrMap_Hash          (cstr key);
+PHX_API void*    StrMap_GetHashed     (StrMap*, cstr key, uint64 hash);
+PHX_API void     StrMap_RemoveHashed  (StrMap*, cstr key, uint64 hash);
+PHX_API void     StrMap_SetHashed     (StrMap*, cstr key, uint64 hash, void* val);
+
+PHX_API void     StrMap_Dump          (StrMap*);
 
 PHX_API StrMapIter* StrMap_Iterate      (StrMap*);
 PHX_API void        StrMapIter_Advance  (StrMapIter*);
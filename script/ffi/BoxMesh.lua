@@ -5,19 +5,21 @@ local BoxMesh
 
 do -- C Definitions
   ffi.cdef [[
-    BoxMesh* BoxMesh_Create  ();
-    void     BoxMesh_Free    (BoxMesh*);
-    void     BoxMesh_Add     (BoxMesh*, float px, float py, float pz, float sx, float sy, float sz, float rx, float ry, float rz, float bx, float by, float bz);
-    Mesh*    BoxMesh_GetMesh (BoxMesh*, int res);
+    BoxMesh* BoxMesh_Create          ();
+    void     BoxMesh_Free            (BoxMesh*);
+    void     BoxMesh_Add             (BoxMesh*, float px, float py, float pz, float sx, float sy, float sz, float rx, float ry, float rz, float bx, float by, float bz);
+    Mesh*    BoxMesh_GetMesh         (BoxMesh*, int res);
+    Mesh*    BoxMesh_GetMeshThreaded (BoxMesh*, int res, int threads);
   ]]
 end
 
 do -- Global Symbol Table
   BoxMesh = {
-    Create  = libphx.BoxMesh_Create,
-    Free    = libphx.BoxMesh_Free,
-    Add     = libphx.BoxMesh_Add,
-    GetMesh = libphx.BoxMesh_GetMesh,
+    Create          = libphx.BoxMesh_Create,
+    Free            = libphx.BoxMesh_Free,
+    Add             = libphx.BoxMesh_Add,
+    GetMesh         = libphx.BoxMesh_GetMesh,
+    GetMeshThreaded = libphx.BoxMesh_GetMeshThreaded,
   }
 
   if onDef_BoxMesh then onDef_BoxMesh(BoxMesh, mt) end
@@ -28,10 +30,11 @@ do -- Metatype for class instances
   local t  = ffi.typeof('BoxMesh')
   local mt = {
     __index = {
-      managed = function (self) return ffi.gc(self, libphx.BoxMesh_Free) end,
-      free    = libphx.BoxMesh_Free,
-      add     = libphx.BoxMesh_Add,
-      getMesh = libphx.BoxMesh_GetMesh,
+      managed         = function (self) return ffi.gc(self, libphx.BoxMesh_Free) end,
+      free            = libphx.BoxMesh_Free,
+      add             = libphx.BoxMesh_Add,
+      getMesh         = libphx.BoxMesh_GetMesh,
+      getMeshThreaded = libphx.BoxMesh_GetMeshThreaded,
     },
   }
 
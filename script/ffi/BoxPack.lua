@@ -0,0 +1,30 @@
+-- BoxPack ---------------------------------------------------------------------
+local ffi = require('ffi')
+local libphx = require('ffi.libphx').lib
+local BoxPack
+
+do -- Global Symbol Table
+  BoxPack = {
+  }
+
+  local mt = {
+    __call  = function (t, ...) return BoxPack_t(...) end,
+  }
+
+  if onDef_BoxPack then onDef_BoxPack(BoxPack, mt) end
+  BoxPack = setmetatable(BoxPack, mt)
+end
+
+do -- Metatype for class instances
+  local t  = ffi.typeof('BoxPack')
+  local mt = {
+    __index = {
+      clone = function (x) return BoxPack_t(x) end,
+    },
+  }
+
+  if onDef_BoxPack_t then onDef_BoxPack_t(t, mt) end
+  BoxPack_t = ffi.metatype(t, mt)
+end
+
+return BoxPack
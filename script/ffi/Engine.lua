@@ -5,29 +5,45 @@ local Engine
 
 do -- C Definitions
   ffi.cdef [[
-    void   Engine_Init          (int glVersionMajor, int glVersionMinor);
-    void   Engine_Free          ();
-    void   Engine_Abort         ();
-    int    Engine_GetBits       ();
-    double Engine_GetTime       ();
-    cstr   Engine_GetVersion    ();
-    bool   Engine_IsInitialized ();
-    void   Engine_Terminate     ();
-    void   Engine_Update        ();
+    void   Engine_Init              (int glVersionMajor, int glVersionMinor);
+    void   Engine_InitHeadless      ();
+    void   Engine_Free              ();
+    void   Engine_Abort             ();
+    int    Engine_GetBits           ();
+    double Engine_GetTime           ();
+    cstr   Engine_GetVersion        ();
+    bool   Engine_IsInitialized     ();
+    void   Engine_Terminate         ();
+    void   Engine_Update            ();
+    bool   Engine_IsHeadless        ();
+    void   Engine_MarkInitPhase     (cstr name);
+    int    Engine_GetInitPhaseCount ();
+    cstr   Engine_GetInitPhaseName  (int index);
+    double Engine_GetInitPhaseTime  (int index);
+    double Engine_GetInitTime       ();
+    void   Engine_PrintInitReport   ();
   ]]
 end
 
 do -- Global Symbol Table
   Engine = {
-    Init          = libphx.Engine_Init,
-    Free          = libphx.Engine_Free,
-    Abort         = libphx.Engine_Abort,
-    GetBits       = libphx.Engine_GetBits,
-    GetTime       = libphx.Engine_GetTime,
-    GetVersion    = libphx.Engine_GetVersion,
-    IsInitialized = libphx.Engine_IsInitialized,
-    Terminate     = libphx.Engine_Terminate,
-    Update        = libphx.Engine_Update,
+    Init              = libphx.Engine_Init,
+    InitHeadless      = libphx.Engine_InitHeadless,
+    Free              = libphx.Engine_Free,
+    Abort             = libphx.Engine_Abort,
+    GetBits           = libphx.Engine_GetBits,
+    GetTime           = libphx.Engine_GetTime,
+    GetVersion        = libphx.Engine_GetVersion,
+    IsInitialized     = libphx.Engine_IsInitialized,
+    Terminate         = libphx.Engine_Terminate,
+    Update            = libphx.Engine_Update,
+    IsHeadless        = libphx.Engine_IsHeadless,
+    MarkInitPhase     = libphx.Engine_MarkInitPhase,
+    GetInitPhaseCount = libphx.Engine_GetInitPhaseCount,
+    GetInitPhaseName  = libphx.Engine_GetInitPhaseName,
+    GetInitPhaseTime  = libphx.Engine_GetInitPhaseTime,
+    GetInitTime       = libphx.Engine_GetInitTime,
+    PrintInitReport   = libphx.Engine_PrintInitReport,
   }
 
   if onDef_Engine then onDef_Engine(Engine, mt) end
@@ -9,6 +9,7 @@ do -- C Definitions
     File*  File_Open      (cstr path);
     void   File_Close     (File*);
     bool   File_Exists    (cstr path);
+    uint64 File_Hash      (cstr path);
     bool   File_IsDir     (cstr path);
     Bytes* File_ReadBytes (cstr path);
     cstr   File_ReadCstr  (cstr path);
@@ -45,6 +46,7 @@ do -- Global Symbol Table
     Open      = libphx.File_Open,
     Close     = libphx.File_Close,
     Exists    = libphx.File_Exists,
+    Hash      = libphx.File_Hash,
     IsDir     = libphx.File_IsDir,
     ReadBytes = libphx.File_ReadBytes,
     ReadCstr  = libphx.File_ReadCstr,
@@ -13,6 +13,10 @@ do -- C Definitions
     uint64 Hash_FNV64_Incremental (uint64, void const* buf, int len);
     uint32 Hash_Murmur3           (void const* buf, int len);
     uint64 Hash_XX64              (void const* buf, int len, uint64 seed);
+    void   Hash_XX64_Init         (HashXX64State*, uint64 seed);
+    void   Hash_XX64_Update       (HashXX64State*, void const* buf, int len);
+    uint64 Hash_XX64_Digest       (HashXX64State const*);
+    uint64 Hash_XXH3              (void const* buf, int len, uint64 seed);
   ]]
 end
 
@@ -26,6 +30,10 @@ do -- Global Symbol Table
     FNV64_Incremental = libphx.Hash_FNV64_Incremental,
     Murmur3           = libphx.Hash_Murmur3,
     XX64              = libphx.Hash_XX64,
+    XX64_Init         = libphx.Hash_XX64_Init,
+    XX64_Update       = libphx.Hash_XX64_Update,
+    XX64_Digest       = libphx.Hash_XX64_Digest,
+    XXH3              = libphx.Hash_XXH3,
   }
 
   if onDef_Hash then onDef_Hash(Hash, mt) end
@@ -5,27 +5,43 @@ local HashMap
 
 do -- C Definitions
   ffi.cdef [[
-    HashMap* HashMap_Create  (uint32 keySize, uint32 capacity);
-    void     HashMap_Free    (HashMap*);
-    void     HashMap_Foreach (HashMap*, ValueForeach, void* userData);
-    void*    HashMap_Get     (HashMap*, void const* key);
-    void*    HashMap_GetRaw  (HashMap*, uint64 keyHash);
-    void     HashMap_Resize  (HashMap*, uint32 capacity);
-    void     HashMap_Set     (HashMap*, void const* key, void* value);
-    void     HashMap_SetRaw  (HashMap*, uint64 keyHash, void* value);
+    HashMap* HashMap_Create        (uint32 keySize, uint32 capacity);
+    void     HashMap_Free          (HashMap*);
+    void     HashMap_Foreach       (HashMap*, ValueForeach, void* userData);
+    void*    HashMap_Get           (HashMap*, void const* key);
+    void*    HashMap_GetRaw        (HashMap*, uint64 keyHash);
+    bool     HashMap_Next          (HashMap*, uint32* iterator, uint64* keyHash, void** value);
+    void*    HashMap_Remove        (HashMap*, void const* key);
+    void*    HashMap_RemoveRaw     (HashMap*, uint64 keyHash);
+    void     HashMap_Resize        (HashMap*, uint32 capacity);
+    void     HashMap_Set           (HashMap*, void const* key, void* value);
+    void     HashMap_SetRaw        (HashMap*, uint64 keyHash, void* value);
+    uint32   HashMap_GetCapacity   (HashMap*);
+    float    HashMap_GetMaxLoad    (HashMap*);
+    void     HashMap_GetProbeStats (HashMap*, float* avgProbe, uint32* maxProbe);
+    uint32   HashMap_GetSize       (HashMap*);
+    void     HashMap_SetMaxLoad    (HashMap*, float maxLoad);
   ]]
 end
 
 do -- Global Symbol Table
   HashMap = {
-    Create  = libphx.HashMap_Create,
-    Free    = libphx.HashMap_Free,
-    Foreach = libphx.HashMap_Foreach,
-    Get     = libphx.HashMap_Get,
-    GetRaw  = libphx.HashMap_GetRaw,
-    Resize  = libphx.HashMap_Resize,
-    Set     = libphx.HashMap_Set,
-    SetRaw  = libphx.HashMap_SetRaw,
+    Create        = libphx.HashMap_Create,
+    Free          = libphx.HashMap_Free,
+    Foreach       = libphx.HashMap_Foreach,
+    Get           = libphx.HashMap_Get,
+    GetRaw        = libphx.HashMap_GetRaw,
+    Next          = libphx.HashMap_Next,
+    Remove        = libphx.HashMap_Remove,
+    RemoveRaw     = libphx.HashMap_RemoveRaw,
+    Resize        = libphx.HashMap_Resize,
+    Set           = libphx.HashMap_Set,
+    SetRaw        = libphx.HashMap_SetRaw,
+    GetCapacity   = libphx.HashMap_GetCapacity,
+    GetMaxLoad    = libphx.HashMap_GetMaxLoad,
+    GetProbeStats = libphx.HashMap_GetProbeStats,
+    GetSize       = libphx.HashMap_GetSize,
+    SetMaxLoad    = libphx.HashMap_SetMaxLoad,
   }
 
   if onDef_HashMap then onDef_HashMap(HashMap, mt) end
@@ -36,14 +52,22 @@ do -- Metatype for class instances
   local t  = ffi.typeof('HashMap')
   local mt = {
     __index = {
-      managed = function (self) return ffi.gc(self, libphx.HashMap_Free) end,
-      free    = libphx.HashMap_Free,
-      foreach = libphx.HashMap_Foreach,
-      get     = libphx.HashMap_Get,
-      getRaw  = libphx.HashMap_GetRaw,
-      resize  = libphx.HashMap_Resize,
-      set     = libphx.HashMap_Set,
-      setRaw  = libphx.HashMap_SetRaw,
+      managed       = function (self) return ffi.gc(self, libphx.HashMap_Free) end,
+      free          = libphx.HashMap_Free,
+      foreach       = libphx.HashMap_Foreach,
+      get           = libphx.HashMap_Get,
+      getRaw        = libphx.HashMap_GetRaw,
+      next          = libphx.HashMap_Next,
+      remove        = libphx.HashMap_Remove,
+      removeRaw     = libphx.HashMap_RemoveRaw,
+      resize        = libphx.HashMap_Resize,
+      set           = libphx.HashMap_Set,
+      setRaw        = libphx.HashMap_SetRaw,
+      getCapacity   = libphx.HashMap_GetCapacity,
+      getMaxLoad    = libphx.HashMap_GetMaxLoad,
+      getProbeStats = libphx.HashMap_GetProbeStats,
+      getSize       = libphx.HashMap_GetSize,
+      setMaxLoad    = libphx.HashMap_SetMaxLoad,
     },
   }
 
@@ -0,0 +1,30 @@
+-- HashXX64State ---------------------------------------------------------------
+local ffi = require('ffi')
+local libphx = require('ffi.libphx').lib
+local HashXX64State
+
+do -- Global Symbol Table
+  HashXX64State = {
+  }
+
+  local mt = {
+    __call  = function (t, ...) return HashXX64State_t(...) end,
+  }
+
+  if onDef_HashXX64State then onDef_HashXX64State(HashXX64State, mt) end
+  HashXX64State = setmetatable(HashXX64State, mt)
+end
+
+do -- Metatype for class instances
+  local t  = ffi.typeof('HashXX64State')
+  local mt = {
+    __index = {
+      clone = function (x) return HashXX64State_t(x) end,
+    },
+  }
+
+  if onDef_HashXX64State_t then onDef_HashXX64State_t(t, mt) end
+  HashXX64State_t = ffi.metatype(t, mt)
+end
+
+return HashXX64State
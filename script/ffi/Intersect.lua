@@ -15,6 +15,13 @@ do -- C Definitions
     bool Intersect_RectRect                  (Vec4f const*, Vec4f const*);
     bool Intersect_RectRectFast              (Vec4f const*, Vec4f const*);
     bool Intersect_SphereTriangle            (Sphere const*, Triangle const*, Vec3f* pHit);
+    void Intersect_PackBoxes                 (Box3f const*, int count, BoxPack*);
+    void Intersect_PackRays                  (Ray const*, int count, RayPacket*);
+    void Intersect_PackTriangles             (Triangle const*, int count, TrianglePack*);
+    int  Intersect_RayBoxes                  (Ray const*, BoxPack const*, int count, float* tEnter);
+    int  Intersect_RayPacketBox              (RayPacket const*, Box3f const*);
+    int  Intersect_RayTriangles              (Ray const*, TrianglePack const*, int count, float* tHit);
+    bool Intersect_SetWideKernel             (int kernel);
   ]]
 end
 
@@ -30,6 +37,13 @@ do -- Global Symbol Table
     RectRect                  = libphx.Intersect_RectRect,
     RectRectFast              = libphx.Intersect_RectRectFast,
     SphereTriangle            = libphx.Intersect_SphereTriangle,
+    PackBoxes                 = libphx.Intersect_PackBoxes,
+    PackRays                  = libphx.Intersect_PackRays,
+    PackTriangles             = libphx.Intersect_PackTriangles,
+    RayBoxes                  = libphx.Intersect_RayBoxes,
+    RayPacketBox              = libphx.Intersect_RayPacketBox,
+    RayTriangles              = libphx.Intersect_RayTriangles,
+    SetWideKernel             = libphx.Intersect_SetWideKernel,
   }
 
   if onDef_Intersect then onDef_Intersect(Intersect, mt) end
@@ -5,23 +5,47 @@ local LodMesh
 
 do -- C Definitions
   ffi.cdef [[
-    LodMesh* LodMesh_Create  ();
-    void     LodMesh_Acquire (LodMesh*);
-    void     LodMesh_Free    (LodMesh*);
-    void     LodMesh_Add     (LodMesh*, Mesh*, float distMin, float distMax);
-    void     LodMesh_Draw    (LodMesh*, float distanceSquared);
-    Mesh*    LodMesh_Get     (LodMesh*, float distanceSquared);
+    LodMesh* LodMesh_Create         ();
+    void     LodMesh_Acquire        (LodMesh*);
+    void     LodMesh_Free           (LodMesh*);
+    void     LodMesh_Add            (LodMesh*, Mesh*, float distMin, float distMax);
+    void     LodMesh_Draw           (LodMesh*, float distanceSquared);
+    Mesh*    LodMesh_Get            (LodMesh*, float distanceSquared);
+    void     LodMesh_AddLevel       (LodMesh*, Mesh*, float error);
+    float    LodMesh_GetHysteresis  (LodMesh*);
+    Mesh*    LodMesh_GetLevel       (LodMesh*, int level);
+    int      LodMesh_GetLevelCount  (LodMesh*);
+    float    LodMesh_GetLevelError  (LodMesh*, int level);
+    void     LodMesh_SetHysteresis  (LodMesh*, float hysteresis);
+    int      LodMesh_SelectLevel    (LodMesh*, float distance, float pixelScale, float maxError, int current);
+    void     LodMesh_SelectLevels   (LodMesh*, Vec3f const* eye, Vec3f const* positions, int count, float pixelScale, float maxError, int32* levels);
+    void     LodMesh_DrawBind       (LodMesh*);
+    void     LodMesh_DrawBoundLevel (LodMesh*, int level);
+    void     LodMesh_DrawUnbind     (LodMesh*);
+    void     LodMesh_DrawLevel      (LodMesh*, int level);
   ]]
 end
 
 do -- Global Symbol Table
   LodMesh = {
-    Create  = libphx.LodMesh_Create,
-    Acquire = libphx.LodMesh_Acquire,
-    Free    = libphx.LodMesh_Free,
-    Add     = libphx.LodMesh_Add,
-    Draw    = libphx.LodMesh_Draw,
-    Get     = libphx.LodMesh_Get,
+    Create         = libphx.LodMesh_Create,
+    Acquire        = libphx.LodMesh_Acquire,
+    Free           = libphx.LodMesh_Free,
+    Add            = libphx.LodMesh_Add,
+    Draw           = libphx.LodMesh_Draw,
+    Get            = libphx.LodMesh_Get,
+    AddLevel       = libphx.LodMesh_AddLevel,
+    GetHysteresis  = libphx.LodMesh_GetHysteresis,
+    GetLevel       = libphx.LodMesh_GetLevel,
+    GetLevelCount  = libphx.LodMesh_GetLevelCount,
+    GetLevelError  = libphx.LodMesh_GetLevelError,
+    SetHysteresis  = libphx.LodMesh_SetHysteresis,
+    SelectLevel    = libphx.LodMesh_SelectLevel,
+    SelectLevels   = libphx.LodMesh_SelectLevels,
+    DrawBind       = libphx.LodMesh_DrawBind,
+    DrawBoundLevel = libphx.LodMesh_DrawBoundLevel,
+    DrawUnbind     = libphx.LodMesh_DrawUnbind,
+    DrawLevel      = libphx.LodMesh_DrawLevel,
   }
 
   if onDef_LodMesh then onDef_LodMesh(LodMesh, mt) end
@@ -32,12 +56,24 @@ do -- Metatype for class instances
   local t  = ffi.typeof('LodMesh')
   local mt = {
     __index = {
-      managed = function (self) return ffi.gc(self, libphx.LodMesh_Free) end,
-      acquire = libphx.LodMesh_Acquire,
-      free    = libphx.LodMesh_Free,
-      add     = libphx.LodMesh_Add,
-      draw    = libphx.LodMesh_Draw,
-      get     = libphx.LodMesh_Get,
+      managed        = function (self) return ffi.gc(self, libphx.LodMesh_Free) end,
+      acquire        = libphx.LodMesh_Acquire,
+      free           = libphx.LodMesh_Free,
+      add            = libphx.LodMesh_Add,
+      draw           = libphx.LodMesh_Draw,
+      get            = libphx.LodMesh_Get,
+      addLevel       = libphx.LodMesh_AddLevel,
+      getHysteresis  = libphx.LodMesh_GetHysteresis,
+      getLevel       = libphx.LodMesh_GetLevel,
+      getLevelCount  = libphx.LodMesh_GetLevelCount,
+      getLevelError  = libphx.LodMesh_GetLevelError,
+      setHysteresis  = libphx.LodMesh_SetHysteresis,
+      selectLevel    = libphx.LodMesh_SelectLevel,
+      selectLevels   = libphx.LodMesh_SelectLevels,
+      drawBind       = libphx.LodMesh_DrawBind,
+      drawBoundLevel = libphx.LodMesh_DrawBoundLevel,
+      drawUnbind     = libphx.LodMesh_DrawUnbind,
+      drawLevel      = libphx.LodMesh_DrawLevel,
     },
   }
 
@@ -14,6 +14,11 @@ do -- C Definitions
     Matrix* Matrix_Product            (Matrix const*, Matrix const*);
     Matrix* Matrix_Sum                (Matrix const*, Matrix const*);
     Matrix* Matrix_Transpose          (Matrix const*);
+    void    Matrix_IOInverse          (Matrix const* in, Matrix* out);
+    void    Matrix_IOInverseTranspose (Matrix const* in, Matrix* out);
+    void    Matrix_IOProduct          (Matrix const* a, Matrix const* b, Matrix* out);
+    void    Matrix_IOSum              (Matrix const* a, Matrix const* b, Matrix* out);
+    void    Matrix_IOTranspose        (Matrix const* in, Matrix* out);
     void    Matrix_IInverse           (Matrix*);
     void    Matrix_IScale             (Matrix*, float);
     void    Matrix_ITranspose         (Matrix*);
@@ -28,10 +33,27 @@ do -- C Definitions
     Matrix* Matrix_SRT                (float sx, float sy, float sz, float ry, float rp, float rr, float tx, float ty, float tz);
     Matrix* Matrix_Translation        (float tx, float ty, float tz);
     Matrix* Matrix_YawPitchRoll       (float yaw, float pitch, float roll);
+    void    Matrix_SetIdentity        (Matrix* out);
+    void    Matrix_SetLookAt          (Matrix* out, Vec3f const* pos, Vec3f const* at, Vec3f const* up);
+    void    Matrix_SetLookUp          (Matrix* out, Vec3f const* pos, Vec3f const* look, Vec3f const* up);
+    void    Matrix_SetPerspective     (Matrix* out, float degreesFovY, float aspect, float zNear, float zFar);
+    void    Matrix_SetRotationX       (Matrix* out, float rads);
+    void    Matrix_SetRotationY       (Matrix* out, float rads);
+    void    Matrix_SetRotationZ       (Matrix* out, float rads);
+    void    Matrix_SetScaling         (Matrix* out, float sx, float sy, float sz);
+    void    Matrix_SetSRT             (Matrix* out, float sx, float sy, float sz, float ry, float rp, float rr, float tx, float ty, float tz);
+    void    Matrix_SetTranslation     (Matrix* out, float tx, float ty, float tz);
+    void    Matrix_SetYawPitchRoll    (Matrix* out, float yaw, float pitch, float roll);
     void    Matrix_MulBox             (Matrix const*, Box3f* out, Box3f const* in);
     void    Matrix_MulDir             (Matrix const*, Vec3f* out, float x, float y, float z);
     void    Matrix_MulPoint           (Matrix const*, Vec3f* out, float x, float y, float z);
     void    Matrix_MulVec             (Matrix const*, Vec4f* out, float x, float y, float z, float w);
+    void    Matrix_MulDirs            (Matrix const*, Vec3f* out, Vec3f const* in, int count);
+    void    Matrix_MulDirsSoA         (Matrix const*, float* x, float* y, float* z, int count);
+    void    Matrix_MulDirsStrided     (Matrix const*, void* out, void const* in, int count, int stride);
+    void    Matrix_MulPoints          (Matrix const*, Vec3f* out, Vec3f const* in, int count);
+    void    Matrix_MulPointsSoA       (Matrix const*, float* x, float* y, float* z, int count);
+    void    Matrix_MulPointsStrided   (Matrix const*, void* out, void const* in, int count, int stride);
     void    Matrix_GetForward         (Matrix const*, Vec3f* out);
     void    Matrix_GetRight           (Matrix const*, Vec3f* out);
     void    Matrix_GetUp              (Matrix const*, Vec3f* out);
@@ -42,6 +64,11 @@ do -- C Definitions
     Matrix* Matrix_FromPosRotScale    (Vec3f const*, Quat const*, float);
     Matrix* Matrix_FromPosBasis       (Vec3f const* pos, Vec3f const* x, Vec3f const* y, Vec3f const* z);
     Matrix* Matrix_FromQuat           (Quat const*);
+    void    Matrix_SetFromBasis       (Matrix* out, Vec3f const* x, Vec3f const* y, Vec3f const* z);
+    void    Matrix_SetFromPosRot      (Matrix* out, Vec3f const*, Quat const*);
+    void    Matrix_SetFromPosRotScale (Matrix* out, Vec3f const*, Quat const*, float);
+    void    Matrix_SetFromPosBasis    (Matrix* out, Vec3f const* pos, Vec3f const* x, Vec3f const* y, Vec3f const* z);
+    void    Matrix_SetFromQuat        (Matrix* out, Quat const*);
     void    Matrix_ToQuat             (Matrix const*, Quat* out);
     void    Matrix_Print              (Matrix const*);
     cstr    Matrix_ToString           (Matrix const*);
@@ -59,6 +86,11 @@ do -- Global Symbol Table
     Product            = libphx.Matrix_Product,
     Sum                = libphx.Matrix_Sum,
     Transpose          = libphx.Matrix_Transpose,
+    IOInverse          = libphx.Matrix_IOInverse,
+    IOInverseTranspose = libphx.Matrix_IOInverseTranspose,
+    IOProduct          = libphx.Matrix_IOProduct,
+    IOSum              = libphx.Matrix_IOSum,
+    IOTranspose        = libphx.Matrix_IOTranspose,
     IInverse           = libphx.Matrix_IInverse,
     IScale             = libphx.Matrix_IScale,
     ITranspose         = libphx.Matrix_ITranspose,
@@ -73,10 +105,27 @@ do -- Global Symbol Table
     SRT                = libphx.Matrix_SRT,
     Translation        = libphx.Matrix_Translation,
     YawPitchRoll       = libphx.Matrix_YawPitchRoll,
+    SetIdentity        = libphx.Matrix_SetIdentity,
+    SetLookAt          = libphx.Matrix_SetLookAt,
+    SetLookUp          = libphx.Matrix_SetLookUp,
+    SetPerspective     = libphx.Matrix_SetPerspective,
+    SetRotationX       = libphx.Matrix_SetRotationX,
+    SetRotationY       = libphx.Matrix_SetRotationY,
+    SetRotationZ       = libphx.Matrix_SetRotationZ,
+    SetScaling         = libphx.Matrix_SetScaling,
+    SetSRT             = libphx.Matrix_SetSRT,
+    SetTranslation     = libphx.Matrix_SetTranslation,
+    SetYawPitchRoll    = libphx.Matrix_SetYawPitchRoll,
     MulBox             = libphx.Matrix_MulBox,
     MulDir             = libphx.Matrix_MulDir,
     MulPoint           = libphx.Matrix_MulPoint,
     MulVec             = libphx.Matrix_MulVec,
+    MulDirs            = libphx.Matrix_MulDirs,
+    MulDirsSoA         = libphx.Matrix_MulDirsSoA,
+    MulDirsStrided     = libphx.Matrix_MulDirsStrided,
+    MulPoints          = libphx.Matrix_MulPoints,
+    MulPointsSoA       = libphx.Matrix_MulPointsSoA,
+    MulPointsStrided   = libphx.Matrix_MulPointsStrided,
     GetForward         = libphx.Matrix_GetForward,
     GetRight           = libphx.Matrix_GetRight,
     GetUp              = libphx.Matrix_GetUp,
@@ -87,6 +136,11 @@ do -- Global Symbol Table
     FromPosRotScale    = libphx.Matrix_FromPosRotScale,
     FromPosBasis       = libphx.Matrix_FromPosBasis,
     FromQuat           = libphx.Matrix_FromQuat,
+    SetFromBasis       = libphx.Matrix_SetFromBasis,
+    SetFromPosRot      = libphx.Matrix_SetFromPosRot,
+    SetFromPosRotScale = libphx.Matrix_SetFromPosRotScale,
+    SetFromPosBasis    = libphx.Matrix_SetFromPosBasis,
+    SetFromQuat        = libphx.Matrix_SetFromQuat,
     ToQuat             = libphx.Matrix_ToQuat,
     Print              = libphx.Matrix_Print,
     ToString           = libphx.Matrix_ToString,
@@ -116,18 +170,45 @@ do -- Metatype for class instances
       product            = libphx.Matrix_Product,
       sum                = libphx.Matrix_Sum,
       transpose          = libphx.Matrix_Transpose,
+      iOInverse          = libphx.Matrix_IOInverse,
+      iOInverseTranspose = libphx.Matrix_IOInverseTranspose,
+      iOProduct          = libphx.Matrix_IOProduct,
+      iOSum              = libphx.Matrix_IOSum,
+      iOTranspose        = libphx.Matrix_IOTranspose,
       iInverse           = libphx.Matrix_IInverse,
       iScale             = libphx.Matrix_IScale,
       iTranspose         = libphx.Matrix_ITranspose,
+      setIdentity        = libphx.Matrix_SetIdentity,
+      setLookAt          = libphx.Matrix_SetLookAt,
+      setLookUp          = libphx.Matrix_SetLookUp,
+      setPerspective     = libphx.Matrix_SetPerspective,
+      setRotationX       = libphx.Matrix_SetRotationX,
+      setRotationY       = libphx.Matrix_SetRotationY,
+      setRotationZ       = libphx.Matrix_SetRotationZ,
+      setScaling         = libphx.Matrix_SetScaling,
+      setSRT             = libphx.Matrix_SetSRT,
+      setTranslation     = libphx.Matrix_SetTranslation,
+      setYawPitchRoll    = libphx.Matrix_SetYawPitchRoll,
       mulBox             = libphx.Matrix_MulBox,
       mulDir             = libphx.Matrix_MulDir,
       mulPoint           = libphx.Matrix_MulPoint,
       mulVec             = libphx.Matrix_MulVec,
+      mulDirs            = libphx.Matrix_MulDirs,
+      mulDirsSoA         = libphx.Matrix_MulDirsSoA,
+      mulDirsStrided     = libphx.Matrix_MulDirsStrided,
+      mulPoints          = libphx.Matrix_MulPoints,
+      mulPointsSoA       = libphx.Matrix_MulPointsSoA,
+      mulPointsStrided   = libphx.Matrix_MulPointsStrided,
       getForward         = libphx.Matrix_GetForward,
       getRight           = libphx.Matrix_GetRight,
       getUp              = libphx.Matrix_GetUp,
       getPos             = libphx.Matrix_GetPos,
       getRow             = libphx.Matrix_GetRow,
+      setFromBasis       = libphx.Matrix_SetFromBasis,
+      setFromPosRot      = libphx.Matrix_SetFromPosRot,
+      setFromPosRotScale = libphx.Matrix_SetFromPosRotScale,
+      setFromPosBasis    = libphx.Matrix_SetFromPosBasis,
+      setFromQuat        = libphx.Matrix_SetFromQuat,
       toQuat             = libphx.Matrix_ToQuat,
       print              = libphx.Matrix_Print,
       toString           = libphx.Matrix_ToString,
@@ -0,0 +1,59 @@
+-- MemArena --------------------------------------------------------------------
+local ffi = require('ffi')
+local libphx = require('ffi.libphx').lib
+local MemArena
+
+do -- C Definitions
+  ffi.cdef [[
+    MemArena* MemArena_Create      (uint32 chunkSize);
+    void      MemArena_Free        (MemArena*);
+    void*     MemArena_Alloc       (MemArena*, uint32 size);
+    void      MemArena_Clear       (MemArena*);
+    uint64    MemArena_GetMarker   (MemArena*);
+    void      MemArena_Rewind      (MemArena*, uint64 marker);
+    void      MemArena_Trim        (MemArena*);
+    uint64    MemArena_GetCapacity (MemArena*);
+    uint64    MemArena_GetSize     (MemArena*);
+    MemArena* MemArena_GetScratch  ();
+  ]]
+end
+
+do -- Global Symbol Table
+  MemArena = {
+    Create      = libphx.MemArena_Create,
+    Free        = libphx.MemArena_Free,
+    Alloc       = libphx.MemArena_Alloc,
+    Clear       = libphx.MemArena_Clear,
+    GetMarker   = libphx.MemArena_GetMarker,
+    Rewind      = libphx.MemArena_Rewind,
+    Trim        = libphx.MemArena_Trim,
+    GetCapacity = libphx.MemArena_GetCapacity,
+    GetSize     = libphx.MemArena_GetSize,
+    GetScratch  = libphx.MemArena_GetScratch,
+  }
+
+  if onDef_MemArena then onDef_MemArena(MemArena, mt) end
+  MemArena = setmetatable(MemArena, mt)
+end
+
+do -- Metatype for class instances
+  local t  = ffi.typeof('MemArena')
+  local mt = {
+    __index = {
+      managed     = function (self) return ffi.gc(self, libphx.MemArena_Free) end,
+      free        = libphx.MemArena_Free,
+      alloc       = libphx.MemArena_Alloc,
+      clear       = libphx.MemArena_Clear,
+      getMarker   = libphx.MemArena_GetMarker,
+      rewind      = libphx.MemArena_Rewind,
+      trim        = libphx.MemArena_Trim,
+      getCapacity = libphx.MemArena_GetCapacity,
+      getSize     = libphx.MemArena_GetSize,
+    },
+  }
+
+  if onDef_MemArena_t then onDef_MemArena_t(t, mt) end
+  MemArena_t = ffi.metatype(t, mt)
+end
+
+return MemArena
@@ -0,0 +1,57 @@
+-- MemPoolMT -------------------------------------------------------------------
+local ffi = require('ffi')
+local libphx = require('ffi.libphx').lib
+local MemPoolMT
+
+do -- C Definitions
+  ffi.cdef [[
+    MemPoolMT* MemPoolMT_Create        (uint32 cellSize, uint32 alignment, bool zeroMemory);
+    void       MemPoolMT_Free          (MemPoolMT*);
+    void*      MemPoolMT_Alloc         (MemPoolMT*);
+    void       MemPoolMT_Dealloc       (MemPoolMT*, void*);
+    uint32     MemPoolMT_Trim          (MemPoolMT*);
+    uint32     MemPoolMT_GetBlockCount (MemPoolMT*);
+    uint32     MemPoolMT_GetCapacity   (MemPoolMT*);
+    uint32     MemPoolMT_GetCellSize   (MemPoolMT*);
+    uint32     MemPoolMT_GetSize       (MemPoolMT*);
+  ]]
+end
+
+do -- Global Symbol Table
+  MemPoolMT = {
+    Create        = libphx.MemPoolMT_Create,
+    Free          = libphx.MemPoolMT_Free,
+    Alloc         = libphx.MemPoolMT_Alloc,
+    Dealloc       = libphx.MemPoolMT_Dealloc,
+    Trim          = libphx.MemPoolMT_Trim,
+    GetBlockCount = libphx.MemPoolMT_GetBlockCount,
+    GetCapacity   = libphx.MemPoolMT_GetCapacity,
+    GetCellSize   = libphx.MemPoolMT_GetCellSize,
+    GetSize       = libphx.MemPoolMT_GetSize,
+  }
+
+  if onDef_MemPoolMT then onDef_MemPoolMT(MemPoolMT, mt) end
+  MemPoolMT = setmetatable(MemPoolMT, mt)
+end
+
+do -- Metatype for class instances
+  local t  = ffi.typeof('MemPoolMT')
+  local mt = {
+    __index = {
+      managed       = function (self) return ffi.gc(self, libphx.MemPoolMT_Free) end,
+      free          = libphx.MemPoolMT_Free,
+      alloc         = libphx.MemPoolMT_Alloc,
+      dealloc       = libphx.MemPoolMT_Dealloc,
+      trim          = libphx.MemPoolMT_Trim,
+      getBlockCount = libphx.MemPoolMT_GetBlockCount,
+      getCapacity   = libphx.MemPoolMT_GetCapacity,
+      getCellSize   = libphx.MemPoolMT_GetCellSize,
+      getSize       = libphx.MemPoolMT_GetSize,
+    },
+  }
+
+  if onDef_MemPoolMT_t then onDef_MemPoolMT_t(t, mt) end
+  MemPoolMT_t = ffi.metatype(t, mt)
+end
+
+return MemPoolMT
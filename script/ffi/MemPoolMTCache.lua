@@ -0,0 +1,45 @@
+-- MemPoolMTCache --------------------------------------------------------------
+local ffi = require('ffi')
+local libphx = require('ffi.libphx').lib
+local MemPoolMTCache
+
+do -- C Definitions
+  ffi.cdef [[
+    MemPoolMTCache* MemPoolMTCache_Create  (MemPoolMT*);
+    void            MemPoolMTCache_Free    (MemPoolMTCache*);
+    void*           MemPoolMTCache_Alloc   (MemPoolMTCache*);
+    void            MemPoolMTCache_Dealloc (MemPoolMTCache*, void*);
+    void            MemPoolMTCache_Flush   (MemPoolMTCache*);
+  ]]
+end
+
+do -- Global Symbol Table
+  MemPoolMTCache = {
+    Create  = libphx.MemPoolMTCache_Create,
+    Free    = libphx.MemPoolMTCache_Free,
+    Alloc   = libphx.MemPoolMTCache_Alloc,
+    Dealloc = libphx.MemPoolMTCache_Dealloc,
+    Flush   = libphx.MemPoolMTCache_Flush,
+  }
+
+  if onDef_MemPoolMTCache then onDef_MemPoolMTCache(MemPoolMTCache, mt) end
+  MemPoolMTCache = setmetatable(MemPoolMTCache, mt)
+end
+
+do -- Metatype for class instances
+  local t  = ffi.typeof('MemPoolMTCache')
+  local mt = {
+    __index = {
+      managed = function (self) return ffi.gc(self, libphx.MemPoolMTCache_Free) end,
+      free    = libphx.MemPoolMTCache_Free,
+      alloc   = libphx.MemPoolMTCache_Alloc,
+      dealloc = libphx.MemPoolMTCache_Dealloc,
+      flush   = libphx.MemPoolMTCache_Flush,
+    },
+  }
+
+  if onDef_MemPoolMTCache_t then onDef_MemPoolMTCache_t(t, mt) end
+  MemPoolMTCache_t = ffi.metatype(t, mt)
+end
+
+return MemPoolMTCache
@@ -0,0 +1,22 @@
+-- MemTag ----------------------------------------------------------------------
+local ffi = require('ffi')
+local libphx = require('ffi.libphx').lib
+local MemTag
+
+do -- Global Symbol Table
+  MemTag = {
+    All       = -1,
+    Default   = 0,
+    Collision = 1,
+    Gui       = 2,
+    Mesh      = 3,
+    Render    = 4,
+    User      = 8,
+    SIZE      = 16,
+  }
+
+  if onDef_MemTag then onDef_MemTag(MemTag, mt) end
+  MemTag = setmetatable(MemTag, mt)
+end
+
+return MemTag
@@ -5,23 +5,55 @@ local Memory
 
 do -- C Definitions
   ffi.cdef [[
-    void* Memory_Alloc   (size_t);
-    void* Memory_Calloc  (size_t n, size_t size);
-    void  Memory_Free    (void* ptr);
-    void  Memory_MemCopy (void* dst, void const* src, size_t size);
-    void  Memory_MemMove (void* dst, void const* src, size_t size);
-    void* Memory_Realloc (void* ptr, size_t newSize);
+    void*  Memory_Alloc             (size_t);
+    void*  Memory_Calloc            (size_t n, size_t size);
+    void   Memory_Free              (void* ptr);
+    void   Memory_MemCopy           (void* dst, void const* src, size_t size);
+    void   Memory_MemMove           (void* dst, void const* src, size_t size);
+    void*  Memory_Realloc           (void* ptr, size_t newSize);
+    bool   Memory_IsTracking        ();
+    void   Memory_PushTag           (MemTag);
+    void   Memory_PopTag            ();
+    MemTag Memory_GetTag            ();
+    cstr   Memory_GetTagName        (MemTag);
+    uint64 Memory_GetLiveBytes      (MemTag);
+    uint64 Memory_GetLiveCount      (MemTag);
+    uint64 Memory_GetPeakBytes      (MemTag);
+    uint32 Memory_GetFrameAllocs    (MemTag);
+    uint64 Memory_GetFrameBytes     (MemTag);
+    uint32 Memory_GetFrameFrees     (MemTag);
+    uint64 Memory_GetHistogram      (int bucket);
+    uint64 Memory_GetHistogramLimit (int bucket);
+    int    Memory_GetHistogramSize  ();
+    void   Memory_PrintReport       ();
+    void   Memory_ResetPeak         ();
   ]]
 end
 
 do -- Global Symbol Table
   Memory = {
-    Alloc   = libphx.Memory_Alloc,
-    Calloc  = libphx.Memory_Calloc,
-    Free    = libphx.Memory_Free,
-    MemCopy = libphx.Memory_MemCopy,
-    MemMove = libphx.Memory_MemMove,
-    Realloc = libphx.Memory_Realloc,
+    Alloc             = libphx.Memory_Alloc,
+    Calloc            = libphx.Memory_Calloc,
+    Free              = libphx.Memory_Free,
+    MemCopy           = libphx.Memory_MemCopy,
+    MemMove           = libphx.Memory_MemMove,
+    Realloc           = libphx.Memory_Realloc,
+    IsTracking        = libphx.Memory_IsTracking,
+    PushTag           = libphx.Memory_PushTag,
+    PopTag            = libphx.Memory_PopTag,
+    GetTag            = libphx.Memory_GetTag,
+    GetTagName        = libphx.Memory_GetTagName,
+    GetLiveBytes      = libphx.Memory_GetLiveBytes,
+    GetLiveCount      = libphx.Memory_GetLiveCount,
+    GetPeakBytes      = libphx.Memory_GetPeakBytes,
+    GetFrameAllocs    = libphx.Memory_GetFrameAllocs,
+    GetFrameBytes     = libphx.Memory_GetFrameBytes,
+    GetFrameFrees     = libphx.Memory_GetFrameFrees,
+    GetHistogram      = libphx.Memory_GetHistogram,
+    GetHistogramLimit = libphx.Memory_GetHistogramLimit,
+    GetHistogramSize  = libphx.Memory_GetHistogramSize,
+    PrintReport       = libphx.Memory_PrintReport,
+    ResetPeak         = libphx.Memory_ResetPeak,
   }
 
   if onDef_Memory then onDef_Memory(Memory, mt) end
@@ -5,56 +5,60 @@ local Mesh
 
 do -- C Definitions
   ffi.cdef [[
-    Mesh*   Mesh_Create            ();
-    void    Mesh_Acquire           (Mesh*);
-    void    Mesh_Free              (Mesh*);
-    Mesh*   Mesh_Load              (cstr name);
-    Mesh*   Mesh_Clone             (Mesh*);
-    Bytes*  Mesh_ToBytes           (Mesh*);
-    Mesh*   Mesh_FromBytes         (Bytes*);
-    Mesh*   Mesh_FromObj           (cstr);
-    Mesh*   Mesh_FromSDF           (SDF*);
-    void    Mesh_AddIndex          (Mesh*, int);
-    void    Mesh_AddMesh           (Mesh*, Mesh*);
-    void    Mesh_AddQuad           (Mesh*, int, int, int, int);
-    void    Mesh_AddTri            (Mesh*, int, int, int);
-    void    Mesh_AddVertex         (Mesh*, float px, float py, float pz, float nx, float ny, float nz, float u, float v);
-    void    Mesh_AddVertexRaw      (Mesh*, Vertex const*);
-    uint64  Mesh_GetVersion        (Mesh*);
-    void    Mesh_IncVersion        (Mesh*);
-    void    Mesh_GetBound          (Mesh*, Box3f* out);
-    void    Mesh_GetCenter         (Mesh*, Vec3f* out);
-    int     Mesh_GetIndexCount     (Mesh*);
-    int*    Mesh_GetIndexData      (Mesh*);
-    float   Mesh_GetRadius         (Mesh*);
-    Vertex* Mesh_GetVertex         (Mesh*, int);
-    int     Mesh_GetVertexCount    (Mesh*);
-    Vertex* Mesh_GetVertexData     (Mesh*);
-    void    Mesh_ReserveIndexData  (Mesh*, int capacity);
-    void    Mesh_ReserveVertexData (Mesh*, int capacity);
-    Error   Mesh_Validate          (Mesh*);
-    void    Mesh_Draw              (Mesh*);
-    void    Mesh_DrawBind          (Mesh*);
-    void    Mesh_DrawBound         (Mesh*);
-    void    Mesh_DrawUnbind        (Mesh*);
-    void    Mesh_DrawNormals       (Mesh*, float scale);
-    Mesh*   Mesh_Center            (Mesh*);
-    Mesh*   Mesh_Invert            (Mesh*);
-    Mesh*   Mesh_RotateX           (Mesh*, float rads);
-    Mesh*   Mesh_RotateY           (Mesh*, float rads);
-    Mesh*   Mesh_RotateZ           (Mesh*, float rads);
-    Mesh*   Mesh_RotateYPR         (Mesh*, float yaw, float pitch, float roll);
-    Mesh*   Mesh_Scale             (Mesh*, float x, float y, float z);
-    Mesh*   Mesh_ScaleUniform      (Mesh*, float);
-    Mesh*   Mesh_Transform         (Mesh*, Matrix*);
-    Mesh*   Mesh_Translate         (Mesh*, float x, float y, float z);
-    void    Mesh_ComputeAO         (Mesh*, float radius);
-    void    Mesh_ComputeOcclusion  (Mesh*, Tex3D* sdf, float radius);
-    void    Mesh_ComputeNormals    (Mesh*);
-    void    Mesh_SplitNormals      (Mesh*, float minDot);
-    Mesh*   Mesh_Box               (int res);
-    Mesh*   Mesh_BoxSphere         (int res);
-    Mesh*   Mesh_Plane             (Vec3f origin, Vec3f du, Vec3f dv, int resU, int resV);
+    Mesh*         Mesh_Create            ();
+    void          Mesh_Acquire           (Mesh*);
+    void          Mesh_Free              (Mesh*);
+    Mesh*         Mesh_Load              (cstr name);
+    Mesh*         Mesh_Clone             (Mesh*);
+    Bytes*        Mesh_ToBytes           (Mesh*);
+    Mesh*         Mesh_FromBytes         (Bytes*);
+    Mesh*         Mesh_FromObj           (cstr);
+    Mesh*         Mesh_FromSDF           (SDF*);
+    void          Mesh_AddIndex          (Mesh*, int);
+    void          Mesh_AddMesh           (Mesh*, Mesh*);
+    void          Mesh_AddQuad           (Mesh*, int, int, int, int);
+    void          Mesh_AddTri            (Mesh*, int, int, int);
+    void          Mesh_AddVertex         (Mesh*, float px, float py, float pz, float nx, float ny, float nz, float u, float v);
+    void          Mesh_AddVertexRaw      (Mesh*, Vertex const*);
+    uint64        Mesh_GetVersion        (Mesh*);
+    void          Mesh_IncVersion        (Mesh*);
+    void          Mesh_GetBound          (Mesh*, Box3f* out);
+    void          Mesh_GetCenter         (Mesh*, Vec3f* out);
+    int           Mesh_GetIndexCount     (Mesh*);
+    int*          Mesh_GetIndexData      (Mesh*);
+    float         Mesh_GetRadius         (Mesh*);
+    Vertex*       Mesh_GetVertex         (Mesh*, int);
+    int           Mesh_GetVertexCount    (Mesh*);
+    Vertex*       Mesh_GetVertexData     (Mesh*);
+    void          Mesh_ReserveIndexData  (Mesh*, int capacity);
+    void          Mesh_ReserveVertexData (Mesh*, int capacity);
+    void          Mesh_ResizeIndexData   (Mesh*, int size);
+    void          Mesh_ResizeVertexData  (Mesh*, int size);
+    Error         Mesh_Validate          (Mesh*);
+    void          Mesh_Draw              (Mesh*);
+    void          Mesh_DrawBind          (Mesh*);
+    void          Mesh_DrawBound         (Mesh*);
+    void          Mesh_DrawBoundRange    (Mesh*, int indexOffset, int indexCount);
+    void          Mesh_DrawUnbind        (Mesh*);
+    void          Mesh_DrawNormals       (Mesh*, float scale);
+    Mesh*         Mesh_Center            (Mesh*);
+    Mesh*         Mesh_Invert            (Mesh*);
+    Mesh*         Mesh_RotateX           (Mesh*, float rads);
+    Mesh*         Mesh_RotateY           (Mesh*, float rads);
+    Mesh*         Mesh_RotateZ           (Mesh*, float rads);
+    Mesh*         Mesh_RotateYPR         (Mesh*, float yaw, float pitch, float roll);
+    Mesh*         Mesh_Scale             (Mesh*, float x, float y, float z);
+    Mesh*         Mesh_ScaleUniform      (Mesh*, float);
+    Mesh*         Mesh_Transform         (Mesh*, Matrix*);
+    Mesh*         Mesh_Translate         (Mesh*, float x, float y, float z);
+    MeshClusters* Mesh_BuildClusters     (Mesh*, int maxVertices, int maxTriangles);
+    void          Mesh_ComputeAO         (Mesh*, float radius);
+    void          Mesh_ComputeOcclusion  (Mesh*, Tex3D* sdf, float radius);
+    void          Mesh_ComputeNormals    (Mesh*);
+    void          Mesh_SplitNormals      (Mesh*, float minDot);
+    Mesh*         Mesh_Box               (int res);
+    Mesh*         Mesh_BoxSphere         (int res);
+    Mesh*         Mesh_Plane             (Vec3f origin, Vec3f du, Vec3f dv, int resU, int resV);
   ]]
 end
 
@@ -87,10 +91,13 @@ do -- Global Symbol Table
     GetVertexData     = libphx.Mesh_GetVertexData,
     ReserveIndexData  = libphx.Mesh_ReserveIndexData,
     ReserveVertexData = libphx.Mesh_ReserveVertexData,
+    ResizeIndexData   = libphx.Mesh_ResizeIndexData,
+    ResizeVertexData  = libphx.Mesh_ResizeVertexData,
     Validate          = libphx.Mesh_Validate,
     Draw              = libphx.Mesh_Draw,
     DrawBind          = libphx.Mesh_DrawBind,
     DrawBound         = libphx.Mesh_DrawBound,
+    DrawBoundRange    = libphx.Mesh_DrawBoundRange,
     DrawUnbind        = libphx.Mesh_DrawUnbind,
     DrawNormals       = libphx.Mesh_DrawNormals,
     Center            = libphx.Mesh_Center,
@@ -103,6 +110,7 @@ do -- Global Symbol Table
     ScaleUniform      = libphx.Mesh_ScaleUniform,
     Transform         = libphx.Mesh_Transform,
     Translate         = libphx.Mesh_Translate,
+    BuildClusters     = libphx.Mesh_BuildClusters,
     ComputeAO         = libphx.Mesh_ComputeAO,
     ComputeOcclusion  = libphx.Mesh_ComputeOcclusion,
     ComputeNormals    = libphx.Mesh_ComputeNormals,
@@ -143,10 +151,13 @@ do -- Metatype for class instances
       getVertexData     = libphx.Mesh_GetVertexData,
       reserveIndexData  = libphx.Mesh_ReserveIndexData,
       reserveVertexData = libphx.Mesh_ReserveVertexData,
+      resizeIndexData   = libphx.Mesh_ResizeIndexData,
+      resizeVertexData  = libphx.Mesh_ResizeVertexData,
       validate          = libphx.Mesh_Validate,
       draw              = libphx.Mesh_Draw,
       drawBind          = libphx.Mesh_DrawBind,
       drawBound         = libphx.Mesh_DrawBound,
+      drawBoundRange    = libphx.Mesh_DrawBoundRange,
       drawUnbind        = libphx.Mesh_DrawUnbind,
       drawNormals       = libphx.Mesh_DrawNormals,
       center            = libphx.Mesh_Center,
@@ -159,6 +170,7 @@ do -- Metatype for class instances
       scaleUniform      = libphx.Mesh_ScaleUniform,
       transform         = libphx.Mesh_Transform,
       translate         = libphx.Mesh_Translate,
+      buildClusters     = libphx.Mesh_BuildClusters,
       computeAO         = libphx.Mesh_ComputeAO,
       computeOcclusion  = libphx.Mesh_ComputeOcclusion,
       computeNormals    = libphx.Mesh_ComputeNormals,
@@ -0,0 +1,30 @@
+-- MeshCluster -----------------------------------------------------------------
+local ffi = require('ffi')
+local libphx = require('ffi.libphx').lib
+local MeshCluster
+
+do -- Global Symbol Table
+  MeshCluster = {
+  }
+
+  local mt = {
+    __call  = function (t, ...) return MeshCluster_t(...) end,
+  }
+
+  if onDef_MeshCluster then onDef_MeshCluster(MeshCluster, mt) end
+  MeshCluster = setmetatable(MeshCluster, mt)
+end
+
+do -- Metatype for class instances
+  local t  = ffi.typeof('MeshCluster')
+  local mt = {
+    __index = {
+      clone = function (x) return MeshCluster_t(x) end,
+    },
+  }
+
+  if onDef_MeshCluster_t then onDef_MeshCluster_t(t, mt) end
+  MeshCluster_t = ffi.metatype(t, mt)
+end
+
+return MeshCluster
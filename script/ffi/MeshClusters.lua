@@ -0,0 +1,55 @@
+-- MeshClusters ----------------------------------------------------------------
+local ffi = require('ffi')
+local libphx = require('ffi.libphx').lib
+local MeshClusters
+
+do -- C Definitions
+  ffi.cdef [[
+    void   MeshClusters_Free             (MeshClusters*);
+    int    MeshClusters_Cull             (MeshClusters*, Plane const* planes, int planeCount, Vec3f const* eye, int32* visible, int* triangles);
+    void   MeshClusters_Get              (MeshClusters*, int index, MeshCluster* out);
+    int    MeshClusters_GetCount         (MeshClusters*);
+    int    MeshClusters_GetTriangleCount (MeshClusters*);
+    uint8* MeshClusters_GetTriangleData  (MeshClusters*);
+    int    MeshClusters_GetVertexCount   (MeshClusters*);
+    int32* MeshClusters_GetVertexData    (MeshClusters*);
+  ]]
+end
+
+do -- Global Symbol Table
+  MeshClusters = {
+    Free             = libphx.MeshClusters_Free,
+    Cull             = libphx.MeshClusters_Cull,
+    Get              = libphx.MeshClusters_Get,
+    GetCount         = libphx.MeshClusters_GetCount,
+    GetTriangleCount = libphx.MeshClusters_GetTriangleCount,
+    GetTriangleData  = libphx.MeshClusters_GetTriangleData,
+    GetVertexCount   = libphx.MeshClusters_GetVertexCount,
+    GetVertexData    = libphx.MeshClusters_GetVertexData,
+  }
+
+  if onDef_MeshClusters then onDef_MeshClusters(MeshClusters, mt) end
+  MeshClusters = setmetatable(MeshClusters, mt)
+end
+
+do -- Metatype for class instances
+  local t  = ffi.typeof('MeshClusters')
+  local mt = {
+    __index = {
+      managed          = function (self) return ffi.gc(self, libphx.MeshClusters_Free) end,
+      free             = libphx.MeshClusters_Free,
+      cull             = libphx.MeshClusters_Cull,
+      get              = libphx.MeshClusters_Get,
+      getCount         = libphx.MeshClusters_GetCount,
+      getTriangleCount = libphx.MeshClusters_GetTriangleCount,
+      getTriangleData  = libphx.MeshClusters_GetTriangleData,
+      getVertexCount   = libphx.MeshClusters_GetVertexCount,
+      getVertexData    = libphx.MeshClusters_GetVertexData,
+    },
+  }
+
+  if onDef_MeshClusters_t then onDef_MeshClusters_t(t, mt) end
+  MeshClusters_t = ffi.metatype(t, mt)
+end
+
+return MeshClusters
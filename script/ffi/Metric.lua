@@ -5,8 +5,19 @@ local Metric
 
 do -- C Definitions
   ffi.cdef [[
-    int32 Metric_Get     (Metric);
-    cstr  Metric_GetName (Metric);
+    int32  Metric_Get        (Metric);
+    cstr   Metric_GetName    (Metric);
+    int32  Metric_GetCount   ();
+    Metric Metric_Find       (cstr name);
+    Metric Metric_Register   (cstr name, bool gauge);
+    bool   Metric_IsGauge    (Metric);
+    void   Metric_Add        (Metric, int32 delta);
+    void   Metric_Set        (Metric, int32 value);
+    int32  Metric_GetLast    (Metric);
+    int32  Metric_GetMin     (Metric);
+    double Metric_GetAvg     (Metric);
+    int32  Metric_GetMax     (Metric);
+    int    Metric_GetHistory (Metric, int32* out, int count);
   ]]
 end
 
@@ -20,9 +31,25 @@ do -- Global Symbol Table
     VertsDrawn = 0x5,
     Flush      = 0x6,
     FBOSwap    = 0x7,
-    SIZE       = 0x7,
-    Get     = libphx.Metric_Get,
-    GetName = libphx.Metric_GetName,
+    BSPNodes   = 0x8,
+    GridCells  = 0x9,
+    RayCasts   = 0xA,
+    Allocs     = 0xB,
+    LuaGCSteps = 0xC,
+    SIZE       = 0xC,
+    Get        = libphx.Metric_Get,
+    GetName    = libphx.Metric_GetName,
+    GetCount   = libphx.Metric_GetCount,
+    Find       = libphx.Metric_Find,
+    Register   = libphx.Metric_Register,
+    IsGauge    = libphx.Metric_IsGauge,
+    Add        = libphx.Metric_Add,
+    Set        = libphx.Metric_Set,
+    GetLast    = libphx.Metric_GetLast,
+    GetMin     = libphx.Metric_GetMin,
+    GetAvg     = libphx.Metric_GetAvg,
+    GetMax     = libphx.Metric_GetMax,
+    GetHistory = libphx.Metric_GetHistory,
   }
 
   if onDef_Metric then onDef_Metric(Metric, mt) end
@@ -8,6 +8,7 @@ do -- C Definitions
     cstr OS_GetClipboard   ();
     int  OS_GetCPUCount    ();
     cstr OS_GetVideoDriver ();
+    bool OS_HasAVX         ();
     void OS_SetClipboard   (cstr text);
   ]]
 end
@@ -17,6 +18,7 @@ do -- Global Symbol Table
     GetClipboard   = libphx.OS_GetClipboard,
     GetCPUCount    = libphx.OS_GetCPUCount,
     GetVideoDriver = libphx.OS_GetVideoDriver,
+    HasAVX         = libphx.OS_HasAVX,
     SetClipboard   = libphx.OS_SetClipboard,
   }
 
@@ -5,25 +5,53 @@ local Profiler
 
 do -- C Definitions
   ffi.cdef [[
-    void Profiler_Enable     ();
-    void Profiler_Disable    ();
-    void Profiler_Begin      (cstr);
-    void Profiler_End        ();
-    void Profiler_SetValue   (cstr, int);
-    void Profiler_LoopMarker ();
-    void Profiler_Backtrace  ();
+    void   Profiler_Enable             ();
+    void   Profiler_Disable            ();
+    void   Profiler_Begin              (cstr);
+    void   Profiler_End                ();
+    void   Profiler_SetValue           (cstr, int);
+    void   Profiler_SetThreadName      (cstr);
+    void   Profiler_AddSample          (cstr, double seconds);
+    void   Profiler_LoopMarker         ();
+    int    Profiler_GetThreadCount     ();
+    cstr   Profiler_GetThreadName      (int thread);
+    bool   Profiler_GetScopeStats      (cstr scope, int thread, ProfilerStats*);
+    double Profiler_GetScopePercentile (cstr scope, int thread, double p);
+    void   Profiler_SetScopeBudget     (cstr scope, double seconds);
+    void   Profiler_SetFrameBudget     (double seconds);
+    bool   Profiler_GetFrameStats      (ProfilerStats*);
+    int    Profiler_GetFrameHistory    (double* out, int count);
+    void   Profiler_SetTraceWindow     (double seconds);
+    void   Profiler_FlushTrace         ();
+    bool   Profiler_DumpTrace          (cstr path);
+    bool   Profiler_ConvertTrace       (cstr src, cstr dst);
+    void   Profiler_Backtrace          ();
   ]]
 end
 
 do -- Global Symbol Table
   Profiler = {
-    Enable     = libphx.Profiler_Enable,
-    Disable    = libphx.Profiler_Disable,
-    Begin      = libphx.Profiler_Begin,
-    End        = libphx.Profiler_End,
-    SetValue   = libphx.Profiler_SetValue,
-    LoopMarker = libphx.Profiler_LoopMarker,
-    Backtrace  = libphx.Profiler_Backtrace,
+    Enable             = libphx.Profiler_Enable,
+    Disable            = libphx.Profiler_Disable,
+    Begin              = libphx.Profiler_Begin,
+    End                = libphx.Profiler_End,
+    SetValue           = libphx.Profiler_SetValue,
+    SetThreadName      = libphx.Profiler_SetThreadName,
+    AddSample          = libphx.Profiler_AddSample,
+    LoopMarker         = libphx.Profiler_LoopMarker,
+    GetThreadCount     = libphx.Profiler_GetThreadCount,
+    GetThreadName      = libphx.Profiler_GetThreadName,
+    GetScopeStats      = libphx.Profiler_GetScopeStats,
+    GetScopePercentile = libphx.Profiler_GetScopePercentile,
+    SetScopeBudget     = libphx.Profiler_SetScopeBudget,
+    SetFrameBudget     = libphx.Profiler_SetFrameBudget,
+    GetFrameStats      = libphx.Profiler_GetFrameStats,
+    GetFrameHistory    = libphx.Profiler_GetFrameHistory,
+    SetTraceWindow     = libphx.Profiler_SetTraceWindow,
+    FlushTrace         = libphx.Profiler_FlushTrace,
+    DumpTrace          = libphx.Profiler_DumpTrace,
+    ConvertTrace       = libphx.Profiler_ConvertTrace,
+    Backtrace          = libphx.Profiler_Backtrace,
   }
 
   if onDef_Profiler then onDef_Profiler(Profiler, mt) end
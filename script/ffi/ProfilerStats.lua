@@ -0,0 +1,30 @@
+-- ProfilerStats ---------------------------------------------------------------
+local ffi = require('ffi')
+local libphx = require('ffi.libphx').lib
+local ProfilerStats
+
+do -- Global Symbol Table
+  ProfilerStats = {
+  }
+
+  local mt = {
+    __call  = function (t, ...) return ProfilerStats_t(...) end,
+  }
+
+  if onDef_ProfilerStats then onDef_ProfilerStats(ProfilerStats, mt) end
+  ProfilerStats = setmetatable(ProfilerStats, mt)
+end
+
+do -- Metatype for class instances
+  local t  = ffi.typeof('ProfilerStats')
+  local mt = {
+    __index = {
+      clone = function (x) return ProfilerStats_t(x) end,
+    },
+  }
+
+  if onDef_ProfilerStats_t then onDef_ProfilerStats_t(t, mt) end
+  ProfilerStats_t = ffi.metatype(t, mt)
+end
+
+return ProfilerStats
@@ -27,6 +27,8 @@ do -- C Definitions
     void  Quat_MulV               (Quat const*, Vec3f const*, Vec3f* out);
     void  Quat_Normalize          (Quat const*, Quat* out);
     void  Quat_INormalize         (Quat*);
+    void  Quat_RotateVectors      (Quat const*, Vec3f* out, Vec3f const* in, int count);
+    void  Quat_RotateVectorsSoA   (Quat const*, float* x, float* y, float* z, int count);
     void  Quat_Scale              (Quat const*, float, Quat* out);
     void  Quat_IScale             (Quat*, float);
     void  Quat_Slerp              (Quat const*, Quat const*, float, Quat* out);
@@ -64,6 +66,8 @@ do -- Global Symbol Table
     MulV               = libphx.Quat_MulV,
     Normalize          = libphx.Quat_Normalize,
     INormalize         = libphx.Quat_INormalize,
+    RotateVectors      = libphx.Quat_RotateVectors,
+    RotateVectorsSoA   = libphx.Quat_RotateVectorsSoA,
     Scale              = libphx.Quat_Scale,
     IScale             = libphx.Quat_IScale,
     Slerp              = libphx.Quat_Slerp,
@@ -111,6 +115,8 @@ do -- Metatype for class instances
       mulV               = libphx.Quat_MulV,
       normalize          = libphx.Quat_Normalize,
       iNormalize         = libphx.Quat_INormalize,
+      rotateVectors      = libphx.Quat_RotateVectors,
+      rotateVectorsSoA   = libphx.Quat_RotateVectorsSoA,
       scale              = libphx.Quat_Scale,
       iScale             = libphx.Quat_IScale,
       slerp              = libphx.Quat_Slerp,
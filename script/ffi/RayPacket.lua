@@ -0,0 +1,30 @@
+-- RayPacket -------------------------------------------------------------------
+local ffi = require('ffi')
+local libphx = require('ffi.libphx').lib
+local RayPacket
+
+do -- Global Symbol Table
+  RayPacket = {
+  }
+
+  local mt = {
+    __call  = function (t, ...) return RayPacket_t(...) end,
+  }
+
+  if onDef_RayPacket then onDef_RayPacket(RayPacket, mt) end
+  RayPacket = setmetatable(RayPacket, mt)
+end
+
+do -- Metatype for class instances
+  local t  = ffi.typeof('RayPacket')
+  local mt = {
+    __index = {
+      clone = function (x) return RayPacket_t(x) end,
+    },
+  }
+
+  if onDef_RayPacket_t then onDef_RayPacket_t(t, mt) end
+  RayPacket_t = ffi.metatype(t, mt)
+end
+
+return RayPacket
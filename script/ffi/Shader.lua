@@ -27,6 +27,17 @@ do -- C Definitions
     void         Shader_SetTex2D      (cstr, Tex2D*);
     void         Shader_SetTex3D      (cstr, Tex3D*);
     void         Shader_SetTexCube    (cstr, TexCube*);
+    void         Shader_SetFloatId    (uint32, float);
+    void         Shader_SetFloat2Id   (uint32, float, float);
+    void         Shader_SetFloat3Id   (uint32, float, float, float);
+    void         Shader_SetFloat4Id   (uint32, float, float, float, float);
+    void         Shader_SetIntId      (uint32, int);
+    void         Shader_SetMatrixId   (uint32, Matrix*);
+    void         Shader_SetMatrixTId  (uint32, Matrix*);
+    void         Shader_SetTex1DId    (uint32, Tex1D*);
+    void         Shader_SetTex2DId    (uint32, Tex2D*);
+    void         Shader_SetTex3DId    (uint32, Tex3D*);
+    void         Shader_SetTexCubeId  (uint32, TexCube*);
     void         Shader_ISetFloat     (int, float);
     void         Shader_ISetFloat2    (int, float, float);
     void         Shader_ISetFloat3    (int, float, float, float);
@@ -65,6 +76,17 @@ do -- Global Symbol Table
     SetTex2D      = libphx.Shader_SetTex2D,
     SetTex3D      = libphx.Shader_SetTex3D,
     SetTexCube    = libphx.Shader_SetTexCube,
+    SetFloatId    = libphx.Shader_SetFloatId,
+    SetFloat2Id   = libphx.Shader_SetFloat2Id,
+    SetFloat3Id   = libphx.Shader_SetFloat3Id,
+    SetFloat4Id   = libphx.Shader_SetFloat4Id,
+    SetIntId      = libphx.Shader_SetIntId,
+    SetMatrixId   = libphx.Shader_SetMatrixId,
+    SetMatrixTId  = libphx.Shader_SetMatrixTId,
+    SetTex1DId    = libphx.Shader_SetTex1DId,
+    SetTex2DId    = libphx.Shader_SetTex2DId,
+    SetTex3DId    = libphx.Shader_SetTex3DId,
+    SetTexCubeId  = libphx.Shader_SetTexCubeId,
     ISetFloat     = libphx.Shader_ISetFloat,
     ISetFloat2    = libphx.Shader_ISetFloat2,
     ISetFloat3    = libphx.Shader_ISetFloat3,
@@ -5,35 +5,59 @@ local ShaderVar
 
 do -- C Definitions
   ffi.cdef [[
-    void* ShaderVar_Get         (cstr, ShaderVarType);
-    void  ShaderVar_PushFloat   (cstr, float);
-    void  ShaderVar_PushFloat2  (cstr, float, float);
-    void  ShaderVar_PushFloat3  (cstr, float, float, float);
-    void  ShaderVar_PushFloat4  (cstr, float, float, float, float);
-    void  ShaderVar_PushInt     (cstr, int);
-    void  ShaderVar_PushMatrix  (cstr, Matrix*);
-    void  ShaderVar_PushTex1D   (cstr, Tex1D*);
-    void  ShaderVar_PushTex2D   (cstr, Tex2D*);
-    void  ShaderVar_PushTex3D   (cstr, Tex3D*);
-    void  ShaderVar_PushTexCube (cstr, TexCube*);
-    void  ShaderVar_Pop         (cstr);
+    void* ShaderVar_Get           (cstr, ShaderVarType);
+    void  ShaderVar_PushFloat     (cstr, float);
+    void  ShaderVar_PushFloat2    (cstr, float, float);
+    void  ShaderVar_PushFloat3    (cstr, float, float, float);
+    void  ShaderVar_PushFloat4    (cstr, float, float, float, float);
+    void  ShaderVar_PushInt       (cstr, int);
+    void  ShaderVar_PushMatrix    (cstr, Matrix*);
+    void  ShaderVar_PushTex1D     (cstr, Tex1D*);
+    void  ShaderVar_PushTex2D     (cstr, Tex2D*);
+    void  ShaderVar_PushTex3D     (cstr, Tex3D*);
+    void  ShaderVar_PushTexCube   (cstr, TexCube*);
+    void  ShaderVar_Pop           (cstr);
+    void* ShaderVar_GetId         (uint32, ShaderVarType);
+    void  ShaderVar_PushFloatId   (uint32, float);
+    void  ShaderVar_PushFloat2Id  (uint32, float, float);
+    void  ShaderVar_PushFloat3Id  (uint32, float, float, float);
+    void  ShaderVar_PushFloat4Id  (uint32, float, float, float, float);
+    void  ShaderVar_PushIntId     (uint32, int);
+    void  ShaderVar_PushMatrixId  (uint32, Matrix*);
+    void  ShaderVar_PushTex1DId   (uint32, Tex1D*);
+    void  ShaderVar_PushTex2DId   (uint32, Tex2D*);
+    void  ShaderVar_PushTex3DId   (uint32, Tex3D*);
+    void  ShaderVar_PushTexCubeId (uint32, TexCube*);
+    void  ShaderVar_PopId         (uint32);
   ]]
 end
 
 do -- Global Symbol Table
   ShaderVar = {
-    Get         = libphx.ShaderVar_Get,
-    PushFloat   = libphx.ShaderVar_PushFloat,
-    PushFloat2  = libphx.ShaderVar_PushFloat2,
-    PushFloat3  = libphx.ShaderVar_PushFloat3,
-    PushFloat4  = libphx.ShaderVar_PushFloat4,
-    PushInt     = libphx.ShaderVar_PushInt,
-    PushMatrix  = libphx.ShaderVar_PushMatrix,
-    PushTex1D   = libphx.ShaderVar_PushTex1D,
-    PushTex2D   = libphx.ShaderVar_PushTex2D,
-    PushTex3D   = libphx.ShaderVar_PushTex3D,
-    PushTexCube = libphx.ShaderVar_PushTexCube,
-    Pop         = libphx.ShaderVar_Pop,
+    Get           = libphx.ShaderVar_Get,
+    PushFloat     = libphx.ShaderVar_PushFloat,
+    PushFloat2    = libphx.ShaderVar_PushFloat2,
+    PushFloat3    = libphx.ShaderVar_PushFloat3,
+    PushFloat4    = libphx.ShaderVar_PushFloat4,
+    PushInt       = libphx.ShaderVar_PushInt,
+    PushMatrix    = libphx.ShaderVar_PushMatrix,
+    PushTex1D     = libphx.ShaderVar_PushTex1D,
+    PushTex2D     = libphx.ShaderVar_PushTex2D,
+    PushTex3D     = libphx.ShaderVar_PushTex3D,
+    PushTexCube   = libphx.ShaderVar_PushTexCube,
+    Pop           = libphx.ShaderVar_Pop,
+    GetId         = libphx.ShaderVar_GetId,
+    PushFloatId   = libphx.ShaderVar_PushFloatId,
+    PushFloat2Id  = libphx.ShaderVar_PushFloat2Id,
+    PushFloat3Id  = libphx.ShaderVar_PushFloat3Id,
+    PushFloat4Id  = libphx.ShaderVar_PushFloat4Id,
+    PushIntId     = libphx.ShaderVar_PushIntId,
+    PushMatrixId  = libphx.ShaderVar_PushMatrixId,
+    PushTex1DId   = libphx.ShaderVar_PushTex1DId,
+    PushTex2DId   = libphx.ShaderVar_PushTex2DId,
+    PushTex3DId   = libphx.ShaderVar_PushTex3DId,
+    PushTexCubeId = libphx.ShaderVar_PushTexCubeId,
+    PopId         = libphx.ShaderVar_PopId,
   }
 
   if onDef_ShaderVar then onDef_ShaderVar(ShaderVar, mt) end
@@ -0,0 +1,29 @@
+-- Str -------------------------------------------------------------------------
+local ffi = require('ffi')
+local libphx = require('ffi.libphx').lib
+local Str
+
+do -- C Definitions
+  ffi.cdef [[
+    cstr   Str_Intern         (cstr);
+    uint32 Str_InternId       (cstr);
+    uint32 Str_GetInternCount ();
+    uint32 Str_GetInternId    (cstr interned);
+    cstr   Str_GetInterned    (uint32 id);
+  ]]
+end
+
+do -- Global Symbol Table
+  Str = {
+    Intern         = libphx.Str_Intern,
+    InternId       = libphx.Str_InternId,
+    GetInternCount = libphx.Str_GetInternCount,
+    GetInternId    = libphx.Str_GetInternId,
+    GetInterned    = libphx.Str_GetInterned,
+  }
+
+  if onDef_Str then onDef_Str(Str, mt) end
+  Str = setmetatable(Str, mt)
+end
+
+return Str
@@ -0,0 +1,30 @@
+-- TrianglePack ----------------------------------------------------------------
+local ffi = require('ffi')
+local libphx = require('ffi.libphx').lib
+local TrianglePack
+
+do -- Global Symbol Table
+  TrianglePack = {
+  }
+
+  local mt = {
+    __call  = function (t, ...) return TrianglePack_t(...) end,
+  }
+
+  if onDef_TrianglePack then onDef_TrianglePack(TrianglePack, mt) end
+  TrianglePack = setmetatable(TrianglePack, mt)
+end
+
+do -- Metatype for class instances
+  local t  = ffi.typeof('TrianglePack')
+  local mt = {
+    __index = {
+      clone = function (x) return TrianglePack_t(x) end,
+    },
+  }
+
+  if onDef_TrianglePack_t then onDef_TrianglePack_t(t, mt) end
+  TrianglePack_t = ffi.metatype(t, mt)
+end
+
+return TrianglePack
@@ -27,6 +27,7 @@ do -- Basic Typedefs
     typedef int32          DataFormat;
     typedef int32          DeviceType;
     typedef uint32         Error;
+    typedef int32          MemTag;
     typedef int32          Metric;
     typedef int32          Modifier;
     typedef int32          PixelFormat;
@@ -62,46 +63,50 @@ end
 
 do -- Opaque Structs
   ffi.cdef [[
-    typedef struct BSP          {} BSP;
-    typedef struct BoxMesh      {} BoxMesh;
-    typedef struct BoxTree      {} BoxTree;
-    typedef struct Bytes        {} Bytes;
-    typedef struct Directory    {} Directory;
-    typedef struct File         {} File;
-    typedef struct Font         {} Font;
-    typedef struct HashGrid     {} HashGrid;
-    typedef struct HashGridElem {} HashGridElem;
-    typedef struct HashMap      {} HashMap;
-    typedef struct InputBinding {} InputBinding;
-    typedef struct KDTree       {} KDTree;
-    typedef struct LodMesh      {} LodMesh;
-    typedef struct MemPool      {} MemPool;
-    typedef struct MemStack     {} MemStack;
-    typedef struct Mesh         {} Mesh;
-    typedef struct MidiDevice   {} MidiDevice;
-    typedef struct Octree       {} Octree;
-    typedef struct Physics      {} Physics;
-    typedef struct RNG          {} RNG;
-    typedef struct RigidBody    {} RigidBody;
-    typedef struct RmGui        {} RmGui;
-    typedef struct SDF          {} SDF;
-    typedef struct Shader       {} Shader;
-    typedef struct ShaderState  {} ShaderState;
-    typedef struct Socket       {} Socket;
-    typedef struct Sound        {} Sound;
-    typedef struct SoundDesc    {} SoundDesc;
-    typedef struct StrBuffer    {} StrBuffer;
-    typedef struct StrMap       {} StrMap;
-    typedef struct StrMapIter   {} StrMapIter;
-    typedef struct Tex1D        {} Tex1D;
-    typedef struct Tex2D        {} Tex2D;
-    typedef struct Tex3D        {} Tex3D;
-    typedef struct TexCube      {} TexCube;
-    typedef struct Thread       {} Thread;
-    typedef struct ThreadPool   {} ThreadPool;
-    typedef struct Timer        {} Timer;
-    typedef struct Trigger      {} Trigger;
-    typedef struct Window       {} Window;
+    typedef struct BSP            {} BSP;
+    typedef struct BoxMesh        {} BoxMesh;
+    typedef struct BoxTree        {} BoxTree;
+    typedef struct Bytes          {} Bytes;
+    typedef struct Directory      {} Directory;
+    typedef struct File           {} File;
+    typedef struct Font           {} Font;
+    typedef struct HashGrid       {} HashGrid;
+    typedef struct HashGridElem   {} HashGridElem;
+    typedef struct HashMap        {} HashMap;
+    typedef struct InputBinding   {} InputBinding;
+    typedef struct KDTree         {} KDTree;
+    typedef struct LodMesh        {} LodMesh;
+    typedef struct MemArena       {} MemArena;
+    typedef struct MemPool        {} MemPool;
+    typedef struct MemPoolMT      {} MemPoolMT;
+    typedef struct MemPoolMTCache {} MemPoolMTCache;
+    typedef struct MemStack       {} MemStack;
+    typedef struct Mesh           {} Mesh;
+    typedef struct MeshClusters   {} MeshClusters;
+    typedef struct MidiDevice     {} MidiDevice;
+    typedef struct Octree         {} Octree;
+    typedef struct Physics        {} Physics;
+    typedef struct RNG            {} RNG;
+    typedef struct RigidBody      {} RigidBody;
+    typedef struct RmGui          {} RmGui;
+    typedef struct SDF            {} SDF;
+    typedef struct Shader         {} Shader;
+    typedef struct ShaderState    {} ShaderState;
+    typedef struct Socket         {} Socket;
+    typedef struct Sound          {} Sound;
+    typedef struct SoundDesc      {} SoundDesc;
+    typedef struct StrBuffer      {} StrBuffer;
+    typedef struct StrMap         {} StrMap;
+    typedef struct StrMapIter     {} StrMapIter;
+    typedef struct Tex1D          {} Tex1D;
+    typedef struct Tex2D          {} Tex2D;
+    typedef struct Tex3D          {} Tex3D;
+    typedef struct TexCube        {} TexCube;
+    typedef struct Thread         {} Thread;
+    typedef struct ThreadPool     {} ThreadPool;
+    typedef struct Timer          {} Timer;
+    typedef struct Trigger        {} Trigger;
+    typedef struct Window         {} Window;
   ]]
 
   libphx.Opaques = {
@@ -118,9 +123,13 @@ do -- Opaque Structs
     'InputBinding',
     'KDTree',
     'LodMesh',
+    'MemArena',
     'MemPool',
+    'MemPoolMT',
+    'MemPoolMTCache',
     'MemStack',
     'Mesh',
+    'MeshClusters',
     'MidiDevice',
     'Octree',
     'Physics',
@@ -182,6 +191,15 @@ do -- Transparent Structs
       int upperz;
     } Box3i;
 
+    typedef struct BoxPack {
+      float lowerx[8];
+      float lowery[8];
+      float lowerz[8];
+      float upperx[8];
+      float uppery[8];
+      float upperz[8];
+    } BoxPack;
+
     typedef struct Collision {
       int        index;
       int        count;
@@ -194,6 +212,13 @@ do -- Transparent Structs
       uint32     id;
     } Device;
 
+    typedef struct HashXX64State {
+      uint64 v[4];
+      uint64 total;
+      uint8  buffer[32];
+      uint32 bufferSize;
+    } HashXX64State;
+
     typedef struct InputEvent {
       uint32     timestamp;
       DeviceType devicetype;
@@ -225,6 +250,24 @@ do -- Transparent Structs
       float m[16];
     } Matrix;
 
+    typedef struct MeshCluster {
+      float centerx;
+      float centery;
+      float centerz;
+      float radius;
+      float coneApexx;
+      float coneApexy;
+      float coneApexz;
+      float coneAxisx;
+      float coneAxisy;
+      float coneAxisz;
+      float coneCutoff;
+      int32 vertexOffset;
+      int32 vertexCount;
+      int32 triangleOffset;
+      int32 triangleCount;
+    } MeshCluster;
+
     typedef struct Plane {
       float nx;
       float ny;
@@ -238,6 +281,21 @@ do -- Transparent Structs
       struct Vec3f* vertices_data;
     } Polygon;
 
+    typedef struct ProfilerStats {
+      double total;
+      double count;
+      double mean;
+      double stddev;
+      double min;
+      double max;
+      double p50;
+      double p90;
+      double p99;
+      double p999;
+      double budget;
+      double overBudget;
+    } ProfilerStats;
+
     typedef struct Quat {
       float x;
       float y;
@@ -267,6 +325,17 @@ do -- Transparent Structs
       float      t;
     } RayCastResult;
 
+    typedef struct RayPacket {
+      float px[8];
+      float py[8];
+      float pz[8];
+      float rdx[8];
+      float rdy[8];
+      float rdz[8];
+      float tMin[8];
+      float tMax[8];
+    } RayPacket;
+
     typedef struct ShapeCastResult {
       int32       hits_size;
       int32       hits_capacity;
@@ -301,6 +370,18 @@ do -- Transparent Structs
       Vec3f vertices[3];
     } Triangle;
 
+    typedef struct TrianglePack {
+      float v0x[8];
+      float v0y[8];
+      float v0z[8];
+      float e1x[8];
+      float e1y[8];
+      float e1z[8];
+      float e2x[8];
+      float e2y[8];
+      float e2z[8];
+    } TrianglePack;
+
     typedef struct TriangleTest {
       struct Triangle* triangle;
       bool             hit;
@@ -371,22 +452,28 @@ do -- Transparent Structs
     'Box3d',
     'Box3f',
     'Box3i',
+    'BoxPack',
     'Collision',
     'Device',
+    'HashXX64State',
     'InputEvent',
     'IntersectSphereProfiling',
     'LineSegment',
     'Matrix',
+    'MeshCluster',
     'Plane',
     'Polygon',
+    'ProfilerStats',
     'Quat',
     'Ray',
     'RayCastResult',
+    'RayPacket',
     'ShapeCastResult',
     'Sphere',
     'Time',
     'Vec3f',
     'Triangle',
+    'TrianglePack',
     'TriangleTest',
     'Vec2d',
     'Vec2f',
@@ -1,5 +1,6 @@
 local libphx = require('ffi.libphx').lib
 local memory
+local frameHistory = ffi.new('double[1024]')
 
 function onDef_Profiler (t, mt)
   t.BeginMemoryProfile = function ()
@@ -22,4 +23,27 @@ function onDef_Profiler (t, mt)
     local duration = TimeStamp.GetElapsedMs(begin)
     printf('%s : %.2f ms', name, duration)
   end
+
+  -- thread defaults to -1 (all threads); returns nil for unknown scopes
+  t.GetStats = function (scope, thread)
+    local stats = ffi.new('ProfilerStats')
+    if libphx.Profiler_GetScopeStats(scope, thread or -1, stats) then
+      return stats
+    end
+    return nil
+  end
+
+  t.GetFrameStats = function ()
+    local stats = ffi.new('ProfilerStats')
+    if libphx.Profiler_GetFrameStats(stats) then return stats end
+    return nil
+  end
+
+  -- Returns up to count (default 1024) recent frame times, oldest first
+  t.GetFrameHistory = function (count)
+    local n = libphx.Profiler_GetFrameHistory(frameHistory, count or 1024)
+    local result = {}
+    for i = 0, n - 1 do result[i + 1] = frameHistory[i] end
+    return result
+  end
 end
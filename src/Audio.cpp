@@ -1,5 +1,6 @@
 #include "ArrayList.h"
 #include "Audio.h"
+#include "Engine.h"
 #include "FMODError.h"
 #include "MemPool.h"
 #include "PhxMath.h"
@@ -26,6 +27,9 @@ struct Audio {
 } static self;
 
 void Audio_Init () {
+    if (Engine_IsHeadless())
+      Fatal("Audio_Init: Audio is unavailable in headless mode");
+
     /* Initialize Debugging. */ {
       FMOD_DEBUG_FLAGS flags = 0;
       NCHECK(flags |= FMOD_DEBUG_LEVEL_NONE);
@@ -1,5 +1,6 @@
 #include "Array.h"
 #include "BSP.h"
+#include "Metric.h"
 #include "Plane.h"
 #include "Sphere.h"
 
@@ -308,9 +309,11 @@ bool BSP_IntersectRay (BSP* self, Ray const* _ray, float* tHit) {
   bool       hit      = false;
   int32      depth    = 0;
   int32      maxDepth = 0;
+  int32      visited  = 0;
 
   for (;;) {
     maxDepth = Max(depth, maxDepth);
+    visited++;
 
     if (nodeRef.index >= 0) {
       BSPNode* node = ArrayList_GetPtr(self->nodes, nodeRef.index);
@@ -400,6 +403,7 @@ bool BSP_IntersectRay (BSP* self, Ray const* _ray, float* tHit) {
   }
 
   ArrayList_Clear(rayStack);
+  Metric_Mod(Metric_BSPNodes, visited);
   BSP_PROFILE (
     self->profilingData.ray.count++;
     self->profilingData.ray.depth += maxDepth;
@@ -427,9 +431,11 @@ bool BSP_IntersectSphere (BSP* self, Sphere const* sphere, Vec3f* pHit) {
   bool       hit      = false;
   int32      depth    = 0;
   int32      maxDepth = 0;
+  int32      visited  = 0;
 
   for (;;) {
     maxDepth = Max(depth, maxDepth);
+    visited++;
 
     if (nodeRef.index >= 0) {
       BSPNode* node = ArrayList_GetPtr(self->nodes, nodeRef.index);
@@ -478,6 +484,7 @@ bool BSP_IntersectSphere (BSP* self, Sphere const* sphere, Vec3f* pHit) {
   }
 
   ArrayList_Clear(nodeStack);
+  Metric_Mod(Metric_BSPNodes, visited);
   BSP_PROFILE (
     self->profilingData.sphere.count++;
     self->profilingData.sphere.depth += maxDepth;
@@ -489,6 +496,7 @@ bool BSP_IntersectSphere (BSP* self, Sphere const* sphere, Vec3f* pHit) {
 /* --- Building ------------------------------------------------------------- */
 
 #include <float.h>
+#include "MemArena.h"
 #include "Mesh.h"
 #include "RNG.h"
 #include "Vertex.h"
@@ -522,6 +530,7 @@ struct BSPBuild_Node {
 
 struct BSPBuild {
   BSPBuild_Node* rootNode;
+  MemArena* nodeArena;
   RNG* rng;
   int32 nodeCount;
   int32 leafCount;
@@ -835,7 +844,8 @@ static BSPBuild_Node* BSPBuild_CreateNode (BSPBuild* bsp, BSPBuild_NodeData* nod
 
   Assert(nodeData->depth < 1 << 8*sizeof(nodeData->depth));
 
-  BSPBuild_Node* node = MemNewZero(BSPBuild_Node);
+  BSPBuild_Node* node = MemArena_New(bsp->nodeArena, BSPBuild_Node);
+  MemZero(node, sizeof(BSPBuild_Node));
   CHECK2(node->id = bsp->nextNodeID++;)
 
   Plane splitPlane = {};
@@ -964,7 +974,6 @@ static void BSPBuild_FreeNode (BSPBuild_Node* node) {
     }
     ArrayList_Free(node->polygons);
   }
-  MemFree(node);
 }
 
 BSP_PROFILE (
@@ -1030,6 +1039,7 @@ BSP* BSP_Create (Mesh* mesh) {
    *        stores indices and vertex attributes I expect the proportionality
    *        constant to be in the ballpark of 0.5 */
 
+  MEMTAG_BEGIN(MemTag_Collision);
   BSP* self = MemNewZero(BSP);
 
   int32   indexLen   = Mesh_GetIndexCount(mesh);
@@ -1038,7 +1048,10 @@ BSP* BSP_Create (Mesh* mesh) {
 
   /* TODO : Implement some form of soft abort when the incoming mesh is bad. */
   CHECK2 (
-    if (Mesh_Validate(mesh) != Error_None) return 0;
+    if (Mesh_Validate(mesh) != Error_None) {
+      MEMTAG_END;
+      return 0;
+    }
   )
 
   BSPBuild_NodeData nodeData = {};
@@ -1065,8 +1078,9 @@ BSP* BSP_Create (Mesh* mesh) {
 
   /* Build */
   BSPBuild bspBuild = {};
-  bspBuild.rng      = RNG_Create(1235);
-  bspBuild.rootNode = BSPBuild_CreateNode(&bspBuild, &nodeData);
+  bspBuild.rng       = RNG_Create(1235);
+  bspBuild.nodeArena = MemArena_Create(0x10000);
+  bspBuild.rootNode  = BSPBuild_CreateNode(&bspBuild, &nodeData);
 
   /* Optimize */
   Triangle nullLeaf = {};
@@ -1089,12 +1103,14 @@ BSP* BSP_Create (Mesh* mesh) {
   #endif
 
   BSPBuild_FreeNode(bspBuild.rootNode);
+  MemArena_Free(bspBuild.nodeArena);
   RNG_Free(bspBuild.rng);
 
   Assert(ArrayList_GetSize(self->nodes)     == ArrayList_GetCapacity(self->nodes));
   Assert(ArrayList_GetSize(self->triangles) == ArrayList_GetCapacity(self->triangles));
   BSP_PROFILE(BSPBuild_AnalyzeTree(self, mesh, self->rootNode, 0);)
 
+  MEMTAG_END;
   return self;
 }
 
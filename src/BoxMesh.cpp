@@ -1,8 +1,16 @@
 #include "ArrayList.h"
 #include "BoxMesh.h"
-#include "Matrix.h"
 #include "Mesh.h"
+#include "OS.h"
+#include "PhxMath.h"
+#include "ThreadPool.h"
+#include "Vec2.h"
 #include "Vec3.h"
+#include "Vertex.h"
+
+/* Below this many boxes per worker, thread startup costs more than the
+ * emission itself. */
+static const int kMinBoxesPerThread = 1024;
 
 struct Box {
   Vec3f p, s, r, b;
@@ -52,46 +60,127 @@ void BoxMesh_Add (BoxMesh* self,
   box->b = Vec3f_Create(bx, by, bz);
 }
 
-Mesh* BoxMesh_GetMesh (BoxMesh* self, int res) {
-  Mesh* mesh = Mesh_Create();
-  Mesh_ReserveVertexData(mesh, 6 * res * res * self->elem_size);
-  Mesh_ReserveIndexData(mesh, 12 * (res - 1) * (res - 1));
+/* Rotation-only rows of Matrix_YawPitchRoll, built on the stack so that box
+ * emission never touches the heap. */
+static void BoxMesh_Rotation (Vec3f const* r, Vec3f out[3]) {
+  float ca = Cos(r->z);
+  float sa = Sin(r->z);
+  float cb = Cos(r->x);
+  float sb = Sin(r->x);
+  float cy = Cos(r->y);
+  float sy = Sin(r->y);
+  out[0] = Vec3f_Create(ca * cb, ca * sb * sy - sa * cy, ca * sb * cy + sa * sy);
+  out[1] = Vec3f_Create(sa * cb, sa * sb * sy + ca * cy, sa * sb * cy - ca * sy);
+  out[2] = Vec3f_Create(    -sb,               cb * sy,               cb * cy);
+}
+
+struct BoxMeshJob {
+  Box const* box;
+  int boxes;
+  int res;
+  Vertex* vertex;
+  int32* index;
+};
+
+/* Emits boxes [begin, end) into the preallocated vertex and index arrays. Each
+ * box owns a fixed-size slice of both arrays, so disjoint ranges may be filled
+ * concurrently. Output is identical to emitting the boxes one at a time. */
+static void BoxMesh_EmitRange (BoxMeshJob const* job, int begin, int end) {
+  int res = job->res;
+  int vertsPerFace = res * res;
+  int vertsPerBox = 6 * vertsPerFace;
+  int indicesPerBox = 36 * (res - 1) * (res - 1);
+  float rcpRes = 1.0f / (float)(res - 1);
+
+  Vec3f faceN[6];
+  for (int face = 0; face < 6; ++face)
+    faceN[face] = Vec3f_Normalize(Vec3f_Cross(kFaceU[face], kFaceV[face]));
+
+  for (int i = begin; i < end; ++i) {
+    Box const* box = job->box + i;
+    Vertex* v = job->vertex + (size_t)i * vertsPerBox;
+    int32* index = job->index + (size_t)i * indicesPerBox;
+    int32 base = i * vertsPerBox;
 
-  for (int i = 0; i < self->elem_size; ++i) {
-    Box* box = self->elem_data + i;
     Vec3f lower = Vec3f_Create(box->b.x - 1.0f, box->b.y - 1.0f, box->b.z - 1.0f);
     Vec3f upper = Vec3f_Create(1.0f - box->b.x, 1.0f - box->b.y, 1.0f - box->b.z);
-    Matrix* rot = Matrix_YawPitchRoll(box->r.x, box->r.y, box->r.z);
+    Vec3f rot[3];
+    BoxMesh_Rotation(&box->r, rot);
 
     for (int face = 0; face < 6; ++face) {
       Vec3f o = kFaceOrigin[face];
       Vec3f du = kFaceU[face];
       Vec3f dv = kFaceV[face];
-      Vec3f n = Vec3f_Normalize(Vec3f_Cross(du, dv));
+      Vec3f n = faceN[face];
 
       for (int iu = 0; iu < res; ++iu) {
-        float u = (float)iu / (float)(res - 1);
+        float u = (float)iu * rcpRes;
         for (int iv = 0; iv < res; ++iv) {
-          float v = (float)iv / (float)(res - 1);
-          Vec3f p = Vec3f_Add(o, Vec3f_Add(Vec3f_Muls(du, u), Vec3f_Muls(dv, v)));
+          float t = (float)iv * rcpRes;
+          Vec3f p = Vec3f_Add(o, Vec3f_Add(Vec3f_Muls(du, u), Vec3f_Muls(dv, t)));
           Vec3f clamped = Vec3f_Clamp(p, lower, upper);
           Vec3f proj = Vec3f_Sub(p, clamped);
           p = Vec3f_Add(clamped, Vec3f_Mul(Vec3f_SNormalize(proj), box->b));
           p = Vec3f_Mul(p, box->s);
-          Vec3f rp;
-          Matrix_MulPoint(rot, &rp, p.x, p.y, p.z);
-          p = Vec3f_Add(rp, box->p);
 
           if (iu && iv) {
-            int off = Mesh_GetVertexCount(mesh);
-            Mesh_AddQuad(mesh, off, off - res, off - res - 1, off - 1);
+            int32 off = base + face * vertsPerFace + iu * res + iv;
+            index[0] = off;
+            index[1] = off - res;
+            index[2] = off - res - 1;
+            index[3] = off;
+            index[4] = off - res - 1;
+            index[5] = off - 1;
+            index += 6;
           }
-          Mesh_AddVertex(mesh, p.x, p.y, p.z, n.x, n.y, n.z, u, v);
+
+          v->p = Vec3f_Add(box->p, Vec3f_Create(
+            Vec3f_Dot(rot[0], p),
+            Vec3f_Dot(rot[1], p),
+            Vec3f_Dot(rot[2], p)));
+          v->n = n;
+          v->uv = Vec2f_Create(u, t);
+          ++v;
         }
       }
     }
+  }
+}
+
+static int BoxMesh_EmitThread (int threadIndex, int threadCount, void* data) {
+  BoxMeshJob const* job = (BoxMeshJob const*)data;
+  int begin = (int)(((int64)job->boxes * (threadIndex + 0)) / threadCount);
+  int end   = (int)(((int64)job->boxes * (threadIndex + 1)) / threadCount);
+  BoxMesh_EmitRange(job, begin, end);
+  return 0;
+}
+
+Mesh* BoxMesh_GetMesh (BoxMesh* self, int res) {
+  int threads = OS_GetCPUCount();
+  threads = Min(threads, self->elem_size / kMinBoxesPerThread);
+  return BoxMesh_GetMeshThreaded(self, res, threads);
+}
+
+Mesh* BoxMesh_GetMeshThreaded (BoxMesh* self, int res, int threads) {
+  Mesh* mesh = Mesh_Create();
+  Mesh_ResizeVertexData(mesh, 6 * res * res * self->elem_size);
+  Mesh_ResizeIndexData(mesh, 36 * (res - 1) * (res - 1) * self->elem_size);
+
+  BoxMeshJob job;
+  job.box = self->elem_data;
+  job.boxes = self->elem_size;
+  job.res = res;
+  job.vertex = Mesh_GetVertexData(mesh);
+  job.index = Mesh_GetIndexData(mesh);
 
-    Matrix_Free(rot);
+  threads = Min(threads, self->elem_size);
+  if (threads > 1) {
+    ThreadPool* pool = ThreadPool_Create(threads);
+    ThreadPool_Launch(pool, BoxMesh_EmitThread, &job);
+    ThreadPool_Wait(pool);
+    ThreadPool_Free(pool);
+  } else {
+    BoxMesh_EmitRange(&job, 0, self->elem_size);
   }
 
   return mesh;
@@ -1,6 +1,7 @@
 #include "BoxTree.h"
 #include "Draw.h"
 #include "Matrix.h"
+#include "MatrixDef.h"
 #include "PhxMemory.h"
 #include "Mesh.h"
 #include "RNG.h"
@@ -161,10 +162,9 @@ bool BoxTree_IntersectRay (
   Vec3f const* rd)
 {
   if (!self->root) return false;
-  Matrix* inv = Matrix_Inverse(matrix);
-  Vec3f invRo; Matrix_MulPoint(inv, &invRo, ro->x, ro->y, ro->z);
-  Vec3f invRd; Matrix_MulDir(inv, &invRd, rd->x, rd->y, rd->z);
-  Matrix_Free(inv);
+  Matrix inv; Matrix_IOInverse(matrix, &inv);
+  Vec3f invRo; Matrix_MulPoint(&inv, &invRo, ro->x, ro->y, ro->z);
+  Vec3f invRd; Matrix_MulDir(&inv, &invRd, rd->x, rd->y, rd->z);
   return Node_IntersectRay(self->root, invRo, Vec3f_Rcp(invRd));
 }
 
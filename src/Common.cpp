@@ -74,5 +74,5 @@ void Warn (cstr format, ...) {
 
   fprintf(stdout, "%s\n", message);
   fflush(stdout);
-  free(message);
+  MemFree(message);
 }
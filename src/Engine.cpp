@@ -4,8 +4,10 @@
 #include "Input.h"
 #include "Joystick.h"
 #include "Keyboard.h"
+#include "MemArena.h"
 #include "Metric.h"
 #include "Mouse.h"
+#include "PhxMemory.h"
 #include "PhxSignal.h"
 #include "Profiler.h"
 #include "Resource.h"
@@ -25,6 +27,9 @@
   }
 #endif
 
+/* NOTE : Headless mode keeps only the subsystems needed by CPU-side code:
+ *        events (for signals and quit requests) and timers. Windows, GL
+ *        contexts, input devices and haptics are unavailable. */
 const uint32 subsystems =
   SDL_INIT_EVENTS |
   SDL_INIT_VIDEO |
@@ -33,12 +38,50 @@ const uint32 subsystems =
   SDL_INIT_JOYSTICK |
   SDL_INIT_GAMECONTROLLER;
 
+const uint32 subsystemsHeadless =
+  SDL_INIT_EVENTS |
+  SDL_INIT_TIMER;
+
+#define MAX_INIT_PHASES 32
+
+struct EngineInitPhase {
+  char name[32];
+  double time;
+};
+
 static cstr versionString = __DATE__ " " __TIME__;
 static TimeStamp initTime = 0;
+static bool headless = false;
+
+struct EngineInitReport {
+  TimeStamp start;
+  TimeStamp last;
+  int count;
+  EngineInitPhase phase[MAX_INIT_PHASES];
+} static initReport;
+
+void Engine_MarkInitPhase (cstr name) {
+  TimeStamp now = TimeStamp_Get();
+  if (initReport.count == MAX_INIT_PHASES) {
+    Warn("Engine_MarkInitPhase: Too many phases, dropping <%s>", name);
+    return;
+  }
 
-void Engine_Init (int glVersionMajor, int glVersionMinor) {
+  EngineInitPhase* phase = initReport.phase + initReport.count++;
+  snprintf(phase->name, sizeof(phase->name), "%s", name);
+  phase->time = TimeStamp_GetDifference(initReport.last, now);
+  initReport.last = now;
+}
+
+static void Engine_InitImpl (bool isHeadless, int glVersionMajor, int glVersionMinor) {
   static bool firstTime = true;
+  initReport.start = TimeStamp_Get();
+  initReport.last = initReport.start;
+  initReport.count = 0;
+  headless = isHeadless;
+
   Signal_Init();
+  Engine_MarkInitPhase("Signal");
 
   if (firstTime) {
     firstTime = false;
@@ -63,40 +106,62 @@ void Engine_Init (int glVersionMajor, int glVersionMinor) {
     if (!Directory_Create("log"))
       Fatal("Engine_Init: Failed to create log directory.");
     atexit(SDL_Quit);
+    Engine_MarkInitPhase("SDL");
   }
 
-  if (SDL_InitSubSystem(subsystems) != 0)
+  if (SDL_InitSubSystem(headless ? subsystemsHeadless : subsystems) != 0)
     Fatal("Engine_Init: Failed to initialize SDL's subsystems");
+  Engine_MarkInitPhase("SDL Subsystems");
+
+  if (!headless) {
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, glVersionMajor);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, glVersionMinor);
+    SDL_GL_SetAttribute(
+      SDL_GL_CONTEXT_PROFILE_MASK,
+      SDL_GL_CONTEXT_PROFILE_COMPATIBILITY);
+    SDL_GL_SetAttribute(SDL_GL_ACCELERATED_VISUAL, 1);
+    SDL_GL_SetAttribute(SDL_GL_RED_SIZE, 8);
+    SDL_GL_SetAttribute(SDL_GL_GREEN_SIZE, 8);
+    SDL_GL_SetAttribute(SDL_GL_BLUE_SIZE, 8);
+    SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);
+    SDL_GL_SetAttribute(SDL_GL_DEPTH_SIZE, 24);
+    Engine_MarkInitPhase("GL Attributes");
+
+    Keyboard_Init();
+    Mouse_Init();
+    Input_Init();
+    Engine_MarkInitPhase("Input");
+  }
 
-  SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, glVersionMajor);
-  SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, glVersionMinor);
-  SDL_GL_SetAttribute(
-    SDL_GL_CONTEXT_PROFILE_MASK,
-    SDL_GL_CONTEXT_PROFILE_COMPATIBILITY);
-  SDL_GL_SetAttribute(SDL_GL_ACCELERATED_VISUAL, 1);
-  SDL_GL_SetAttribute(SDL_GL_RED_SIZE, 8);
-  SDL_GL_SetAttribute(SDL_GL_GREEN_SIZE, 8);
-  SDL_GL_SetAttribute(SDL_GL_BLUE_SIZE, 8);
-  SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);
-  SDL_GL_SetAttribute(SDL_GL_DEPTH_SIZE, 24);
-
-  Keyboard_Init();
   Metric_Reset();
-  Mouse_Init();
-  Input_Init();
   Resource_Init();
-  ShaderVar_Init();
+  Engine_MarkInitPhase("Resource");
+
+  if (!headless) {
+    ShaderVar_Init();
+    Engine_MarkInitPhase("ShaderVar");
+  }
 
   initTime = TimeStamp_Get();
 }
 
+void Engine_Init (int glVersionMajor, int glVersionMinor) {
+  Engine_InitImpl(false, glVersionMajor, glVersionMinor);
+}
+
+void Engine_InitHeadless () {
+  Engine_InitImpl(true, 0, 0);
+}
+
 void Engine_Free () {
-  ShaderVar_Free();
-  Keyboard_Free();
-  Mouse_Free();
-  Input_Free();
+  if (!headless) {
+    ShaderVar_Free();
+    Keyboard_Free();
+    Mouse_Free();
+    Input_Free();
+  }
   Signal_Free();
-  SDL_QuitSubSystem(subsystems);
+  SDL_QuitSubSystem(headless ? subsystemsHeadless : subsystems);
 }
 
 void Engine_Abort () {
@@ -115,22 +180,63 @@ cstr Engine_GetVersion () {
   return versionString;
 }
 
+int Engine_GetInitPhaseCount () {
+  return initReport.count;
+}
+
+cstr Engine_GetInitPhaseName (int index) {
+  if (index < 0 || index >= initReport.count)
+    Fatal("Engine_GetInitPhaseName: Index %d out of range", index);
+  return initReport.phase[index].name;
+}
+
+double Engine_GetInitPhaseTime (int index) {
+  if (index < 0 || index >= initReport.count)
+    Fatal("Engine_GetInitPhaseTime: Index %d out of range", index);
+  return initReport.phase[index].time;
+}
+
+double Engine_GetInitTime () {
+  return TimeStamp_GetDifference(initReport.start, initReport.last);
+}
+
+bool Engine_IsHeadless () {
+  return headless;
+}
+
 bool Engine_IsInitialized () {
   return initTime != 0;
 }
 
+void Engine_PrintInitReport () {
+  double total = Engine_GetInitTime();
+  printf("Engine_Init%s: %.3f ms\n", headless ? " (headless)" : "", 1000.0 * total);
+  for (int i = 0; i < initReport.count; ++i) {
+    EngineInitPhase const* phase = initReport.phase + i;
+    printf("  %-24s %9.3f ms  %5.1f%%\n",
+      phase->name, 1000.0 * phase->time,
+      total > 0 ? 100.0 * phase->time / total : 0.0);
+  }
+}
+
 void Engine_Terminate () {
   exit(0);
 }
 
 void Engine_Update () {
   FRAME_BEGIN;
-  Metric_Reset();
-  Keyboard_UpdatePre();
-  Mouse_Update();
-  Joystick_Update();
-  Gamepad_Update();
-  Input_Update();
-  Keyboard_UpdatePost();
+  MemArena_NextFrame();
+  Memory_NextFrame();
+  /* Allocs only reaches the history; see Metric.h. */
+  Metric_Mod(Metric_Allocs, (int32)Memory_GetFrameAllocs(MemTag_All));
+  Metric_NextFrame();
+  if (!headless) {
+    Keyboard_UpdatePre();
+    Mouse_Update();
+    Joystick_Update();
+    Gamepad_Update();
+    Input_Update();
+    Keyboard_UpdatePost();
+  }
   FRAME_END;
 }
@@ -1,5 +1,6 @@
 #include "Bytes.h"
 #include "File.h"
+#include "Hash.h"
 #include "PhxMemory.h"
 #include "PhxString.h"
 
@@ -95,6 +96,21 @@ cstr File_ReadCstr (cstr path) {
   return buffer;
 }
 
+uint64 File_Hash (cstr path) {
+  FILE* file = fopen(path, "rb");
+  if (!file)
+    return 0;
+
+  HashXX64State state;
+  Hash_XX64_Init(&state, 0);
+  uint8 buffer[0x4000];
+  size_t read;
+  while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    Hash_XX64_Update(&state, buffer, (int)read);
+  fclose(file);
+  return Hash_XX64_Digest(&state);
+}
+
 int64 File_Size (cstr path) {
   FILE* file = fopen(path, "rb");
   if (!file)
@@ -11,6 +11,7 @@
 #include "Resource.h"
 #include "PhxMath.h"
 #include "Shader.h"
+#include "StrIntern.h"
 #include "Tex2D.h"
 #include "PixelFormat.h"
 #include "TexFormat.h"
@@ -46,6 +47,9 @@ struct Font {
 
 static FT_Library ft = 0;
 
+/* Gamma-corrected alpha for each 8-bit coverage value FreeType renders. */
+static float gammaTable[256];
+
 static Glyph* Font_GetGlyph (Font* self, uint32 codepoint) {
   if (codepoint < 256 && self->glyphsAscii[codepoint])
     return self->glyphsAscii[codepoint];
@@ -82,8 +86,7 @@ static Glyph* Font_GetGlyph (Font* self, uint32 codepoint) {
     Vec4f* pBuffer = buffer;
     for (uint dy = 0; dy < bitmap->rows; ++dy) {
       for (uint dx = 0; dx < bitmap->width; ++dx) {
-        float a = Pow((float)(pBitmap[dx]) / 255.0f, kRcpGamma);
-        *pBuffer++ = Vec4f_Create(1.0f, 1.0f, 1.0f, a);
+        *pBuffer++ = Vec4f_Create(1.0f, 1.0f, 1.0f, gammaTable[pBitmap[dx]]);
       }
       pBitmap += bitmap->pitch;
     }
@@ -111,8 +114,12 @@ inline static int Font_GetKerning (Font* self, int a, int b) {
 }
 
 Font* Font_Load (cstr name, int size) {
-  if (!ft)
+  MEMTAG_BEGIN(MemTag_Render);
+  if (!ft) {
     FT_Init_FreeType(&ft);
+    for (int i = 0; i < 256; ++i)
+      gammaTable[i] = Pow((float)i / 255.0f, kRcpGamma);
+  }
 
   cstr path = Resource_GetPath(ResourceType_Font, name);
   Font* self = MemNew(Font);
@@ -124,6 +131,7 @@ Font* Font_Load (cstr name, int size) {
 
   MemZero(self->glyphsAscii, sizeof(self->glyphsAscii));
   self->glyphs = HashMap_Create(sizeof(uint32), 16);
+  MEMTAG_END;
   return self;
 }
 
@@ -176,6 +184,7 @@ void Font_Draw (
 }
 
 void Font_DrawShaded (Font* self, cstr text, float x, float y) {
+  static uint32 const glyphId = Str_InternId("glyph");
   FRAME_BEGIN;
   int glyphLast = 0;
   uint32 codepoint = *text++;
@@ -191,7 +200,7 @@ void Font_DrawShaded (Font* self, cstr text, float x, float y) {
       float y0 = (float)(y + glyph->y0);
       float x1 = (float)(x + glyph->x1);
       float y1 = (float)(y + glyph->y1);
-      Shader_SetTex2D("glyph", glyph->tex);
+      Shader_SetTex2DId(glyphId, glyph->tex);
       Tex2D_DrawEx(glyph->tex, x0, y0, x1, y1, 0, 0, 1, 1);
       x += glyph->advance;
       glyphLast = glyph->index;
@@ -1,4 +1,16 @@
 #include "Hash.h"
+#include "PhxMemory.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+  #define XXH3_SSE2 1
+  #include <emmintrin.h>
+#else
+  #define XXH3_SSE2 0
+#endif
+
+#if defined(_MSC_VER)
+  #include <intrin.h>
+#endif
 
 /* --- Fowler–Noll–Vo ------------------------------------------------------- */
 
@@ -131,41 +143,9 @@ static uint64 XXH64_mergeRound (uint64 acc, uint64 val) {
   return acc;
 }
 
-uint64 Hash_XX64 (void const* buf, int len, uint64 seed) {
-  uint8 const* p = (uint8 const*)buf;
-  uint8 const* end = p + len;
-  uint64 hash;
-
-  if (len >= 32) {
-    uint8 const* const limit = end - 32;
-    uint64 v1 = seed + PRIME64_1 + PRIME64_2;
-    uint64 v2 = seed + PRIME64_2;
-    uint64 v3 = seed + 0;
-    uint64 v4 = seed - PRIME64_1;
-
-    do {
-      v1 = XXH64_round(v1, *(uint64 const*)p); p += 8;
-      v2 = XXH64_round(v2, *(uint64 const*)p); p += 8;
-      v3 = XXH64_round(v3, *(uint64 const*)p); p += 8;
-      v4 = XXH64_round(v4, *(uint64 const*)p); p += 8;
-    } while (p <= limit);
-
-    hash =
-      XXH_rotl64(v1,  1) +
-      XXH_rotl64(v2,  7) +
-      XXH_rotl64(v3, 12) +
-      XXH_rotl64(v4, 18);
-
-    hash = XXH64_mergeRound(hash, v1);
-    hash = XXH64_mergeRound(hash, v2);
-    hash = XXH64_mergeRound(hash, v3);
-    hash = XXH64_mergeRound(hash, v4);
-  } else {
-    hash = seed + PRIME64_5;
-  }
-
-  hash += (uint64)len;
-
+/* Consumes the final (< 32) bytes and avalanches. Shared by the one-shot and
+ * streaming variants so that both produce identical digests. */
+static uint64 XXH64_finalize (uint64 hash, uint8 const* p, uint8 const* end) {
   while (p + 8 <= end) {
     uint64 const k1 = XXH64_round(0, *(uint64 const*)p);
     hash ^= k1;
@@ -190,3 +170,351 @@ uint64 Hash_XX64 (void const* buf, int len, uint64 seed) {
   hash ^= hash >> 32;
   return hash;
 }
+
+inline static uint64 XXH64_mergeLanes (uint64 const* v) {
+  uint64 hash =
+    XXH_rotl64(v[0],  1) +
+    XXH_rotl64(v[1],  7) +
+    XXH_rotl64(v[2], 12) +
+    XXH_rotl64(v[3], 18);
+
+  hash = XXH64_mergeRound(hash, v[0]);
+  hash = XXH64_mergeRound(hash, v[1]);
+  hash = XXH64_mergeRound(hash, v[2]);
+  hash = XXH64_mergeRound(hash, v[3]);
+  return hash;
+}
+
+inline static void XXH64_initLanes (uint64* v, uint64 seed) {
+  v[0] = seed + PRIME64_1 + PRIME64_2;
+  v[1] = seed + PRIME64_2;
+  v[2] = seed + 0;
+  v[3] = seed - PRIME64_1;
+}
+
+inline static void XXH64_consume (uint64* v, uint8 const* p) {
+  v[0] = XXH64_round(v[0], ((uint64 const*)p)[0]);
+  v[1] = XXH64_round(v[1], ((uint64 const*)p)[1]);
+  v[2] = XXH64_round(v[2], ((uint64 const*)p)[2]);
+  v[3] = XXH64_round(v[3], ((uint64 const*)p)[3]);
+}
+
+uint64 Hash_XX64 (void const* buf, int len, uint64 seed) {
+  uint8 const* p = (uint8 const*)buf;
+  uint8 const* end = p + len;
+  uint64 hash;
+
+  if (len >= 32) {
+    uint8 const* const limit = end - 32;
+    uint64 v[4];
+    XXH64_initLanes(v, seed);
+    do {
+      XXH64_consume(v, p);
+      p += 32;
+    } while (p <= limit);
+    hash = XXH64_mergeLanes(v);
+  } else {
+    hash = seed + PRIME64_5;
+  }
+
+  hash += (uint64)len;
+  return XXH64_finalize(hash, p, end);
+}
+
+void Hash_XX64_Init (HashXX64State* self, uint64 seed) {
+  XXH64_initLanes(self->v, seed);
+  self->total = 0;
+  self->bufferSize = 0;
+}
+
+void Hash_XX64_Update (HashXX64State* self, void const* buf, int len) {
+  uint8 const* p = (uint8 const*)buf;
+  uint8 const* end = p + len;
+  self->total += (uint64)len;
+
+  if (self->bufferSize + (uint32)len < 32) {
+    MemCpy(self->buffer + self->bufferSize, p, (size_t)len);
+    self->bufferSize += (uint32)len;
+    return;
+  }
+
+  if (self->bufferSize) {
+    uint32 fill = 32 - self->bufferSize;
+    MemCpy(self->buffer + self->bufferSize, p, fill);
+    XXH64_consume(self->v, self->buffer);
+    p += fill;
+    self->bufferSize = 0;
+  }
+
+  for (; p + 32 <= end; p += 32)
+    XXH64_consume(self->v, p);
+
+  self->bufferSize = (uint32)(end - p);
+  MemCpy(self->buffer, p, self->bufferSize);
+}
+
+uint64 Hash_XX64_Digest (HashXX64State const* self) {
+  /* v[2] still holds the seed if no full stripe has been consumed. */
+  uint64 hash = self->total >= 32
+    ? XXH64_mergeLanes(self->v)
+    : self->v[2] + PRIME64_5;
+  hash += self->total;
+  return XXH64_finalize(hash, self->buffer, self->buffer + self->bufferSize);
+}
+
+/* --- XXH3 (64-bit) ---------------------------------------------------------
+ *   https://github.com/Cyan4973/xxHash/blob/dev/xxhash.h
+ *
+ *   Matches XXH3_64bits_withSeed from xxHash 0.8. Inputs up to 240 bytes take
+ *   dedicated short paths; longer inputs are accumulated in 64-byte stripes
+ *   across eight lanes, using SSE2 where available.
+ * -------------------------------------------------------------------------- */
+
+#define XXH3_SECRET_SIZE 192
+#define XXH3_STRIPE_LEN 64
+#define XXH3_STRIPES_PER_BLOCK ((XXH3_SECRET_SIZE - XXH3_STRIPE_LEN) / 8)
+#define XXH3_BLOCK_LEN (XXH3_STRIPE_LEN * XXH3_STRIPES_PER_BLOCK)
+
+static const uint32 PRIME32_1 = 0x9E3779B1U;
+static const uint32 PRIME32_2 = 0x85EBCA77U;
+static const uint32 PRIME32_3 = 0xC2B2AE3DU;
+static const uint64 PRIME_MX1 = 0x165667919E3779F9ULL;
+static const uint64 PRIME_MX2 = 0x9FB21C651E98DF25ULL;
+
+static const uint8 kSecret[XXH3_SECRET_SIZE] = {
+  0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+  0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+  0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+  0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+  0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+  0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+  0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+  0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+  0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+  0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+  0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+  0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+inline static uint32 XXH_read32 (uint8 const* p) {
+  uint32 v;
+  MemCpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline static uint64 XXH_read64 (uint8 const* p) {
+  uint64 v;
+  MemCpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline static void XXH_write64 (uint8* p, uint64 v) {
+  MemCpy(p, &v, sizeof(v));
+}
+
+inline static uint32 XXH_swap32 (uint32 x) {
+  return ((x << 24) & 0xFF000000U) | ((x <<  8) & 0x00FF0000U) |
+         ((x >>  8) & 0x0000FF00U) | ((x >> 24) & 0x000000FFU);
+}
+
+inline static uint64 XXH_swap64 (uint64 x) {
+  return ((uint64)XXH_swap32((uint32)x) << 32) | (uint64)XXH_swap32((uint32)(x >> 32));
+}
+
+inline static uint64 XXH_mul128_fold64 (uint64 a, uint64 b) {
+#if defined(_MSC_VER) && defined(_M_X64)
+  uint64 hi;
+  uint64 lo = _umul128(a, b, &hi);
+  return lo ^ hi;
+#else
+  __uint128_t product = (__uint128_t)a * (__uint128_t)b;
+  return (uint64)product ^ (uint64)(product >> 64);
+#endif
+}
+
+inline static uint64 XXH64_avalanche (uint64 h) {
+  h ^= h >> 33; h *= PRIME64_2;
+  h ^= h >> 29; h *= PRIME64_3;
+  h ^= h >> 32;
+  return h;
+}
+
+inline static uint64 XXH3_avalanche (uint64 h) {
+  h ^= h >> 37;
+  h *= PRIME_MX1;
+  h ^= h >> 32;
+  return h;
+}
+
+inline static uint64 XXH3_rrmxmx (uint64 h, uint64 len) {
+  h ^= XXH_rotl64(h, 49) ^ XXH_rotl64(h, 24);
+  h *= PRIME_MX2;
+  h ^= (h >> 35) + len;
+  h *= PRIME_MX2;
+  return h ^ (h >> 28);
+}
+
+inline static uint64 XXH3_mix16B (uint8 const* p, uint8 const* secret, uint64 seed) {
+  return XXH_mul128_fold64(
+    XXH_read64(p + 0) ^ (XXH_read64(secret + 0) + seed),
+    XXH_read64(p + 8) ^ (XXH_read64(secret + 8) - seed));
+}
+
+static uint64 XXH3_len0to16 (uint8 const* p, uint64 len, uint64 seed) {
+  if (len > 8) {
+    uint64 bitflip1 = (XXH_read64(kSecret + 24) ^ XXH_read64(kSecret + 32)) + seed;
+    uint64 bitflip2 = (XXH_read64(kSecret + 40) ^ XXH_read64(kSecret + 48)) - seed;
+    uint64 lo = XXH_read64(p) ^ bitflip1;
+    uint64 hi = XXH_read64(p + len - 8) ^ bitflip2;
+    uint64 acc = len + XXH_swap64(lo) + hi + XXH_mul128_fold64(lo, hi);
+    return XXH3_avalanche(acc);
+  }
+
+  if (len >= 4) {
+    seed ^= (uint64)XXH_swap32((uint32)seed) << 32;
+    uint32 in1 = XXH_read32(p);
+    uint32 in2 = XXH_read32(p + len - 4);
+    uint64 bitflip = (XXH_read64(kSecret + 8) ^ XXH_read64(kSecret + 16)) - seed;
+    uint64 in64 = in2 + ((uint64)in1 << 32);
+    return XXH3_rrmxmx(in64 ^ bitflip, len);
+  }
+
+  if (len > 0) {
+    uint32 combined =
+      ((uint32)p[0] << 16) |
+      ((uint32)p[len >> 1] << 24) |
+      ((uint32)p[len - 1] << 0) |
+      ((uint32)len << 8);
+    uint64 bitflip = (XXH_read32(kSecret) ^ XXH_read32(kSecret + 4)) + seed;
+    return XXH64_avalanche((uint64)combined ^ bitflip);
+  }
+
+  return XXH64_avalanche(seed ^ (XXH_read64(kSecret + 56) ^ XXH_read64(kSecret + 64)));
+}
+
+static uint64 XXH3_len17to128 (uint8 const* p, uint64 len, uint64 seed) {
+  uint64 acc = len * PRIME64_1;
+  if (len > 32) {
+    if (len > 64) {
+      if (len > 96) {
+        acc += XXH3_mix16B(p + 48, kSecret + 96, seed);
+        acc += XXH3_mix16B(p + len - 64, kSecret + 112, seed);
+      }
+      acc += XXH3_mix16B(p + 32, kSecret + 64, seed);
+      acc += XXH3_mix16B(p + len - 48, kSecret + 80, seed);
+    }
+    acc += XXH3_mix16B(p + 16, kSecret + 32, seed);
+    acc += XXH3_mix16B(p + len - 32, kSecret + 48, seed);
+  }
+  acc += XXH3_mix16B(p + 0, kSecret + 0, seed);
+  acc += XXH3_mix16B(p + len - 16, kSecret + 16, seed);
+  return XXH3_avalanche(acc);
+}
+
+static uint64 XXH3_len129to240 (uint8 const* p, uint64 len, uint64 seed) {
+  uint64 acc = len * PRIME64_1;
+  int rounds = (int)len / 16;
+  for (int i = 0; i < 8; ++i)
+    acc += XXH3_mix16B(p + 16 * i, kSecret + 16 * i, seed);
+  acc = XXH3_avalanche(acc);
+
+  for (int i = 8; i < rounds; ++i)
+    acc += XXH3_mix16B(p + 16 * i, kSecret + 16 * (i - 8) + 3, seed);
+  acc += XXH3_mix16B(p + len - 16, kSecret + 136 - 17, seed);
+  return XXH3_avalanche(acc);
+}
+
+#if XXH3_SSE2
+inline static void XXH3_accumulate512 (uint64* acc, uint8 const* p, uint8 const* secret) {
+  __m128i* xacc = (__m128i*)acc;
+  for (int i = 0; i < 4; ++i) {
+    __m128i a = _mm_loadu_si128(xacc + i);
+    __m128i data = _mm_loadu_si128((__m128i const*)p + i);
+    __m128i key = _mm_loadu_si128((__m128i const*)secret + i);
+    __m128i dataKey = _mm_xor_si128(data, key);
+    __m128i dataKeyLo = _mm_shuffle_epi32(dataKey, _MM_SHUFFLE(0, 3, 0, 1));
+    __m128i product = _mm_mul_epu32(dataKey, dataKeyLo);
+    __m128i dataSwap = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+    _mm_storeu_si128(xacc + i, _mm_add_epi64(product, _mm_add_epi64(a, dataSwap)));
+  }
+}
+
+inline static void XXH3_scramble (uint64* acc, uint8 const* secret) {
+  __m128i* xacc = (__m128i*)acc;
+  __m128i prime = _mm_set1_epi32((int)PRIME32_1);
+  for (int i = 0; i < 4; ++i) {
+    __m128i a = _mm_loadu_si128(xacc + i);
+    a = _mm_xor_si128(a, _mm_srli_epi64(a, 47));
+    a = _mm_xor_si128(a, _mm_loadu_si128((__m128i const*)secret + i));
+    __m128i aHi = _mm_shuffle_epi32(a, _MM_SHUFFLE(0, 3, 0, 1));
+    __m128i lo = _mm_mul_epu32(a, prime);
+    __m128i hi = _mm_mul_epu32(aHi, prime);
+    _mm_storeu_si128(xacc + i, _mm_add_epi64(lo, _mm_slli_epi64(hi, 32)));
+  }
+}
+#else
+inline static void XXH3_accumulate512 (uint64* acc, uint8 const* p, uint8 const* secret) {
+  for (int i = 0; i < 8; ++i) {
+    uint64 data = XXH_read64(p + 8 * i);
+    uint64 dataKey = data ^ XXH_read64(secret + 8 * i);
+    acc[i ^ 1] += data;
+    acc[i] += (uint64)(uint32)dataKey * (dataKey >> 32);
+  }
+}
+
+inline static void XXH3_scramble (uint64* acc, uint8 const* secret) {
+  for (int i = 0; i < 8; ++i) {
+    uint64 a = acc[i];
+    a ^= a >> 47;
+    a ^= XXH_read64(secret + 8 * i);
+    acc[i] = a * PRIME32_1;
+  }
+}
+#endif
+
+static uint64 XXH3_hashLong (uint8 const* p, uint64 len, uint8 const* secret) {
+  uint64 acc[8] = {
+    PRIME32_3, PRIME64_1, PRIME64_2, PRIME64_3,
+    PRIME64_4, PRIME32_2, PRIME64_5, PRIME32_1,
+  };
+
+  uint64 blocks = (len - 1) / XXH3_BLOCK_LEN;
+  for (uint64 n = 0; n < blocks; ++n) {
+    uint8 const* block = p + n * XXH3_BLOCK_LEN;
+    for (int s = 0; s < XXH3_STRIPES_PER_BLOCK; ++s)
+      XXH3_accumulate512(acc, block + s * XXH3_STRIPE_LEN, secret + s * 8);
+    XXH3_scramble(acc, secret + XXH3_SECRET_SIZE - XXH3_STRIPE_LEN);
+  }
+
+  /* Partial last block, then the final stripe (which may overlap it). */
+  uint8 const* block = p + blocks * XXH3_BLOCK_LEN;
+  uint64 stripes = ((len - 1) - blocks * XXH3_BLOCK_LEN) / XXH3_STRIPE_LEN;
+  for (uint64 s = 0; s < stripes; ++s)
+    XXH3_accumulate512(acc, block + s * XXH3_STRIPE_LEN, secret + s * 8);
+  XXH3_accumulate512(acc, p + len - XXH3_STRIPE_LEN,
+    secret + XXH3_SECRET_SIZE - XXH3_STRIPE_LEN - 7);
+
+  uint64 result = len * PRIME64_1;
+  for (int i = 0; i < 4; ++i)
+    result += XXH_mul128_fold64(
+      acc[2 * i + 0] ^ XXH_read64(secret + 11 + 16 * i + 0),
+      acc[2 * i + 1] ^ XXH_read64(secret + 11 + 16 * i + 8));
+  return XXH3_avalanche(result);
+}
+
+uint64 Hash_XXH3 (void const* buf, int len, uint64 seed) {
+  uint8 const* p = (uint8 const*)buf;
+  uint64 n = (uint64)len;
+  if (n <= 16) return XXH3_len0to16(p, n, seed);
+  if (n <= 128) return XXH3_len17to128(p, n, seed);
+  if (n <= 240) return XXH3_len129to240(p, n, seed);
+  if (seed == 0) return XXH3_hashLong(p, n, kSecret);
+
+  /* A seeded long hash uses a secret derived from the seed. */
+  uint8 secret[XXH3_SECRET_SIZE];
+  for (int i = 0; i < XXH3_SECRET_SIZE / 16; ++i) {
+    XXH_write64(secret + 16 * i + 0, XXH_read64(kSecret + 16 * i + 0) + seed);
+    XXH_write64(secret + 16 * i + 8, XXH_read64(kSecret + 16 * i + 8) - seed);
+  }
+  return XXH3_hashLong(p, n, secret);
+}
@@ -3,6 +3,7 @@
 #include "Hash.h"
 #include "HashGrid.h"
 #include "MemPool.h"
+#include "Metric.h"
 #include "PhxMemory.h"
 #include "PhxMath.h"
 #include "Profiler.h"
@@ -67,8 +68,13 @@ inline static HashGridCell* HashGrid_GetCell (HashGrid* self, int32 x, int32 y,
   return self->cells + (hash & self->mask);
 }
 
+inline static int32 HashGrid_GetCellCount (int32 const* lower, int32 const* upper) {
+  return (upper[0] - lower[0] + 1) * (upper[1] - lower[1] + 1) * (upper[2] - lower[2] + 1);
+}
+
 static void HashGrid_AddElem (HashGrid* self, HashGridElem* elem) {
   self->version++;
+  Metric_Mod(Metric_GridCells, HashGrid_GetCellCount(elem->lower, elem->upper));
   for (int32 x = elem->lower[0]; x <= elem->upper[0]; ++x)
   for (int32 y = elem->lower[1]; y <= elem->upper[1]; ++y)
   for (int32 z = elem->lower[2]; z <= elem->upper[2]; ++z) {
@@ -86,6 +92,7 @@ static void HashGrid_AddElem (HashGrid* self, HashGridElem* elem) {
 
 static void HashGrid_RemoveElem (HashGrid* self, HashGridElem* elem) {
   self->version++;
+  Metric_Mod(Metric_GridCells, HashGrid_GetCellCount(elem->lower, elem->upper));
   for (int32 x = elem->lower[0]; x <= elem->upper[0]; ++x)
   for (int32 y = elem->lower[1]; y <= elem->upper[1]; ++y)
   for (int32 z = elem->lower[2]; z <= elem->upper[2]; ++z) {
@@ -163,6 +170,8 @@ void HashGrid_Update (HashGrid* self, HashGridElem* elem, Box3f const* box) {
     Max(upper[2], elem->upper[2]),
   };
 
+  Metric_Mod(Metric_GridCells, HashGrid_GetCellCount(lowerUnion, upperUnion));
+
   uint64 vRemove = ++self->version;
   uint64 vAdd = ++self->version;
 
@@ -256,6 +265,8 @@ int HashGrid_QueryBox (HashGrid* self, Box3f const* box) {
     HashGrid_ToLocal(self, box->upper.z),
   };
 
+  Metric_Mod(Metric_GridCells, HashGrid_GetCellCount(lower, upper));
+
   for (int32 x = lower[0]; x <= upper[0]; ++x)
   for (int32 y = lower[1]; y <= upper[1]; ++y)
   for (int32 z = lower[2]; z <= upper[2]; ++z) {
@@ -283,6 +294,7 @@ int HashGrid_QueryPoint (HashGrid* self, Vec3f const* p) {
   /* Since a point query is restricted to a single cell, we don't need to use
    * versioning here. */
   ArrayList_Clear(self->results);
+  Metric_Inc(Metric_GridCells);
 
   HashGridCell* cell = HashGrid_GetCell(self,
     HashGrid_ToLocal(self, p->x),
@@ -5,6 +5,23 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if !ENABLE_HASHMAP_SWISS
+
+/* NOTE : Robin Hood open addressing. Each element sits at most 'distance'
+ *        slots past its home slot, and insertion displaces any element that
+ *        is closer to its home than the one being inserted. Hence a lookup
+ *        can stop as soon as it meets an element closer to home than the
+ *        current probe distance, and probe lengths stay short and uniform
+ *        even at high load. Removal shifts the following run of displaced
+ *        elements back by one slot, so no tombstones are needed.
+ *
+ *        Home slots come from Fibonacci hashing of the 64-bit key hash. This
+ *        keeps raw keys such as pointers (see the Profiler) from clustering
+ *        on their aligned low bits. */
+
+#define MIN_CAPACITY 8
+#define DEFAULT_MAX_LOAD 0.875f
+
 struct Node {
   uint64 hash;
   void*  value;
@@ -15,29 +32,84 @@ struct HashMap {
   uint32 size;
   uint32 capacity;
   uint32 mask;
+  uint32 shift;
   uint32 keySize;
-  uint32 maxProbe;
+  uint32 maxSize;
+  float maxLoad;
 };
 
 inline static uint64 Hash (void const* key, uint32 len) {
   return Hash_XX64(key, len, 0x0ULL);
 }
 
-HashMap* HashMap_Create (uint32 keySize, uint32 capacity) {
+inline static uint32 HashMap_Home (HashMap* self, uint64 hash) {
+  return (uint32)((hash * 0x9E3779B97F4A7C15ULL) >> self->shift);
+}
+
+inline static uint32 HashMap_Distance (HashMap* self, uint32 index, uint64 hash) {
+  return (index - HashMap_Home(self, hash)) & self->mask;
+}
+
+static void HashMap_Init (HashMap* self, uint32 capacity) {
   uint32 logCapacity = 0;
-  while (capacity > 1) {
-    capacity /= 2;
+  while ((1U << logCapacity) < capacity || (1U << logCapacity) < MIN_CAPACITY)
     logCapacity++;
-  }
-  capacity = 1 << logCapacity;
+  capacity = 1U << logCapacity;
 
-  HashMap* self = MemNew(HashMap);
   self->elems = MemNewArrayZero(Node, capacity);
   self->size = 0;
   self->capacity = capacity;
-  self->mask = (1 << logCapacity) - 1;
+  self->mask = capacity - 1;
+  self->shift = 64 - logCapacity;
+  self->maxSize = (uint32)((float)capacity * self->maxLoad);
+  if (self->maxSize >= capacity)
+    self->maxSize = capacity - 1;
+}
+
+/* Inserts a hash that is known not to be in the map. */
+static void HashMap_Insert (HashMap* self, uint64 hash, void* value) {
+  uint32 index = HashMap_Home(self, hash);
+  uint32 distance = 0;
+  for (;;) {
+    Node* node = self->elems + index;
+    if (!node->value) {
+      node->hash = hash;
+      node->value = value;
+      self->size++;
+      return;
+    }
+
+    uint32 nodeDistance = HashMap_Distance(self, index, node->hash);
+    if (nodeDistance < distance) {
+      uint64 h = node->hash; node->hash = hash;   hash = h;
+      void*  v = node->value; node->value = value; value = v;
+      distance = nodeDistance;
+    }
+
+    index = (index + 1) & self->mask;
+    distance++;
+  }
+}
+
+static Node* HashMap_Find (HashMap* self, uint64 hash) {
+  uint32 index = HashMap_Home(self, hash);
+  for (uint32 distance = 0;; ++distance) {
+    Node* node = self->elems + index;
+    if (!node->value)
+      return 0;
+    if (node->hash == hash)
+      return node;
+    if (distance > HashMap_Distance(self, index, node->hash))
+      return 0;
+    index = (index + 1) & self->mask;
+  }
+}
+
+HashMap* HashMap_Create (uint32 keySize, uint32 capacity) {
+  HashMap* self = MemNew(HashMap);
   self->keySize = keySize;
-  self->maxProbe = logCapacity;
+  self->maxLoad = DEFAULT_MAX_LOAD;
+  HashMap_Init(self, capacity);
   return self;
 }
 
@@ -59,52 +131,62 @@ void* HashMap_Get (HashMap* self, void const* key) {
 }
 
 void* HashMap_GetRaw (HashMap* self, uint64 hash) {
-  uint32 index = 0;
-  Node* node = self->elems + ((hash + index) & self->mask);
-  while (node->value && index < self->maxProbe) {
-    if (node->hash == hash) return node->value;
-    index++;
-    node = self->elems + ((hash + index) & self->mask);
-  }
-  return 0;
+  Node* node = HashMap_Find(self, hash);
+  return node ? node->value : 0;
 }
 
-/* TODO : Removal in open-addressing is non-trivial! */
-#if 0
-void* HashMap_Remove (HashMap* self, void const* key) {
-  Node* node = HashMap_GetNode(self, key);
-  Node* head = node;
-  Node* last = 0;
-
-  while (node && node->key) {
-    if (memcmp(node->key, key, self->keySize) == 0) {
-      void* value = node->value;
-      MemFree(node->key);
-      if (last) {
-        last->next = node->next;
-        MemFree(node);
-      } else if (node->next)
-        *head = *node->next;
-      return value;
+bool HashMap_Next (HashMap* self, uint32* iterator, uint64* keyHash, void** value) {
+  for (uint32 i = *iterator; i < self->capacity; ++i) {
+    Node* node = self->elems + i;
+    if (node->value) {
+      if (keyHash) *keyHash = node->hash;
+      if (value) *value = node->value;
+      *iterator = i + 1;
+      return true;
     }
-    last = node;
-    node = node->next;
   }
+  *iterator = self->capacity;
+  return false;
+}
 
-  return 0;
+void* HashMap_Remove (HashMap* self, void const* key) {
+  return HashMap_RemoveRaw(self, Hash(key, self->keySize));
 }
-#endif
 
-void HashMap_Resize (HashMap* self, uint32 capacity) {
-  HashMap* other = HashMap_Create(self->keySize, capacity);
-  for (uint32 i = 0; i < self->capacity; ++i) {
-    Node* node = self->elems + i;
-    if (node->value)
-      HashMap_SetRaw(other, node->hash, node->value);
+void* HashMap_RemoveRaw (HashMap* self, uint64 hash) {
+  Node* node = HashMap_Find(self, hash);
+  if (!node)
+    return 0;
+
+  void* value = node->value;
+  uint32 index = (uint32)(node - self->elems);
+  for (;;) {
+    uint32 next = (index + 1) & self->mask;
+    Node* nextNode = self->elems + next;
+    if (!nextNode->value || HashMap_Distance(self, next, nextNode->hash) == 0)
+      break;
+    self->elems[index] = *nextNode;
+    index = next;
   }
 
-  MemFree(self->elems);
-  *self = *other;
+  self->elems[index].hash = 0;
+  self->elems[index].value = 0;
+  self->size--;
+  return value;
+}
+
+void HashMap_Resize (HashMap* self, uint32 capacity) {
+  uint32 minCapacity = (uint32)((float)self->size / self->maxLoad) + 1;
+  if (capacity < minCapacity)
+    capacity = minCapacity;
+
+  Node* elems = self->elems;
+  uint32 oldCapacity = self->capacity;
+  HashMap_Init(self, capacity);
+  for (uint32 i = 0; i < oldCapacity; ++i)
+    if (elems[i].value)
+      HashMap_Insert(self, elems[i].hash, elems[i].value);
+  MemFree(elems);
 }
 
 void HashMap_Set (HashMap* self, void const* key, void* value) {
@@ -112,20 +194,60 @@ void HashMap_Set (HashMap* self, void const* key, void* value) {
 }
 
 void HashMap_SetRaw (HashMap* self, uint64 hash, void* value) {
-  uint32 index = 0;
-  Node* node = self->elems + ((hash + index) & self->mask);
-  while (node->value && index < self->maxProbe) {
-    if (node->hash == hash) { node->value = value; return; }
-    index++;
-    node = self->elems + ((hash + index) & self->mask);
+  Node* node = HashMap_Find(self, hash);
+  if (node) {
+    if (value)
+      node->value = value;
+    else
+      HashMap_RemoveRaw(self, hash);
+    return;
   }
 
-  if (index >= self->maxProbe) {
+  if (!value)
+    return;
+  if (self->size >= self->maxSize)
     HashMap_Resize(self, self->capacity * 2);
-    HashMap_SetRaw(self, hash, value);
-  } else {
-    node->hash = hash;
-    node->value = value;
-    self->size++;
+  HashMap_Insert(self, hash, value);
+}
+
+void HashMap_SetMaxLoad (HashMap* self, float maxLoad) {
+  if (!(maxLoad > 0.0f && maxLoad < 1.0f))
+    Fatal("HashMap_SetMaxLoad: Load factor must be in (0, 1), got %f", maxLoad);
+  self->maxLoad = maxLoad;
+  self->maxSize = (uint32)((float)self->capacity * maxLoad);
+  if (self->maxSize >= self->capacity)
+    self->maxSize = self->capacity - 1;
+  if (self->size > self->maxSize)
+    HashMap_Resize(self, self->capacity);
+}
+
+uint32 HashMap_GetCapacity (HashMap* self) {
+  return self->capacity;
+}
+
+float HashMap_GetMaxLoad (HashMap* self) {
+  return self->maxLoad;
+}
+
+uint32 HashMap_GetSize (HashMap* self) {
+  return self->size;
+}
+
+void HashMap_GetProbeStats (HashMap* self, float* avgProbe, uint32* maxProbe) {
+  uint64 total = 0;
+  uint32 longest = 0;
+  for (uint32 i = 0; i < self->capacity; ++i) {
+    Node* node = self->elems + i;
+    if (node->value) {
+      uint32 distance = HashMap_Distance(self, i, node->hash);
+      total += distance;
+      longest = distance > longest ? distance : longest;
+    }
   }
+  if (avgProbe)
+    *avgProbe = self->size ? (float)((double)total / (double)self->size) : 0.0f;
+  if (maxProbe)
+    *maxProbe = longest;
 }
+
+#endif
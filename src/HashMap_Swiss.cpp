@@ -0,0 +1,297 @@
+#include "Hash.h"
+#include "HashMap.h"
+#include "PhxMemory.h"
+
+#if ENABLE_HASHMAP_SWISS
+
+#include <emmintrin.h>
+#if WINDOWS
+  #include <intrin.h>
+#endif
+
+/* NOTE : Swiss-table layout. Every slot has a control byte: EMPTY, DELETED,
+ *        or the top 7 bits of the slot's (mixed) hash. Probing loads 16
+ *        control bytes at a time and compares them against the wanted 7
+ *        bits with a single SSE2 instruction, so only slots whose tag
+ *        matches are ever touched. The first GROUP_SIZE control bytes are
+ *        mirrored past the end of the array so that a group starting near
+ *        the end can be loaded without wrapping.
+ *
+ *        Groups are visited with triangular steps (16, 32, 48, ...), which
+ *        covers the whole power-of-two table. Removal leaves a DELETED
+ *        marker; markers are purged when the table is rehashed. */
+
+#define GROUP_SIZE 16
+#define MIN_CAPACITY 16
+#define DEFAULT_MAX_LOAD 0.875f
+
+static int8 const kEmpty   = (int8)0x80;
+static int8 const kDeleted = (int8)0xFE;
+
+struct Node {
+  uint64 hash;
+  void*  value;
+};
+
+struct HashMap {
+  int8* ctrl;
+  Node* elems;
+  uint32 size;
+  uint32 deleted;
+  uint32 capacity;
+  uint32 mask;
+  uint32 shift;
+  uint32 keySize;
+  uint32 maxSize;
+  float maxLoad;
+};
+
+inline static uint64 Hash (void const* key, uint32 len) {
+  return Hash_XX64(key, len, 0x0ULL);
+}
+
+/* Mixing keeps raw keys such as pointers from clustering. Only the high bits
+ * of the product depend on every bit of the key, so both fields come from
+ * there: the top 7 bits form the control tag and the bits just below them
+ * pick the home position. */
+inline static uint64 HashMap_Mix (uint64 hash) {
+  return hash * 0x9E3779B97F4A7C15ULL;
+}
+
+inline static uint32 HashMap_Home (HashMap* self, uint64 mixed) {
+  return (uint32)(mixed >> self->shift) & self->mask;
+}
+
+inline static int8 HashMap_Tag (uint64 mixed) {
+  return (int8)(mixed >> 57);
+}
+
+inline static uint32 HashMap_LowestBit (uint32 mask) {
+#if WINDOWS
+  unsigned long index;
+  _BitScanForward(&index, mask);
+  return (uint32)index;
+#else
+  return (uint32)__builtin_ctz(mask);
+#endif
+}
+
+inline static void HashMap_SetCtrl (HashMap* self, uint32 index, int8 ctrl) {
+  self->ctrl[index] = ctrl;
+  if (index < GROUP_SIZE)
+    self->ctrl[self->capacity + index] = ctrl;
+}
+
+static void HashMap_Init (HashMap* self, uint32 capacity) {
+  uint32 c = MIN_CAPACITY;
+  while (c < capacity)
+    c <<= 1;
+
+  uint32 bits = 0;
+  while ((1U << bits) < c)
+    bits++;
+
+  self->ctrl = (int8*)MemAlloc(c + GROUP_SIZE);
+  MemSet(self->ctrl, kEmpty, c + GROUP_SIZE);
+  self->elems = MemNewArray(Node, c);
+  self->size = 0;
+  self->deleted = 0;
+  self->capacity = c;
+  self->mask = c - 1;
+  self->shift = 57 - bits;
+  self->maxSize = (uint32)((float)c * self->maxLoad);
+  if (self->maxSize >= c)
+    self->maxSize = c - 1;
+}
+
+static Node* HashMap_Find (HashMap* self, uint64 hash) {
+  uint64 mixed = HashMap_Mix(hash);
+  __m128i tag = _mm_set1_epi8(HashMap_Tag(mixed));
+  __m128i empty = _mm_set1_epi8(kEmpty);
+  uint32 pos = HashMap_Home(self, mixed);
+
+  for (uint32 step = GROUP_SIZE;; step += GROUP_SIZE) {
+    __m128i group = _mm_loadu_si128((__m128i const*)(self->ctrl + pos));
+    uint32 match = (uint32)_mm_movemask_epi8(_mm_cmpeq_epi8(group, tag));
+    while (match) {
+      Node* node = self->elems + ((pos + HashMap_LowestBit(match)) & self->mask);
+      if (node->hash == hash)
+        return node;
+      match &= match - 1;
+    }
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(group, empty)))
+      return 0;
+    pos = (pos + step) & self->mask;
+  }
+}
+
+/* Inserts a hash that is known not to be in the map. */
+static void HashMap_Insert (HashMap* self, uint64 hash, void* value) {
+  uint64 mixed = HashMap_Mix(hash);
+  uint32 pos = HashMap_Home(self, mixed);
+
+  for (uint32 step = GROUP_SIZE;; step += GROUP_SIZE) {
+    __m128i group = _mm_loadu_si128((__m128i const*)(self->ctrl + pos));
+    /* EMPTY and DELETED are the only control bytes with the sign bit set. */
+    uint32 avail = (uint32)_mm_movemask_epi8(group);
+    if (avail) {
+      uint32 index = (pos + HashMap_LowestBit(avail)) & self->mask;
+      if (self->ctrl[index] == kDeleted)
+        self->deleted--;
+      HashMap_SetCtrl(self, index, HashMap_Tag(mixed));
+      self->elems[index].hash = hash;
+      self->elems[index].value = value;
+      self->size++;
+      return;
+    }
+    pos = (pos + step) & self->mask;
+  }
+}
+
+HashMap* HashMap_Create (uint32 keySize, uint32 capacity) {
+  HashMap* self = MemNew(HashMap);
+  self->keySize = keySize;
+  self->maxLoad = DEFAULT_MAX_LOAD;
+  HashMap_Init(self, capacity);
+  return self;
+}
+
+void HashMap_Free (HashMap* self) {
+  MemFree(self->ctrl);
+  MemFree(self->elems);
+  MemFree(self);
+}
+
+void HashMap_Foreach (HashMap* self, ValueForeach fn, void* userData) {
+  for (uint32 i = 0; i < self->capacity; ++i)
+    if (self->ctrl[i] >= 0)
+      fn(self->elems[i].value, userData);
+}
+
+void* HashMap_Get (HashMap* self, void const* key) {
+  return HashMap_GetRaw(self, Hash(key, self->keySize));
+}
+
+void* HashMap_GetRaw (HashMap* self, uint64 hash) {
+  Node* node = HashMap_Find(self, hash);
+  return node ? node->value : 0;
+}
+
+bool HashMap_Next (HashMap* self, uint32* iterator, uint64* keyHash, void** value) {
+  for (uint32 i = *iterator; i < self->capacity; ++i) {
+    if (self->ctrl[i] >= 0) {
+      if (keyHash) *keyHash = self->elems[i].hash;
+      if (value) *value = self->elems[i].value;
+      *iterator = i + 1;
+      return true;
+    }
+  }
+  *iterator = self->capacity;
+  return false;
+}
+
+void* HashMap_Remove (HashMap* self, void const* key) {
+  return HashMap_RemoveRaw(self, Hash(key, self->keySize));
+}
+
+void* HashMap_RemoveRaw (HashMap* self, uint64 hash) {
+  Node* node = HashMap_Find(self, hash);
+  if (!node)
+    return 0;
+  void* value = node->value;
+  HashMap_SetCtrl(self, (uint32)(node - self->elems), kDeleted);
+  node->value = 0;
+  self->size--;
+  self->deleted++;
+  return value;
+}
+
+void HashMap_Resize (HashMap* self, uint32 capacity) {
+  uint32 minCapacity = (uint32)((float)self->size / self->maxLoad) + 1;
+  if (capacity < minCapacity)
+    capacity = minCapacity;
+
+  int8* ctrl = self->ctrl;
+  Node* elems = self->elems;
+  uint32 oldCapacity = self->capacity;
+  HashMap_Init(self, capacity);
+  for (uint32 i = 0; i < oldCapacity; ++i)
+    if (ctrl[i] >= 0)
+      HashMap_Insert(self, elems[i].hash, elems[i].value);
+  MemFree(ctrl);
+  MemFree(elems);
+}
+
+void HashMap_Set (HashMap* self, void const* key, void* value) {
+  HashMap_SetRaw(self, Hash(key, self->keySize), value);
+}
+
+void HashMap_SetRaw (HashMap* self, uint64 hash, void* value) {
+  Node* node = HashMap_Find(self, hash);
+  if (node) {
+    if (value)
+      node->value = value;
+    else
+      HashMap_RemoveRaw(self, hash);
+    return;
+  }
+
+  if (!value)
+    return;
+
+  /* DELETED markers lengthen probes like live elements do. When they are
+   * mostly what pushes the table over its load, rehash in place instead of
+   * growing. */
+  if (self->size + self->deleted >= self->maxSize) {
+    bool grow = (uint64)self->size * 8 > (uint64)self->maxSize * 7;
+    HashMap_Resize(self, grow ? self->capacity * 2 : self->capacity);
+  }
+  HashMap_Insert(self, hash, value);
+}
+
+void HashMap_SetMaxLoad (HashMap* self, float maxLoad) {
+  if (!(maxLoad > 0.0f && maxLoad < 1.0f))
+    Fatal("HashMap_SetMaxLoad: Load factor must be in (0, 1), got %f", maxLoad);
+  self->maxLoad = maxLoad;
+  self->maxSize = (uint32)((float)self->capacity * maxLoad);
+  if (self->maxSize >= self->capacity)
+    self->maxSize = self->capacity - 1;
+  if (self->size + self->deleted > self->maxSize)
+    HashMap_Resize(self, self->capacity);
+}
+
+uint32 HashMap_GetCapacity (HashMap* self) {
+  return self->capacity;
+}
+
+float HashMap_GetMaxLoad (HashMap* self) {
+  return self->maxLoad;
+}
+
+uint32 HashMap_GetSize (HashMap* self) {
+  return self->size;
+}
+
+void HashMap_GetProbeStats (HashMap* self, float* avgProbe, uint32* maxProbe) {
+  /* Probe length is measured in groups visited before the element's own. */
+  uint64 total = 0;
+  uint32 longest = 0;
+  for (uint32 i = 0; i < self->capacity; ++i) {
+    if (self->ctrl[i] < 0)
+      continue;
+    uint32 pos = HashMap_Home(self, HashMap_Mix(self->elems[i].hash));
+    uint32 probes = 0;
+    for (uint32 step = GROUP_SIZE; ((i - pos) & self->mask) >= GROUP_SIZE; step += GROUP_SIZE) {
+      pos = (pos + step) & self->mask;
+      probes++;
+    }
+    total += probes;
+    longest = probes > longest ? probes : longest;
+  }
+  if (avgProbe)
+    *avgProbe = self->size ? (float)((double)total / (double)self->size) : 0.0f;
+  if (maxProbe)
+    *maxProbe = longest;
+}
+
+#endif
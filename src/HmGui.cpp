@@ -7,6 +7,7 @@
 #include "HashMap.h"
 #include "HmGui.h"
 #include "Input.h"
+#include "MemArena.h"
 #include "PhxMemory.h"
 #include "PhxString.h"
 #include "Profiler.h"
@@ -103,7 +104,11 @@ struct HmGuiStyle {
   Vec4f colorText;
 };
 
+/* NOTE : The widget tree is rebuilt every frame, so widgets, their text and
+ *        clip rects all live in a single arena that HmGui_Begin clears. */
+
 struct HmGui {
+  MemArena* arena;
   HmGuiGroup* group;
   HmGuiGroup* root;
   HmGuiWidget* last;
@@ -121,8 +126,10 @@ static bool init = false;
 #include "HmGuiInternal.h"
 
 void HmGui_Begin (float sx, float sy) {
+  MEMTAG_BEGIN(MemTag_Gui);
   if (!init) {
     init = true;
+    self.arena = MemArena_Create(0x10000);
     self.group = 0;
     self.root = 0;
 
@@ -142,10 +149,8 @@ void HmGui_Begin (float sx, float sy) {
     self.activate = false;
   }
 
-  if (self.root) {
-    HmGui_FreeGroup(self.root);
-    self.root = 0;
-  }
+  MemArena_Clear(self.arena);
+  self.root = 0;
   self.last = 0;
   self.activate = Input_GetPressed(Button_Mouse_Left);
 
@@ -154,6 +159,7 @@ void HmGui_Begin (float sx, float sy) {
   self.group->pos = Vec2f_Create(0, 0);
   self.group->size = Vec2f_Create(sx, sy);
   self.root = self.group;
+  MEMTAG_END;
 }
 
 void HmGui_End () {
@@ -325,14 +331,14 @@ float HmGui_Slider (float lower, float upper, float value) {
 /* -------------------------------------------------------------------------- */
 
 void HmGui_Image (Tex2D* image) {
-  HmGuiImage* e = MemNew(HmGuiImage);
+  HmGuiImage* e = MemArena_New(self.arena, HmGuiImage);
   HmGui_InitWidget(e, Widget_Image);
   e->image = image;
   e->stretch = Vec2f_Create(1, 1);
 }
 
 void HmGui_Rect (float sx, float sy, float r, float g, float b, float a) {
-  HmGuiRect* e = MemNew(HmGuiRect);
+  HmGuiRect* e = MemArena_New(self.arena, HmGuiRect);
   HmGui_InitWidget(e, Widget_Rect);
   e->color = Vec4f_Create(r, g, b, a);
   e->minSize = Vec2f_Create(sx, sy);
@@ -347,10 +353,13 @@ void HmGui_TextColored (cstr text, float r, float g, float b, float a) {
 }
 
 void HmGui_TextEx (Font* font, cstr text, float r, float g, float b, float a) {
-  HmGuiText* e = MemNew(HmGuiText);
+  HmGuiText* e = MemArena_New(self.arena, HmGuiText);
   HmGui_InitWidget(e, Widget_Text);
   e->font = font;
-  e->text = StrDup(text);
+  uint32 len = (uint32)StrLen(text) + 1;
+  char* copy = MemArena_NewArray(self.arena, char, len);
+  MemCpy(copy, text, len);
+  e->text = copy;
   e->color = Vec4f_Create(r, g, b, a);
   Vec2i size; Font_GetSize2(e->font, &size, e->text);
   e->minSize = Vec2f_Create(size.x, size.y);
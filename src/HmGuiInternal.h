@@ -26,7 +26,7 @@ static void HmGui_InitWidget (HmGuiWidget* e, uint32 type) {
 }
 
 static void HmGui_BeginGroup (uint32 layout) {
-  HmGuiGroup* e = MemNew(HmGuiGroup);
+  HmGuiGroup* e = MemArena_New(self.arena, HmGuiGroup);
   HmGui_InitWidget(e, Widget_Group);
   e->head = 0;
   e->tail = 0;
@@ -58,35 +58,18 @@ static void HmGui_BeginGroup (uint32 layout) {
   }
 }
 
-static void HmGui_FreeText (HmGuiText* e) {
-  StrFree(e->text);
-  MemFree(e);
-}
-
-static void HmGui_FreeGroup (HmGuiGroup* g) {
-  HmGuiWidget* e = g->head;
-  while (e) {
-    HmGuiWidget* next = e->next;
-    switch (e->type) {
-      case Widget_Group: HmGui_FreeGroup((HmGuiGroup*)e); break;
-      case Widget_Text: HmGui_FreeText((HmGuiText*)e); break;
-      default: MemFree(e); break;
-    }
-    e = next;
-  }
-  MemFree(g);
-}
-
 /* -------------------------------------------------------------------------- */
 
 static HmGuiData* HmGui_GetData (HmGuiGroup* g) {
   HmGuiData* data = (HmGuiData*)HashMap_GetRaw(self.data, g->hash);
   if (!data) {
+    MEMTAG_BEGIN(MemTag_Gui);
     data = MemNew(HmGuiData);
     data->offset = Vec2f_Create(0, 0);
     data->minSize = Vec2f_Create(0, 0);
     data->size = Vec2f_Create(0, 0);
     HashMap_SetRaw(self.data, g->hash, data);
+    MEMTAG_END;
   }
   return data;
 }
@@ -94,7 +77,7 @@ static HmGuiData* HmGui_GetData (HmGuiGroup* g) {
 /* -------------------------------------------------------------------------- */
 
 static void HmGui_PushClipRect (HmGuiGroup* g) {
-  HmGuiClipRect* rect = MemNew(HmGuiClipRect);
+  HmGuiClipRect* rect = MemArena_New(self.arena, HmGuiClipRect);
   rect->prev = self.clipRect;
   rect->lower = g->pos;
   rect->upper = Vec2f_Add(g->pos, g->size);
@@ -108,9 +91,7 @@ static void HmGui_PushClipRect (HmGuiGroup* g) {
 }
 
 static void HmGui_PopClipRect () {
-  HmGuiClipRect* rect = self.clipRect;
-  self.clipRect = rect->prev;
-  MemFree(rect);
+  self.clipRect = self.clipRect->prev;
 }
 
 /* -------------------------------------------------------------------------- */
@@ -1,5 +1,9 @@
+#include "Box3.h"
 #include "Intersect.h"
 #include "Matrix.h"
+#include "MatrixDef.h"
+#include "OS.h"
+#include "PhxMemory.h"
 #include "Plane.h"
 #include "Polygon.h"
 #include "Ray.h"
@@ -9,6 +13,22 @@
 #include "Vec3.h"
 #include "Vec4.h"
 
+#include <float.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+  #define INTERSECT_SSE 1
+  #include <emmintrin.h>
+  #include <immintrin.h>
+
+  #if WINDOWS
+    #define INTERSECT_AVX_FN static
+  #else
+    #define INTERSECT_AVX_FN static __attribute__((target("avx")))
+  #endif
+#else
+  #define INTERSECT_SSE 0
+#endif
+
 /* NOTE: On Epsilons
  *  - PLANE_THICKNESS_EPSILON
  *
@@ -35,10 +55,9 @@
 /* TODO : Need to handle epsilons properly in these intersection tests */
 
 bool Intersect_PointBox (Matrix* src, Matrix* dst) {
-  Matrix* inv = Matrix_Inverse(dst);
+  Matrix inv; Matrix_IOInverse(dst, &inv);
   Vec3f srcPt; Matrix_GetPos(src, &srcPt);
-  Vec3f dstPt; Matrix_MulPoint(inv, &dstPt, UNPACK3(srcPt));
-  Matrix_Free(inv);
+  Vec3f dstPt; Matrix_MulPoint(&inv, &dstPt, UNPACK3(srcPt));
   return
     -1.0f < dstPt.x && dstPt.x < 1.0f &&
     -1.0f < dstPt.y && dstPt.y < 1.0f &&
@@ -362,6 +381,506 @@ bool Intersect_SphereTriangle (
   return false;
 }
 
+/* --- Wide Ray Tests ------------------------------------------------------- */
+
+/* The SIMD kernels mirror the scalar lane functions operation for operation,
+ * so under strict float semantics they agree exactly. The library is built
+ * with -ffast-math, though, which lets the compiler reorder either side; a
+ * triangle's t may then differ in the last few ulps. phx_bench --check holds
+ * the kernels to that. */
+
+inline static bool Intersect_RayTriangleLane (
+  Vec3f const* o, Vec3f const* d, TrianglePack const* p, int k, float* t)
+{
+  Vec3f v0 = { p->v0x[k], p->v0y[k], p->v0z[k] };
+  Vec3f e1 = { p->e1x[k], p->e1y[k], p->e1z[k] };
+  Vec3f e2 = { p->e2x[k], p->e2y[k], p->e2z[k] };
+  Vec3f pvec = Vec3f_Cross(*d, e2);
+  float det = Vec3f_Dot(e1, pvec);
+  Vec3f tvec = Vec3f_Sub(*o, v0);
+  float u = Vec3f_Dot(tvec, pvec);
+  Vec3f qvec = Vec3f_Cross(tvec, e1);
+  float v = Vec3f_Dot(*d, qvec);
+  float uv = u + v;
+
+  bool hit =
+    (det >  0.000001f && u >= 0 && u <= det && v >= 0 && uv <= det) ||
+    (det < -0.000001f && u <= 0 && u >= det && v <= 0 && uv >= det);
+  if (hit)
+    *t = Vec3f_Dot(e2, qvec) * (1.0f / det);
+  return hit;
+}
+
+inline static float Intersect_RayBoxLane (
+  float px, float py, float pz, float rdx, float rdy, float rdz,
+  float tMin, float tMax, BoxPack const* b, int k)
+{
+  float t1 = (b->lowerx[k] - px) * rdx;
+  float t2 = (b->upperx[k] - px) * rdx;
+  float tNear = Max(tMin, Min(t1, t2));
+  float tFar  = Min(tMax, Max(t1, t2));
+  t1 = (b->lowery[k] - py) * rdy;
+  t2 = (b->uppery[k] - py) * rdy;
+  tNear = Max(tNear, Min(t1, t2));
+  tFar  = Min(tFar,  Max(t1, t2));
+  t1 = (b->lowerz[k] - pz) * rdz;
+  t2 = (b->upperz[k] - pz) * rdz;
+  tNear = Max(tNear, Min(t1, t2));
+  tFar  = Min(tFar,  Max(t1, t2));
+  return tNear <= tFar ? tNear : FLT_MAX;
+}
+
+/* Keeps the first of equal t, matching a sequential loop over Moller1. */
+inline static void Intersect_KeepNearest (
+  int mask, float const* t, int base, int* best, float* bestT)
+{
+  for (int k = 0; mask; ++k, mask >>= 1) {
+    if ((mask & 1) && (*best < 0 || t[k] < *bestT)) {
+      *best = base + k;
+      *bestT = t[k];
+    }
+  }
+}
+
+#if INTERSECT_SSE
+
+/* Lane masks for the last, partially used group of four or eight. */
+inline static int Intersect_LaneMask (int remaining, int width) {
+  return remaining >= width ? (1 << width) - 1 : (1 << remaining) - 1;
+}
+
+static int Intersect_RayTrianglesSSE (
+  Ray const* ray, TrianglePack const* pack, int count, float* tHit)
+{
+  __m128 ox = _mm_set1_ps(ray->p.x);
+  __m128 oy = _mm_set1_ps(ray->p.y);
+  __m128 oz = _mm_set1_ps(ray->p.z);
+  __m128 dx = _mm_set1_ps(ray->dir.x);
+  __m128 dy = _mm_set1_ps(ray->dir.y);
+  __m128 dz = _mm_set1_ps(ray->dir.z);
+  __m128 eps = _mm_set1_ps(0.000001f);
+  __m128 negEps = _mm_set1_ps(-0.000001f);
+  __m128 zero = _mm_setzero_ps();
+  __m128 one = _mm_set1_ps(1.0f);
+
+  int best = -1;
+  float bestT = 0;
+  for (int i = 0; i < count; i += 4) {
+    TrianglePack const* p = pack + (i >> 3);
+    int k = i & 7;
+    __m128 e2x = _mm_loadu_ps(p->e2x + k);
+    __m128 e2y = _mm_loadu_ps(p->e2y + k);
+    __m128 e2z = _mm_loadu_ps(p->e2z + k);
+    __m128 px = _mm_sub_ps(_mm_mul_ps(e2z, dy), _mm_mul_ps(e2y, dz));
+    __m128 py = _mm_sub_ps(_mm_mul_ps(e2x, dz), _mm_mul_ps(e2z, dx));
+    __m128 pz = _mm_sub_ps(_mm_mul_ps(e2y, dx), _mm_mul_ps(e2x, dy));
+
+    __m128 e1x = _mm_loadu_ps(p->e1x + k);
+    __m128 e1y = _mm_loadu_ps(p->e1y + k);
+    __m128 e1z = _mm_loadu_ps(p->e1z + k);
+    __m128 det = _mm_add_ps(_mm_add_ps(
+      _mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+
+    __m128 tx = _mm_sub_ps(ox, _mm_loadu_ps(p->v0x + k));
+    __m128 ty = _mm_sub_ps(oy, _mm_loadu_ps(p->v0y + k));
+    __m128 tz = _mm_sub_ps(oz, _mm_loadu_ps(p->v0z + k));
+    __m128 u = _mm_add_ps(_mm_add_ps(
+      _mm_mul_ps(tx, px), _mm_mul_ps(ty, py)), _mm_mul_ps(tz, pz));
+
+    __m128 qx = _mm_sub_ps(_mm_mul_ps(e1z, ty), _mm_mul_ps(e1y, tz));
+    __m128 qy = _mm_sub_ps(_mm_mul_ps(e1x, tz), _mm_mul_ps(e1z, tx));
+    __m128 qz = _mm_sub_ps(_mm_mul_ps(e1y, tx), _mm_mul_ps(e1x, ty));
+    __m128 v = _mm_add_ps(_mm_add_ps(
+      _mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz));
+    __m128 uv = _mm_add_ps(u, v);
+
+    __m128 pos = _mm_and_ps(_mm_and_ps(
+      _mm_and_ps(_mm_cmpgt_ps(det, eps), _mm_cmpge_ps(u, zero)),
+      _mm_and_ps(_mm_cmple_ps(u, det), _mm_cmpge_ps(v, zero))),
+      _mm_cmple_ps(uv, det));
+    __m128 neg = _mm_and_ps(_mm_and_ps(
+      _mm_and_ps(_mm_cmplt_ps(det, negEps), _mm_cmple_ps(u, zero)),
+      _mm_and_ps(_mm_cmpge_ps(u, det), _mm_cmple_ps(v, zero))),
+      _mm_cmpge_ps(uv, det));
+
+    int mask = _mm_movemask_ps(_mm_or_ps(pos, neg)) & Intersect_LaneMask(count - i, 4);
+    if (!mask)
+      continue;
+
+    __m128 t = _mm_add_ps(_mm_add_ps(
+      _mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz));
+    float ts[4];
+    _mm_storeu_ps(ts, _mm_mul_ps(t, _mm_div_ps(one, det)));
+    Intersect_KeepNearest(mask, ts, i, &best, &bestT);
+  }
+
+  *tHit = bestT;
+  return best;
+}
+
+INTERSECT_AVX_FN int Intersect_RayTrianglesAVX (
+  Ray const* ray, TrianglePack const* pack, int count, float* tHit)
+{
+  __m256 ox = _mm256_set1_ps(ray->p.x);
+  __m256 oy = _mm256_set1_ps(ray->p.y);
+  __m256 oz = _mm256_set1_ps(ray->p.z);
+  __m256 dx = _mm256_set1_ps(ray->dir.x);
+  __m256 dy = _mm256_set1_ps(ray->dir.y);
+  __m256 dz = _mm256_set1_ps(ray->dir.z);
+  __m256 eps = _mm256_set1_ps(0.000001f);
+  __m256 negEps = _mm256_set1_ps(-0.000001f);
+  __m256 zero = _mm256_setzero_ps();
+  __m256 one = _mm256_set1_ps(1.0f);
+
+  int best = -1;
+  float bestT = 0;
+  for (int i = 0; i < count; i += 8) {
+    TrianglePack const* p = pack + (i >> 3);
+    __m256 e2x = _mm256_loadu_ps(p->e2x);
+    __m256 e2y = _mm256_loadu_ps(p->e2y);
+    __m256 e2z = _mm256_loadu_ps(p->e2z);
+    __m256 px = _mm256_sub_ps(_mm256_mul_ps(e2z, dy), _mm256_mul_ps(e2y, dz));
+    __m256 py = _mm256_sub_ps(_mm256_mul_ps(e2x, dz), _mm256_mul_ps(e2z, dx));
+    __m256 pz = _mm256_sub_ps(_mm256_mul_ps(e2y, dx), _mm256_mul_ps(e2x, dy));
+
+    __m256 e1x = _mm256_loadu_ps(p->e1x);
+    __m256 e1y = _mm256_loadu_ps(p->e1y);
+    __m256 e1z = _mm256_loadu_ps(p->e1z);
+    __m256 det = _mm256_add_ps(_mm256_add_ps(
+      _mm256_mul_ps(e1x, px), _mm256_mul_ps(e1y, py)), _mm256_mul_ps(e1z, pz));
+
+    __m256 tx = _mm256_sub_ps(ox, _mm256_loadu_ps(p->v0x));
+    __m256 ty = _mm256_sub_ps(oy, _mm256_loadu_ps(p->v0y));
+    __m256 tz = _mm256_sub_ps(oz, _mm256_loadu_ps(p->v0z));
+    __m256 u = _mm256_add_ps(_mm256_add_ps(
+      _mm256_mul_ps(tx, px), _mm256_mul_ps(ty, py)), _mm256_mul_ps(tz, pz));
+
+    __m256 qx = _mm256_sub_ps(_mm256_mul_ps(e1z, ty), _mm256_mul_ps(e1y, tz));
+    __m256 qy = _mm256_sub_ps(_mm256_mul_ps(e1x, tz), _mm256_mul_ps(e1z, tx));
+    __m256 qz = _mm256_sub_ps(_mm256_mul_ps(e1y, tx), _mm256_mul_ps(e1x, ty));
+    __m256 v = _mm256_add_ps(_mm256_add_ps(
+      _mm256_mul_ps(dx, qx), _mm256_mul_ps(dy, qy)), _mm256_mul_ps(dz, qz));
+    __m256 uv = _mm256_add_ps(u, v);
+
+    __m256 pos = _mm256_and_ps(_mm256_and_ps(
+      _mm256_and_ps(_mm256_cmp_ps(det, eps, _CMP_GT_OQ), _mm256_cmp_ps(u, zero, _CMP_GE_OQ)),
+      _mm256_and_ps(_mm256_cmp_ps(u, det, _CMP_LE_OQ), _mm256_cmp_ps(v, zero, _CMP_GE_OQ))),
+      _mm256_cmp_ps(uv, det, _CMP_LE_OQ));
+    __m256 neg = _mm256_and_ps(_mm256_and_ps(
+      _mm256_and_ps(_mm256_cmp_ps(det, negEps, _CMP_LT_OQ), _mm256_cmp_ps(u, zero, _CMP_LE_OQ)),
+      _mm256_and_ps(_mm256_cmp_ps(u, det, _CMP_GE_OQ), _mm256_cmp_ps(v, zero, _CMP_LE_OQ))),
+      _mm256_cmp_ps(uv, det, _CMP_GE_OQ));
+
+    int mask = _mm256_movemask_ps(_mm256_or_ps(pos, neg)) & Intersect_LaneMask(count - i, 8);
+    if (!mask)
+      continue;
+
+    __m256 t = _mm256_add_ps(_mm256_add_ps(
+      _mm256_mul_ps(e2x, qx), _mm256_mul_ps(e2y, qy)), _mm256_mul_ps(e2z, qz));
+    float ts[8];
+    _mm256_storeu_ps(ts, _mm256_mul_ps(t, _mm256_div_ps(one, det)));
+    Intersect_KeepNearest(mask, ts, i, &best, &bestT);
+  }
+  _mm256_zeroupper();
+
+  *tHit = bestT;
+  return best;
+}
+
+static int Intersect_RayBoxesSSE (
+  Ray const* ray, BoxPack const* pack, int count, float* tEnter)
+{
+  Vec3f rd = Vec3f_Rcp(ray->dir);
+  __m128 px = _mm_set1_ps(ray->p.x);
+  __m128 py = _mm_set1_ps(ray->p.y);
+  __m128 pz = _mm_set1_ps(ray->p.z);
+  __m128 rdx = _mm_set1_ps(rd.x);
+  __m128 rdy = _mm_set1_ps(rd.y);
+  __m128 rdz = _mm_set1_ps(rd.z);
+  __m128 tMin = _mm_set1_ps(ray->tMin);
+  __m128 tMax = _mm_set1_ps(ray->tMax);
+  __m128 miss = _mm_set1_ps(FLT_MAX);
+
+  int hits = 0;
+  for (int i = 0; i < count; i += 4) {
+    BoxPack const* b = pack + (i >> 3);
+    int k = i & 7;
+    __m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(b->lowerx + k), px), rdx);
+    __m128 t2 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(b->upperx + k), px), rdx);
+    __m128 tNear = _mm_max_ps(tMin, _mm_min_ps(t1, t2));
+    __m128 tFar  = _mm_min_ps(tMax, _mm_max_ps(t1, t2));
+    t1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(b->lowery + k), py), rdy);
+    t2 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(b->uppery + k), py), rdy);
+    tNear = _mm_max_ps(tNear, _mm_min_ps(t1, t2));
+    tFar  = _mm_min_ps(tFar,  _mm_max_ps(t1, t2));
+    t1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(b->lowerz + k), pz), rdz);
+    t2 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(b->upperz + k), pz), rdz);
+    tNear = _mm_max_ps(tNear, _mm_min_ps(t1, t2));
+    tFar  = _mm_min_ps(tFar,  _mm_max_ps(t1, t2));
+
+    __m128 hit = _mm_cmple_ps(tNear, tFar);
+    __m128 t = _mm_or_ps(_mm_and_ps(hit, tNear), _mm_andnot_ps(hit, miss));
+    int mask = _mm_movemask_ps(hit) & Intersect_LaneMask(count - i, 4);
+    if (count - i >= 4) {
+      _mm_storeu_ps(tEnter + i, t);
+    } else {
+      float ts[4];
+      _mm_storeu_ps(ts, t);
+      for (int j = 0; j < count - i; ++j)
+        tEnter[i + j] = ts[j];
+    }
+    for (; mask; mask &= mask - 1)
+      hits++;
+  }
+  return hits;
+}
+
+INTERSECT_AVX_FN int Intersect_RayBoxesAVX (
+  Ray const* ray, BoxPack const* pack, int count, float* tEnter)
+{
+  Vec3f rd = Vec3f_Rcp(ray->dir);
+  __m256 px = _mm256_set1_ps(ray->p.x);
+  __m256 py = _mm256_set1_ps(ray->p.y);
+  __m256 pz = _mm256_set1_ps(ray->p.z);
+  __m256 rdx = _mm256_set1_ps(rd.x);
+  __m256 rdy = _mm256_set1_ps(rd.y);
+  __m256 rdz = _mm256_set1_ps(rd.z);
+  __m256 tMin = _mm256_set1_ps(ray->tMin);
+  __m256 tMax = _mm256_set1_ps(ray->tMax);
+  __m256 miss = _mm256_set1_ps(FLT_MAX);
+
+  int hits = 0;
+  for (int i = 0; i < count; i += 8) {
+    BoxPack const* b = pack + (i >> 3);
+    __m256 t1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(b->lowerx), px), rdx);
+    __m256 t2 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(b->upperx), px), rdx);
+    __m256 tNear = _mm256_max_ps(tMin, _mm256_min_ps(t1, t2));
+    __m256 tFar  = _mm256_min_ps(tMax, _mm256_max_ps(t1, t2));
+    t1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(b->lowery), py), rdy);
+    t2 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(b->uppery), py), rdy);
+    tNear = _mm256_max_ps(tNear, _mm256_min_ps(t1, t2));
+    tFar  = _mm256_min_ps(tFar,  _mm256_max_ps(t1, t2));
+    t1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(b->lowerz), pz), rdz);
+    t2 = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(b->upperz), pz), rdz);
+    tNear = _mm256_max_ps(tNear, _mm256_min_ps(t1, t2));
+    tFar  = _mm256_min_ps(tFar,  _mm256_max_ps(t1, t2));
+
+    __m256 hit = _mm256_cmp_ps(tNear, tFar, _CMP_LE_OQ);
+    __m256 t = _mm256_blendv_ps(miss, tNear, hit);
+    int mask = _mm256_movemask_ps(hit) & Intersect_LaneMask(count - i, 8);
+    if (count - i >= 8) {
+      _mm256_storeu_ps(tEnter + i, t);
+    } else {
+      float ts[8];
+      _mm256_storeu_ps(ts, t);
+      for (int j = 0; j < count - i; ++j)
+        tEnter[i + j] = ts[j];
+    }
+    for (; mask; mask &= mask - 1)
+      hits++;
+  }
+  _mm256_zeroupper();
+  return hits;
+}
+
+static int Intersect_RayPacketBoxSSE (RayPacket const* rays, Box3f const* box) {
+  int mask = 0;
+  for (int k = 0; k < 8; k += 4) {
+    __m128 px = _mm_loadu_ps(rays->px + k);
+    __m128 py = _mm_loadu_ps(rays->py + k);
+    __m128 pz = _mm_loadu_ps(rays->pz + k);
+    __m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(box->lower.x), px), _mm_loadu_ps(rays->rdx + k));
+    __m128 t2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(box->upper.x), px), _mm_loadu_ps(rays->rdx + k));
+    __m128 tNear = _mm_max_ps(_mm_loadu_ps(rays->tMin + k), _mm_min_ps(t1, t2));
+    __m128 tFar  = _mm_min_ps(_mm_loadu_ps(rays->tMax + k), _mm_max_ps(t1, t2));
+    t1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(box->lower.y), py), _mm_loadu_ps(rays->rdy + k));
+    t2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(box->upper.y), py), _mm_loadu_ps(rays->rdy + k));
+    tNear = _mm_max_ps(tNear, _mm_min_ps(t1, t2));
+    tFar  = _mm_min_ps(tFar,  _mm_max_ps(t1, t2));
+    t1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(box->lower.z), pz), _mm_loadu_ps(rays->rdz + k));
+    t2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(box->upper.z), pz), _mm_loadu_ps(rays->rdz + k));
+    tNear = _mm_max_ps(tNear, _mm_min_ps(t1, t2));
+    tFar  = _mm_min_ps(tFar,  _mm_max_ps(t1, t2));
+    mask |= _mm_movemask_ps(_mm_cmple_ps(tNear, tFar)) << k;
+  }
+  return mask;
+}
+
+INTERSECT_AVX_FN int Intersect_RayPacketBoxAVX (RayPacket const* rays, Box3f const* box) {
+  __m256 px = _mm256_loadu_ps(rays->px);
+  __m256 py = _mm256_loadu_ps(rays->py);
+  __m256 pz = _mm256_loadu_ps(rays->pz);
+  __m256 t1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(box->lower.x), px), _mm256_loadu_ps(rays->rdx));
+  __m256 t2 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(box->upper.x), px), _mm256_loadu_ps(rays->rdx));
+  __m256 tNear = _mm256_max_ps(_mm256_loadu_ps(rays->tMin), _mm256_min_ps(t1, t2));
+  __m256 tFar  = _mm256_min_ps(_mm256_loadu_ps(rays->tMax), _mm256_max_ps(t1, t2));
+  t1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(box->lower.y), py), _mm256_loadu_ps(rays->rdy));
+  t2 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(box->upper.y), py), _mm256_loadu_ps(rays->rdy));
+  tNear = _mm256_max_ps(tNear, _mm256_min_ps(t1, t2));
+  tFar  = _mm256_min_ps(tFar,  _mm256_max_ps(t1, t2));
+  t1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(box->lower.z), pz), _mm256_loadu_ps(rays->rdz));
+  t2 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(box->upper.z), pz), _mm256_loadu_ps(rays->rdz));
+  tNear = _mm256_max_ps(tNear, _mm256_min_ps(t1, t2));
+  tFar  = _mm256_min_ps(tFar,  _mm256_max_ps(t1, t2));
+  int mask = _mm256_movemask_ps(_mm256_cmp_ps(tNear, tFar, _CMP_LE_OQ));
+  _mm256_zeroupper();
+  return mask;
+}
+
+#endif
+
+static int Intersect_RayTrianglesScalar (
+  Ray const* ray, TrianglePack const* pack, int count, float* tHit)
+{
+  int best = -1;
+  float bestT = 0;
+  for (int i = 0; i < count; ++i) {
+    float t;
+    if (Intersect_RayTriangleLane(&ray->p, &ray->dir, pack + (i >> 3), i & 7, &t))
+      Intersect_KeepNearest(1, &t, i, &best, &bestT);
+  }
+  *tHit = bestT;
+  return best;
+}
+
+static int Intersect_RayBoxesScalar (
+  Ray const* ray, BoxPack const* pack, int count, float* tEnter)
+{
+  Vec3f rd = Vec3f_Rcp(ray->dir);
+  int hits = 0;
+  for (int i = 0; i < count; ++i) {
+    tEnter[i] = Intersect_RayBoxLane(
+      ray->p.x, ray->p.y, ray->p.z, rd.x, rd.y, rd.z,
+      ray->tMin, ray->tMax, pack + (i >> 3), i & 7);
+    hits += tEnter[i] != FLT_MAX;
+  }
+  return hits;
+}
+
+static int Intersect_RayPacketBoxScalar (RayPacket const* rays, Box3f const* box) {
+  BoxPack b;
+  for (int k = 0; k < 8; ++k) {
+    b.lowerx[k] = box->lower.x; b.lowery[k] = box->lower.y; b.lowerz[k] = box->lower.z;
+    b.upperx[k] = box->upper.x; b.uppery[k] = box->upper.y; b.upperz[k] = box->upper.z;
+  }
+
+  int mask = 0;
+  for (int k = 0; k < 8; ++k) {
+    float t = Intersect_RayBoxLane(
+      rays->px[k], rays->py[k], rays->pz[k], rays->rdx[k], rays->rdy[k], rays->rdz[k],
+      rays->tMin[k], rays->tMax[k], &b, k);
+    if (t != FLT_MAX)
+      mask |= 1 << k;
+  }
+  return mask;
+}
+
+static int wideKernel = Intersect_WideAuto;
+
+inline static int Intersect_GetWideKernel () {
+#if INTERSECT_SSE
+  if (wideKernel == Intersect_WideAuto)
+    return OS_HasAVX() ? Intersect_WideAVX : Intersect_WideSSE;
+  return wideKernel;
+#else
+  return Intersect_WideScalar;
+#endif
+}
+
+void Intersect_PackBoxes (Box3f const* boxes, int count, BoxPack* out) {
+  /* Padding lanes are empty boxes at +infinity. The slab test orders each
+   * axis' two planes itself, so an inverted box would still be hit; a box
+   * at infinity puts every slab at t = +/-infinity, which no ray with a
+   * finite [tMin, tMax] reaches. A finite far corner would not do: a
+   * diagonal ray with tMax = FLT_MAX meets all of its slabs at once. */
+  float const inf = INFINITY;
+  for (int i = 0; i < (count + 7) / 8 * 8; ++i) {
+    BoxPack* b = out + (i >> 3);
+    int k = i & 7;
+    Box3f box = i < count ? boxes[i] : Box3f_Create(
+      Vec3f_Create(inf, inf, inf),
+      Vec3f_Create(inf, inf, inf));
+    b->lowerx[k] = box.lower.x; b->lowery[k] = box.lower.y; b->lowerz[k] = box.lower.z;
+    b->upperx[k] = box.upper.x; b->uppery[k] = box.upper.y; b->upperz[k] = box.upper.z;
+  }
+}
+
+void Intersect_PackRays (Ray const* rays, int count, RayPacket* out) {
+  if (count > 8)
+    Fatal("Intersect_PackRays: A packet holds at most 8 rays, got %d", count);
+
+  /* Padding lanes get an empty [tMin, tMax] interval. */
+  for (int k = 0; k < 8; ++k) {
+    Ray const* ray = rays + k;
+    bool used = k < count;
+    Vec3f rd = used ? Vec3f_Rcp(ray->dir) : Vec3f_Create(1, 1, 1);
+    out->px[k] = used ? ray->p.x : 0;
+    out->py[k] = used ? ray->p.y : 0;
+    out->pz[k] = used ? ray->p.z : 0;
+    out->rdx[k] = rd.x;
+    out->rdy[k] = rd.y;
+    out->rdz[k] = rd.z;
+    out->tMin[k] = used ? ray->tMin : 1;
+    out->tMax[k] = used ? ray->tMax : 0;
+  }
+}
+
+void Intersect_PackTriangles (Triangle const* triangles, int count, TrianglePack* out) {
+  /* Padding lanes are degenerate triangles, whose determinant is zero. */
+  MemZero(out, sizeof(TrianglePack) * ((count + 7) / 8));
+  for (int i = 0; i < count; ++i) {
+    TrianglePack* p = out + (i >> 3);
+    int k = i & 7;
+    Vec3f const* vt = triangles[i].vertices;
+    Vec3f e1 = Vec3f_Sub(vt[1], vt[0]);
+    Vec3f e2 = Vec3f_Sub(vt[2], vt[0]);
+    p->v0x[k] = vt[0].x; p->v0y[k] = vt[0].y; p->v0z[k] = vt[0].z;
+    p->e1x[k] = e1.x;    p->e1y[k] = e1.y;    p->e1z[k] = e1.z;
+    p->e2x[k] = e2.x;    p->e2y[k] = e2.y;    p->e2z[k] = e2.z;
+  }
+}
+
+int Intersect_RayBoxes (Ray const* ray, BoxPack const* pack, int count, float* tEnter) {
+  switch (Intersect_GetWideKernel()) {
+#if INTERSECT_SSE
+    case Intersect_WideAVX: return Intersect_RayBoxesAVX(ray, pack, count, tEnter);
+    case Intersect_WideSSE: return Intersect_RayBoxesSSE(ray, pack, count, tEnter);
+#endif
+    default: return Intersect_RayBoxesScalar(ray, pack, count, tEnter);
+  }
+}
+
+int Intersect_RayPacketBox (RayPacket const* rays, Box3f const* box) {
+  switch (Intersect_GetWideKernel()) {
+#if INTERSECT_SSE
+    case Intersect_WideAVX: return Intersect_RayPacketBoxAVX(rays, box);
+    case Intersect_WideSSE: return Intersect_RayPacketBoxSSE(rays, box);
+#endif
+    default: return Intersect_RayPacketBoxScalar(rays, box);
+  }
+}
+
+int Intersect_RayTriangles (Ray const* ray, TrianglePack const* pack, int count, float* tHit) {
+  switch (Intersect_GetWideKernel()) {
+#if INTERSECT_SSE
+    case Intersect_WideAVX: return Intersect_RayTrianglesAVX(ray, pack, count, tHit);
+    case Intersect_WideSSE: return Intersect_RayTrianglesSSE(ray, pack, count, tHit);
+#endif
+    default: return Intersect_RayTrianglesScalar(ray, pack, count, tHit);
+  }
+}
+
+bool Intersect_SetWideKernel (int kernel) {
+  bool available =
+    kernel == Intersect_WideAuto ||
+    kernel == Intersect_WideScalar ||
+    (INTERSECT_SSE && kernel == Intersect_WideSSE) ||
+    (INTERSECT_SSE && kernel == Intersect_WideAVX && OS_HasAVX());
+  if (available)
+    wideKernel = kernel;
+  return available;
+}
+
 #if 0
 /* TODO : This is not yet working properly
  * TODO : Need to precompute index of the largest normal component */
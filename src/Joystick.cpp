@@ -95,7 +95,7 @@ void Joystick_Close (Joystick* self) {
   }
 
   SDL_JoystickClose(self->handle);
-  MemFree(self->guid);
+  StrFree(self->guid);
   MemFree(self->buttonStates);
   MemFree(self->axisStates);
   MemFree(self);
@@ -1,5 +1,6 @@
 #include "Draw.h"
 #include "KDTree.h"
+#include "MemArena.h"
 #include "PhxMemory.h"
 #include "Mesh.h"
 #include "Vertex.h"
@@ -56,20 +57,14 @@ static KDTree* Partition (Box3f* boxes, int boxCount, int dim) {
   if (dim == 1) qsort(boxes, boxCount, sizeof(Box3f), compareLowerY);
   if (dim == 2) qsort(boxes, boxCount, sizeof(Box3f), compareLowerZ);
 
+  /* The halves are disjoint and this node is done with them once sorted, so
+   * the children can sort them in place. */
   int boxCountBack = boxCount / 2;
   int boxCountFront = boxCount - boxCountBack;
-  Box3f* boxesBack = MemNewArray(Box3f, boxCountBack);
-  Box3f* boxesFront = MemNewArray(Box3f, boxCountFront);
-  MemCpy(boxesBack, boxes, boxCountBack * sizeof(Box3f));
-  MemCpy(boxesFront, boxes + boxCountBack, boxCountFront * sizeof(Box3f));
-
-  self->back = Partition(boxesBack, boxCountBack, (dim + 1) % 3);
-  self->front = Partition(boxesFront, boxCountFront, (dim + 1) % 3);
+  self->back = Partition(boxes, boxCountBack, (dim + 1) % 3);
+  self->front = Partition(boxes + boxCountBack, boxCountFront, (dim + 1) % 3);
   self->box = Box3f_Union(self->back->box, self->front->box);
   self->elems = 0;
-
-  MemFree(boxesBack);
-  MemFree(boxesFront);
   return self;
 }
 
@@ -79,7 +74,10 @@ KDTree* KDTree_FromMesh (Mesh* mesh) {
   Vertex const* vertexData = Mesh_GetVertexData(mesh);
 
   int const boxCount = indexCount / 3;
-  Box3f* boxes = MemNewArray(Box3f, boxCount);
+  MEMTAG_BEGIN(MemTag_Collision);
+  MemArena* scratch = MemArena_GetScratch();
+  uint64 marker = MemArena_GetMarker(scratch);
+  Box3f* boxes = MemArena_NewArray(scratch, Box3f, boxCount);
 
   for (int i = 0; i < indexCount; i += 3) {
     Vertex const* v0 = vertexData + indexData[i + 0];
@@ -91,7 +89,8 @@ KDTree* KDTree_FromMesh (Mesh* mesh) {
   }
 
   KDTree* self = Partition(boxes, boxCount, 0);
-  MemFree(boxes);
+  MemArena_Rewind(scratch, marker);
+  MEMTAG_END;
   return self;
 }
 
@@ -1,28 +1,119 @@
+#include "ArrayList.h"
 #include "LodMesh.h"
+#include "PhxMath.h"
 #include "PhxMemory.h"
 #include "Mesh.h"
 #include "RefCounted.h"
+#include "Vec3.h"
 
-/* TODO : Merge meshes into single IBO/VBO so that we can skip all the rebinds
- *        (profiling shows that they are a huge perf drain in the rendering
- *         pipeline) */
+#include <float.h>
+
+/* NOTE : Every component is appended to one packed mesh so that the entire
+ *        LodMesh lives in a single VBO/IBO. Components are drawn as index
+ *        ranges of that buffer, hence switching LODs (or drawing many
+ *        instances at different LODs) costs no rebinds. The packed mesh is
+ *        rebuilt whenever a component's version changes. */
 
 struct LodMeshEntry {
-  LodMeshEntry* next;
   Mesh* mesh;
   float dMin;
   float dMax;
+  uint64 version;
+  int32 indexOffset;
+  int32 indexCount;
+};
+
+struct LodLevel {
+  int32 entry;
+  float error;
 };
 
 struct LodMesh {
   RefCounted;
-  LodMeshEntry* head;
+  Mesh* packed;
+  float hysteresis;
+  ArrayList(LodMeshEntry, entry);
+  ArrayList(LodLevel, level);
 };
 
+static void LodMesh_Pack (LodMesh* self) {
+  bool dirty = !self->packed;
+  ArrayList_ForEach(self->entry, LodMeshEntry, e)
+    dirty |= e->version != Mesh_GetVersion(e->mesh);
+  if (!dirty)
+    return;
+
+  int vertexCount = 0;
+  int indexCount = 0;
+  ArrayList_ForEach(self->entry, LodMeshEntry, e) {
+    vertexCount += Mesh_GetVertexCount(e->mesh);
+    indexCount += Mesh_GetIndexCount(e->mesh);
+  }
+
+  if (self->packed)
+    Mesh_Free(self->packed);
+  self->packed = Mesh_Create();
+  Mesh_ReserveVertexData(self->packed, vertexCount);
+  Mesh_ReserveIndexData(self->packed, indexCount);
+
+  ArrayList_ForEach(self->entry, LodMeshEntry, e) {
+    e->indexOffset = Mesh_GetIndexCount(self->packed);
+    e->indexCount = Mesh_GetIndexCount(e->mesh);
+    e->version = Mesh_GetVersion(e->mesh);
+    Mesh_AddMesh(self->packed, e->mesh);
+  }
+}
+
+static LodMeshEntry* LodMesh_AddEntry (LodMesh* self, Mesh* mesh) {
+  ArrayList_Grow(self->entry);
+  LodMeshEntry* e = self->entry_data + (self->entry_size++);
+  e->mesh = mesh;
+  e->dMin = FLT_MAX;
+  e->dMax = -FLT_MAX;
+  e->version = 0;
+  e->indexOffset = 0;
+  e->indexCount = 0;
+  return e;
+}
+
+/* Picks the coarsest level whose error fits in 'budget' (world units). Moving
+ * to a coarser level than 'current' additionally requires fitting within the
+ * tighter 'coarsenBudget'. */
+inline static int LodMesh_SelectFromBudget (
+  LodMesh* self,
+  float budget,
+  float coarsenBudget,
+  int current)
+{
+  int levels = self->level_size;
+  LodLevel const* level = self->level_data;
+  if (!levels)
+    return -1;
+
+  int desired = 0;
+  for (int i = levels - 1; i > 0; --i) {
+    if (level[i].error <= budget) {
+      desired = i;
+      break;
+    }
+  }
+
+  if (current < 0 || current >= levels || desired <= current)
+    return desired;
+
+  for (int i = desired; i > current; --i)
+    if (level[i].error <= coarsenBudget)
+      return i;
+  return current;
+}
+
 LodMesh* LodMesh_Create () {
   LodMesh* self = MemNew(LodMesh);
   RefCounted_Init(self);
-  self->head = 0;
+  self->packed = 0;
+  self->hysteresis = 0.1f;
+  ArrayList_Init(self->entry);
+  ArrayList_Init(self->level);
   return self;
 }
 
@@ -32,35 +123,124 @@ void LodMesh_Acquire (LodMesh* self) {
 
 void LodMesh_Free (LodMesh* self) {
   RefCounted_Free(self) {
-    LodMeshEntry* e = self->head;
-    while (e) {
-      LodMeshEntry* next = e->next;
+    ArrayList_ForEach(self->entry, LodMeshEntry, e)
       Mesh_Free(e->mesh);
-      MemFree(e);
-      e = next;
-    }
+    ArrayList_Free(self->entry);
+    ArrayList_Free(self->level);
+    if (self->packed)
+      Mesh_Free(self->packed);
     MemFree(self);
   }
 }
 
 void LodMesh_Add (LodMesh* self, Mesh* mesh, float dMin, float dMax) {
-  LodMeshEntry* e = MemNew(LodMeshEntry);
-  e->mesh = mesh;
+  LodMeshEntry* e = LodMesh_AddEntry(self, mesh);
   e->dMin = dMin * dMin;
   e->dMax = dMax * dMax;
-  e->next = self->head;
-  self->head = e;
 }
 
 void LodMesh_Draw (LodMesh* self, float d2) {
-  for (LodMeshEntry* e = self->head; e; e = e->next)
-    if (e->dMin <= d2 && d2 <= e->dMax)
-      Mesh_Draw(e->mesh);
+  bool bound = false;
+  ArrayList_ForEachReverse(self->entry, LodMeshEntry, e) {
+    if (e->dMin <= d2 && d2 <= e->dMax) {
+      if (!bound) {
+        LodMesh_DrawBind(self);
+        bound = true;
+      }
+      Mesh_DrawBoundRange(self->packed, e->indexOffset, e->indexCount);
+    }
+  }
+  if (bound)
+    LodMesh_DrawUnbind(self);
 }
 
 Mesh* LodMesh_Get (LodMesh* self, float d2) {
-  for (LodMeshEntry* e = self->head; e; e = e->next)
+  ArrayList_ForEachReverse(self->entry, LodMeshEntry, e)
     if (e->dMin <= d2 && d2 <= e->dMax)
       return e->mesh;
   return 0;
 }
+
+void LodMesh_AddLevel (LodMesh* self, Mesh* mesh, float error) {
+  LodMesh_AddEntry(self, mesh);
+  LodLevel level = { self->entry_size - 1, error };
+
+  /* Keep levels sorted from finest to coarsest. */
+  int i = self->level_size;
+  ArrayList_Grow(self->level);
+  for (; i > 0 && self->level_data[i - 1].error > error; --i)
+    self->level_data[i] = self->level_data[i - 1];
+  self->level_data[i] = level;
+  self->level_size++;
+}
+
+float LodMesh_GetHysteresis (LodMesh* self) {
+  return self->hysteresis;
+}
+
+Mesh* LodMesh_GetLevel (LodMesh* self, int level) {
+  return self->entry_data[self->level_data[level].entry].mesh;
+}
+
+int LodMesh_GetLevelCount (LodMesh* self) {
+  return self->level_size;
+}
+
+float LodMesh_GetLevelError (LodMesh* self, int level) {
+  return self->level_data[level].error;
+}
+
+void LodMesh_SetHysteresis (LodMesh* self, float hysteresis) {
+  self->hysteresis = Clamp(hysteresis, 0.0f, 1.0f);
+}
+
+int LodMesh_SelectLevel (
+  LodMesh* self,
+  float distance,
+  float pixelScale,
+  float maxError,
+  int current)
+{
+  float budget = maxError * Max(distance, 0.0f) / pixelScale;
+  return LodMesh_SelectFromBudget(self, budget, budget * (1.0f - self->hysteresis), current);
+}
+
+void LodMesh_SelectLevels (
+  LodMesh* self,
+  Vec3f const* eye,
+  Vec3f const* positions,
+  int count,
+  float pixelScale,
+  float maxError,
+  int32* levels)
+{
+  /* Fold the per-instance projection into a single scale so that each
+   * instance costs one distance and a short scan over level errors. */
+  float scale = maxError / pixelScale;
+  float coarsen = 1.0f - self->hysteresis;
+  Vec3f e = *eye;
+  for (int i = 0; i < count; ++i) {
+    float budget = scale * Vec3f_Distance(positions[i], e);
+    levels[i] = LodMesh_SelectFromBudget(self, budget, budget * coarsen, levels[i]);
+  }
+}
+
+void LodMesh_DrawBind (LodMesh* self) {
+  LodMesh_Pack(self);
+  Mesh_DrawBind(self->packed);
+}
+
+void LodMesh_DrawBoundLevel (LodMesh* self, int level) {
+  LodMeshEntry* e = self->entry_data + self->level_data[level].entry;
+  Mesh_DrawBoundRange(self->packed, e->indexOffset, e->indexCount);
+}
+
+void LodMesh_DrawUnbind (LodMesh* self) {
+  Mesh_DrawUnbind(self->packed);
+}
+
+void LodMesh_DrawLevel (LodMesh* self, int level) {
+  LodMesh_DrawBind(self);
+  LodMesh_DrawBoundLevel(self, level);
+  LodMesh_DrawUnbind(self);
+}
@@ -1,5 +1,6 @@
 #include "ArrayList.h"
 #include "Lua.h"
+#include "Metric.h"
 #include "PhxMemory.h"
 #include "PhxSignal.h"
 #include "PhxString.h"
@@ -71,6 +72,7 @@ static void Lua_InitExtensions (Lua* self) {
   Lua_SetFn(self, "Call", Lua_CallBarrier);
   LuaScheduler_Init(self);
   LuaScheduler_Register(self);
+  LuaProfiler_Register(self);
 }
 
 Lua* Lua_Create () {
@@ -92,6 +94,8 @@ Lua* Lua_CreateThread (Lua* self) {
 }
 
 void Lua_Free (Lua* self) {
+  LuaProfiler_Free(self);
+  LuaScheduler_Free(self);
   lua_close(self);
 }
 
@@ -199,6 +203,7 @@ void Lua_GCSetActive (Lua* self, bool active) {
 }
 
 void Lua_GCStep (Lua* self) {
+  Metric_Inc(Metric_LuaGCSteps);
   lua_gc(self, LUA_GCSTEP, 0);
 }
 
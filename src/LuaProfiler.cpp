@@ -0,0 +1,170 @@
+#include "Lua.h"
+#include "PhxMath.h"
+#include "PhxString.h"
+#include "Profiler.h"
+#include "StrMap.h"
+#include "luajit/luajit.h"
+
+#include <stdio.h>
+
+/* NOTE : Samples are delivered by LuaJIT on the profiled Lua state's own
+ *        thread, at the next safe point after the timer fires, so the
+ *        callback may freely call back into the Profiler. Like the
+ *        scheduler, the sampler is global and may profile a single Lua
+ *        state at a time. */
+
+#define MAX_NATIVE_DEPTH 32
+#define MAX_STACK_LENGTH 4096
+
+struct LuaProfiler {
+  Lua* lua;
+  StrMap* folded;
+  double interval;
+  int depth;
+  bool lines;
+  char name[256];
+  char stack[MAX_STACK_LENGTH];
+} static self;
+
+/* Appends 'len' bytes of 'src' at 'pos', truncating at the end of the stack
+ * buffer. Returns the new position. Frame names come from chunk names, which
+ * may hold anything; line breaks would split the folded line, so they become
+ * spaces. (Quotes and backslashes are left alone here and escaped wherever
+ * the names are written as JSON.) */
+inline static size_t LuaProfiler_Append (size_t pos, cstr src, size_t len) {
+  len = Min((int)len, (int)(MAX_STACK_LENGTH - 1 - pos));
+  for (size_t i = 0; i < len; ++i) {
+    char c = src[i];
+    self.stack[pos + i] = c == '\n' || c == '\r' ? ' ' : c;
+  }
+  return pos + len;
+}
+
+static void LuaProfiler_Callback (void*, Lua* L, int samples, int vmstate) {
+  size_t len;
+  cstr leaf;
+
+  /* Attribute the time to the innermost Lua function, or to the VM itself
+   * while it is collecting garbage or compiling traces. */
+  if (vmstate == 'G') {
+    leaf = "[Lua GC]";
+    len = StrLen(leaf);
+  } else if (vmstate == 'J') {
+    leaf = "[Lua JIT]";
+    len = StrLen(leaf);
+  } else {
+    leaf = luaJIT_profile_dumpstack(L, self.lines ? "l" : "F", 1, &len);
+  }
+  snprintf(self.name, sizeof(self.name), "[Lua] %.*s", (int)len, leaf);
+  Profiler_AddSample(self.name, samples * self.interval);
+
+  if (self.depth <= 0)
+    return;
+
+  /* Folded stack: native scopes, then Lua frames, outermost first. */
+  size_t pos = 0;
+  cstr native[MAX_NATIVE_DEPTH];
+  int nativeCount = Profiler_GetStack(native, MAX_NATIVE_DEPTH);
+  for (int i = 0; i < nativeCount; ++i) {
+    pos = LuaProfiler_Append(pos, native[i], StrLen(native[i]));
+    pos = LuaProfiler_Append(pos, ";", 1);
+  }
+
+  cstr frames = luaJIT_profile_dumpstack(L, self.lines ? "lZ;" : "FZ;", -self.depth, &len);
+  pos = LuaProfiler_Append(pos, frames, len);
+  if (vmstate == 'G' || vmstate == 'J') {
+    pos = LuaProfiler_Append(pos, ";", 1);
+    pos = LuaProfiler_Append(pos, leaf, StrLen(leaf));
+  }
+  self.stack[pos] = 0;
+
+  uint64 hash = StrMap_Hash(self.stack);
+  size_t count = (size_t)StrMap_GetHashed(self.folded, self.stack, hash);
+  StrMap_SetHashed(self.folded, self.stack, hash, (void*)(count + samples));
+}
+
+void LuaProfiler_Start (Lua* L, int intervalMs, int depth, bool lines) {
+  if (self.lua) {
+    Warn("LuaProfiler_Start: Sampler is already running; restarting");
+    LuaProfiler_Stop();
+  }
+
+  intervalMs = Max(intervalMs, 1);
+  char mode[32];
+  snprintf(mode, sizeof(mode), "%ci%d", lines ? 'l' : 'f', intervalMs);
+
+  if (!self.folded)
+    self.folded = StrMap_Create(256);
+  self.lua = L;
+  self.interval = intervalMs / 1000.0;
+  self.depth = depth;
+  self.lines = lines;
+  luaJIT_profile_start(L, mode, LuaProfiler_Callback, 0);
+}
+
+void LuaProfiler_Stop () {
+  if (!self.lua)
+    return;
+  luaJIT_profile_stop(self.lua);
+  self.lua = 0;
+}
+
+void LuaProfiler_Reset () {
+  if (self.folded) {
+    StrMap_Free(self.folded);
+    self.folded = StrMap_Create(256);
+  }
+}
+
+bool LuaProfiler_WriteFolded (cstr path) {
+  FILE* file = fopen(path, "wb");
+  if (!file) {
+    Warn("LuaProfiler_WriteFolded: Failed to open <%s>", path);
+    return false;
+  }
+
+  if (self.folded) {
+    StrMapIter* it = StrMap_Iterate(self.folded);
+    for (; StrMapIter_HasMore(it); StrMapIter_Advance(it))
+      fprintf(file, "%s %llu\n",
+        StrMapIter_GetKey(it),
+        (unsigned long long)(size_t)StrMapIter_GetValue(it));
+    StrMapIter_Free(it);
+  }
+
+  fclose(file);
+  return true;
+}
+
+/* -- Script Bindings ------------------------------------------------------- */
+
+/* (intervalMs, depth, lines) */
+static int LuaProfiler_StartFn (Lua* L) {
+  int intervalMs = (int)luaL_optinteger(L, 1, 1);
+  int depth = (int)luaL_optinteger(L, 2, 64);
+  bool lines = lua_toboolean(L, 3) != 0;
+  LuaProfiler_Start(L, intervalMs, depth, lines);
+  return 0;
+}
+
+static int LuaProfiler_StopFn (Lua*) {
+  LuaProfiler_Stop();
+  return 0;
+}
+
+/* (path) */
+static int LuaProfiler_WriteFoldedFn (Lua* L) {
+  lua_pushboolean(L, LuaProfiler_WriteFolded(luaL_checkstring(L, 1)));
+  return 1;
+}
+
+void LuaProfiler_Free (Lua* L) {
+  if (self.lua == L)
+    LuaProfiler_Stop();
+}
+
+void LuaProfiler_Register (Lua* L) {
+  Lua_SetFn(L, "ProfileStart", LuaProfiler_StartFn);
+  Lua_SetFn(L, "ProfileStop", LuaProfiler_StopFn);
+  Lua_SetFn(L, "ProfileWriteFolded", LuaProfiler_WriteFoldedFn);
+}
@@ -2,116 +2,276 @@
 #include "Lua.h"
 #include "TimeStamp.h"
 
-#include <stdlib.h>
-
 /* WARNING : Scheduler is currently global, hence the entire scheduling
- *           mechanism may be used from only a single Lua instance! We can
- *           improve this in the future. */
+ *           mechanism may be used from only a single Lua instance! The first
+ *           state to be created owns it; later states neither reset it nor
+ *           receive the scheduling globals. We can improve this in the
+ *           future. */
 
-/* NOTE : Should qsort ever become the bottleneck here, we can exploit the
- *        temporal coherence of this queue in numerous ways. Heaps, segregated
- *        unsorted time range interval blocks, modular/radix buckets, etc. */
+/* NOTE : Scheduled elements live in a slot array and are ordered by a binary
+ *        min-heap of wake times that indexes into it. Scheduling and
+ *        cancellation are O(log n), and an update that wakes nothing is O(1).
+ *        Ties are broken by scheduling order, so that callbacks with the same
+ *        wake time run first-in first-out.
+ *
+ *        Each slot records its position in the heap, so that a handle finds
+ *        its element directly. A handle packs the slot index with the slot's
+ *        generation, which is bumped whenever the slot is released; stale
+ *        handles therefore never cancel an unrelated element. */
 
 typedef lua_Integer LuaRef;
 
+const int    kSlotBits    = 24;
+const int32  kSlotMax     = (1 << kSlotBits) - 1;
+const uint32 kGenMask     = (1 << 28) - 1;
+
+/* Heap indices with special meaning. */
+const int32  kHeapPending = -1;
+const int32  kHeapFree    = -2;
+
 struct SchedulerElem {
   LuaRef fn;
   LuaRef arg;
   TimeStamp tCreated;
   TimeStamp tWake;
+  uint32 order;
+  uint32 generation;
+  int32 heapIndex;
+};
+
+struct SchedulerNode {
+  TimeStamp tWake;
+  uint32 order;
+  int32 slot;
 };
 
 struct Scheduler {
   ArrayList(SchedulerElem, elems);
-  ArrayList(SchedulerElem, addQueue);
+  ArrayList(SchedulerNode, heap);
+  ArrayList(int32, freeSlots);
+  ArrayList(int32, addQueue);
   TimeStamp now;
+  uint32 order;
   bool locked;
+  Lua* lua;
 } static self;
 
-/* NOTE : We sort in decreasing order of wake time, such that the element with
- *        the earliest wake time is at the end. This way, we can pop elements
- *        off the stack as we process them in O(1) without breaking order. */
-static int SortByWake (void const* pa, void const* pb) {
-  SchedulerElem const* a = (SchedulerElem const*)pa;
-  SchedulerElem const* b = (SchedulerElem const*)pb;
-  return a->tWake <  b->tWake ? 1 :
-         a->tWake == b->tWake ? 0 : -1;
+/* -------------------------------------------------------------------------- */
+
+inline static bool Scheduler_Before (SchedulerNode const* a, SchedulerNode const* b) {
+  return a->tWake != b->tWake ? a->tWake < b->tWake :
+                                (int32)(a->order - b->order) < 0;
 }
 
-/* (fn, arg, timeUntilWake) */
+inline static void Scheduler_Place (int32 i, SchedulerNode const* node) {
+  *ArrayList_GetPtr(self.heap, i) = *node;
+  ArrayList_GetPtr(self.elems, node->slot)->heapIndex = i;
+}
+
+static void Scheduler_SiftUp (int32 i) {
+  SchedulerNode node = ArrayList_Get(self.heap, i);
+  while (i > 0) {
+    int32 parent = (i - 1) / 2;
+    SchedulerNode* p = ArrayList_GetPtr(self.heap, parent);
+    if (!Scheduler_Before(&node, p))
+      break;
+    Scheduler_Place(i, p);
+    i = parent;
+  }
+  Scheduler_Place(i, &node);
+}
+
+static void Scheduler_SiftDown (int32 i) {
+  int32 size = ArrayList_GetSize(self.heap);
+  SchedulerNode node = ArrayList_Get(self.heap, i);
+  for (;;) {
+    int32 child = 2 * i + 1;
+    if (child >= size)
+      break;
+    SchedulerNode* c = ArrayList_GetPtr(self.heap, child);
+    if (child + 1 < size && Scheduler_Before(c + 1, c)) {
+      c++;
+      child++;
+    }
+    if (!Scheduler_Before(c, &node))
+      break;
+    Scheduler_Place(i, c);
+    i = child;
+  }
+  Scheduler_Place(i, &node);
+}
+
+static void Scheduler_HeapPush (int32 slot) {
+  SchedulerElem* elem = ArrayList_GetPtr(self.elems, slot);
+  SchedulerNode node = { elem->tWake, elem->order, slot };
+  ArrayList_Append(self.heap, node);
+  Scheduler_SiftUp(ArrayList_GetSize(self.heap) - 1);
+}
+
+static void Scheduler_HeapRemove (int32 i) {
+  SchedulerNode last = ArrayList_PopRet(self.heap);
+  if (i == ArrayList_GetSize(self.heap))
+    return;
+
+  Scheduler_Place(i, &last);
+  if (i > 0 && Scheduler_Before(&last, ArrayList_GetPtr(self.heap, (i - 1) / 2)))
+    Scheduler_SiftUp(i);
+  else
+    Scheduler_SiftDown(i);
+}
+
+static int32 Scheduler_AllocSlot () {
+  if (ArrayList_GetSize(self.freeSlots))
+    return ArrayList_PopRet(self.freeSlots);
+
+  int32 slot = ArrayList_GetSize(self.elems);
+  if (slot > kSlotMax)
+    Fatal("LuaScheduler: Exceeded %d scheduled elements", kSlotMax + 1);
+
+  SchedulerElem elem = {};
+  elem.heapIndex = kHeapFree;
+  ArrayList_Append(self.elems, elem);
+  return slot;
+}
+
+static void Scheduler_FreeSlot (int32 slot) {
+  SchedulerElem* elem = ArrayList_GetPtr(self.elems, slot);
+  elem->generation = (elem->generation + 1) & kGenMask;
+  elem->heapIndex = kHeapFree;
+  ArrayList_Append(self.freeSlots, slot);
+}
+
+/* Returns the slot named by a handle, or -1 if the handle is stale. */
+static int32 Scheduler_FindSlot (double handle) {
+  if (!(handle >= 0.0 && handle < (double)((uint64)1 << 52)))
+    return -1;
+
+  uint64 bits = (uint64)handle;
+  int32 slot = (int32)(bits & kSlotMax);
+  uint32 generation = (uint32)(bits >> kSlotBits);
+  if (slot >= ArrayList_GetSize(self.elems))
+    return -1;
+
+  SchedulerElem* elem = ArrayList_GetPtr(self.elems, slot);
+  if (elem->heapIndex == kHeapFree || elem->generation != generation)
+    return -1;
+  return slot;
+}
+
+/* -------------------------------------------------------------------------- */
+
+/* (fn, arg, timeUntilWake) -> handle */
 static int LuaScheduler_Add (Lua* L) {
-  SchedulerElem elem;
+  int32 slot = Scheduler_AllocSlot();
+  SchedulerElem* elem = ArrayList_GetPtr(self.elems, slot);
 
   /* Compute timestamps. */ {
     double timeToWake = lua_tonumber(L, lua_gettop(L));
-    elem.tCreated = self.now;
-    elem.tWake = TimeStamp_GetRelative(self.now, timeToWake);
+    elem->tCreated = self.now;
+    elem->tWake = TimeStamp_GetRelative(self.now, timeToWake);
+    elem->order = self.order++;
     lua_pop(L, 1);
   }
 
   /* Get references to arg and fn. */ {
-    elem.arg = Lua_GetRef(L);
-    elem.fn = Lua_GetRef(L);
+    elem->arg = Lua_GetRef(L);
+    elem->fn = Lua_GetRef(L);
   }
 
   /* Queue the element. */ {
     if (self.locked) {
-      ArrayList_Append(self.addQueue, elem);
+      elem->heapIndex = kHeapPending;
+      ArrayList_Append(self.addQueue, slot);
     } else {
-      ArrayList_Append(self.elems, elem);
+      Scheduler_HeapPush(slot);
     }
   }
 
-  return 0;
+  uint64 handle = ((uint64)elem->generation << kSlotBits) | (uint64)slot;
+  lua_pushnumber(L, (double)handle);
+  return 1;
 }
 
-static int LuaScheduler_Clear (Lua* L) {
-  /* Release all references. */ {
-    for (int i = 0; i < ArrayList_GetSize(self.elems); ++i) {
-      SchedulerElem* elem = ArrayList_GetPtr(self.elems, i);
-      luaL_unref(L, LUA_REGISTRYINDEX, elem->fn);
-      luaL_unref(L, LUA_REGISTRYINDEX, elem->arg);
+/* (handle) -> whether the element was still scheduled */
+static int LuaScheduler_Cancel (Lua* L) {
+  int32 slot = Scheduler_FindSlot(lua_tonumber(L, 1));
+  if (slot >= 0) {
+    SchedulerElem* elem = ArrayList_GetPtr(self.elems, slot);
+    if (elem->heapIndex == kHeapPending) {
+      ArrayList_Remove(self.addQueue, slot);
+    } else {
+      Scheduler_HeapRemove(elem->heapIndex);
     }
+    Lua_ReleaseRef(L, elem->fn);
+    Lua_ReleaseRef(L, elem->arg);
+    Scheduler_FreeSlot(slot);
+  }
+
+  lua_pushboolean(L, slot >= 0);
+  return 1;
+}
+
+static int LuaScheduler_Clear (Lua* L) {
+  /* Release all references. Slots are freed rather than dropped so that
+   * outstanding handles remain stale. */
+  for (int32 i = 0; i < ArrayList_GetSize(self.elems); ++i) {
+    SchedulerElem* elem = ArrayList_GetPtr(self.elems, i);
+    if (elem->heapIndex == kHeapFree)
+      continue;
+    luaL_unref(L, LUA_REGISTRYINDEX, elem->fn);
+    luaL_unref(L, LUA_REGISTRYINDEX, elem->arg);
+    Scheduler_FreeSlot(i);
   }
 
-  ArrayList_Clear(self.elems);
+  ArrayList_Clear(self.heap);
+  ArrayList_Clear(self.addQueue);
   return 0;
 }
 
+/* (maxCalls = 0) -> number of callbacks run. A maxCalls <= 0 runs every
+ * element that is due; otherwise the remainder stays due for the next
+ * update. */
 static int LuaScheduler_Update (Lua* L) {
-  /* Lock the element queue while we process to preserve ordering. */
-  self.locked = true;
-
-  qsort(
-    ArrayList_GetData(self.elems),
-    ArrayList_GetSize(self.elems),
-    sizeof(SchedulerElem),
-    SortByWake);
+  int maxCalls = lua_gettop(L) >= 1 ? (int)lua_tonumber(L, 1) : 0;
+  int calls = 0;
 
+  /* Defer elements added by callbacks until the end of the update, so that
+   * an element rescheduling itself with no delay cannot stall it. */
+  self.locked = true;
   self.now = TimeStamp_Get();
 
   /* Push the error handler. */
   lua_getglobal(L, "__error_handler__");
   int handler = lua_gettop(L);
 
-  while (ArrayList_GetSize(self.elems)) {
-    SchedulerElem* elem = ArrayList_GetLastPtr(self.elems);
-    if (self.now < elem->tWake)
+  while (ArrayList_GetSize(self.heap)) {
+    if (maxCalls > 0 && calls == maxCalls)
+      break;
+
+    SchedulerNode* top = ArrayList_GetPtr(self.heap, 0);
+    if (self.now < top->tWake)
       break;
 
-    double dt = TimeStamp_GetDifference(elem->tCreated, self.now);
+    /* Unlink the element before calling it, so that the callback may freely
+     * cancel, schedule or clear. */
+    int32 slot = top->slot;
+    SchedulerElem elem = ArrayList_Get(self.elems, slot);
+    Scheduler_HeapRemove(0);
+    Scheduler_FreeSlot(slot);
+
+    double dt = TimeStamp_GetDifference(elem.tCreated, self.now);
 
     /* Call fn(dt, arg) */ {
-      Lua_PushRef(L, elem->fn);
+      Lua_PushRef(L, elem.fn);
       Lua_PushNumber(L, dt);
-      Lua_PushRef(L, elem->arg);
+      Lua_PushRef(L, elem.arg);
       Lua_Call(L, 2, 0, handler);
     }
 
     /* Release references on fn and arg. */
-    Lua_ReleaseRef(L, elem->fn);
-    Lua_ReleaseRef(L, elem->arg);
-    ArrayList_Pop(self.elems);
+    Lua_ReleaseRef(L, elem.fn);
+    Lua_ReleaseRef(L, elem.arg);
+    calls++;
   }
 
   /* Pop the error handler. */
@@ -119,26 +279,46 @@ static int LuaScheduler_Update (Lua* L) {
 
   self.locked = false;
 
-  /* Append any elements that were added while locked. */
-  while (ArrayList_GetSize(self.addQueue)) {
-    SchedulerElem elem = ArrayList_PopRet(self.addQueue);
-    ArrayList_Append(self.elems, elem);
-  }
+  /* Insert any elements that were added while locked. */
+  for (int32 i = 0; i < ArrayList_GetSize(self.addQueue); ++i)
+    Scheduler_HeapPush(ArrayList_Get(self.addQueue, i));
+  ArrayList_Clear(self.addQueue);
 
-  return 0;
+  lua_pushnumber(L, (double)calls);
+  return 1;
 }
 
 void LuaScheduler_Init (Lua* L) {
-  UNUSED(L);
   /* TODO : Store in Lua state so that the scheduler is per-instance */
+  if (self.lua)
+    return;
+  self.lua = L;
   ArrayList_Init(self.elems);
+  ArrayList_Init(self.heap);
+  ArrayList_Init(self.freeSlots);
   ArrayList_Init(self.addQueue);
   self.now = TimeStamp_Get();
+  self.order = 0;
   self.locked = false;
 }
 
+/* NOTE : The references held by scheduled elements die with the Lua state,
+ *        so only the scheduler's own storage is released here. */
+void LuaScheduler_Free (Lua* L) {
+  if (self.lua != L)
+    return;
+  ArrayList_Free(self.elems);
+  ArrayList_Free(self.heap);
+  ArrayList_Free(self.freeSlots);
+  ArrayList_Free(self.addQueue);
+  self.lua = 0;
+}
+
 void LuaScheduler_Register (Lua* L) {
+  if (self.lua != L)
+    return;
   Lua_SetFn(L, "Schedule", LuaScheduler_Add);
+  Lua_SetFn(L, "SchedulerCancel", LuaScheduler_Cancel);
   Lua_SetFn(L, "SchedulerClear", LuaScheduler_Clear);
   Lua_SetFn(L, "SchedulerUpdate", LuaScheduler_Update);
 }
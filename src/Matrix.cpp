@@ -1,6 +1,7 @@
 #include "Box3.h"
 #include "Matrix.h"
 #include "MatrixDef.h"
+#include "OS.h"
 #include "PhxMemory.h"
 #include "Quat.h"
 #include "PhxMath.h"
@@ -9,6 +10,25 @@
 
 #include <stdio.h>
 
+#if defined(__SSE2__) || defined(_M_X64)
+  #define MATRIX_SSE 1
+  #include <emmintrin.h>
+  #include <immintrin.h>
+
+  /* AVX kernels are compiled alongside the SSE2 baseline and selected at
+   * runtime, so the build itself never requires AVX. */
+  #if WINDOWS
+    #define MATRIX_AVX_FN static
+  #else
+    #define MATRIX_AVX_FN static __attribute__((target("avx")))
+  #endif
+#else
+  #define MATRIX_SSE 0
+#endif
+
+/* NOTE : All IO and Set functions write through 'out' only after reading
+ *        every input, so 'out' may alias any of the inputs. */
+
 Matrix* Matrix_Clone (Matrix const* self) {
   Matrix* clone = MemNew(Matrix);
   *clone = *self;
@@ -19,9 +39,129 @@ void Matrix_Free (Matrix* self) {
   MemFree(self);
 }
 
-static void Matrix_IOInverse (Matrix const* NO_ALIAS in, Matrix* NO_ALIAS out) {
-  float const* src = (float const*)in;
-  float* dst       = (float*)out;
+#if MATRIX_SSE
+
+#define MATRIX_SHUFFLE(a, b, x, y, z, w)                                       \
+  _mm_shuffle_ps(a, b, (x) | ((y) << 2) | ((z) << 4) | ((w) << 6))
+
+#define MATRIX_SWIZZLE(v, x, y, z, w) MATRIX_SHUFFLE(v, v, x, y, z, w)
+
+/* 2x2 blocks packed as (m00, m01, m10, m11). */
+
+/* A * B */
+inline static __m128 Mat2_Mul (__m128 a, __m128 b) {
+  return _mm_add_ps(
+    _mm_mul_ps(a, MATRIX_SWIZZLE(b, 0, 3, 0, 3)),
+    _mm_mul_ps(MATRIX_SWIZZLE(a, 1, 0, 3, 2), MATRIX_SWIZZLE(b, 2, 1, 2, 1)));
+}
+
+/* adj(A) * B */
+inline static __m128 Mat2_AdjMul (__m128 a, __m128 b) {
+  return _mm_sub_ps(
+    _mm_mul_ps(MATRIX_SWIZZLE(a, 3, 3, 0, 0), b),
+    _mm_mul_ps(MATRIX_SWIZZLE(a, 1, 1, 2, 2), MATRIX_SWIZZLE(b, 2, 3, 0, 1)));
+}
+
+/* A * adj(B) */
+inline static __m128 Mat2_MulAdj (__m128 a, __m128 b) {
+  return _mm_sub_ps(
+    _mm_mul_ps(a, MATRIX_SWIZZLE(b, 3, 0, 3, 0)),
+    _mm_mul_ps(MATRIX_SWIZZLE(a, 1, 0, 3, 2), MATRIX_SWIZZLE(b, 2, 1, 2, 1)));
+}
+
+/* General 4x4 inverse by 2x2 block decomposition:
+ *
+ *   M = | A B |    inv(M) = 1/|M| * | X# Y# |
+ *       | C D |                     | Z# W# |
+ *
+ * where |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C) and the blocks of the
+ * adjugate only need 2x2 products. Layout-agnostic, so the row-major storage
+ * doesn't matter. */
+void Matrix_IOInverse (Matrix const* in, Matrix* out) {
+  __m128 r0 = _mm_loadu_ps(in->m +  0);
+  __m128 r1 = _mm_loadu_ps(in->m +  4);
+  __m128 r2 = _mm_loadu_ps(in->m +  8);
+  __m128 r3 = _mm_loadu_ps(in->m + 12);
+
+  __m128 A = _mm_movelh_ps(r0, r1);
+  __m128 B = _mm_movehl_ps(r1, r0);
+  __m128 C = _mm_movelh_ps(r2, r3);
+  __m128 D = _mm_movehl_ps(r3, r2);
+
+  /* (|A|, |B|, |C|, |D|) */
+  __m128 detSub = _mm_sub_ps(
+    _mm_mul_ps(MATRIX_SHUFFLE(r0, r2, 0, 2, 0, 2), MATRIX_SHUFFLE(r1, r3, 1, 3, 1, 3)),
+    _mm_mul_ps(MATRIX_SHUFFLE(r0, r2, 1, 3, 1, 3), MATRIX_SHUFFLE(r1, r3, 0, 2, 0, 2)));
+  __m128 detA = MATRIX_SWIZZLE(detSub, 0, 0, 0, 0);
+  __m128 detB = MATRIX_SWIZZLE(detSub, 1, 1, 1, 1);
+  __m128 detC = MATRIX_SWIZZLE(detSub, 2, 2, 2, 2);
+  __m128 detD = MATRIX_SWIZZLE(detSub, 3, 3, 3, 3);
+
+  __m128 DC = Mat2_AdjMul(D, C);
+  __m128 AB = Mat2_AdjMul(A, B);
+  __m128 X = _mm_sub_ps(_mm_mul_ps(detD, A), Mat2_Mul(B, DC));
+  __m128 W = _mm_sub_ps(_mm_mul_ps(detA, D), Mat2_Mul(C, AB));
+  __m128 Y = _mm_sub_ps(_mm_mul_ps(detB, C), Mat2_MulAdj(D, AB));
+  __m128 Z = _mm_sub_ps(_mm_mul_ps(detC, B), Mat2_MulAdj(A, DC));
+
+  __m128 tr = _mm_mul_ps(AB, MATRIX_SWIZZLE(DC, 0, 2, 1, 3));
+  tr = _mm_add_ps(tr, MATRIX_SWIZZLE(tr, 2, 3, 0, 1));
+  tr = _mm_add_ps(tr, MATRIX_SWIZZLE(tr, 1, 0, 3, 2));
+
+  __m128 detM = _mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC));
+  detM = _mm_sub_ps(detM, tr);
+  __m128 rcpDet = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), detM);
+
+  X = _mm_mul_ps(X, rcpDet);
+  Y = _mm_mul_ps(Y, rcpDet);
+  Z = _mm_mul_ps(Z, rcpDet);
+  W = _mm_mul_ps(W, rcpDet);
+
+  /* The final shuffles apply the 2x2 adjugate and reassemble the rows. */
+  _mm_storeu_ps(out->m +  0, MATRIX_SHUFFLE(X, Y, 3, 1, 3, 1));
+  _mm_storeu_ps(out->m +  4, MATRIX_SHUFFLE(X, Y, 2, 0, 2, 0));
+  _mm_storeu_ps(out->m +  8, MATRIX_SHUFFLE(Z, W, 3, 1, 3, 1));
+  _mm_storeu_ps(out->m + 12, MATRIX_SHUFFLE(Z, W, 2, 0, 2, 0));
+}
+
+void Matrix_IOProduct (Matrix const* a, Matrix const* b, Matrix* out) {
+  __m128 b0 = _mm_loadu_ps(b->m +  0);
+  __m128 b1 = _mm_loadu_ps(b->m +  4);
+  __m128 b2 = _mm_loadu_ps(b->m +  8);
+  __m128 b3 = _mm_loadu_ps(b->m + 12);
+
+  __m128 row[4];
+  for (int i = 0; i < 4; ++i) {
+    __m128 ai = _mm_loadu_ps(a->m + 4 * i);
+    __m128 r = _mm_mul_ps(MATRIX_SWIZZLE(ai, 0, 0, 0, 0), b0);
+    r = _mm_add_ps(r, _mm_mul_ps(MATRIX_SWIZZLE(ai, 1, 1, 1, 1), b1));
+    r = _mm_add_ps(r, _mm_mul_ps(MATRIX_SWIZZLE(ai, 2, 2, 2, 2), b2));
+    r = _mm_add_ps(r, _mm_mul_ps(MATRIX_SWIZZLE(ai, 3, 3, 3, 3), b3));
+    row[i] = r;
+  }
+
+  for (int i = 0; i < 4; ++i)
+    _mm_storeu_ps(out->m + 4 * i, row[i]);
+}
+
+void Matrix_IOTranspose (Matrix const* in, Matrix* out) {
+  __m128 r0 = _mm_loadu_ps(in->m +  0);
+  __m128 r1 = _mm_loadu_ps(in->m +  4);
+  __m128 r2 = _mm_loadu_ps(in->m +  8);
+  __m128 r3 = _mm_loadu_ps(in->m + 12);
+  _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+  _mm_storeu_ps(out->m +  0, r0);
+  _mm_storeu_ps(out->m +  4, r1);
+  _mm_storeu_ps(out->m +  8, r2);
+  _mm_storeu_ps(out->m + 12, r3);
+}
+
+#else
+
+void Matrix_IOInverse (Matrix const* in, Matrix* out) {
+  Matrix tmp = *in;
+  float const* src = tmp.m;
+  float* dst       = out->m;
 
   dst[0] =
     src[ 5] * src[10] * src[15] - src[ 5] * src[11] * src[14] -
@@ -109,15 +249,41 @@ static void Matrix_IOInverse (Matrix const* NO_ALIAS in, Matrix* NO_ALIAS out) {
     dst[i] *= det;
 }
 
-static void Matrix_IOTranspose (Matrix const* NO_ALIAS in, Matrix* NO_ALIAS out) {
-  float const* src = (float const*)in;
-  float* dst       = (float*)out;
+void Matrix_IOProduct (Matrix const* a, Matrix const* b, Matrix* out) {
+  Matrix result;
+  float* pResult = result.m;
+  for (int i = 0; i < 4; ++i)
+  for (int j = 0; j < 4; ++j) {
+    float sum = 0.0f;
+    for (int k = 0; k < 4; ++k)
+      sum += a->m[4 * i + k] * b->m[4 * k + j];
+    *pResult++ = sum;
+  }
+  *out = result;
+}
+
+void Matrix_IOTranspose (Matrix const* in, Matrix* out) {
+  Matrix tmp = *in;
+  float const* src = tmp.m;
+  float* dst       = out->m;
   dst[ 0] = src[ 0]; dst[ 1] = src[ 4]; dst[ 2] = src[ 8]; dst[ 3] = src[12];
   dst[ 4] = src[ 1]; dst[ 5] = src[ 5]; dst[ 6] = src[ 9]; dst[ 7] = src[13];
   dst[ 8] = src[ 2]; dst[ 9] = src[ 6]; dst[10] = src[10]; dst[11] = src[14];
   dst[12] = src[ 3]; dst[13] = src[ 7]; dst[14] = src[11]; dst[15] = src[15];
 }
 
+#endif
+
+void Matrix_IOInverseTranspose (Matrix const* in, Matrix* out) {
+  Matrix_IOInverse(in, out);
+  Matrix_IOTranspose(out, out);
+}
+
+void Matrix_IOSum (Matrix const* a, Matrix const* b, Matrix* out) {
+  for (int i = 0; i < 16; ++i)
+    out->m[i] = a->m[i] + b->m[i];
+}
+
 bool Matrix_Equal (Matrix const* a, Matrix const* b) {
   for (int i = 0; i < 16; i++) {
     if (a->m[i] != b->m[i])
@@ -141,17 +307,20 @@ Matrix* Matrix_Inverse (Matrix const* self) {
 }
 
 Matrix* Matrix_InverseTranspose (Matrix const* self) {
-  Matrix inverse, result;
-  Matrix_IOInverse(self, &inverse);
-  Matrix_IOTranspose(&inverse, &result);
+  Matrix result;
+  Matrix_IOInverseTranspose(self, &result);
+  return Matrix_Clone(&result);
+}
+
+Matrix* Matrix_Product (Matrix const* a, Matrix const* b) {
+  Matrix result;
+  Matrix_IOProduct(a, b, &result);
   return Matrix_Clone(&result);
 }
 
 Matrix* Matrix_Sum (Matrix const* a, Matrix const* b) {
   Matrix result;
-  for (int i = 0; i < 16; ++i) {
-    result.m[i] = a->m[i] + b->m[i];
-  }
+  Matrix_IOSum(a, b, &result);
   return Matrix_Clone(&result);
 }
 
@@ -162,9 +331,7 @@ Matrix* Matrix_Transpose (Matrix const* self) {
 }
 
 void Matrix_IInverse (Matrix* self) {
-  Matrix result;
-  Matrix_IOInverse(self, &result);
-  *self = result;
+  Matrix_IOInverse(self, self);
 }
 
 void Matrix_IScale (Matrix* self, float scale) {
@@ -175,22 +342,20 @@ void Matrix_IScale (Matrix* self, float scale) {
 }
 
 void Matrix_ITranspose (Matrix* self) {
-  Matrix result;
-  Matrix_IOTranspose(self, &result);
-  *self = result;
+  Matrix_IOTranspose(self, self);
 }
 
-Matrix* Matrix_Identity () {
+void Matrix_SetIdentity (Matrix* out) {
   Matrix const identity = {
     1, 0, 0, 0,
     0, 1, 0, 0,
     0, 0, 1, 0,
     0, 0, 0, 1,
   };
-  return Matrix_Clone(&identity);
+  *out = identity;
 }
 
-Matrix* Matrix_LookAt (Vec3f const* pos, Vec3f const* at, Vec3f const* up) {
+void Matrix_SetLookAt (Matrix* out, Vec3f const* pos, Vec3f const* at, Vec3f const* up) {
   Vec3f z = Vec3f_Normalize(Vec3f_Sub(*pos, *at));
   Vec3f x = Vec3f_Normalize(Vec3f_Cross(*up, z));
   Vec3f y = Vec3f_Cross(z, x);
@@ -200,10 +365,10 @@ Matrix* Matrix_LookAt (Vec3f const* pos, Vec3f const* at, Vec3f const* up) {
      x.z, y.z, z.z, pos->z,
        0,   0,   0,      1,
   };
-  return Matrix_Clone(&result);
+  *out = result;
 }
 
-Matrix* Matrix_LookUp (Vec3f const* pos, Vec3f const* look, Vec3f const* up) {
+void Matrix_SetLookUp (Matrix* out, Vec3f const* pos, Vec3f const* look, Vec3f const* up) {
   Vec3f z = Vec3f_Normalize(Vec3f_Muls(*look, -1.0f));
   Vec3f x = Vec3f_Normalize(Vec3f_Cross(*up, z));
   Vec3f y = Vec3f_Cross(z, x);
@@ -213,10 +378,10 @@ Matrix* Matrix_LookUp (Vec3f const* pos, Vec3f const* look, Vec3f const* up) {
      x.z, y.z, z.z, pos->z,
        0,   0,   0,      1,
   };
-  return Matrix_Clone(&result);
+  *out = result;
 }
 
-Matrix* Matrix_Perspective (float degreesFovy, float aspect, float N, float F) {
+void Matrix_SetPerspective (Matrix* out, float degreesFovy, float aspect, float N, float F) {
   double rads = Pi * degreesFovy / 360.0;
   double cot = 1.0 / Tan(rads);
   Matrix result = {
@@ -225,23 +390,10 @@ Matrix* Matrix_Perspective (float degreesFovy, float aspect, float N, float F) {
     0, 0, (N + F) / (N - F), (float)(2.0 * (F * N) / (N - F)),
     0, 0, -1.0f, 0,
   };
-  return Matrix_Clone(&result);
+  *out = result;
 }
 
-Matrix* Matrix_Product (Matrix const* a, Matrix const* b) {
-  Matrix result;
-  float* pResult = result.m;
-  for (int i = 0; i < 4; ++i)
-  for (int j = 0; j < 4; ++j) {
-    float sum = 0.0f;
-    for (int k = 0; k < 4; ++k)
-      sum += a->m[4 * i + k] * b->m[4 * k + j];
-    *pResult++ = sum;
-  }
-  return Matrix_Clone(&result);
-}
-
-Matrix* Matrix_RotationX (float rads) {
+void Matrix_SetRotationX (Matrix* out, float rads) {
   float c = Cos(rads);
   float s = Sin(rads);
   Matrix result = {
@@ -250,10 +402,10 @@ Matrix* Matrix_RotationX (float rads) {
     0,  s,  c,  0,
     0,  0,  0,  1,
   };
-  return Matrix_Clone(&result);
+  *out = result;
 }
 
-Matrix* Matrix_RotationY (float rads) {
+void Matrix_SetRotationY (Matrix* out, float rads) {
   float c = Cos(rads);
   float s = Sin(rads);
   Matrix result = {
@@ -262,10 +414,10 @@ Matrix* Matrix_RotationY (float rads) {
    -s,  0,  c,  0,
     0,  0,  0,  1,
   };
-  return Matrix_Clone(&result);
+  *out = result;
 }
 
-Matrix* Matrix_RotationZ (float rads) {
+void Matrix_SetRotationZ (Matrix* out, float rads) {
   float c = Cos(rads);
   float s = Sin(rads);
   Matrix result = {
@@ -274,48 +426,45 @@ Matrix* Matrix_RotationZ (float rads) {
     0,  0,  1,  0,
     0,  0,  0,  1,
   };
-  return Matrix_Clone(&result);
+  *out = result;
 }
 
-Matrix* Matrix_Scaling (float sx, float sy, float sz) {
+void Matrix_SetScaling (Matrix* out, float sx, float sy, float sz) {
   Matrix result = {
     sx,  0,  0, 0,
      0, sy,  0, 0,
      0,  0, sz, 0,
      0,  0,  0, 1,
   };
-  return Matrix_Clone(&result);
+  *out = result;
 }
 
-/* TODO : Be less lazy. */
-Matrix* Matrix_SRT (
+/* T * R * S, written out directly: the columns of R scaled by S, with the
+ * translation in the last column. */
+void Matrix_SetSRT (
+  Matrix* out,
   float sx, float sy, float sz,
   float ry, float rp, float rr,
   float tx, float ty, float tz)
 {
-  Matrix* S = Matrix_Scaling(sx, sy, sz);
-  Matrix* R = Matrix_YawPitchRoll(ry, rp, rr);
-  Matrix* T = Matrix_Translation(tx, ty, tz);
-  Matrix* TR = Matrix_Product(T, R);
-  Matrix* TRS = Matrix_Product(TR, S);
-  Matrix_Free(S);
-  Matrix_Free(R);
-  Matrix_Free(T);
-  Matrix_Free(TR);
-  return TRS;
+  Matrix_SetYawPitchRoll(out, ry, rp, rr);
+  float* m = out->m;
+  m[0] *= sx; m[1] *= sy; m[ 2] *= sz; m[ 3] = tx;
+  m[4] *= sx; m[5] *= sy; m[ 6] *= sz; m[ 7] = ty;
+  m[8] *= sx; m[9] *= sy; m[10] *= sz; m[11] = tz;
 }
 
-Matrix* Matrix_Translation (float tx, float ty, float tz) {
+void Matrix_SetTranslation (Matrix* out, float tx, float ty, float tz) {
   Matrix result = {
      1,  0,  0, tx,
      0,  1,  0, ty,
      0,  0,  1, tz,
      0,  0,  0,  1,
   };
-  return Matrix_Clone(&result);
+  *out = result;
 }
 
-Matrix* Matrix_YawPitchRoll (float yaw, float pitch, float roll) {
+void Matrix_SetYawPitchRoll (Matrix* out, float yaw, float pitch, float roll) {
   float ca = Cos(roll);
   float sa = Sin(roll);
   float cb = Cos(yaw);
@@ -328,31 +477,95 @@ Matrix* Matrix_YawPitchRoll (float yaw, float pitch, float roll) {
     -sb, cb * sy, cb * cy, 0,
     0, 0, 0, 1,
   };
+  *out = result;
+}
+
+Matrix* Matrix_Identity () {
+  Matrix result;
+  Matrix_SetIdentity(&result);
+  return Matrix_Clone(&result);
+}
+
+Matrix* Matrix_LookAt (Vec3f const* pos, Vec3f const* at, Vec3f const* up) {
+  Matrix result;
+  Matrix_SetLookAt(&result, pos, at, up);
+  return Matrix_Clone(&result);
+}
+
+Matrix* Matrix_LookUp (Vec3f const* pos, Vec3f const* look, Vec3f const* up) {
+  Matrix result;
+  Matrix_SetLookUp(&result, pos, look, up);
+  return Matrix_Clone(&result);
+}
+
+Matrix* Matrix_Perspective (float degreesFovy, float aspect, float N, float F) {
+  Matrix result;
+  Matrix_SetPerspective(&result, degreesFovy, aspect, N, F);
+  return Matrix_Clone(&result);
+}
+
+Matrix* Matrix_RotationX (float rads) {
+  Matrix result;
+  Matrix_SetRotationX(&result, rads);
+  return Matrix_Clone(&result);
+}
+
+Matrix* Matrix_RotationY (float rads) {
+  Matrix result;
+  Matrix_SetRotationY(&result, rads);
+  return Matrix_Clone(&result);
+}
+
+Matrix* Matrix_RotationZ (float rads) {
+  Matrix result;
+  Matrix_SetRotationZ(&result, rads);
+  return Matrix_Clone(&result);
+}
+
+Matrix* Matrix_Scaling (float sx, float sy, float sz) {
+  Matrix result;
+  Matrix_SetScaling(&result, sx, sy, sz);
+  return Matrix_Clone(&result);
+}
+
+Matrix* Matrix_SRT (
+  float sx, float sy, float sz,
+  float ry, float rp, float rr,
+  float tx, float ty, float tz)
+{
+  Matrix result;
+  Matrix_SetSRT(&result, sx, sy, sz, ry, rp, rr, tx, ty, tz);
+  return Matrix_Clone(&result);
+}
+
+Matrix* Matrix_Translation (float tx, float ty, float tz) {
+  Matrix result;
+  Matrix_SetTranslation(&result, tx, ty, tz);
+  return Matrix_Clone(&result);
+}
+
+Matrix* Matrix_YawPitchRoll (float yaw, float pitch, float roll) {
+  Matrix result;
+  Matrix_SetYawPitchRoll(&result, yaw, pitch, roll);
   return Matrix_Clone(&result);
 }
 
+/* Transforms the box center and sums the absolute contributions of each axis
+ * to the half-extents (Arvo). Equivalent to bounding the eight transformed
+ * corners, since MulPoint treats the matrix as affine. */
 void Matrix_MulBox (Matrix const* self, Box3f* NO_ALIAS out, Box3f const* NO_ALIAS in) {
-  Vec3f const corners[] = {
-    { in->lower.x, in->lower.y, in->lower.z },
-    { in->upper.x, in->lower.y, in->lower.z },
-    { in->lower.x, in->upper.y, in->lower.z },
-    { in->upper.x, in->upper.y, in->lower.z },
-    { in->lower.x, in->lower.y, in->upper.z },
-    { in->upper.x, in->lower.y, in->upper.z },
-    { in->lower.x, in->upper.y, in->upper.z },
-    { in->upper.x, in->upper.y, in->upper.z },
-  };
+  float const* m = self->m;
+  Vec3f c = Vec3f_Muls(Vec3f_Add(in->lower, in->upper), 0.5f);
+  Vec3f e = Vec3f_Muls(Vec3f_Sub(in->upper, in->lower), 0.5f);
 
-  Vec3f result;
-  Matrix_MulPoint(self, &result, corners[0].x, corners[0].y, corners[0].z);
-  out->lower = result;
-  out->upper = result;
+  Vec3f center, extent;
+  Matrix_MulPoint(self, &center, c.x, c.y, c.z);
+  extent.x = Abs(m[0]) * e.x + Abs(m[1]) * e.y + Abs(m[ 2]) * e.z;
+  extent.y = Abs(m[4]) * e.x + Abs(m[5]) * e.y + Abs(m[ 6]) * e.z;
+  extent.z = Abs(m[8]) * e.x + Abs(m[9]) * e.y + Abs(m[10]) * e.z;
 
-  for (int i = 1; i < 8; ++i) {
-    Matrix_MulPoint(self, &result, corners[i].x, corners[i].y, corners[i].z);
-    out->lower = Vec3f_Min(out->lower, result);
-    out->upper = Vec3f_Max(out->upper, result);
-  }
+  out->lower = Vec3f_Sub(center, extent);
+  out->upper = Vec3f_Add(center, extent);
 }
 
 void Matrix_MulDir (Matrix const* self, Vec3f* NO_ALIAS out, float x, float y, float z) {
@@ -377,6 +590,273 @@ void Matrix_MulVec (Matrix const* self, Vec4f* NO_ALIAS out, float x, float y, f
   out->w = m[12] * x + m[13] * y + m[14] * z + m[15] * w;
 }
 
+/* --- Batch Transforms -------------------------------------------------------
+ *
+ *   The kernels below apply the upper 3x4 of the matrix to 'count' vectors,
+ *   with 'w' = 1 for points and 0 for directions. Contiguous Vec3f arrays are
+ *   transposed to SoA in registers four (SSE) or eight (AVX) at a time;
+ *   strided arrays are gathered four at a time. Each block is fully loaded
+ *   before it is stored, so 'out' may equal 'in'. Tails use the scalar path.
+ *
+ * -------------------------------------------------------------------------- */
+
+inline static void Matrix_Mul3 (
+  float const* m, float w, float* out, float x, float y, float z)
+{
+  float rx = m[0] * x + m[1] * y + m[ 2] * z + m[ 3] * w;
+  float ry = m[4] * x + m[5] * y + m[ 6] * z + m[ 7] * w;
+  float rz = m[8] * x + m[9] * y + m[10] * z + m[11] * w;
+  out[0] = rx;
+  out[1] = ry;
+  out[2] = rz;
+}
+
+static void Matrix_MulStridedScalar (
+  float const* m, float w, char* out, char const* in, int count, int stride)
+{
+  for (int i = 0; i < count; ++i) {
+    float const* v = (float const*)(in + (size_t)i * stride);
+    Matrix_Mul3(m, w, (float*)(out + (size_t)i * stride), v[0], v[1], v[2]);
+  }
+}
+
+static void Matrix_MulSoAScalar (
+  float const* m, float w, float* x, float* y, float* z, int count)
+{
+  for (int i = 0; i < count; ++i) {
+    float r[3];
+    Matrix_Mul3(m, w, r, x[i], y[i], z[i]);
+    x[i] = r[0];
+    y[i] = r[1];
+    z[i] = r[2];
+  }
+}
+
+#if MATRIX_SSE
+
+/* (x0 y0 z0 x1) (y1 z1 x2 y2) (z2 x3 y3 z3) <-> (x0..x3) (y0..y3) (z0..z3).
+ * _mm256_shuffle_ps works per 128-bit lane, so the same shuffles transpose
+ * two groups of four at once in the AVX kernels. */
+#define MATRIX_AOS_TO_SOA(shuffle, a, b, c, x, y, z) {                          \
+  xy = shuffle(b, c, _MM_SHUFFLE(2, 1, 3, 2));                                 \
+  yz = shuffle(a, b, _MM_SHUFFLE(1, 0, 2, 1));                                 \
+  x = shuffle(a, xy, _MM_SHUFFLE(2, 0, 3, 0));                                 \
+  y = shuffle(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));                                \
+  z = shuffle(yz, c, _MM_SHUFFLE(3, 0, 3, 1)); }
+
+#define MATRIX_SOA_TO_AOS(shuffle, x, y, z, a, b, c) {                          \
+  xy = shuffle(x, y, _MM_SHUFFLE(2, 0, 2, 0));                                 \
+  yz = shuffle(y, z, _MM_SHUFFLE(3, 1, 3, 1));                                 \
+  zx = shuffle(z, x, _MM_SHUFFLE(3, 1, 2, 0));                                 \
+  a = shuffle(xy, zx, _MM_SHUFFLE(2, 0, 2, 0));                                \
+  b = shuffle(yz, xy, _MM_SHUFFLE(3, 1, 2, 0));                                \
+  c = shuffle(zx, yz, _MM_SHUFFLE(3, 1, 3, 1)); }
+
+/* r = M * (x, y, z, w) for each lane, given broadcast coefficients c[12]. */
+#define MATRIX_MUL3(add, mul, c, x, y, z, rx, ry, rz) {                      \
+  rx = add(add(mul(c[0], x), mul(c[1], y)), add(mul(c[ 2], z), c[ 3]));        \
+  ry = add(add(mul(c[4], x), mul(c[5], y)), add(mul(c[ 6], z), c[ 7]));        \
+  rz = add(add(mul(c[8], x), mul(c[9], y)), add(mul(c[10], z), c[11])); }
+
+static void Matrix_MulAoSSSE (
+  float const* m, float w, float* out, float const* in, int count)
+{
+  __m128 c[12];
+  for (int i = 0; i < 12; ++i)
+    c[i] = _mm_set1_ps((i & 3) == 3 ? m[i] * w : m[i]);
+
+  int i = 0;
+  for (; i + 4 <= count; i += 4, in += 12, out += 12) {
+    __m128 a = _mm_loadu_ps(in + 0);
+    __m128 b = _mm_loadu_ps(in + 4);
+    __m128 d = _mm_loadu_ps(in + 8);
+    __m128 x, y, z, rx, ry, rz, xy, yz, zx;
+    MATRIX_AOS_TO_SOA(_mm_shuffle_ps, a, b, d, x, y, z)
+    MATRIX_MUL3(_mm_add_ps, _mm_mul_ps, c, x, y, z, rx, ry, rz)
+    MATRIX_SOA_TO_AOS(_mm_shuffle_ps, rx, ry, rz, a, b, d)
+    _mm_storeu_ps(out + 0, a);
+    _mm_storeu_ps(out + 4, b);
+    _mm_storeu_ps(out + 8, d);
+  }
+
+  for (; i < count; ++i, in += 3, out += 3)
+    Matrix_Mul3(m, w, out, in[0], in[1], in[2]);
+}
+
+MATRIX_AVX_FN void Matrix_MulAoSAVX (
+  float const* m, float w, float* out, float const* in, int count)
+{
+  __m256 c[12];
+  for (int i = 0; i < 12; ++i)
+    c[i] = _mm256_set1_ps((i & 3) == 3 ? m[i] * w : m[i]);
+
+  int i = 0;
+  for (; i + 8 <= count; i += 8, in += 24, out += 24) {
+    __m256 a = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(in + 0)), _mm_loadu_ps(in + 12), 1);
+    __m256 b = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(in + 4)), _mm_loadu_ps(in + 16), 1);
+    __m256 d = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(in + 8)), _mm_loadu_ps(in + 20), 1);
+    __m256 x, y, z, rx, ry, rz, xy, yz, zx;
+    MATRIX_AOS_TO_SOA(_mm256_shuffle_ps, a, b, d, x, y, z)
+    MATRIX_MUL3(_mm256_add_ps, _mm256_mul_ps, c, x, y, z, rx, ry, rz)
+    MATRIX_SOA_TO_AOS(_mm256_shuffle_ps, rx, ry, rz, a, b, d)
+    _mm_storeu_ps(out +  0, _mm256_castps256_ps128(a));
+    _mm_storeu_ps(out +  4, _mm256_castps256_ps128(b));
+    _mm_storeu_ps(out +  8, _mm256_castps256_ps128(d));
+    _mm_storeu_ps(out + 12, _mm256_extractf128_ps(a, 1));
+    _mm_storeu_ps(out + 16, _mm256_extractf128_ps(b, 1));
+    _mm_storeu_ps(out + 20, _mm256_extractf128_ps(d, 1));
+  }
+  _mm256_zeroupper();
+
+  for (; i < count; ++i, in += 3, out += 3)
+    Matrix_Mul3(m, w, out, in[0], in[1], in[2]);
+}
+
+static void Matrix_MulSoASSE (
+  float const* m, float w, float* x, float* y, float* z, int count)
+{
+  __m128 c[12];
+  for (int i = 0; i < 12; ++i)
+    c[i] = _mm_set1_ps((i & 3) == 3 ? m[i] * w : m[i]);
+
+  int i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128 vx = _mm_loadu_ps(x + i);
+    __m128 vy = _mm_loadu_ps(y + i);
+    __m128 vz = _mm_loadu_ps(z + i);
+    __m128 rx, ry, rz;
+    MATRIX_MUL3(_mm_add_ps, _mm_mul_ps, c, vx, vy, vz, rx, ry, rz)
+    _mm_storeu_ps(x + i, rx);
+    _mm_storeu_ps(y + i, ry);
+    _mm_storeu_ps(z + i, rz);
+  }
+
+  Matrix_MulSoAScalar(m, w, x + i, y + i, z + i, count - i);
+}
+
+MATRIX_AVX_FN void Matrix_MulSoAAVX (
+  float const* m, float w, float* x, float* y, float* z, int count)
+{
+  __m256 c[12];
+  for (int i = 0; i < 12; ++i)
+    c[i] = _mm256_set1_ps((i & 3) == 3 ? m[i] * w : m[i]);
+
+  int i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256 vx = _mm256_loadu_ps(x + i);
+    __m256 vy = _mm256_loadu_ps(y + i);
+    __m256 vz = _mm256_loadu_ps(z + i);
+    __m256 rx, ry, rz;
+    MATRIX_MUL3(_mm256_add_ps, _mm256_mul_ps, c, vx, vy, vz, rx, ry, rz)
+    _mm256_storeu_ps(x + i, rx);
+    _mm256_storeu_ps(y + i, ry);
+    _mm256_storeu_ps(z + i, rz);
+  }
+  _mm256_zeroupper();
+
+  Matrix_MulSoAScalar(m, w, x + i, y + i, z + i, count - i);
+}
+
+/* Loads and stores exactly three floats, so a strided element may be
+ * followed by unrelated data (or nothing at all). */
+inline static __m128 Matrix_Load3 (char const* p) {
+  __m128 xy = _mm_castpd_ps(_mm_load_sd((double const*)p));
+  return _mm_movelh_ps(xy, _mm_load_ss((float const*)p + 2));
+}
+
+inline static void Matrix_Store3 (char* p, __m128 v) {
+  _mm_store_sd((double*)p, _mm_castps_pd(v));
+  _mm_store_ss((float*)p + 2, _mm_movehl_ps(v, v));
+}
+
+static void Matrix_MulStridedSSE (
+  float const* m, float w, char* out, char const* in, int count, int stride)
+{
+  __m128 c[12];
+  for (int i = 0; i < 12; ++i)
+    c[i] = _mm_set1_ps((i & 3) == 3 ? m[i] * w : m[i]);
+
+  size_t const s = (size_t)stride;
+  int i = 0;
+  for (; i + 4 <= count; i += 4, in += 4 * s, out += 4 * s) {
+    __m128 x = Matrix_Load3(in + 0 * s);
+    __m128 y = Matrix_Load3(in + 1 * s);
+    __m128 z = Matrix_Load3(in + 2 * s);
+    __m128 t = Matrix_Load3(in + 3 * s);
+    _MM_TRANSPOSE4_PS(x, y, z, t);
+    __m128 rx, ry, rz;
+    MATRIX_MUL3(_mm_add_ps, _mm_mul_ps, c, x, y, z, rx, ry, rz)
+    t = _mm_setzero_ps();
+    _MM_TRANSPOSE4_PS(rx, ry, rz, t);
+    Matrix_Store3(out + 0 * s, rx);
+    Matrix_Store3(out + 1 * s, ry);
+    Matrix_Store3(out + 2 * s, rz);
+    Matrix_Store3(out + 3 * s, t);
+  }
+
+  Matrix_MulStridedScalar(m, w, out, in, count - i, stride);
+}
+
+#undef MATRIX_AOS_TO_SOA
+#undef MATRIX_SOA_TO_AOS
+#undef MATRIX_MUL3
+
+#endif
+
+static void Matrix_MulStrided (
+  Matrix const* self, float w, void* out, void const* in, int count, int stride)
+{
+#if MATRIX_SSE
+  if (stride == (int)sizeof(Vec3f)) {
+    if (OS_HasAVX())
+      Matrix_MulAoSAVX(self->m, w, (float*)out, (float const*)in, count);
+    else
+      Matrix_MulAoSSSE(self->m, w, (float*)out, (float const*)in, count);
+    return;
+  }
+  Matrix_MulStridedSSE(self->m, w, (char*)out, (char const*)in, count, stride);
+#else
+  Matrix_MulStridedScalar(self->m, w, (char*)out, (char const*)in, count, stride);
+#endif
+}
+
+static void Matrix_MulSoA (
+  Matrix const* self, float w, float* x, float* y, float* z, int count)
+{
+#if MATRIX_SSE
+  if (OS_HasAVX())
+    Matrix_MulSoAAVX(self->m, w, x, y, z, count);
+  else
+    Matrix_MulSoASSE(self->m, w, x, y, z, count);
+#else
+  Matrix_MulSoAScalar(self->m, w, x, y, z, count);
+#endif
+}
+
+void Matrix_MulDirs (Matrix const* self, Vec3f* out, Vec3f const* in, int count) {
+  Matrix_MulStrided(self, 0.0f, out, in, count, (int)sizeof(Vec3f));
+}
+
+void Matrix_MulDirsSoA (Matrix const* self, float* x, float* y, float* z, int count) {
+  Matrix_MulSoA(self, 0.0f, x, y, z, count);
+}
+
+void Matrix_MulDirsStrided (Matrix const* self, void* out, void const* in, int count, int stride) {
+  Matrix_MulStrided(self, 0.0f, out, in, count, stride);
+}
+
+void Matrix_MulPoints (Matrix const* self, Vec3f* out, Vec3f const* in, int count) {
+  Matrix_MulStrided(self, 1.0f, out, in, count, (int)sizeof(Vec3f));
+}
+
+void Matrix_MulPointsSoA (Matrix const* self, float* x, float* y, float* z, int count) {
+  Matrix_MulSoA(self, 1.0f, x, y, z, count);
+}
+
+void Matrix_MulPointsStrided (Matrix const* self, void* out, void const* in, int count, int stride) {
+  Matrix_MulStrided(self, 1.0f, out, in, count, stride);
+}
+
 void Matrix_GetForward (Matrix const* self, Vec3f* out) {
   out->x = -self->m[2];
   out->y = -self->m[6];
@@ -408,17 +888,17 @@ void Matrix_GetRow (Matrix const* self, Vec4f* out, int row) {
   out->w = self->m[4 * row + 3];
 }
 
-Matrix* Matrix_FromBasis (Vec3f const* x, Vec3f const* y, Vec3f const* z) {
+void Matrix_SetFromBasis (Matrix* out, Vec3f const* x, Vec3f const* y, Vec3f const* z) {
   Matrix result = {
     x->x, y->x, z->x, 0,
     x->y, y->y, z->y, 0,
     x->z, y->z, z->z, 0,
       0,   0,   0,    1
   };
-  return Matrix_Clone(&result);
+  *out = result;
 }
 
-Matrix* Matrix_FromPosRot (Vec3f const* pos, Quat const* rot) {
+void Matrix_SetFromPosRot (Matrix* out, Vec3f const* pos, Quat const* rot) {
   Vec3f x; Quat_GetAxisX(rot, &x);
   Vec3f y; Quat_GetAxisY(rot, &y);
   Vec3f z; Quat_GetAxisZ(rot, &z);
@@ -428,10 +908,10 @@ Matrix* Matrix_FromPosRot (Vec3f const* pos, Quat const* rot) {
     x.z, y.z, z.z, pos->z,
       0,   0,   0,      1
   };
-  return Matrix_Clone(&result);
+  *out = result;
 }
 
-Matrix* Matrix_FromPosRotScale (Vec3f const* pos, Quat const* rot, float scale) {
+void Matrix_SetFromPosRotScale (Matrix* out, Vec3f const* pos, Quat const* rot, float scale) {
   Vec3f x; Quat_GetAxisX(rot, &x);
   Vec3f y; Quat_GetAxisY(rot, &y);
   Vec3f z; Quat_GetAxisZ(rot, &z);
@@ -441,20 +921,20 @@ Matrix* Matrix_FromPosRotScale (Vec3f const* pos, Quat const* rot, float scale)
     scale*x.z, scale*y.z, scale*z.z, pos->z,
             0,         0,         0,      1
   };
-  return Matrix_Clone(&result);
+  *out = result;
 }
 
-Matrix* Matrix_FromPosBasis (Vec3f const* pos, Vec3f const* x, Vec3f const* y, Vec3f const* z) {
+void Matrix_SetFromPosBasis (Matrix* out, Vec3f const* pos, Vec3f const* x, Vec3f const* y, Vec3f const* z) {
   Matrix result = {
     x->x, y->x, z->x, pos->x,
     x->y, y->y, z->y, pos->y,
     x->z, y->z, z->z, pos->z,
        0,    0,    0,      1
   };
-  return Matrix_Clone(&result);
+  *out = result;
 }
 
-Matrix* Matrix_FromQuat (Quat const* q) {
+void Matrix_SetFromQuat (Matrix* out, Quat const* q) {
   Vec3f x; Quat_GetAxisX(q, &x);
   Vec3f y; Quat_GetAxisY(q, &y);
   Vec3f z; Quat_GetAxisZ(q, &z);
@@ -464,6 +944,36 @@ Matrix* Matrix_FromQuat (Quat const* q) {
     x.z, y.z, z.z, 0,
       0,   0,   0, 1
   };
+  *out = result;
+}
+
+Matrix* Matrix_FromBasis (Vec3f const* x, Vec3f const* y, Vec3f const* z) {
+  Matrix result;
+  Matrix_SetFromBasis(&result, x, y, z);
+  return Matrix_Clone(&result);
+}
+
+Matrix* Matrix_FromPosRot (Vec3f const* pos, Quat const* rot) {
+  Matrix result;
+  Matrix_SetFromPosRot(&result, pos, rot);
+  return Matrix_Clone(&result);
+}
+
+Matrix* Matrix_FromPosRotScale (Vec3f const* pos, Quat const* rot, float scale) {
+  Matrix result;
+  Matrix_SetFromPosRotScale(&result, pos, rot, scale);
+  return Matrix_Clone(&result);
+}
+
+Matrix* Matrix_FromPosBasis (Vec3f const* pos, Vec3f const* x, Vec3f const* y, Vec3f const* z) {
+  Matrix result;
+  Matrix_SetFromPosBasis(&result, pos, x, y, z);
+  return Matrix_Clone(&result);
+}
+
+Matrix* Matrix_FromQuat (Quat const* q) {
+  Matrix result;
+  Matrix_SetFromQuat(&result, q);
   return Matrix_Clone(&result);
 }
 
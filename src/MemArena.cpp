@@ -0,0 +1,162 @@
+#include "ArrayList.h"
+#include "MemArena.h"
+#include "PhxMath.h"
+#include "PhxMemory.h"
+#include "SDL.h"
+
+/* NOTE : A marker packs (chunk index + 1) into the high 32 bits and the
+ *        offset within that chunk into the low 32 bits, so that the empty
+ *        arena is marker 0. Chunks beyond the current one are retained and
+ *        reused in order; an oversized request inserts a dedicated chunk
+ *        right after the current one. */
+
+#define ALIGNMENT 16
+#define SCRATCH_CHUNK_SIZE 0x40000
+
+struct MemArenaChunk {
+  char* data;
+  uint32 size;
+};
+
+struct MemArena {
+  uint32 chunkSize;
+  int32 current;
+  uint32 offset;
+  int32 frame;
+  int32 markers;
+  ArrayList(MemArenaChunk, chunk);
+};
+
+static SDL_atomic_t frameIndex = { 0 };
+static SDL_SpinLock scratchLock = 0;
+static SDL_TLSID scratchTLS = 0;
+
+inline static uint32 MemArena_AlignUp (uint32 x) {
+  return (x + (ALIGNMENT - 1)) & ~(uint32)(ALIGNMENT - 1);
+}
+
+static void* MemArena_AllocSlow (MemArena* self, uint32 size) {
+  int32 next = self->current + 1;
+  if (next >= self->chunk_size || self->chunk_data[next].size < size) {
+    MemArenaChunk chunk;
+    chunk.size = Max(self->chunkSize, MemArena_AlignUp(size));
+    chunk.data = (char*)MemAllocAligned(chunk.size, ALIGNMENT);
+    if (!chunk.data)
+      Fatal("MemArena_Alloc: Failed to allocate %u byte chunk", chunk.size);
+
+    ArrayList_Grow(self->chunk);
+    for (int32 i = self->chunk_size; i > next; --i)
+      self->chunk_data[i] = self->chunk_data[i - 1];
+    self->chunk_data[next] = chunk;
+    self->chunk_size++;
+  }
+
+  self->current = next;
+  self->offset = size;
+  return self->chunk_data[next].data;
+}
+
+MemArena* MemArena_Create (uint32 chunkSize) {
+  MemArena* self = MemNew(MemArena);
+  self->chunkSize = MemArena_AlignUp(Max(chunkSize, (uint32)ALIGNMENT));
+  self->current = -1;
+  self->offset = 0;
+  self->frame = 0;
+  self->markers = 0;
+  ArrayList_Init(self->chunk);
+  return self;
+}
+
+void MemArena_Free (MemArena* self) {
+  ArrayList_ForEach(self->chunk, MemArenaChunk, chunk)
+    MemFreeAligned(chunk->data);
+  ArrayList_Free(self->chunk);
+  MemFree(self);
+}
+
+void* MemArena_Alloc (MemArena* self, uint32 size) {
+  uint32 begin = MemArena_AlignUp(self->offset);
+  IF_LIKELY (self->current >= 0 && begin + size <= self->chunk_data[self->current].size) {
+    self->offset = begin + size;
+    return self->chunk_data[self->current].data + begin;
+  }
+  return MemArena_AllocSlow(self, size);
+}
+
+void MemArena_Clear (MemArena* self) {
+  self->current = -1;
+  self->offset = 0;
+  self->markers = 0;
+}
+
+uint64 MemArena_GetMarker (MemArena* self) {
+  self->markers++;
+  return ((uint64)(self->current + 1) << 32) | (uint64)self->offset;
+}
+
+void MemArena_Rewind (MemArena* self, uint64 marker) {
+  int32 current = (int32)(marker >> 32) - 1;
+  uint32 offset = (uint32)(marker & 0xFFFFFFFF);
+  if (current > self->current || (current == self->current && offset > self->offset))
+    Fatal("MemArena_Rewind: Marker is ahead of the current position");
+  self->current = current;
+  self->offset = offset;
+  if (self->markers > 0)
+    self->markers--;
+}
+
+void MemArena_Trim (MemArena* self) {
+  for (int32 i = self->current + 1; i < self->chunk_size; ++i)
+    MemFreeAligned(self->chunk_data[i].data);
+  self->chunk_size = self->current + 1;
+}
+
+uint64 MemArena_GetCapacity (MemArena* self) {
+  uint64 capacity = 0;
+  ArrayList_ForEach(self->chunk, MemArenaChunk, chunk)
+    capacity += chunk->size;
+  return capacity;
+}
+
+uint64 MemArena_GetSize (MemArena* self) {
+  uint64 size = self->offset;
+  for (int32 i = 0; i < self->current; ++i)
+    size += self->chunk_data[i].size;
+  return size;
+}
+
+/* --- Scratch -------------------------------------------------------------- */
+
+static void SDLCALL MemArena_FreeScratch (void* arena) {
+  MemArena_Free((MemArena*)arena);
+}
+
+MemArena* MemArena_GetScratch () {
+  IF_UNLIKELY (!scratchTLS) {
+    SDL_AtomicLock(&scratchLock);
+    if (!scratchTLS)
+      scratchTLS = SDL_TLSCreate();
+    SDL_AtomicUnlock(&scratchLock);
+  }
+
+  int32 frame = SDL_AtomicGet(&frameIndex);
+  MemArena* self = (MemArena*)SDL_TLSGet(scratchTLS);
+  IF_UNLIKELY (!self) {
+    self = MemArena_Create(SCRATCH_CHUNK_SIZE);
+    self->frame = frame;
+    if (SDL_TLSSet(scratchTLS, self, MemArena_FreeScratch) != 0)
+      Fatal("MemArena_GetScratch: Failed to set thread-local storage");
+  }
+
+  /* A job that took a marker before the frame boundary will rewind to it
+   * later, so the clear waits until no marker is outstanding. */
+  if (self->frame != frame && self->markers == 0) {
+    self->frame = frame;
+    MemArena_Clear(self);
+  }
+  return self;
+}
+
+void MemArena_NextFrame () {
+  SDL_AtomicIncRef(&frameIndex);
+}
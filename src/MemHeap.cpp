@@ -0,0 +1,276 @@
+#include "PhxMemory.h"
+#include "SDL.h"
+
+#if ENABLE_MEMORY_HEAP
+
+/* NOTE : Requests up to MAX_SMALL bytes are rounded up to one of CLASS_COUNT
+ *        size classes. Each class carves objects out of 64 KiB spans and
+ *        keeps them on free lists: one per thread (no locking) backed by a
+ *        central list per class (spinlock, touched once per batch).
+ *
+ *        A two-level page map records the size class of every span, indexed
+ *        by address >> SPAN_SHIFT. Pointers whose span maps to class 0 did
+ *        not come from the heap and are handed to the system allocator,
+ *        which makes MemHeap_Free / MemHeap_Realloc safe on any pointer from
+ *        malloc. The map covers 48-bit addresses.
+ *
+ *        An object may be freed on any thread; it joins that thread's cache.
+ *        A thread's cache is returned to the central lists when it exits. */
+
+#define SPAN_SHIFT 16
+#define SPAN_SIZE (1 << SPAN_SHIFT)
+#define SPANS_PER_GROUP 16
+#define MAX_SMALL 2048
+#define CLASS_COUNT 24
+#define BATCH_BYTES 0x2000
+#define MAP_BITS 16
+
+static uint32 const kClassSize[CLASS_COUNT + 1] = {
+     0,   16,   32,   48,   64,   80,   96,  112,  128,
+   160,  192,  224,  256,  320,  384,  448,  512,
+   640,  768,  896, 1024, 1280, 1536, 1792, 2048,
+};
+
+/* Size class of a request, indexed by (size + 15) / 16. */
+static uint8 const kClassIndex[MAX_SMALL / 16 + 1] = {
+   1,  1,  2,  3,  4,  5,  6,  7,  8,  9,  9, 10, 10, 11, 11, 12,
+  12, 13, 13, 13, 13, 14, 14, 14, 14, 15, 15, 15, 15, 16, 16, 16,
+  16, 17, 17, 17, 17, 17, 17, 17, 17, 18, 18, 18, 18, 18, 18, 18,
+  18, 19, 19, 19, 19, 19, 19, 19, 19, 20, 20, 20, 20, 20, 20, 20,
+  20, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21,
+  21, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22,
+  22, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23,
+  23, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24,
+  24,
+};
+
+struct MemHeapBin {
+  void* head;
+  uint32 count;
+};
+
+struct MemHeapCentral {
+  SDL_SpinLock lock;
+  MemHeapBin bin;
+  char pad[64 - sizeof(SDL_SpinLock) - sizeof(MemHeapBin)];
+};
+
+struct MemHeapCache {
+  MemHeapBin bin[CLASS_COUNT + 1];
+  bool init;
+  bool dead;
+};
+
+struct MemHeapCacheGuard {
+  ~MemHeapCacheGuard ();
+};
+
+static MemHeapCentral central[CLASS_COUNT + 1];
+static uint8* volatile pageMap[1 << MAP_BITS];
+
+static SDL_SpinLock spanLock = 0;
+static char* spanNext = 0;
+static uint32 spansLeft = 0;
+
+static thread_local MemHeapCache cache;
+static thread_local MemHeapCacheGuard cacheGuard;
+
+inline static uint32 MemHeap_GetBatch (int cls) {
+  uint32 batch = BATCH_BYTES / kClassSize[cls];
+  return batch < 4 ? 4 : batch > 64 ? 64 : batch;
+}
+
+inline static uint8 MemHeap_GetClass (void const* ptr) {
+  uint64 span = (uint64)(uintptr_t)ptr >> SPAN_SHIFT;
+  IF_UNLIKELY (span >> (2 * MAP_BITS))
+    return 0;
+  uint8* leaf = pageMap[span >> MAP_BITS];
+  return leaf ? leaf[span & ((1 << MAP_BITS) - 1)] : 0;
+}
+
+/* Must be called with spanLock held. */
+static void MemHeap_SetClass (char* span, uint8 cls) {
+  uint64 index = (uint64)(uintptr_t)span >> SPAN_SHIFT;
+  if (index >> (2 * MAP_BITS))
+    Fatal("MemHeap: Span address %p is outside the page map", span);
+  uint8* leaf = pageMap[index >> MAP_BITS];
+  if (!leaf) {
+    leaf = (uint8*)calloc(1, 1 << MAP_BITS);
+    if (!leaf)
+      Fatal("MemHeap: Failed to allocate page map");
+    pageMap[index >> MAP_BITS] = leaf;
+  }
+  leaf[index & ((1 << MAP_BITS) - 1)] = cls;
+}
+
+/* Carves a fresh span into a chain of objects. */
+static MemHeapBin MemHeap_NewSpan (int cls) {
+  SDL_AtomicLock(&spanLock);
+  if (!spansLeft) {
+    size_t size = (size_t)SPAN_SIZE * SPANS_PER_GROUP;
+#if WINDOWS
+    spanNext = (char*)_aligned_malloc(size, SPAN_SIZE);
+#else
+    void* group = 0;
+    spanNext = posix_memalign(&group, SPAN_SIZE, size) == 0 ? (char*)group : 0;
+#endif
+    if (!spanNext)
+      Fatal("MemHeap: Failed to allocate spans");
+    spansLeft = SPANS_PER_GROUP;
+  }
+  char* span = spanNext;
+  spanNext += SPAN_SIZE;
+  spansLeft--;
+  MemHeap_SetClass(span, (uint8)cls);
+  SDL_AtomicUnlock(&spanLock);
+
+  uint32 size = kClassSize[cls];
+  uint32 count = SPAN_SIZE / size;
+  char* p = span;
+  for (uint32 i = 1; i < count; ++i, p += size)
+    *(void**)p = p + size;
+  *(void**)p = 0;
+
+  MemHeapBin bin = { span, count };
+  return bin;
+}
+
+/* Moves up to a batch from the central list of 'cls' into 'bin'. */
+static void MemHeap_Refill (MemHeapBin* bin, int cls) {
+  uint32 batch = MemHeap_GetBatch(cls);
+  MemHeapCentral* c = central + cls;
+
+  SDL_AtomicLock(&c->lock);
+  IF_UNLIKELY (!c->bin.head) {
+    SDL_AtomicUnlock(&c->lock);
+    MemHeapBin span = MemHeap_NewSpan(cls);
+    SDL_AtomicLock(&c->lock);
+    /* Splice the whole span onto the central list; we take a batch below. */
+    void* tail = span.head;
+    while (*(void**)tail)
+      tail = *(void**)tail;
+    *(void**)tail = c->bin.head;
+    c->bin.head = span.head;
+    c->bin.count += span.count;
+  }
+
+  void* head = c->bin.head;
+  void* tail = head;
+  uint32 taken = 1;
+  while (taken < batch && *(void**)tail) {
+    tail = *(void**)tail;
+    taken++;
+  }
+  c->bin.head = *(void**)tail;
+  c->bin.count -= taken;
+  SDL_AtomicUnlock(&c->lock);
+
+  *(void**)tail = bin->head;
+  bin->head = head;
+  bin->count += taken;
+}
+
+/* Returns 'count' objects from the front of 'bin' to the central list. */
+static void MemHeap_Release (MemHeapBin* bin, int cls, uint32 count) {
+  void* head = bin->head;
+  void* tail = head;
+  for (uint32 i = 1; i < count; ++i)
+    tail = *(void**)tail;
+  bin->head = *(void**)tail;
+  bin->count -= count;
+
+  MemHeapCentral* c = central + cls;
+  SDL_AtomicLock(&c->lock);
+  *(void**)tail = c->bin.head;
+  c->bin.head = head;
+  c->bin.count += count;
+  SDL_AtomicUnlock(&c->lock);
+}
+
+MemHeapCacheGuard::~MemHeapCacheGuard () {
+  for (int cls = 1; cls <= CLASS_COUNT; ++cls)
+    if (cache.bin[cls].count)
+      MemHeap_Release(cache.bin + cls, cls, cache.bin[cls].count);
+  cache.dead = true;
+}
+
+inline static MemHeapCache* MemHeap_GetCache () {
+  IF_UNLIKELY (!cache.init) {
+    cache.init = true;
+    /* Touching the guard registers its destructor for this thread. */
+    (void)&cacheGuard;
+  }
+  return &cache;
+}
+
+inline static void* MemHeap_AllocSmall (int cls) {
+  MemHeapCache* self = MemHeap_GetCache();
+  MemHeapBin* bin = self->bin + cls;
+  IF_UNLIKELY (!bin->head)
+    MemHeap_Refill(bin, cls);
+  void* p = bin->head;
+  bin->head = *(void**)p;
+  bin->count--;
+  return p;
+}
+
+inline static void MemHeap_FreeSmall (void* ptr, int cls) {
+  MemHeapCache* self = MemHeap_GetCache();
+  MemHeapBin* bin = self->bin + cls;
+  *(void**)ptr = bin->head;
+  bin->head = ptr;
+  bin->count++;
+
+  /* Keep up to two batches per class; a thread that is shutting down keeps
+   * nothing. */
+  uint32 batch = MemHeap_GetBatch(cls);
+  IF_UNLIKELY (bin->count >= 2 * batch || self->dead)
+    MemHeap_Release(bin, cls, self->dead ? bin->count : batch);
+}
+
+void* MemHeap_Alloc (size_t size) {
+  IF_LIKELY (size <= MAX_SMALL)
+    return MemHeap_AllocSmall(kClassIndex[(size + 15) >> 4]);
+  return malloc(size);
+}
+
+void* MemHeap_AllocZero (size_t size) {
+  IF_LIKELY (size <= MAX_SMALL) {
+    void* p = MemHeap_AllocSmall(kClassIndex[(size + 15) >> 4]);
+    memset(p, 0, size);
+    return p;
+  }
+  return calloc(1, size);
+}
+
+void MemHeap_Free (void const* ptr) {
+  if (!ptr)
+    return;
+  uint8 cls = MemHeap_GetClass(ptr);
+  IF_LIKELY (cls)
+    MemHeap_FreeSmall((void*)ptr, cls);
+  else
+    free((void*)ptr);
+}
+
+void* MemHeap_Realloc (void* ptr, size_t newSize) {
+  if (!ptr)
+    return MemHeap_Alloc(newSize);
+
+  uint8 cls = MemHeap_GetClass(ptr);
+  if (!cls)
+    return realloc(ptr, newSize);
+
+  size_t oldSize = kClassSize[cls];
+  if (newSize <= oldSize && newSize > kClassSize[cls - 1])
+    return ptr;
+
+  void* result = MemHeap_Alloc(newSize);
+  if (!result)
+    return 0;
+  memcpy(result, ptr, oldSize < newSize ? oldSize : newSize);
+  MemHeap_FreeSmall(ptr, cls);
+  return result;
+}
+
+#endif
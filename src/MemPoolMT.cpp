@@ -0,0 +1,314 @@
+#include "ArrayList.h"
+#include "MemPoolMT.h"
+#include "PhxMath.h"
+#include "PhxMemory.h"
+#include "SDL.h"
+
+/* NOTE : The shared pool stores its free cells as a stack of chains (singly-
+ *        linked lists threaded through the cells themselves) of at most
+ *        batchSize cells. Moving a batch between a cache and the shared pool
+ *        is a single push or pop under the lock. */
+
+#define BLOCK_SIZE 0x10000
+#define BATCH_BYTES 0x1000
+
+struct MemPoolChain {
+  void* head;
+  uint32 count;
+};
+
+struct MemPoolMT {
+  SDL_SpinLock lock;
+  uint32 cellSize;
+  uint32 alignment;
+  uint32 cellsPerBlock;
+  uint32 batchSize;
+  uint32 capacity;
+  uint32 freeCells;
+  bool zeroMemory;
+  ArrayList(void*, block);
+  ArrayList(MemPoolChain, chain);
+  ArrayList(MemPoolMTCache*, cache);
+};
+
+struct MemPoolMTCache {
+  MemPoolMT* pool;
+  void* freeList;
+  uint32 count;
+};
+
+/* Must be called with the lock held. */
+static void MemPoolMT_Grow (MemPoolMT* self) {
+  char* block = (char*)MemAllocAligned(
+    (size_t)self->cellSize * self->cellsPerBlock, self->alignment);
+  if (!block)
+    Fatal("MemPoolMT_Grow: Failed to allocate block");
+
+  /* Keep blocks sorted by address so that Trim can map cells to blocks. */
+  ArrayList_Grow(self->block);
+  int32 i = self->block_size++;
+  for (; i > 0 && (char*)self->block_data[i - 1] > block; --i)
+    self->block_data[i] = self->block_data[i - 1];
+  self->block_data[i] = block;
+
+  /* Carve the block into batch-sized chains, each wired sequentially for
+   * cache locality. */
+  for (uint32 first = 0; first < self->cellsPerBlock; first += self->batchSize) {
+    uint32 count = (uint32)Min((int)self->batchSize, (int)(self->cellsPerBlock - first));
+    char* cell = block + (size_t)first * self->cellSize;
+    MemPoolChain chain = { cell, count };
+    for (uint32 j = 1; j < count; ++j) {
+      *(void**)cell = cell + self->cellSize;
+      cell += self->cellSize;
+    }
+    *(void**)cell = 0;
+    ArrayList_Append(self->chain, chain);
+  }
+
+  self->capacity += self->cellsPerBlock;
+  self->freeCells += self->cellsPerBlock;
+}
+
+/* Must be called with the lock held. */
+static MemPoolChain MemPoolMT_PopChain (MemPoolMT* self) {
+  IF_UNLIKELY (self->chain_size == 0)
+    MemPoolMT_Grow(self);
+  MemPoolChain chain = ArrayList_PopRet(self->chain);
+  self->freeCells -= chain.count;
+  return chain;
+}
+
+static void MemPoolMT_PushChain (MemPoolMT* self, void* head, uint32 count) {
+  MemPoolChain chain = { head, count };
+  SDL_AtomicLock(&self->lock);
+  ArrayList_Append(self->chain, chain);
+  self->freeCells += count;
+  SDL_AtomicUnlock(&self->lock);
+}
+
+inline static int32 MemPoolMT_FindBlock (MemPoolMT* self, void* p) {
+  int32 lo = 0;
+  int32 hi = self->block_size - 1;
+  while (lo < hi) {
+    int32 mid = (lo + hi + 1) / 2;
+    if ((char*)self->block_data[mid] <= (char*)p)
+      lo = mid;
+    else
+      hi = mid - 1;
+  }
+  return lo;
+}
+
+MemPoolMT* MemPoolMT_Create (uint32 cellSize, uint32 alignment, bool zeroMemory) {
+  if (alignment == 0)
+    alignment = sizeof(void*);
+  if (alignment & (alignment - 1))
+    Fatal("MemPoolMT_Create: Alignment %u is not a power of two", alignment);
+  alignment = Max(alignment, (uint32)sizeof(void*));
+  cellSize = Max(cellSize, (uint32)sizeof(void*));
+  cellSize = (cellSize + alignment - 1) & ~(alignment - 1);
+
+  MemPoolMT* self = MemNew(MemPoolMT);
+  self->lock = 0;
+  self->cellSize = cellSize;
+  self->alignment = alignment;
+  self->cellsPerBlock = Max(BLOCK_SIZE / cellSize, 1U);
+  self->batchSize = (uint32)Clamp((int)(BATCH_BYTES / cellSize), 8, 256);
+  self->capacity = 0;
+  self->freeCells = 0;
+  self->zeroMemory = zeroMemory;
+  ArrayList_Init(self->block);
+  ArrayList_Init(self->chain);
+  ArrayList_Init(self->cache);
+  return self;
+}
+
+void MemPoolMT_Free (MemPoolMT* self) {
+  if (self->cache_size)
+    Fatal("MemPoolMT_Free: Attempting to free pool with %d live caches", self->cache_size);
+  ArrayList_ForEachI(self->block, i)
+    MemFreeAligned(self->block_data[i]);
+  ArrayList_Free(self->block);
+  ArrayList_Free(self->chain);
+  ArrayList_Free(self->cache);
+  MemFree(self);
+}
+
+void* MemPoolMT_Alloc (MemPoolMT* self) {
+  SDL_AtomicLock(&self->lock);
+  IF_UNLIKELY (self->chain_size == 0)
+    MemPoolMT_Grow(self);
+  MemPoolChain* chain = ArrayList_GetLastPtr(self->chain);
+  void* cell = chain->head;
+  chain->head = *(void**)cell;
+  if (--chain->count == 0)
+    ArrayList_Pop(self->chain);
+  self->freeCells--;
+  SDL_AtomicUnlock(&self->lock);
+
+  if (self->zeroMemory)
+    MemZero(cell, self->cellSize);
+  return cell;
+}
+
+void MemPoolMT_Dealloc (MemPoolMT* self, void* ptr) {
+  SDL_AtomicLock(&self->lock);
+  MemPoolChain* chain = self->chain_size ? ArrayList_GetLastPtr(self->chain) : 0;
+  if (chain && chain->count < self->batchSize) {
+    *(void**)ptr = chain->head;
+    chain->head = ptr;
+    chain->count++;
+  } else {
+    MemPoolChain newChain = { ptr, 1 };
+    *(void**)ptr = 0;
+    ArrayList_Append(self->chain, newChain);
+  }
+  self->freeCells++;
+  SDL_AtomicUnlock(&self->lock);
+}
+
+uint32 MemPoolMT_Trim (MemPoolMT* self) {
+  SDL_AtomicLock(&self->lock);
+  uint32 released = 0;
+  uint32* freeCount = MemNewArrayZero(uint32, self->block_size);
+
+  ArrayList_ForEach(self->chain, MemPoolChain, chain)
+    for (void* cell = chain->head; cell; cell = *(void**)cell)
+      freeCount[MemPoolMT_FindBlock(self, cell)]++;
+
+  for (int32 i = 0; i < self->block_size; ++i)
+    released += freeCount[i] == self->cellsPerBlock ? 1 : 0;
+
+  if (released) {
+    /* Re-chain the surviving free cells, skipping those in released blocks. */
+    MemPoolChain* oldChains = self->chain_data;
+    int32 oldChainCount = self->chain_size;
+    ArrayList_Init(self->chain);
+    MemPoolChain curr = { 0, 0 };
+
+    for (int32 i = 0; i < oldChainCount; ++i) {
+      void* cell = oldChains[i].head;
+      while (cell) {
+        void* next = *(void**)cell;
+        if (freeCount[MemPoolMT_FindBlock(self, cell)] != self->cellsPerBlock) {
+          *(void**)cell = curr.head;
+          curr.head = cell;
+          if (++curr.count == self->batchSize) {
+            ArrayList_Append(self->chain, curr);
+            curr.head = 0;
+            curr.count = 0;
+          }
+        }
+        cell = next;
+      }
+    }
+    if (curr.count)
+      ArrayList_Append(self->chain, curr);
+    MemFree(oldChains);
+
+    int32 kept = 0;
+    for (int32 i = 0; i < self->block_size; ++i) {
+      if (freeCount[i] == self->cellsPerBlock)
+        MemFreeAligned(self->block_data[i]);
+      else
+        self->block_data[kept++] = self->block_data[i];
+    }
+    self->block_size = kept;
+    self->capacity -= released * self->cellsPerBlock;
+    self->freeCells -= released * self->cellsPerBlock;
+  }
+
+  SDL_AtomicUnlock(&self->lock);
+  MemFree(freeCount);
+  return released;
+}
+
+uint32 MemPoolMT_GetBlockCount (MemPoolMT* self) {
+  return self->block_size;
+}
+
+uint32 MemPoolMT_GetCapacity (MemPoolMT* self) {
+  return self->capacity;
+}
+
+uint32 MemPoolMT_GetCellSize (MemPoolMT* self) {
+  return self->cellSize;
+}
+
+uint32 MemPoolMT_GetSize (MemPoolMT* self) {
+  SDL_AtomicLock(&self->lock);
+  uint32 size = self->capacity - self->freeCells;
+  ArrayList_ForEachI(self->cache, i)
+    size -= self->cache_data[i]->count;
+  SDL_AtomicUnlock(&self->lock);
+  return size;
+}
+
+/* --- Cache ---------------------------------------------------------------- */
+
+MemPoolMTCache* MemPoolMTCache_Create (MemPoolMT* pool) {
+  MemPoolMTCache* self = MemNew(MemPoolMTCache);
+  self->pool = pool;
+  self->freeList = 0;
+  self->count = 0;
+  SDL_AtomicLock(&pool->lock);
+  ArrayList_Append(pool->cache, self);
+  SDL_AtomicUnlock(&pool->lock);
+  return self;
+}
+
+void MemPoolMTCache_Free (MemPoolMTCache* self) {
+  MemPoolMT* pool = self->pool;
+  MemPoolMTCache_Flush(self);
+  SDL_AtomicLock(&pool->lock);
+  ArrayList_RemoveFast(pool->cache, self);
+  SDL_AtomicUnlock(&pool->lock);
+  MemFree(self);
+}
+
+void* MemPoolMTCache_Alloc (MemPoolMTCache* self) {
+  MemPoolMT* pool = self->pool;
+  IF_UNLIKELY (!self->freeList) {
+    SDL_AtomicLock(&pool->lock);
+    MemPoolChain chain = MemPoolMT_PopChain(pool);
+    SDL_AtomicUnlock(&pool->lock);
+    self->freeList = chain.head;
+    self->count = chain.count;
+  }
+
+  void* cell = self->freeList;
+  self->freeList = *(void**)cell;
+  self->count--;
+
+  if (pool->zeroMemory)
+    MemZero(cell, pool->cellSize);
+  return cell;
+}
+
+void MemPoolMTCache_Dealloc (MemPoolMTCache* self, void* ptr) {
+  *(void**)ptr = self->freeList;
+  self->freeList = ptr;
+  self->count++;
+
+  /* Keep up to two batches locally so that alternating alloc/free around a
+   * batch boundary does not thrash the shared pool. */
+  IF_UNLIKELY (self->count >= 2 * self->pool->batchSize) {
+    uint32 batch = self->pool->batchSize;
+    void* head = self->freeList;
+    void* tail = head;
+    for (uint32 i = 1; i < batch; ++i)
+      tail = *(void**)tail;
+    self->freeList = *(void**)tail;
+    self->count -= batch;
+    *(void**)tail = 0;
+    MemPoolMT_PushChain(self->pool, head, batch);
+  }
+}
+
+void MemPoolMTCache_Flush (MemPoolMTCache* self) {
+  if (!self->count)
+    return;
+  MemPoolMT_PushChain(self->pool, self->freeList, self->count);
+  self->freeList = 0;
+  self->count = 0;
+}
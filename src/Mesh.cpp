@@ -2,6 +2,7 @@
 #include "Box3.h"
 #include "Bytes.h"
 #include "Matrix.h"
+#include "MatrixDef.h"
 #include "Mesh.h"
 #include "Metric.h"
 #include "OpenGL.h"
@@ -231,6 +232,16 @@ void Mesh_DrawBound (Mesh* self) {
   GLCALL(glDrawElements(GL_TRIANGLES, self->index_size, GL_UNSIGNED_INT, 0))
 }
 
+/* NOTE : Finding the exact vertex range that the indices cover would need a
+ *        scan of the index data on every draw. A range of indices references
+ *        at most that many distinct vertices, and at most every vertex of the
+ *        mesh, so the smaller of the two is reported instead. */
+void Mesh_DrawBoundRange (Mesh* self, int indexOffset, int indexCount) {
+  Metric_AddDraw(indexCount / 3, indexCount / 3, Min(indexCount, self->vertex_size));
+  GLCALL(glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT,
+    (void const*)(sizeof(int32) * indexOffset)))
+}
+
 void Mesh_DrawUnbind (Mesh*) {
   GLCALL(glDisableVertexAttribArray(0))
   GLCALL(glDisableVertexAttribArray(1))
@@ -339,6 +350,18 @@ void Mesh_ReserveVertexData (Mesh* self, int capacity) {
   ArrayList_Reserve(self->vertex, capacity);
 }
 
+void Mesh_ResizeIndexData (Mesh* self, int size) {
+  ArrayList_Reserve(self->index, size);
+  self->index_size = size;
+  self->version++;
+}
+
+void Mesh_ResizeVertexData (Mesh* self, int size) {
+  ArrayList_Reserve(self->vertex, size);
+  self->vertex_size = size;
+  self->version++;
+}
+
 Mesh* Mesh_Center (Mesh* self) {
   Vec3f c; Mesh_GetCenter(self, &c);
   Mesh_Translate(self, -c.x, -c.y, -c.z);
@@ -353,30 +376,26 @@ Mesh* Mesh_Invert (Mesh* self) {
 }
 
 Mesh* Mesh_RotateX (Mesh* self, float rads) {
-  Matrix* matrix = Matrix_RotationX(rads);
-  Mesh_Transform(self, matrix);
-  Matrix_Free(matrix);
+  Matrix matrix; Matrix_SetRotationX(&matrix, rads);
+  Mesh_Transform(self, &matrix);
   return self;
 }
 
 Mesh* Mesh_RotateY (Mesh* self, float rads) {
-  Matrix* matrix = Matrix_RotationY(rads);
-  Mesh_Transform(self, matrix);
-  Matrix_Free(matrix);
+  Matrix matrix; Matrix_SetRotationY(&matrix, rads);
+  Mesh_Transform(self, &matrix);
   return self;
 }
 
 Mesh* Mesh_RotateZ (Mesh* self, float rads) {
-  Matrix* matrix = Matrix_RotationZ(rads);
-  Mesh_Transform(self, matrix);
-  Matrix_Free(matrix);
+  Matrix matrix; Matrix_SetRotationZ(&matrix, rads);
+  Mesh_Transform(self, &matrix);
   return self;
 }
 
 Mesh* Mesh_RotateYPR (Mesh* self, float yaw, float pitch, float roll) {
-  Matrix* matrix = Matrix_YawPitchRoll(yaw, pitch, roll);
-  Mesh_Transform(self, matrix);
-  Matrix_Free(matrix);
+  Matrix matrix; Matrix_SetYawPitchRoll(&matrix, yaw, pitch, roll);
+  Mesh_Transform(self, &matrix);
   return self;
 }
 
@@ -406,8 +425,8 @@ Mesh* Mesh_Translate (Mesh* self, float x, float y, float z) {
 }
 
 Mesh* Mesh_Transform (Mesh* self, Matrix* NO_ALIAS matrix) {
-  ArrayList_ForEach(self->vertex, Vertex, v)
-    Matrix_MulPoint(matrix, &v->p, v->p.x, v->p.y, v->p.z);
+  Vec3f* p = &self->vertex_data->p;
+  Matrix_MulPointsStrided(matrix, p, p, self->vertex_size, sizeof(Vertex));
   self->version++;
   return self;
 }
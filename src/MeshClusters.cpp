@@ -0,0 +1,229 @@
+#include "ArrayList.h"
+#include "MemArena.h"
+#include "Mesh.h"
+#include "MeshClusters.h"
+#include "PhxMath.h"
+#include "Plane.h"
+#include "Vertex.h"
+
+#include <float.h>
+
+/* Clusters whose normals spread further than ~84 degrees from the average
+ * can never be rejected as a whole, so they get a cone that never culls. */
+static const float kConeMinDot = 0.1f;
+
+struct MeshClusters {
+  ArrayList(MeshCluster, cluster);
+  ArrayList(int32, vertex);
+  ArrayList(uint8, triangle);
+};
+
+static void MeshClusters_ComputeBounds (
+  MeshClusters* self,
+  MeshCluster* cluster,
+  Vertex const* vertexData)
+{
+  int32 const* vertex = self->vertex_data + cluster->vertexOffset;
+  uint8 const* tri = self->triangle_data + 3 * cluster->triangleOffset;
+
+  /* Bounding sphere about the AABB center, as in Mesh_GetRadius. */ {
+    Vec3f lower = Vec3f_Create( FLT_MAX,  FLT_MAX,  FLT_MAX);
+    Vec3f upper = Vec3f_Create(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    for (int i = 0; i < cluster->vertexCount; ++i) {
+      Vec3f p = vertexData[vertex[i]].p;
+      lower = Vec3f_Min(lower, p);
+      upper = Vec3f_Max(upper, p);
+    }
+
+    cluster->center = Vec3f_Muls(Vec3f_Add(lower, upper), 0.5f);
+    float r2 = 0.0f;
+    for (int i = 0; i < cluster->vertexCount; ++i)
+      r2 = Max(r2, Vec3f_DistanceSquared(vertexData[vertex[i]].p, cluster->center));
+    cluster->radius = Sqrt(r2);
+  }
+
+  /* Normal cone. The axis is the average face normal; the cutoff is derived
+   * from the most divergent face. The apex is pushed back along the axis until
+   * it lies behind every face plane, which makes the cone test exact for
+   * perspective views. */
+  cluster->coneApex = cluster->center;
+  cluster->coneAxis = Vec3f_Create(0, 0, 0);
+  cluster->coneCutoff = 1.0f;
+
+  Vec3f axis = Vec3f_Create(0, 0, 0);
+  for (int i = 0; i < cluster->triangleCount; ++i, tri += 3) {
+    Vec3f p0 = vertexData[vertex[tri[0]]].p;
+    Vec3f p1 = vertexData[vertex[tri[1]]].p;
+    Vec3f p2 = vertexData[vertex[tri[2]]].p;
+    Vec3f n = Vec3f_SNormalize(Vec3f_Cross(Vec3f_Sub(p1, p0), Vec3f_Sub(p2, p0)));
+    Vec3f_IAdd(&axis, n);
+  }
+
+  float axisLength = Vec3f_Length(axis);
+  if (axisLength < 1e-6f)
+    return;
+  axis = Vec3f_Divs(axis, axisLength);
+
+  float minDot = 1.0f;
+  float maxT = 0.0f;
+  tri = self->triangle_data + 3 * cluster->triangleOffset;
+  for (int i = 0; i < cluster->triangleCount; ++i, tri += 3) {
+    Vec3f p0 = vertexData[vertex[tri[0]]].p;
+    Vec3f p1 = vertexData[vertex[tri[1]]].p;
+    Vec3f p2 = vertexData[vertex[tri[2]]].p;
+    Vec3f n = Vec3f_Cross(Vec3f_Sub(p1, p0), Vec3f_Sub(p2, p0));
+    float length = Vec3f_Length(n);
+    if (length <= 0.0f)
+      continue;
+    n = Vec3f_Divs(n, length);
+
+    float dn = Vec3f_Dot(axis, n);
+    minDot = Min(minDot, dn);
+    if (dn <= kConeMinDot)
+      break;
+    maxT = Max(maxT, Vec3f_Dot(Vec3f_Sub(cluster->center, p0), n) / dn);
+  }
+
+  cluster->coneAxis = axis;
+  if (minDot <= kConeMinDot)
+    return;
+  cluster->coneApex = Vec3f_Sub(cluster->center, Vec3f_Muls(axis, maxT));
+  cluster->coneCutoff = Sqrt(1.0f - minDot * minDot);
+}
+
+MeshClusters* Mesh_BuildClusters (Mesh* mesh, int maxVertices, int maxTriangles) {
+  if (maxVertices < 3 || maxVertices > 256)
+    Fatal("Mesh_BuildClusters: maxVertices must be in [3, 256], got %d", maxVertices);
+  if (maxTriangles < 1)
+    Fatal("Mesh_BuildClusters: maxTriangles must be positive, got %d", maxTriangles);
+
+  int vertexCount = Mesh_GetVertexCount(mesh);
+  int indexCount = Mesh_GetIndexCount(mesh);
+  int32 const* indexData = Mesh_GetIndexData(mesh);
+  Vertex const* vertexData = Mesh_GetVertexData(mesh);
+
+  MEMTAG_BEGIN(MemTag_Mesh);
+  MeshClusters* self = MemNew(MeshClusters);
+  ArrayList_Init(self->cluster);
+  ArrayList_Init(self->vertex);
+  ArrayList_Init(self->triangle);
+  ArrayList_Reserve(self->triangle, indexCount);
+  ArrayList_Reserve(self->cluster, indexCount / (3 * maxTriangles) + 1);
+
+  /* Per-mesh-vertex local index, valid only while stamp matches the id of the
+   * cluster being built. Avoids clearing a table for every cluster. */
+  MemArena* scratch = MemArena_GetScratch();
+  uint64 marker = MemArena_GetMarker(scratch);
+  int32* stamp = MemArena_NewArray(scratch, int32, vertexCount);
+  uint8* local = MemArena_NewArray(scratch, uint8, vertexCount);
+  for (int i = 0; i < vertexCount; ++i)
+    stamp[i] = -1;
+
+  MeshCluster curr = {};
+  for (int t = 0; t + 2 < indexCount; t += 3) {
+    int32 const* tri = indexData + t;
+
+    int added = 0;
+    for (int k = 0; k < 3; ++k) {
+      bool seen = stamp[tri[k]] == self->cluster_size;
+      for (int j = 0; j < k; ++j)
+        seen |= tri[j] == tri[k];
+      added += seen ? 0 : 1;
+    }
+
+    if (curr.vertexCount + added > maxVertices || curr.triangleCount == maxTriangles) {
+      MeshClusters_ComputeBounds(self, &curr, vertexData);
+      ArrayList_Append(self->cluster, curr);
+      curr.vertexOffset += curr.vertexCount;
+      curr.vertexCount = 0;
+      curr.triangleOffset += curr.triangleCount;
+      curr.triangleCount = 0;
+    }
+
+    for (int k = 0; k < 3; ++k) {
+      int32 v = tri[k];
+      if (stamp[v] != self->cluster_size) {
+        stamp[v] = self->cluster_size;
+        local[v] = (uint8)curr.vertexCount++;
+        ArrayList_Append(self->vertex, v);
+      }
+      ArrayList_Append(self->triangle, local[v]);
+    }
+    curr.triangleCount++;
+  }
+
+  if (curr.triangleCount) {
+    MeshClusters_ComputeBounds(self, &curr, vertexData);
+    ArrayList_Append(self->cluster, curr);
+  }
+
+  MemArena_Rewind(scratch, marker);
+  MEMTAG_END;
+  return self;
+}
+
+void MeshClusters_Free (MeshClusters* self) {
+  ArrayList_Free(self->cluster);
+  ArrayList_Free(self->vertex);
+  ArrayList_Free(self->triangle);
+  MemFree(self);
+}
+
+int MeshClusters_Cull (
+  MeshClusters* self,
+  Plane const* planes, int planeCount,
+  Vec3f const* eye,
+  int32* visible,
+  int* triangles)
+{
+  int visibleCount = 0;
+  int triangleCount = 0;
+
+  for (int i = 0; i < self->cluster_size; ++i) {
+    MeshCluster const* cluster = self->cluster_data + i;
+
+    bool culled = false;
+    for (int j = 0; j < planeCount && !culled; ++j) {
+      float dist = Vec3f_Dot(planes[j].n, cluster->center) - planes[j].d;
+      culled = dist < -cluster->radius;
+    }
+
+    if (!culled && eye && cluster->coneCutoff < 1.0f) {
+      Vec3f d = Vec3f_Sub(cluster->coneApex, *eye);
+      culled = Vec3f_Dot(d, cluster->coneAxis) >= cluster->coneCutoff * Vec3f_Length(d);
+    }
+
+    if (!culled) {
+      visible[visibleCount++] = i;
+      triangleCount += cluster->triangleCount;
+    }
+  }
+
+  if (triangles)
+    *triangles = triangleCount;
+  return visibleCount;
+}
+
+void MeshClusters_Get (MeshClusters* self, int index, MeshCluster* out) {
+  *out = self->cluster_data[index];
+}
+
+int MeshClusters_GetCount (MeshClusters* self) {
+  return self->cluster_size;
+}
+
+int MeshClusters_GetTriangleCount (MeshClusters* self) {
+  return self->triangle_size / 3;
+}
+
+uint8* MeshClusters_GetTriangleData (MeshClusters* self) {
+  return self->triangle_data;
+}
+
+int MeshClusters_GetVertexCount (MeshClusters* self) {
+  return self->vertex_size;
+}
+
+int32* MeshClusters_GetVertexData (MeshClusters* self) {
+  return self->vertex_data;
+}
@@ -32,6 +32,7 @@ void Mesh_ComputeAO (Mesh* self, float radius) {
   RNG* rng = RNG_Create(vertexCount);
 
   const int kSamples = 128;
+  Vec3f dirs[kSamples];
   Ray ray;
   ray.tMin = 0.0f;
   ray.tMax = 1e6f;
@@ -40,13 +41,13 @@ void Mesh_ComputeAO (Mesh* self, float radius) {
     Vertex* v = vertexData + i;
     ray.p = Vec3f_Add(v->p, Vec3f_Muls(v->n, 0.01f));
     float occlusion = 0;
+    RNG_FillDir3(rng, dirs, kSamples);
     for (int j = 0; j < kSamples; ++j) {
       /* NOTE : Ignoring the projected area differential factor here. Could
        *        easily importance sample if necessary:
        *          Z = rng:getUniform();
        *          D = sqrt(1.0 - z*z) * Normalize(Reject(D, N)) */
-      RNG_GetDir3(rng, &ray.dir);
-      ray.dir = Vec3f_Muls(ray.dir, Sign(Vec3f_Dot(ray.dir, v->n)));
+      ray.dir = Vec3f_Muls(dirs[j], Sign(Vec3f_Dot(dirs[j], v->n)));
       if (BSP_IntersectRay(bsp, &ray, &t))
         occlusion += Exp(-t / radius);
     }
@@ -1,7 +1,31 @@
+#include "PhxMath.h"
 #include "PhxMemory.h"
+#include "PhxString.h"
 #include "Metric.h"
 
-static int32 valueCurr[Metric_SIZE + 1] = { 0 };
+/* NOTE : Storage for every metric, built-in and registered, is allocated up
+ *        front; history is a ring of the last METRIC_HISTORY frames, indexed
+ *        by frame % METRIC_HISTORY. Nothing here allocates after startup
+ *        except Metric_Register. */
+
+#define METRIC_MAX 64
+#define METRIC_HISTORY 128
+
+static int32 valueCurr[METRIC_MAX + 1] = { 0 };
+static int32 history[METRIC_MAX + 1][METRIC_HISTORY] = { { 0 } };
+static cstr userName[METRIC_MAX + 1] = { 0 };
+static bool isGauge[METRIC_MAX + 1] = { 0 };
+static int32 metricCount = Metric_SIZE;
+static uint32 frames = 0;
+
+inline static void Metric_Check (cstr func, Metric self) {
+  if (self <= Metric_None || self > metricCount)
+    Fatal("%s: Invalid metric %d", func, self);
+}
+
+inline static int Metric_GetHistorySize () {
+  return frames < METRIC_HISTORY ? (int)frames : METRIC_HISTORY;
+}
 
 int32 Metric_Get (Metric self) {
   return valueCurr[self];
@@ -16,10 +40,108 @@ cstr Metric_GetName (Metric self) {
     case Metric_VertsDrawn: return "Vertices";
     case Metric_Flush:      return "Pipeline Flushes";
     case Metric_FBOSwap:    return "Framebuffer Swaps";
+    case Metric_BSPNodes:   return "BSP Nodes Visited";
+    case Metric_GridCells:  return "HashGrid Cells Touched";
+    case Metric_RayCasts:   return "Physics Ray Casts";
+    case Metric_Allocs:     return "Allocations";
+    case Metric_LuaGCSteps: return "Lua GC Steps";
   }
+  if (self > Metric_SIZE && self <= metricCount)
+    return userName[self];
   return 0;
 }
 
+int32 Metric_GetCount () {
+  return metricCount;
+}
+
+Metric Metric_Find (cstr name) {
+  for (Metric i = 1; i <= metricCount; ++i)
+    if (StrEqual(Metric_GetName(i), name))
+      return i;
+  return Metric_None;
+}
+
+Metric Metric_Register (cstr name, bool gauge) {
+  Metric self = Metric_Find(name);
+  if (self != Metric_None) {
+    if (self <= Metric_SIZE || isGauge[self] != gauge)
+      Fatal("Metric_Register: Metric <%s> already exists with a different kind", name);
+    return self;
+  }
+
+  if (metricCount == METRIC_MAX)
+    Fatal("Metric_Register: Cannot register <%s>; limit of %d metrics reached",
+      name, METRIC_MAX);
+  self = ++metricCount;
+  userName[self] = StrDup(name);
+  isGauge[self] = gauge;
+  valueCurr[self] = 0;
+  MemZero(history[self], sizeof(history[self]));
+  return self;
+}
+
+bool Metric_IsGauge (Metric self) {
+  return self > Metric_SIZE && self <= metricCount && isGauge[self];
+}
+
+void Metric_Add (Metric self, int32 delta) {
+  Metric_Check("Metric_Add", self);
+  if (self <= Metric_SIZE)
+    Fatal("Metric_Add: Built-in metric <%s> is read-only", Metric_GetName(self));
+  valueCurr[self] += delta;
+}
+
+void Metric_Set (Metric self, int32 value) {
+  Metric_Check("Metric_Set", self);
+  if (self <= Metric_SIZE)
+    Fatal("Metric_Set: Built-in metric <%s> is read-only", Metric_GetName(self));
+  valueCurr[self] = value;
+}
+
+int32 Metric_GetLast (Metric self) {
+  Metric_Check("Metric_GetLast", self);
+  return frames ? history[self][(frames - 1) % METRIC_HISTORY] : 0;
+}
+
+int32 Metric_GetMin (Metric self) {
+  Metric_Check("Metric_GetMin", self);
+  int size = Metric_GetHistorySize();
+  if (!size) return 0;
+  int32 result = history[self][0];
+  for (int i = 1; i < size; ++i)
+    result = Min(result, history[self][i]);
+  return result;
+}
+
+int32 Metric_GetMax (Metric self) {
+  Metric_Check("Metric_GetMax", self);
+  int size = Metric_GetHistorySize();
+  if (!size) return 0;
+  int32 result = history[self][0];
+  for (int i = 1; i < size; ++i)
+    result = Max(result, history[self][i]);
+  return result;
+}
+
+double Metric_GetAvg (Metric self) {
+  Metric_Check("Metric_GetAvg", self);
+  int size = Metric_GetHistorySize();
+  if (!size) return 0.0;
+  double sum = 0.0;
+  for (int i = 0; i < size; ++i)
+    sum += history[self][i];
+  return sum / size;
+}
+
+int Metric_GetHistory (Metric self, int32* out, int count) {
+  Metric_Check("Metric_GetHistory", self);
+  count = Min(count, Metric_GetHistorySize());
+  for (int i = 0; i < count; ++i)
+    out[i] = history[self][(frames - count + i) % METRIC_HISTORY];
+  return count;
+}
+
 void Metric_AddDraw (int32 polys, int32 tris, int32 verts) {
   valueCurr[Metric_DrawCalls]  += 1;
   valueCurr[Metric_PolysDrawn] += polys;
@@ -42,6 +164,18 @@ void Metric_Mod (Metric self, int32 delta) {
   valueCurr[self] += delta;
 }
 
+void Metric_NextFrame () {
+  uint32 slot = frames % METRIC_HISTORY;
+  for (Metric i = 1; i <= metricCount; ++i) {
+    history[i][slot] = valueCurr[i];
+    if (!isGauge[i])
+      valueCurr[i] = 0;
+  }
+  frames++;
+}
+
 void Metric_Reset () {
   MemZero(valueCurr, sizeof(valueCurr));
+  MemZero(history, sizeof(history));
+  frames = 0;
 }
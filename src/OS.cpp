@@ -13,6 +13,11 @@ cstr OS_GetVideoDriver () {
   return SDL_GetCurrentVideoDriver();
 }
 
+/* Checks OS support for the AVX register state as well as the CPUID bit. */
+bool OS_HasAVX () {
+  return SDL_HasAVX() == SDL_TRUE;
+}
+
 void OS_SetClipboard (cstr text) {
   if (SDL_SetClipboardText(text) != 0)
     Fatal("OS_SetClipboard: %s", SDL_GetError());
@@ -1,5 +1,6 @@
 #include "Draw.h"
 #include "Matrix.h"
+#include "MatrixDef.h"
 #include "PhxMemory.h"
 #include "Mesh.h"
 #include "Octree.h"
@@ -117,10 +118,9 @@ bool Octree_IntersectRay (
   Vec3f const* ro,
   Vec3f const* rd)
 {
-  Matrix* inv = Matrix_Inverse(matrix);
-  Vec3f invRo; Matrix_MulPoint(inv, &invRo, ro->x, ro->y, ro->z);
-  Vec3f invRd; Matrix_MulDir(inv, &invRd, rd->x, rd->y, rd->z);
-  Matrix_Free(inv);
+  Matrix inv; Matrix_IOInverse(matrix, &inv);
+  Vec3f invRo; Matrix_MulPoint(&inv, &invRo, ro->x, ro->y, ro->z);
+  Vec3f invRd; Matrix_MulDir(&inv, &invRd, rd->x, rd->y, rd->z);
   return Octree_IntersectRayImpl(self, invRo, Vec3f_Rcp(invRd));
 }
 
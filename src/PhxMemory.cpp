@@ -1,15 +1,22 @@
 #include "PhxMemory.h"
+#include "SDL.h"
+
+#include <stdint.h>
+#include <stdio.h>
 
 void* Memory_Alloc (size_t size) {
-  return malloc(size);
+  return MemAlloc(size);
 }
 
 void* Memory_Calloc (size_t n, size_t size) {
-  return calloc(n, size);
+  if (size && n > SIZE_MAX / size)
+    Fatal("Memory_Calloc: %llu elements of %llu bytes overflow size_t",
+      (unsigned long long)n, (unsigned long long)size);
+  return MemAllocZero(n * size);
 }
 
 void Memory_Free (void* ptr) {
-  free(ptr);
+  MemFree(ptr);
 }
 
 void Memory_MemCopy (void* dst, void const* src, size_t size) {
@@ -21,5 +28,299 @@ void Memory_MemMove (void* dst, void const* src, size_t size) {
 }
 
 void* Memory_Realloc (void* ptr, size_t newSize) {
-  return realloc(ptr, newSize);
+  return MemRealloc(ptr, newSize);
+}
+
+/* --- Allocation Tracking -------------------------------------------------- */
+
+/* NOTE : Tracked allocations carry a MemHeader immediately in front of the
+ *        returned pointer. 'offset' is the distance back to the start of the
+ *        underlying system allocation, which is larger than the header for
+ *        aligned allocations. Index MemTag_SIZE of the stats holds totals. */
+
+#if ENABLE_MEMORY_HEAP
+  #define BASE_ALLOC(size)          MemHeap_Alloc(size)
+  #define BASE_ALLOC_ZERO(size)     MemHeap_AllocZero(size)
+  #define BASE_FREE(ptr)            MemHeap_Free(ptr)
+  #define BASE_REALLOC(ptr, size)   MemHeap_Realloc(ptr, size)
+#else
+  #define BASE_ALLOC(size)          malloc(size)
+  #define BASE_ALLOC_ZERO(size)     calloc(1, size)
+  #define BASE_FREE(ptr)            free(ptr)
+  #define BASE_REALLOC(ptr, size)   realloc(ptr, size)
+#endif
+
+#define HISTOGRAM_SIZE 20
+#define MAX_TAG_DEPTH 32
+
+struct MemHeader {
+  uint64 size;
+  int32 tag;
+  uint32 offset;
+};
+
+struct MemStats {
+  uint64 liveBytes;
+  uint64 liveCount;
+  uint64 peakBytes;
+  uint32 frameAllocs;
+  uint32 frameFrees;
+  uint64 frameBytes;
+  uint32 lastAllocs;
+  uint32 lastFrees;
+  uint64 lastBytes;
+};
+
+static SDL_SpinLock lock = 0;
+static MemStats stats[MemTag_SIZE + 1] = {};
+static uint64 histogram[HISTOGRAM_SIZE] = {};
+
+static thread_local MemTag tagStack[MAX_TAG_DEPTH];
+static thread_local int tagDepth = 0;
+
+static cstr const tagNames[MemTag_SIZE] = {
+  "Default", "Collision", "Gui", "Mesh", "Render", "", "", "",
+  "User0", "User1", "User2", "User3", "User4", "User5", "User6", "User7",
+};
+
+inline static MemStats* Memory_GetStats (MemTag tag) {
+  if (tag == MemTag_All)
+    return stats + MemTag_SIZE;
+  if (tag < 0 || tag >= MemTag_SIZE)
+    Fatal("Memory: Invalid tag %d", tag);
+  return stats + tag;
+}
+
+#if ENABLE_MEMORY_TRACKING
+
+inline static int Memory_GetBucket (uint64 size) {
+  int bucket = 0;
+  for (uint64 limit = 16; size > limit && bucket < HISTOGRAM_SIZE - 1; limit <<= 1)
+    bucket++;
+  return bucket;
+}
+
+/* Must be called with the lock held. */
+inline static void Memory_RecordAlloc (MemStats* s, uint64 size) {
+  s->liveBytes += size;
+  s->liveCount++;
+  s->peakBytes = s->peakBytes > s->liveBytes ? s->peakBytes : s->liveBytes;
+  s->frameAllocs++;
+  s->frameBytes += size;
+}
+
+/* Must be called with the lock held. */
+inline static void Memory_RecordFree (MemStats* s, uint64 size) {
+  s->liveBytes -= size;
+  s->liveCount--;
+  s->frameFrees++;
+}
+
+static void* Memory_Attach (void* base, size_t offset, size_t size, MemTag tag) {
+  if (!base)
+    return 0;
+
+  MemHeader* header = (MemHeader*)((char*)base + offset) - 1;
+  header->size = size;
+  header->tag = tag;
+  header->offset = (uint32)offset;
+
+  SDL_AtomicLock(&lock);
+  Memory_RecordAlloc(stats + tag, size);
+  Memory_RecordAlloc(stats + MemTag_SIZE, size);
+  histogram[Memory_GetBucket(size)]++;
+  SDL_AtomicUnlock(&lock);
+  return header + 1;
+}
+
+static MemHeader* Memory_Detach (void const* ptr) {
+  MemHeader* header = (MemHeader*)ptr - 1;
+  SDL_AtomicLock(&lock);
+  Memory_RecordFree(stats + header->tag, header->size);
+  Memory_RecordFree(stats + MemTag_SIZE, header->size);
+  SDL_AtomicUnlock(&lock);
+  return header;
+}
+
+void* Memory_TrackedAlloc (size_t size, bool zero) {
+  size_t total = size + sizeof(MemHeader);
+  void* base = zero ? BASE_ALLOC_ZERO(total) : BASE_ALLOC(total);
+  return Memory_Attach(base, sizeof(MemHeader), size, Memory_GetTag());
+}
+
+void* Memory_TrackedAllocAligned (size_t size, size_t alignment) {
+  /* A power-of-two offset of at least the header size keeps the returned
+   * pointer aligned. */
+  size_t offset = alignment > sizeof(MemHeader) ? alignment : sizeof(MemHeader);
+#if WINDOWS
+  void* base = _aligned_malloc(size + offset, alignment);
+#else
+  void* base = 0;
+  if (alignment < sizeof(void*))
+    alignment = sizeof(void*);
+  if (posix_memalign(&base, alignment, size + offset) != 0)
+    base = 0;
+#endif
+  return Memory_Attach(base, offset, size, Memory_GetTag());
+}
+
+void Memory_TrackedFree (void const* ptr) {
+  if (!ptr)
+    return;
+  MemHeader* header = Memory_Detach(ptr);
+  BASE_FREE((char*)(header + 1) - header->offset);
+}
+
+void Memory_TrackedFreeAligned (void const* ptr) {
+  if (!ptr)
+    return;
+  MemHeader* header = Memory_Detach(ptr);
+  void* base = (char*)(header + 1) - header->offset;
+#if WINDOWS
+  _aligned_free(base);
+#else
+  free(base);
+#endif
+}
+
+void* Memory_TrackedRealloc (void* ptr, size_t newSize) {
+  if (!ptr)
+    return Memory_TrackedAlloc(newSize, false);
+
+  MemHeader* header = Memory_Detach(ptr);
+  MemTag tag = header->tag;
+  void* base = BASE_REALLOC(header, newSize + sizeof(MemHeader));
+  if (!base) {
+    /* The original block is untouched; restore its accounting. */
+    Memory_Attach(header, sizeof(MemHeader), (size_t)header->size, tag);
+    return 0;
+  }
+  return Memory_Attach(base, sizeof(MemHeader), newSize, tag);
+}
+
+#endif
+
+bool Memory_IsTracking () {
+  return ENABLE_MEMORY_TRACKING != 0;
+}
+
+void Memory_PushTag (MemTag tag) {
+  if (tag < 0 || tag >= MemTag_SIZE)
+    Fatal("Memory_PushTag: Invalid tag %d", tag);
+  if (tagDepth == MAX_TAG_DEPTH)
+    Fatal("Memory_PushTag: Maximum tag depth of %d exceeded", MAX_TAG_DEPTH);
+  tagStack[tagDepth++] = tag;
+}
+
+void Memory_PopTag () {
+  if (tagDepth == 0)
+    Fatal("Memory_PopTag: Attempting to pop an empty tag stack");
+  tagDepth--;
+}
+
+MemTag Memory_GetTag () {
+  return tagDepth ? tagStack[tagDepth - 1] : MemTag_Default;
+}
+
+cstr Memory_GetTagName (MemTag tag) {
+  if (tag == MemTag_All)
+    return "All";
+  return tag >= 0 && tag < MemTag_SIZE ? tagNames[tag] : 0;
+}
+
+uint64 Memory_GetLiveBytes (MemTag tag) {
+  return Memory_GetStats(tag)->liveBytes;
+}
+
+uint64 Memory_GetLiveCount (MemTag tag) {
+  return Memory_GetStats(tag)->liveCount;
+}
+
+uint64 Memory_GetPeakBytes (MemTag tag) {
+  return Memory_GetStats(tag)->peakBytes;
+}
+
+uint32 Memory_GetFrameAllocs (MemTag tag) {
+  return Memory_GetStats(tag)->lastAllocs;
+}
+
+uint64 Memory_GetFrameBytes (MemTag tag) {
+  return Memory_GetStats(tag)->lastBytes;
+}
+
+uint32 Memory_GetFrameFrees (MemTag tag) {
+  return Memory_GetStats(tag)->lastFrees;
+}
+
+uint64 Memory_GetHistogram (int bucket) {
+  return bucket >= 0 && bucket < HISTOGRAM_SIZE ? histogram[bucket] : 0;
+}
+
+uint64 Memory_GetHistogramLimit (int bucket) {
+  return bucket >= 0 && bucket < HISTOGRAM_SIZE - 1 ? (uint64)16 << bucket : 0;
+}
+
+int Memory_GetHistogramSize () {
+  return HISTOGRAM_SIZE;
+}
+
+void Memory_PrintReport () {
+  if (!ENABLE_MEMORY_TRACKING) {
+    puts("Memory_PrintReport: Allocation tracking is disabled (ENABLE_MEMORY_TRACKING)");
+    return;
+  }
+
+  SDL_AtomicLock(&lock);
+  MemStats s[MemTag_SIZE + 1];
+  uint64 h[HISTOGRAM_SIZE];
+  MemCpy(s, stats, sizeof(stats));
+  MemCpy(h, histogram, sizeof(histogram));
+  SDL_AtomicUnlock(&lock);
+
+  puts("-- Memory ----------------------------------------------------------------");
+  printf("%-10s %12s %10s %12s %8s %8s %12s\n",
+    "Tag", "Live (KiB)", "Count", "Peak (KiB)", "Allocs", "Frees", "Bytes/Frame");
+  for (int i = 0; i <= MemTag_SIZE; ++i) {
+    if (s[i].peakBytes == 0)
+      continue;
+    printf("%-10s %12.1f %10llu %12.1f %8u %8u %12llu\n",
+      i == MemTag_SIZE ? "All" : tagNames[i],
+      s[i].liveBytes / 1024.0,
+      (unsigned long long)s[i].liveCount,
+      s[i].peakBytes / 1024.0,
+      s[i].lastAllocs,
+      s[i].lastFrees,
+      (unsigned long long)s[i].lastBytes);
+  }
+
+  puts("\n  Size        Allocs");
+  for (int i = 0; i < HISTOGRAM_SIZE; ++i) {
+    if (!h[i])
+      continue;
+    if (i < HISTOGRAM_SIZE - 1)
+      printf("  <= %-8llu %llu\n", (unsigned long long)Memory_GetHistogramLimit(i), (unsigned long long)h[i]);
+    else
+      printf("  >  %-8llu %llu\n", (unsigned long long)Memory_GetHistogramLimit(i - 1), (unsigned long long)h[i]);
+  }
+}
+
+void Memory_ResetPeak () {
+  SDL_AtomicLock(&lock);
+  for (int i = 0; i <= MemTag_SIZE; ++i)
+    stats[i].peakBytes = stats[i].liveBytes;
+  SDL_AtomicUnlock(&lock);
+}
+
+void Memory_NextFrame () {
+  SDL_AtomicLock(&lock);
+  for (int i = 0; i <= MemTag_SIZE; ++i) {
+    MemStats* s = stats + i;
+    s->lastAllocs = s->frameAllocs;
+    s->lastFrees = s->frameFrees;
+    s->lastBytes = s->frameBytes;
+    s->frameAllocs = 0;
+    s->frameFrees = 0;
+    s->frameBytes = 0;
+  }
+  SDL_AtomicUnlock(&lock);
 }
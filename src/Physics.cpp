@@ -1,5 +1,6 @@
 #include "Bullet.h"
 #include "CollisionShape.h"
+#include "Metric.h"
 #include "PhxMath.h"
 #include "Physics.h"
 #include "PhysicsDefs.h"
@@ -9,6 +10,7 @@
 #include "RigidBody.h"
 #include "Shader.h"
 #include "Sphere.h"
+#include "StrIntern.h"
 #include "Trigger.h"
 
 struct Physics {
@@ -190,6 +192,7 @@ void Physics_Update (Physics* self, float dt) {
 
 void Physics_RayCast (Physics* self, Ray* ray, RayCastResult* result) {
   typedef btTriangleRaycastCallback::EFlags Flags;
+  Metric_Inc(Metric_RayCasts);
 
   Vec3f from; Ray_GetPoint(ray, ray->tMin, &from);
   Vec3f to;   Ray_GetPoint(ray, ray->tMax, &to);
@@ -207,6 +210,7 @@ void Physics_RayCast (Physics* self, Ray* ray, RayCastResult* result) {
 }
 
 inline static void Physics_ShapeCast (Physics* self, btConvexShape* shape, Vec3f* pos, Quat* rot, ShapeCastResult* result) {
+  Metric_Inc(Metric_RayCasts);
   btTransform btPos = btTransform(Quat_ToBullet(rot), Vec3f_ToBullet(pos));
   *result = {};
 
@@ -275,6 +279,7 @@ void Physics_PrintProfiling (Physics* self) {
 }
 
 void Physics_DrawBoundingBoxesLocal (Physics* self) {
+  static uint32 const mWorld = Str_InternId("mWorld");
   RenderState_PushWireframe(true);
   btCollisionObjectArray& collisionObjects = self->dynamicsWorld->getCollisionObjectArray();
   for (int i = 0; i < collisionObjects.size(); i++) {
@@ -289,20 +294,18 @@ void Physics_DrawBoundingBoxesLocal (Physics* self) {
         Box3f box; RigidBody_GetBoundingBoxLocalCompound(rigidBody, &box);
         Vec3f pos; RigidBody_GetPos(rigidBody, &pos);
         Quat  rot; RigidBody_GetRot(rigidBody, &rot);
-        Matrix* mat = Matrix_FromPosRot(&pos, &rot);
-        Shader_SetMatrix("mWorld", mat);
+        Matrix mat; Matrix_SetFromPosRot(&mat, &pos, &rot);
+        Shader_SetMatrixId(mWorld, &mat);
         Draw_Box3(&box);
-        Matrix_Free(mat);
       }
 
       while (rigidBody) {
         Box3f box; RigidBody_GetBoundingBoxLocal(rigidBody, &box);
         Vec3f pos; RigidBody_GetPos(rigidBody, &pos);
         Quat  rot; RigidBody_GetRot(rigidBody, &rot);
-        Matrix* mat = Matrix_FromPosRot(&pos, &rot);
-        Shader_SetMatrix("mWorld", mat);
+        Matrix mat; Matrix_SetFromPosRot(&mat, &pos, &rot);
+        Shader_SetMatrixId(mWorld, &mat);
         Draw_Box3(&box);
-        Matrix_Free(mat);
         rigidBody = rigidBody->next;
       }
     }
@@ -5,17 +5,118 @@
 #include "PhxSignal.h"
 #include "Profiler.h"
 #include "PhxString.h"
+#include "SDL.h"
+#include "StrIntern.h"
+#include "Thread.h"
 #include "TimeStamp.h"
 
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+/* NOTE : Every thread that enters a scope gets its own ProfilerThread holding
+ *        its scope stack and scope table, so Begin/End never touch shared
+ *        state. Threads are registered by pushing onto a lock-free list.
+ *
+ *        Per-frame times are folded into the statistics by the owning thread
+ *        itself: Profiler_LoopMarker only advances a global frame counter
+ *        (and folds the calling thread), and every other thread folds the
+ *        next time it begins or ends a scope. Hence each thread's statistics
+ *        have a single writer and the merge takes no locks.
+ *
+ *        When a thread exits, its record is retired rather than freed. A new
+ *        thread registering under the same name adopts it, so that pools
+ *        which spawn short-lived workers do not accumulate records.
+ *
+ *        Trace events are 16-byte records written to a per-thread ring with
+ *        a single producer (the thread) and a single consumer (whoever holds
+ *        traceLock). In streaming mode the consumer drains the rings to a
+ *        binary file and a full ring drops new events; in capture mode
+ *        nothing is drained and the ring overwrites its oldest events. */
 
 #define MAX_STACK_DEPTH 128
 #define RESERVE_SIZE 1024
+#define THREAD_RESERVE_SIZE 64
 #define TRACE_FILE "log/trace.json"
+#define TRACE_BIN_FILE "log/trace.bin"
+#define TRACE_RING_SIZE 0x10000
+#define TRACE_FLUSH_MS 100
+#define FRAME_HISTORY 1024
+
+/* --- Histograms --------------------------------------------------------------
+ *
+ *   Per-frame scope times are counted in log-spaced buckets: HIST_SUB
+ *   buckets per power of two, covering [2^HIST_MIN_EXP, 2^HIST_MAX_EXP)
+ *   seconds (about 1 us to 16 s). Shorter samples land in the first bucket
+ *   and longer ones in the last. Percentiles report the bucket midpoint, so
+ *   they are within 1 / (2 * HIST_SUB) (about 6%) of the true value.
+ *
+ * -------------------------------------------------------------------------- */
+
+#define HIST_SUB 8
+#define HIST_MIN_EXP -20
+#define HIST_MAX_EXP 4
+#define HIST_BUCKETS (HIST_SUB * (HIST_MAX_EXP - HIST_MIN_EXP))
+
+/* --- Trace File Format -------------------------------------------------------
+ *
+ *   TraceHeader, followed by any number of chunks, each a TraceChunk header
+ *   and 'size' bytes of payload:
+ *
+ *     TraceChunk_Thread : int32 tid, then the null-terminated thread name
+ *     TraceChunk_Name   : uint32 intern ID, then the null-terminated name
+ *     TraceChunk_Events : int32 tid, then an array of TraceEvent
+ *
+ *   A TraceEvent's tag holds its TraceEventType in the top two bits and the
+ *   intern ID of its name in the rest. Timestamps are raw TimeStamp ticks at
+ *   TraceHeader::frequency ticks per second. A Sample event's value is the
+ *   time it accounts for, in microseconds, ending at its timestamp.
+ *
+ * -------------------------------------------------------------------------- */
+
+static const char kTraceMagic[4] = { 'P', 'H', 'X', 'T' };
+static const uint32 kTraceVersion = 1;
+
+enum TraceChunkType {
+  TraceChunk_Thread = 1,
+  TraceChunk_Name   = 2,
+  TraceChunk_Events = 3,
+};
+
+enum TraceEventType {
+  TraceEvent_Begin   = 0,
+  TraceEvent_End     = 1,
+  TraceEvent_Counter = 2,
+  TraceEvent_Sample  = 3,
+};
+
+struct TraceHeader {
+  char magic[4];
+  uint32 version;
+  uint64 frequency;
+};
+
+struct TraceChunk {
+  uint32 type;
+  uint32 size;
+};
+
+struct TraceEvent {
+  TimeStamp ts;
+  uint32 tag;
+  int32 value;
+};
+
+/* Samples are shown on a row of their own, since they need not nest within
+ * the thread's scopes. */
+#define TRACE_SAMPLE_TID 1000
+#define TRACE_TYPE_SHIFT 30
+#define TRACE_ID_MASK ((1U << TRACE_TYPE_SHIFT) - 1)
 
 struct Scope {
   cstr name;
+  uint32 id;
   TimeStamp last;
   TimeStamp frame;
   TimeStamp total;
@@ -24,60 +125,206 @@ struct Scope {
   double var;
   double min;
   double max;
+  double budget;
+  double overBudget;
+  uint32 hist[HIST_BUCKETS];
 };
 
-struct Profiler {
-  HashMap* map;
+struct ProfilerThread {
+  ProfilerThread* next;
+  cstr name;
+  int32 tid;
+  int32 frame;
+  SDL_atomic_t retired;
   int stackIndex;
   Scope* stack[MAX_STACK_DEPTH];
+  HashMap* map;
   ArrayList(Scope*, scopeList);
+#if ENABLE_PROFILER_TRACE
+  TraceEvent* ring;
+  volatile uint32 ringWrite;
+  volatile uint32 ringRead;
+  uint32 dropped;
+  bool traceNamed;
+#endif
+};
+
+struct ProfilerThreadGuard {
+  ~ProfilerThreadGuard ();
+};
+
+struct Profiler {
+  ProfilerThread* threadList;
+  SDL_atomic_t threadCount;
+  SDL_atomic_t frame;
+  int generation;
   TimeStamp start;
+  TimeStamp frameLast;
+  Scope frameScope;
+  uint32 frameHistorySize;
+  double frameHistory[FRAME_HISTORY];
 #if ENABLE_PROFILER_TRACE
   FILE* traceLog;
+  Thread* traceFlusher;
+  SDL_SpinLock traceLock;
+  volatile bool traceFlushing;
+  bool traceCapture;
+  uint32 traceNames;
 #endif
 } static self;
 
-static bool profiling = false;
+static volatile bool profiling = false;
+static double traceWindow = 0.0;
+static double frameBudget = 0.0;
+
+/* Scope budgets outlive profiling sessions, so they are kept by intern ID
+ * rather than on the per-thread scopes. */
+struct ProfilerBudgets {
+  SDL_SpinLock lock;
+  ArrayList(double, budget);
+} static budgets;
+
+/* The record is only valid if it was registered during the current profiling
+ * session; Profiler_Disable frees all records and bumps the generation. */
+static thread_local ProfilerThread* threadSelf = 0;
+static thread_local int threadGeneration = 0;
+static thread_local ProfilerThreadGuard threadGuard;
 
 #if ENABLE_PROFILER_TRACE
+static void Trace_WriteChunk (FILE* file, uint32 type, void const* a, uint32 aSize,
+                             void const* b, uint32 bSize)
+{
+  TraceChunk chunk = { type, aSize + bSize };
+  fwrite(&chunk, sizeof(chunk), 1, file);
+  fwrite(a, aSize, 1, file);
+  if (bSize)
+    fwrite(b, bSize, 1, file);
+}
+
+static FILE* Trace_OpenFile (cstr path) {
+  FILE* file = fopen(path, "wb");
+  if (!file)
+    return 0;
+  TraceHeader header;
+  MemCpy(header.magic, kTraceMagic, sizeof(kTraceMagic));
+  header.version = kTraceVersion;
+  header.frequency = SDL_GetPerformanceFrequency();
+  fwrite(&header, sizeof(header), 1, file);
+  return file;
+}
+
+static void Trace_WriteThread (FILE* file, int32 tid, cstr name) {
+  Trace_WriteChunk(file, TraceChunk_Thread, &tid, sizeof(tid), name, (uint32)StrLen(name) + 1);
+}
+
+/* Writes the names of intern IDs in (first, last]. */
+static void Trace_WriteNames (FILE* file, uint32 first, uint32 last) {
+  for (uint32 id = first + 1; id <= last; ++id) {
+    cstr name = Str_GetInterned(id);
+    Trace_WriteChunk(file, TraceChunk_Name, &id, sizeof(id), name, (uint32)StrLen(name) + 1);
+  }
+}
+
+static void Trace_WriteEvents (FILE* file, int32 tid, TraceEvent const* events, uint32 count) {
+  if (count)
+    Trace_WriteChunk(file, TraceChunk_Events, &tid, sizeof(tid),
+      events, count * (uint32)sizeof(TraceEvent));
+}
+
+inline static void Trace_Record (ProfilerThread* thread, uint32 type, uint32 id,
+                                 TimeStamp ts, int32 value)
+{
+  uint32 w = thread->ringWrite;
+  IF_UNLIKELY (!self.traceCapture && w - thread->ringRead >= TRACE_RING_SIZE) {
+    thread->dropped++;
+    return;
+  }
+  TraceEvent* e = thread->ring + (w & (TRACE_RING_SIZE - 1));
+  e->ts = ts;
+  e->tag = (type << TRACE_TYPE_SHIFT) | id;
+  e->value = value;
+  SDL_MemoryBarrierRelease();
+  thread->ringWrite = w + 1;
+}
+
+/* Must be called with traceLock held. */
+static void Trace_Drain () {
+  for (ProfilerThread* t = self.threadList; t; t = t->next) {
+    if (!t->traceNamed) {
+      Trace_WriteThread(self.traceLog, t->tid, t->name);
+      t->traceNamed = true;
+    }
+
+    uint32 r = t->ringRead;
+    uint32 w = t->ringWrite;
+    SDL_MemoryBarrierAcquire();
+    while (r != w) {
+      uint32 begin = r & (TRACE_RING_SIZE - 1);
+      uint32 count = (uint32)Min((int)(w - r), (int)(TRACE_RING_SIZE - begin));
+      Trace_WriteEvents(self.traceLog, t->tid, t->ring + begin, count);
+      r += count;
+    }
+    SDL_MemoryBarrierRelease();
+    t->ringRead = r;
+  }
+
+  /* Any ID referenced above was interned before its event was recorded. */
+  uint32 names = Str_GetInternCount();
+  Trace_WriteNames(self.traceLog, self.traceNames, names);
+  self.traceNames = names;
+  fflush(self.traceLog);
+}
+
+static int Trace_FlushThread (void*) {
+  while (self.traceFlushing) {
+    Profiler_FlushTrace();
+    Thread_Sleep(TRACE_FLUSH_MS);
+  }
+  return 0;
+}
+
 static void Trace_Start () {
-  self.traceLog = fopen(TRACE_FILE, "wb");
-  fputs("[ {"
-    "\"name\":\"TRACE_START\","
-    "\"ph\":\"M\","
-    "\"pid\":1,\"tid\":1}", self.traceLog);
+  self.traceCapture = traceWindow > 0.0;
+  self.traceNames = 0;
+  self.traceLock = 0;
+  self.traceLog = 0;
+  self.traceFlusher = 0;
+  if (self.traceCapture)
+    return;
+
+  self.traceLog = Trace_OpenFile(TRACE_BIN_FILE);
+  if (!self.traceLog) {
+    Warn("Profiler: Failed to open trace file <%s>", TRACE_BIN_FILE);
+    return;
+  }
+  self.traceFlushing = true;
+  self.traceFlusher = Thread_Create("PHX_ProfilerTrace", Trace_FlushThread, 0);
 }
 
 static void Trace_Stop () {
-  fputs("\n]", self.traceLog);
+  if (!self.traceLog)
+    return;
+  self.traceFlushing = false;
+  Thread_Wait(self.traceFlusher);
+  self.traceFlusher = 0;
+
+  SDL_AtomicLock(&self.traceLock);
+  Trace_Drain();
   fclose(self.traceLog);
   self.traceLog = 0;
-}
+  SDL_AtomicUnlock(&self.traceLock);
 
-inline static void Trace_Begin (cstr name, TimeStamp ts) {
-  fprintf(self.traceLog, ",\n  {"
-    "\"name\":\"%s\","
-    "\"ph\":\"B\","
-    "\"ts\":%llu,"
-    "\"pid\":1,\"tid\":1"
-    "}",
-    name, ts);
-}
-
-inline static void Trace_End (cstr name, TimeStamp ts) {
-  fprintf(self.traceLog, ",\n  {"
-    "\"name\":\"%s\","
-    "\"ph\":\"E\","
-    "\"ts\":%llu,"
-    "\"pid\":1,\"tid\":1"
-    "}",
-    name, ts);
+  for (ProfilerThread* t = self.threadList; t; t = t->next)
+    if (t->dropped)
+      Warn("Profiler: Trace ring of thread <%s> overflowed; %u events dropped",
+        t->name, t->dropped);
+  Profiler_ConvertTrace(TRACE_BIN_FILE, TRACE_FILE);
 }
 #endif
 
-static Scope* Scope_Create (cstr name) {
-  Scope* scope = MemNew(Scope);
-  scope->name = StrDup(name);
+static void Scope_Init (Scope* scope, cstr name, double budget) {
+  scope->name = name;
+  scope->id = name ? Str_GetInternId(name) : 0;
   scope->last = 0;
   scope->frame = 0;
   scope->total = 0;
@@ -87,15 +334,112 @@ static Scope* Scope_Create (cstr name) {
   scope->var = 0.0;
   scope->min = 1e30;
   scope->max = -1e30;
-  ArrayList_Append(self.scopeList, scope);
+  scope->budget = budget;
+  scope->overBudget = 0.0;
+  MemZero(scope->hist, sizeof(scope->hist));
+}
+
+static double Profiler_GetBudget (uint32 id) {
+  SDL_AtomicLock(&budgets.lock);
+  double budget = (int32)id < budgets.budget_size ? budgets.budget_data[id] : 0.0;
+  SDL_AtomicUnlock(&budgets.lock);
+  return budget;
+}
+
+/* 'name' must be interned. */
+static Scope* Scope_Create (ProfilerThread* thread, cstr name) {
+  Scope* scope = MemNew(Scope);
+  Scope_Init(scope, name, Profiler_GetBudget(Str_GetInternId(name)));
+  ArrayList_Append(thread->scopeList, scope);
   return scope;
 }
 
 static void Scope_Free (Scope* scope) {
-  StrFree(scope->name);
   MemFree(scope);
 }
 
+/* Merges the statistics of src into dst (Chan et al. parallel variance). */
+static void Scope_Merge (Scope* dst, Scope const* src) {
+  if (src->count <= 0.0)
+    return;
+  double count = dst->count + src->count;
+  double delta = src->mean - dst->mean;
+  dst->var += src->var + delta * delta * dst->count * src->count / count;
+  dst->mean += delta * src->count / count;
+  dst->count = count;
+  dst->total += src->total;
+  dst->min = Min(dst->min, src->min);
+  dst->max = Max(dst->max, src->max);
+  dst->budget = Max(dst->budget, src->budget);
+  dst->overBudget += src->overBudget;
+  for (int i = 0; i < HIST_BUCKETS; ++i)
+    dst->hist[i] += src->hist[i];
+}
+
+inline static double Scope_GetStdDev (Scope const* scope) {
+  return scope->count > 1.0 ? Sqrt(scope->var / (scope->count - 1.0)) : 0.0;
+}
+
+inline static int Hist_GetBucket (double t) {
+  if (t <= 0.0)
+    return 0;
+  int e;
+  double m = frexp(t, &e);
+  int bucket = HIST_SUB * (e - 1 - HIST_MIN_EXP) + (int)((2.0 * m - 1.0) * HIST_SUB);
+  return Clamp(bucket, 0, HIST_BUCKETS - 1);
+}
+
+inline static double Hist_GetValue (int bucket) {
+  int e = bucket / HIST_SUB + HIST_MIN_EXP;
+  return ldexp(1.0 + ((bucket % HIST_SUB) + 0.5) / HIST_SUB, e);
+}
+
+static void Scope_AddSample (Scope* scope, double t) {
+  scope->min = Min(scope->min, t);
+  scope->max = Max(scope->max, t);
+
+  /* Use Welford's algorithm to compute variance in one pass. */
+  scope->count += 1.0;
+  double d1 = t - scope->mean;
+  scope->mean += d1 / scope->count;
+  double d2 = t - scope->mean;
+  scope->var += d1 * d2;
+
+  scope->hist[Hist_GetBucket(t)]++;
+  if (scope->budget > 0.0 && t > scope->budget)
+    scope->overBudget += 1.0;
+}
+
+/* Returns the p-th quantile (p in [0, 1]) of the scope's frame times. */
+static double Scope_GetPercentile (Scope const* scope, double p) {
+  if (scope->count <= 0.0)
+    return 0.0;
+  double rank = Clamp(p, 0.0, 1.0) * scope->count;
+  double cumulative = 0.0;
+  for (int i = 0; i < HIST_BUCKETS; ++i) {
+    cumulative += scope->hist[i];
+    if (cumulative >= rank && scope->hist[i])
+      return Clamp(Hist_GetValue(i), scope->min, scope->max);
+  }
+  return scope->max;
+}
+
+static void Scope_GetStats (Scope const* scope, ProfilerStats* out) {
+  bool any = scope->count > 0.0;
+  out->total = TimeStamp_ToDouble(scope->total);
+  out->count = scope->count;
+  out->mean = scope->mean;
+  out->stddev = Scope_GetStdDev(scope);
+  out->min = any ? scope->min : 0.0;
+  out->max = any ? scope->max : 0.0;
+  out->p50 = Scope_GetPercentile(scope, 0.5);
+  out->p90 = Scope_GetPercentile(scope, 0.9);
+  out->p99 = Scope_GetPercentile(scope, 0.99);
+  out->p999 = Scope_GetPercentile(scope, 0.999);
+  out->budget = scope->budget;
+  out->overBudget = scope->overBudget;
+}
+
 static int SortScopes (void const* pa, void const* pb) {
   Scope const* a = *(Scope const**)pa;
   Scope const* b = *(Scope const**)pb;
@@ -103,14 +447,170 @@ static int SortScopes (void const* pa, void const* pb) {
          b->total == a->total ?  0 : 1;
 }
 
-static Scope* Profiler_GetScope (cstr name) {
-  Scope* scope = (Scope*)HashMap_GetRaw(self.map, (uint64)(size_t)name);
+static void ProfilerThread_Fold (ProfilerThread* thread) {
+  for (int i = 0; i < ArrayList_GetSize(thread->scopeList); ++i) {
+    Scope* scope = ArrayList_Get(thread->scopeList, i);
+    if (scope->frame > 0.0) {
+      scope->total += scope->frame;
+      Scope_AddSample(scope, TimeStamp_ToDouble(scope->frame));
+      scope->frame = 0;
+    }
+  }
+  thread->frame = SDL_AtomicGet(&self.frame);
+}
+
+static void ProfilerThread_Free (ProfilerThread* thread) {
+#if ENABLE_PROFILER_TRACE
+  MemFree(thread->ring);
+#endif
+  ArrayList_FreeEx(thread->scopeList, Scope_Free);
+  HashMap_Free(thread->map);
+  MemFree(thread);
+}
+
+static ProfilerThread* Profiler_RegisterThread (cstr name) {
+  name = Str_Intern(name);
+  ProfilerThread* thread = 0;
+
+  for (ProfilerThread* t = self.threadList; t; t = t->next) {
+    if (t->name == name && SDL_AtomicCAS(&t->retired, 1, 0)) {
+      thread = t;
+      thread->stackIndex = -1;
+      break;
+    }
+  }
+
+  if (!thread) {
+    thread = MemNew(ProfilerThread);
+    thread->name = name;
+    thread->tid = SDL_AtomicIncRef(&self.threadCount) + 1;
+    thread->frame = SDL_AtomicGet(&self.frame);
+    SDL_AtomicSet(&thread->retired, 0);
+    thread->stackIndex = -1;
+    thread->map = HashMap_Create(sizeof(void*), 2 * THREAD_RESERVE_SIZE);
+    ArrayList_Init(thread->scopeList);
+    ArrayList_Reserve(thread->scopeList, THREAD_RESERVE_SIZE);
+#if ENABLE_PROFILER_TRACE
+    thread->ring = MemNewArray(TraceEvent, TRACE_RING_SIZE);
+    thread->ringWrite = 0;
+    thread->ringRead = 0;
+    thread->dropped = 0;
+    thread->traceNamed = false;
+#endif
+    do {
+      thread->next = self.threadList;
+    } while (!SDL_AtomicCASPtr((void**)&self.threadList, thread->next, thread));
+  }
+
+  threadSelf = thread;
+  threadGeneration = self.generation;
+  (void)&threadGuard;
+  return thread;
+}
+
+inline static ProfilerThread* Profiler_GetThread () {
+  IF_LIKELY (threadSelf && threadGeneration == self.generation)
+    return threadSelf;
+  return Profiler_RegisterThread("Thread");
+}
+
+ProfilerThreadGuard::~ProfilerThreadGuard () {
+  if (profiling && threadSelf && threadGeneration == self.generation) {
+    ProfilerThread_Fold(threadSelf);
+    SDL_AtomicSet(&threadSelf->retired, 1);
+  }
+  threadSelf = 0;
+}
+
+/* Scopes are keyed by interned name, so that the same name reached through
+ * different pointers (say, a literal and a formatted string) shares a scope.
+ * Every pointer seen is also mapped directly, which keeps the common case of
+ * a literal or __func__ down to a single lookup. */
+static Scope* Profiler_GetScope (ProfilerThread* thread, cstr name) {
+  Scope* scope = (Scope*)HashMap_GetRaw(thread->map, (uint64)(size_t)name);
   if (scope) return scope;
-  scope = Scope_Create(name);
-  HashMap_SetRaw(self.map, (uint64)(size_t)name, scope);
+
+  cstr interned = Str_Intern(name);
+  scope = (Scope*)HashMap_GetRaw(thread->map, (uint64)(size_t)interned);
+  if (!scope) {
+    scope = Scope_Create(thread, interned);
+    HashMap_SetRaw(thread->map, (uint64)(size_t)interned, scope);
+  }
+  if (interned != name)
+    HashMap_SetRaw(thread->map, (uint64)(size_t)name, scope);
   return scope;
 }
 
+/* Thread index i corresponds to tid i + 1; -1 selects the aggregate. */
+static ProfilerThread* Profiler_FindThread (int index) {
+  for (ProfilerThread* t = self.threadList; t; t = t->next)
+    if (t->tid == index + 1)
+      return t;
+  return 0;
+}
+
+static Scope* Profiler_FindScope (ProfilerThread* thread, cstr name) {
+  return (Scope*)HashMap_GetRaw(thread->map, (uint64)(size_t)Str_Intern(name));
+}
+
+static void Profiler_PrintScopes (cstr title, Scope** scopes, int count, double total) {
+  qsort(scopes, count, sizeof(Scope*), SortScopes);
+
+  printf("-- %s ", title);
+  for (int i = (int)StrLen(title) + 4; i < 53; ++i)
+    putchar('-');
+  putchar('\n');
+
+  double cumulative = 0;
+  for (int i = 0; i < count; ++i) {
+    Scope* scope = scopes[i];
+    double scopeTotal = TimeStamp_ToDouble(scope->total);
+    double stddev = Scope_GetStdDev(scope);
+    cumulative += scopeTotal;
+    if ((scopeTotal / total) < 0.01 && scope->max < 0.01)
+      continue;
+    printf("%*.1f%% %*.0f%% %*.0fms  [%*.2f, %*.2f] %*.2f  / %*.2f  (%*.0f%%)"
+           "  %*.2f %*.2f %*.2f  |  %s",
+      5, 100.0 * (scopeTotal / total),
+      4, 100.0 * (cumulative / total),
+      6, 1000.0 * scopeTotal,
+      6, 1000.0 * scope->min,
+      6, 1000.0 * scope->max,
+      6, 1000.0 * scope->mean,
+      5, 1000.0 * stddev,
+      4, 100.0 * (stddev / scope->mean),
+      6, 1000.0 * Scope_GetPercentile(scope, 0.5),
+      6, 1000.0 * Scope_GetPercentile(scope, 0.99),
+      6, 1000.0 * Scope_GetPercentile(scope, 0.999),
+      scope->name);
+    if (scope->budget > 0.0)
+      printf("  (%.0f over %.2fms)", scope->overBudget, 1000.0 * scope->budget);
+    putchar('\n');
+  }
+}
+
+static void Profiler_PrintFrames () {
+  Scope const* frames = &self.frameScope;
+  if (frames->count <= 0.0)
+    return;
+  puts("-- PHX PROFILER [Frames] ----------------------------");
+  printf("%*.0f frames  [%*.2f, %*.2f] %*.2f  / %*.2f  p50 %.2f  p90 %.2f  p99 %.2f  p99.9 %.2f\n",
+    6, frames->count,
+    6, 1000.0 * frames->min,
+    6, 1000.0 * frames->max,
+    6, 1000.0 * frames->mean,
+    5, 1000.0 * Scope_GetStdDev(frames),
+    1000.0 * Scope_GetPercentile(frames, 0.5),
+    1000.0 * Scope_GetPercentile(frames, 0.9),
+    1000.0 * Scope_GetPercentile(frames, 0.99),
+    1000.0 * Scope_GetPercentile(frames, 0.999));
+  if (frames->budget > 0.0)
+    printf("%*.0f frames over budget of %.2fms (%.1f%%)\n",
+      6, frames->overBudget,
+      1000.0 * frames->budget,
+      100.0 * frames->overBudget / frames->count);
+}
+
 static void Profiler_SignalHandler (Signal) {
   Profiler_Backtrace();
 }
@@ -119,15 +619,21 @@ static void Profiler_SignalHandler (Signal) {
 
 void Profiler_Enable () {
 #if ENABLE_PROFILER
-  profiling = true;
-  self.map = HashMap_Create(sizeof(void*), 2 * RESERVE_SIZE);
-  ArrayList_Init(self.scopeList);
-  ArrayList_Reserve(self.scopeList, RESERVE_SIZE);
-  self.stackIndex = -1;
+  self.threadList = 0;
+  SDL_AtomicSet(&self.threadCount, 0);
+  SDL_AtomicSet(&self.frame, 0);
+  self.generation++;
   self.start = TimeStamp_Get();
+  self.frameLast = self.start;
+  self.frameHistorySize = 0;
+  Scope_Init(&self.frameScope, 0, frameBudget);
 #if ENABLE_PROFILER_TRACE
   Trace_Start();
 #endif
+  ProfilerThread* thread = Profiler_RegisterThread("Main");
+  HashMap_Resize(thread->map, 2 * RESERVE_SIZE);
+  ArrayList_Reserve(thread->scopeList, RESERVE_SIZE);
+  profiling = true;
   Profiler_Begin("[Root]");
   Signal_AddHandlerAll(Profiler_SignalHandler);
 #endif
@@ -135,7 +641,8 @@ void Profiler_Enable () {
 
 void Profiler_Disable () {
 #if ENABLE_PROFILER
-  if (self.stackIndex != 0)
+  ProfilerThread* main = Profiler_GetThread();
+  if (main->stackIndex != 0)
     Fatal("Profiler_Disable: Cannot stop profiler from within a profiled section");
 
   Profiler_End();
@@ -144,44 +651,60 @@ void Profiler_Disable () {
 #endif
   double total = TimeStamp_GetElapsed(self.start);
 
-  /* Compute compensated variance. */
-  for (int i = 0; i < ArrayList_GetSize(self.scopeList); ++i) {
-    Scope* scope = ArrayList_Get(self.scopeList, i);
-    scope->var /= scope->count - 1.0;
-    scope->var = Sqrt(scope->var);
+  /* Other threads fold lazily; catch up on everything here. Their records
+   * are folded and freed below without synchronization, which is only safe
+   * because every other thread must be idle by now (see Profiler.h). */
+  int threads = 0;
+  for (ProfilerThread* t = self.threadList; t; t = t->next) {
+    ProfilerThread_Fold(t);
+    threads++;
   }
 
-  qsort(
-    ArrayList_GetData(self.scopeList),
-    ArrayList_GetSize(self.scopeList),
-    sizeof(Scope*),
-    SortScopes);
+  /* With several threads, print each one and then the aggregate, keyed by
+   * interned scope name. */
+  ArrayList(Scope*, all);
+  ArrayList_Init(all);
+  for (int tid = 1; tid <= threads; ++tid) {
+    ProfilerThread* t = Profiler_FindThread(tid - 1);
+    if (!t) continue;
+    if (threads > 1) {
+      cstr title = StrFormat("PHX PROFILER [%s #%d]", t->name, t->tid);
+      Profiler_PrintScopes(title, t->scopeList_data, t->scopeList_size, total);
+      StrFree(title);
+    }
 
-  puts("-- PHX PROFILER -------------------------------------");
-  double cumulative = 0;
-  for (int i = 0; i < ArrayList_GetSize(self.scopeList); ++i) {
-    Scope* scope = ArrayList_Get(self.scopeList, i);
-    double scopeTotal = TimeStamp_ToDouble(scope->total);
-    cumulative += scopeTotal;
-    if ((scopeTotal / total) < 0.01 && scope->max < 0.01)
-      continue;
-    printf("%*.1f%% %*.0f%% %*.0fms  [%*.2f, %*.2f] %*.2f  / %*.2f  (%*.0f%%)  |  %s\n",
-      5, 100.0 * (scopeTotal / total),
-      4, 100.0 * (cumulative / total),
-      6, 1000.0 * scopeTotal,
-      6, 1000.0 * scope->min,
-      6, 1000.0 * scope->max,
-      6, 1000.0 * scope->mean,
-      5, 1000.0 * scope->var,
-      4, 100.0 * (scope->var / scope->mean),
-      scope->name);
+    ArrayList_ForEachI(t->scopeList, i) {
+      Scope* src = t->scopeList_data[i];
+      Scope* dst = 0;
+      ArrayList_ForEachI(all, j)
+        if (all_data[j]->name == src->name)
+          dst = all_data[j];
+      if (!dst) {
+        dst = MemNew(Scope);
+        *dst = *src;
+        ArrayList_Append(all, dst);
+      } else {
+        Scope_Merge(dst, src);
+      }
+    }
   }
+
+  Profiler_PrintScopes(threads > 1 ? "PHX PROFILER [All Threads]" : "PHX PROFILER",
+    all_data, all_size, total);
+  Profiler_PrintFrames();
   puts("-----------------------------------------------------");
   fflush(stdout);
+  ArrayList_FreeEx(all, Scope_Free);
 
-  ArrayList_FreeEx(self.scopeList, Scope_Free);
-  HashMap_Free(self.map);
   profiling = false;
+  ProfilerThread* thread = self.threadList;
+  while (thread) {
+    ProfilerThread* next = thread->next;
+    ProfilerThread_Free(thread);
+    thread = next;
+  }
+  self.threadList = 0;
+  self.generation++;
   Signal_RemoveHandlerAll(Profiler_SignalHandler);
 #endif
 }
@@ -189,25 +712,28 @@ void Profiler_Disable () {
 void Profiler_Begin (cstr name) {
 #if ENABLE_PROFILER
   if (!profiling) return;
-  if (self.stackIndex + 1 >= MAX_STACK_DEPTH) {
+  ProfilerThread* thread = Profiler_GetThread();
+  if (thread->stackIndex + 1 >= MAX_STACK_DEPTH) {
     Profiler_Backtrace();
     Fatal("Profiler_Begin: Maximum stack depth exceeded");
   }
+  IF_UNLIKELY (thread->frame != SDL_AtomicGet(&self.frame))
+    ProfilerThread_Fold(thread);
   TimeStamp now = TimeStamp_Get();
 
-  if (self.stackIndex >= 0) {
-    Scope* prev = self.stack[self.stackIndex];
+  if (thread->stackIndex >= 0) {
+    Scope* prev = thread->stack[thread->stackIndex];
     prev->frame += now - prev->last;
     prev->last = now;
   }
 
-  self.stackIndex++;
-  Scope* curr = Profiler_GetScope(name);
-  self.stack[self.stackIndex] = curr;
+  thread->stackIndex++;
+  Scope* curr = Profiler_GetScope(thread, name);
+  thread->stack[thread->stackIndex] = curr;
   curr->last = now;
 
 #if ENABLE_PROFILER_TRACE
-  Trace_Begin(curr->name, now);
+  Trace_Record(thread, TraceEvent_Begin, curr->id, now, 0);
 #endif
 #endif
 }
@@ -215,23 +741,26 @@ void Profiler_Begin (cstr name) {
 void Profiler_End () {
 #if ENABLE_PROFILER
   if (!profiling) return;
-  if (self.stackIndex < 0) {
+  ProfilerThread* thread = Profiler_GetThread();
+  if (thread->stackIndex < 0) {
     Profiler_Backtrace();
     Fatal("Profiler_End: Attempting to pop an empty stack");
   }
   TimeStamp now = TimeStamp_Get();
-  Scope* prev = self.stack[self.stackIndex];
+  Scope* prev = thread->stack[thread->stackIndex];
   prev->frame += now - prev->last;
-  self.stackIndex--;
+  thread->stackIndex--;
 
 #if ENABLE_PROFILER_TRACE
-  Trace_End(prev->name, now);
+  Trace_Record(thread, TraceEvent_End, prev->id, now, 0);
 #endif
 
-  if (self.stackIndex >= 0) {
-    Scope* curr = self.stack[self.stackIndex];
+  if (thread->stackIndex >= 0) {
+    Scope* curr = thread->stack[thread->stackIndex];
     curr->last = now;
   }
+  IF_UNLIKELY (thread->frame != SDL_AtomicGet(&self.frame))
+    ProfilerThread_Fold(thread);
 #endif
 }
 
@@ -239,49 +768,457 @@ void Profiler_SetValue (cstr name, int value) {
 #if ENABLE_PROFILER
 #if ENABLE_PROFILER_TRACE
   if (!profiling) return;
-  TimeStamp ts = TimeStamp_Get();
-  fprintf(self.traceLog, ",\n  {"
-    "\"name\":\"%s\","
-    "\"ph\":\"C\","
-    "\"ts\":%llu,"
-    "\"args\":{\"value\": %d},"
-    "\"pid\":1,\"tid\":1"
-    "}",
-    name, ts, value);
+  ProfilerThread* thread = Profiler_GetThread();
+  Trace_Record(thread, TraceEvent_Counter, Str_InternId(name), TimeStamp_Get(), value);
+#endif
+#endif
+}
+
+void Profiler_AddSample (cstr name, double seconds) {
+#if ENABLE_PROFILER
+  if (!profiling || seconds <= 0.0) return;
+  ProfilerThread* thread = Profiler_GetThread();
+  IF_UNLIKELY (thread->frame != SDL_AtomicGet(&self.frame))
+    ProfilerThread_Fold(thread);
+  TimeStamp now = TimeStamp_Get();
+  TimeStamp ticks = (TimeStamp)(seconds * (double)SDL_GetPerformanceFrequency());
+
+  /* The sampled time was spent inside the innermost open scope, so move it
+   * out of that scope rather than counting it twice. */
+  if (thread->stackIndex >= 0) {
+    Scope* top = thread->stack[thread->stackIndex];
+    top->frame += now - top->last;
+    top->last = now;
+    ticks = top->frame < ticks ? top->frame : ticks;
+    top->frame -= ticks;
+  }
+
+  Scope* scope = Profiler_GetScope(thread, Str_Intern(name));
+  scope->frame += ticks;
+
+#if ENABLE_PROFILER_TRACE
+  Trace_Record(thread, TraceEvent_Sample, scope->id, now, (int32)(seconds * 1e6));
+#endif
+#endif
+}
+
+int Profiler_GetStack (cstr* names, int capacity) {
+#if ENABLE_PROFILER
+  if (!profiling) return 0;
+  ProfilerThread* thread = Profiler_GetThread();
+  int count = Min(thread->stackIndex + 1, capacity);
+  for (int i = 0; i < count; ++i)
+    names[i] = thread->stack[i]->name;
+  return count;
+#else
+  return 0;
 #endif
+}
+
+void Profiler_SetThreadName (cstr name) {
+#if ENABLE_PROFILER
+  if (!profiling) return;
+  ProfilerThread* thread = threadSelf;
+  if (thread && threadGeneration == self.generation) {
+    if (thread->name == Str_Intern(name))
+      return;
+    /* Renaming an active record would merge unrelated threads under one
+     * name; retire it and register afresh instead. */
+    if (thread->stackIndex >= 0)
+      Fatal("Profiler_SetThreadName: Cannot rename a thread from within a profiled section");
+    ProfilerThread_Fold(thread);
+    SDL_AtomicSet(&thread->retired, 1);
+  }
+  Profiler_RegisterThread(name);
 #endif
 }
 
 void Profiler_LoopMarker () {
 #if ENABLE_PROFILER
   if (!profiling) return;
-  for (int i = 0; i < ArrayList_GetSize(self.scopeList); ++i) {
-    Scope* scope = ArrayList_Get(self.scopeList, i);
-    if (scope->frame > 0.0) {
-      scope->total += scope->frame;
-      double frame = TimeStamp_ToDouble(scope->frame);
-      scope->min = Min(scope->min, frame);
-      scope->max = Max(scope->max, frame);
-
-      /* Use Welford's algorithm to compute variance in one pass. */
-      scope->count += 1.0;
-      double d1 = frame - scope->mean;
-      scope->mean += d1 / scope->count;
-      double d2 = frame - scope->mean;
-      scope->var += d1 * d2;
-      scope->frame = 0;
-    }
+  SDL_AtomicIncRef(&self.frame);
+  ProfilerThread_Fold(Profiler_GetThread());
+
+  TimeStamp now = TimeStamp_Get();
+  TimeStamp frame = now - self.frameLast;
+  double t = TimeStamp_ToDouble(frame);
+  self.frameLast = now;
+  self.frameScope.total += frame;
+  Scope_AddSample(&self.frameScope, t);
+  self.frameHistory[self.frameHistorySize++ % FRAME_HISTORY] = t;
+#endif
+}
+
+int Profiler_GetThreadCount () {
+#if ENABLE_PROFILER
+  if (!profiling) return 0;
+  return SDL_AtomicGet(&self.threadCount);
+#else
+  return 0;
+#endif
+}
+
+cstr Profiler_GetThreadName (int thread) {
+#if ENABLE_PROFILER
+  if (!profiling) return 0;
+  ProfilerThread* t = Profiler_FindThread(thread);
+  return t ? t->name : 0;
+#else
+  return 0;
+#endif
+}
+
+/* Gathers the statistics of 'name' on one thread, or on all with thread = -1,
+ * into 'scope'. */
+static bool Profiler_CollectScope (cstr name, int thread, Scope* scope) {
+  name = Str_Intern(name);
+  Scope_Init(scope, name, 0.0);
+  bool found = false;
+  for (ProfilerThread* t = self.threadList; t; t = t->next) {
+    if (thread >= 0 && t->tid != thread + 1)
+      continue;
+    Scope* src = Profiler_FindScope(t, name);
+    if (!src)
+      continue;
+    Scope_Merge(scope, src);
+    found = true;
+  }
+  return found;
+}
+
+bool Profiler_GetScopeStats (cstr name, int thread, ProfilerStats* out) {
+#if ENABLE_PROFILER
+  if (!profiling) return false;
+  Scope scope;
+  if (!Profiler_CollectScope(name, thread, &scope))
+    return false;
+  Scope_GetStats(&scope, out);
+  return true;
+#else
+  return false;
+#endif
+}
+
+double Profiler_GetScopePercentile (cstr name, int thread, double p) {
+#if ENABLE_PROFILER
+  if (!profiling) return 0.0;
+  Scope scope;
+  if (!Profiler_CollectScope(name, thread, &scope))
+    return 0.0;
+  return Scope_GetPercentile(&scope, p);
+#else
+  return 0.0;
+#endif
+}
+
+void Profiler_SetScopeBudget (cstr name, double seconds) {
+  uint32 id = Str_InternId(name);
+  seconds = Max(seconds, 0.0);
+
+  SDL_AtomicLock(&budgets.lock);
+  while (budgets.budget_size <= (int32)id)
+    ArrayList_Append(budgets.budget, 0.0);
+  budgets.budget_data[id] = seconds;
+  SDL_AtomicUnlock(&budgets.lock);
+
+#if ENABLE_PROFILER
+  /* Existing scopes pick up the new budget for subsequent frames. */
+  if (!profiling) return;
+  for (ProfilerThread* t = self.threadList; t; t = t->next)
+    ArrayList_ForEachI(t->scopeList, i)
+      if (t->scopeList_data[i]->id == id)
+        t->scopeList_data[i]->budget = seconds;
+#endif
+}
+
+void Profiler_SetFrameBudget (double seconds) {
+  frameBudget = Max(seconds, 0.0);
+#if ENABLE_PROFILER
+  self.frameScope.budget = frameBudget;
+#endif
+}
+
+bool Profiler_GetFrameStats (ProfilerStats* out) {
+#if ENABLE_PROFILER
+  if (!profiling || self.frameScope.count <= 0.0) return false;
+  Scope_GetStats(&self.frameScope, out);
+  return true;
+#else
+  return false;
+#endif
+}
+
+int Profiler_GetFrameHistory (double* out, int count) {
+#if ENABLE_PROFILER
+  if (!profiling) return 0;
+  uint32 size = self.frameHistorySize;
+  int available = size < FRAME_HISTORY ? (int)size : FRAME_HISTORY;
+  count = Min(count, available);
+  for (int i = 0; i < count; ++i)
+    out[i] = self.frameHistory[(size - count + i) % FRAME_HISTORY];
+  return count;
+#else
+  return 0;
+#endif
+}
+
+void Profiler_SetTraceWindow (double seconds) {
+  traceWindow = Max(seconds, 0.0);
+}
+
+void Profiler_FlushTrace () {
+#if ENABLE_PROFILER && ENABLE_PROFILER_TRACE
+  if (!profiling || self.traceCapture) return;
+  SDL_AtomicLock(&self.traceLock);
+  if (self.traceLog)
+    Trace_Drain();
+  SDL_AtomicUnlock(&self.traceLock);
+#endif
+}
+
+bool Profiler_DumpTrace (cstr path) {
+#if ENABLE_PROFILER && ENABLE_PROFILER_TRACE
+  if (!profiling) return false;
+  if (!self.traceCapture) {
+    Warn("Profiler_DumpTrace: Trace is not in capture mode (see Profiler_SetTraceWindow)");
+    return false;
+  }
+
+  FILE* file = Trace_OpenFile(path);
+  if (!file) {
+    Warn("Profiler_DumpTrace: Failed to open <%s>", path);
+    return false;
+  }
+
+  TimeStamp now = TimeStamp_Get();
+  TimeStamp window = (TimeStamp)(traceWindow * (double)SDL_GetPerformanceFrequency());
+  TimeStamp cutoff = now > window ? now - window : 0;
+  TraceEvent* buffer = MemNewArray(TraceEvent, TRACE_RING_SIZE);
+
+  SDL_AtomicLock(&self.traceLock);
+  for (ProfilerThread* t = self.threadList; t; t = t->next) {
+    Trace_WriteThread(file, t->tid, t->name);
+
+    uint32 w = t->ringWrite;
+    SDL_MemoryBarrierAcquire();
+    uint32 count = w < TRACE_RING_SIZE ? w : TRACE_RING_SIZE;
+    uint32 first = w - count;
+    for (uint32 i = 0; i < count; ++i)
+      buffer[i] = t->ring[(first + i) & (TRACE_RING_SIZE - 1)];
+    SDL_MemoryBarrierAcquire();
+
+    /* The thread keeps recording while we copy; anything it may have
+     * overwritten in the meantime is discarded. */
+    uint32 written = t->ringWrite - first;
+    uint32 skip = written >= TRACE_RING_SIZE ? written - TRACE_RING_SIZE + 1 : 0;
+    skip = (uint32)Min((int)skip, (int)count);
+    while (skip < count && buffer[skip].ts < cutoff)
+      skip++;
+    Trace_WriteEvents(file, t->tid, buffer + skip, count - skip);
   }
+  Trace_WriteNames(file, 0, Str_GetInternCount());
+  SDL_AtomicUnlock(&self.traceLock);
+
+  MemFree(buffer);
+  fclose(file);
+  return true;
+#else
+  return false;
 #endif
 }
 
+/* Writes 's' as a quoted JSON string. Names come from arbitrary strings
+ * (script chunk names in particular), so quotes, backslashes and control
+ * characters must be escaped. */
+static void Trace_WriteJsonString (FILE* out, cstr s) {
+  fputc('"', out);
+  for (; *s; ++s) {
+    uchar c = (uchar)*s;
+    if (c == '"' || c == '\\') {
+      fputc('\\', out);
+      fputc(c, out);
+    } else if (c < 0x20) {
+      fprintf(out, "\\u%04x", c);
+    } else {
+      fputc(c, out);
+    }
+  }
+  fputc('"', out);
+}
+
+/* Chrome's viewer wants microseconds; timestamps are rebased to the earliest
+ * event so that they stay small. */
+bool Profiler_ConvertTrace (cstr src, cstr dst) {
+  FILE* in = fopen(src, "rb");
+  if (!in) {
+    Warn("Profiler_ConvertTrace: Failed to open <%s>", src);
+    return false;
+  }
+  fseek(in, 0, SEEK_END);
+  long size = ftell(in);
+  rewind(in);
+  uint8* data = (uint8*)MemAlloc(size > 0 ? (size_t)size : 1);
+  bool ok = size >= (long)sizeof(TraceHeader) && fread(data, (size_t)size, 1, in) == 1;
+  fclose(in);
+
+  TraceHeader const* header = (TraceHeader const*)data;
+  if (ok)
+    ok = memcmp(header->magic, kTraceMagic, sizeof(kTraceMagic)) == 0 &&
+         header->version == kTraceVersion && header->frequency > 0;
+  if (!ok) {
+    Warn("Profiler_ConvertTrace: <%s> is not a valid trace", src);
+    MemFree(data);
+    return false;
+  }
+
+  uint8 const* begin = data + sizeof(TraceHeader);
+  uint8 const* end = data + size;
+
+  /* Pass 1 : Name tables and the time origin. */
+  ArrayList(cstr, name);
+  ArrayList(cstr, thread);
+  ArrayList(int32, depth);
+  ArrayList(bool, sampled);
+  ArrayList_Init(name);
+  ArrayList_Init(thread);
+  ArrayList_Init(depth);
+  ArrayList_Init(sampled);
+  TimeStamp origin = ~(TimeStamp)0;
+
+  for (uint8 const* p = begin; p + sizeof(TraceChunk) <= end;) {
+    TraceChunk const* chunk = (TraceChunk const*)p;
+    uint8 const* payload = p + sizeof(TraceChunk);
+    p = payload + chunk->size;
+    if (p > end || chunk->size < sizeof(uint32))
+      break;
+
+    uint32 key = *(uint32 const*)payload;
+    if (chunk->type == TraceChunk_Name || chunk->type == TraceChunk_Thread) {
+      bool isName = chunk->type == TraceChunk_Name;
+      while ((uint32)(isName ? name_size : thread_size) <= key) {
+        if (isName) ArrayList_Append(name, 0)
+        else ArrayList_Append(thread, 0)
+      }
+      (isName ? name_data : thread_data)[key] = (cstr)(payload + sizeof(uint32));
+    } else if (chunk->type == TraceChunk_Events) {
+      TraceEvent const* e = (TraceEvent const*)(payload + sizeof(uint32));
+      uint32 count = (chunk->size - sizeof(uint32)) / sizeof(TraceEvent);
+      for (uint32 i = 0; i < count; ++i) {
+        if (e[i].ts < origin) origin = e[i].ts;
+        if ((e[i].tag >> TRACE_TYPE_SHIFT) == TraceEvent_Sample) {
+          while ((uint32)sampled_size <= key)
+            ArrayList_Append(sampled, false);
+          sampled_data[key] = true;
+        }
+      }
+    }
+  }
+
+  FILE* out = fopen(dst, "wb");
+  if (!out) {
+    Warn("Profiler_ConvertTrace: Failed to open <%s>", dst);
+    ArrayList_Free(name);
+    ArrayList_Free(thread);
+    ArrayList_Free(depth);
+    ArrayList_Free(sampled);
+    MemFree(data);
+    return false;
+  }
+
+  fputs("[ {\"name\":\"TRACE_START\",\"ph\":\"M\",\"pid\":1,\"tid\":1}", out);
+  for (int32 tid = 0; tid < thread_size; ++tid) {
+    if (!thread_data[tid]) continue;
+    fprintf(out, ",\n  {"
+      "\"name\":\"thread_name\","
+      "\"ph\":\"M\","
+      "\"pid\":1,\"tid\":%d,"
+      "\"args\":{\"name\":",
+      tid);
+    Trace_WriteJsonString(out, thread_data[tid]);
+    fputs("}}", out);
+    if (tid < sampled_size && sampled_data[tid]) {
+      cstr title = StrAdd(thread_data[tid], " (samples)");
+      fprintf(out, ",\n  {"
+        "\"name\":\"thread_name\","
+        "\"ph\":\"M\","
+        "\"pid\":1,\"tid\":%d,"
+        "\"args\":{\"name\":",
+        tid + TRACE_SAMPLE_TID);
+      Trace_WriteJsonString(out, title);
+      fputs("}}", out);
+      StrFree(title);
+    }
+  }
+
+  /* Pass 2 : Events. An End whose Begin precedes the capture is dropped. */
+  double toMicros = 1e6 / (double)header->frequency;
+  for (uint8 const* p = begin; p + sizeof(TraceChunk) <= end;) {
+    TraceChunk const* chunk = (TraceChunk const*)p;
+    uint8 const* payload = p + sizeof(TraceChunk);
+    p = payload + chunk->size;
+    if (p > end || chunk->size < sizeof(uint32))
+      break;
+    if (chunk->type != TraceChunk_Events)
+      continue;
+
+    int32 tid = *(int32 const*)payload;
+    while (depth_size <= tid)
+      ArrayList_Append(depth, 0);
+
+    TraceEvent const* e = (TraceEvent const*)(payload + sizeof(uint32));
+    uint32 count = (chunk->size - sizeof(uint32)) / sizeof(TraceEvent);
+    for (uint32 i = 0; i < count; ++i) {
+      uint32 type = e[i].tag >> TRACE_TYPE_SHIFT;
+      uint32 id = e[i].tag & TRACE_ID_MASK;
+      cstr eventName = (int32)id < name_size && name_data[id] ? name_data[id] : "?";
+      double ts = (double)(e[i].ts - origin) * toMicros;
+
+      if (type == TraceEvent_Begin) {
+        depth_data[tid]++;
+        fputs(",\n  {\"name\":", out);
+        Trace_WriteJsonString(out, eventName);
+        fprintf(out, ",\"ph\":\"B\",\"ts\":%.3f,\"pid\":1,\"tid\":%d}", ts, tid);
+      } else if (type == TraceEvent_End) {
+        if (depth_data[tid] == 0) continue;
+        depth_data[tid]--;
+        fputs(",\n  {\"name\":", out);
+        Trace_WriteJsonString(out, eventName);
+        fprintf(out, ",\"ph\":\"E\",\"ts\":%.3f,\"pid\":1,\"tid\":%d}", ts, tid);
+      } else if (type == TraceEvent_Counter) {
+        fputs(",\n  {\"name\":", out);
+        Trace_WriteJsonString(out, eventName);
+        fprintf(out, ",\"ph\":\"C\",\"ts\":%.3f,"
+          "\"args\":{\"value\": %d},\"pid\":1,\"tid\":%d}",
+          ts, e[i].value, tid);
+      } else if (type == TraceEvent_Sample) {
+        double dur = Min((double)e[i].value, ts);
+        fputs(",\n  {\"name\":", out);
+        Trace_WriteJsonString(out, eventName);
+        fprintf(out, ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+          "\"pid\":1,\"tid\":%d}",
+          ts - dur, dur, tid + TRACE_SAMPLE_TID);
+      }
+    }
+  }
+  fputs("\n]", out);
+  fclose(out);
+
+  ArrayList_Free(name);
+  ArrayList_Free(thread);
+  ArrayList_Free(depth);
+  ArrayList_Free(sampled);
+  MemFree(data);
+  return true;
+}
+
 void Profiler_Backtrace () {
 #if ENABLE_PROFILER
   if (!profiling) return;
-  puts("PHX Profiler Backtrace:");
-  for (int i = 0; i <= self.stackIndex; ++i) {
-    int index = self.stackIndex - i;
-    printf("  [%i] %s\n", index, self.stack[index]->name);
+  ProfilerThread* thread = Profiler_GetThread();
+  printf("PHX Profiler Backtrace [%s #%d]:\n", thread->name, thread->tid);
+  for (int i = 0; i <= thread->stackIndex; ++i) {
+    int index = thread->stackIndex - i;
+    printf("  [%i] %s\n", index, thread->stack[index]->name);
   }
   fflush(stdout);
 #endif
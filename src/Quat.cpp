@@ -1,3 +1,5 @@
+#include "Matrix.h"
+#include "MatrixDef.h"
 #include "PhxMath.h"
 #include "PhxFloat.h"
 #include "Quat.h"
@@ -244,6 +246,28 @@ void Quat_MulV (Quat const* q, Vec3f const* v, Vec3f* out) {
   Assert(Vec3f_Validate(*out) == Error_None);
 }
 
+/* Batch rotation goes through the equivalent 3x3 matrix, which costs nine
+ * multiply-adds per vector instead of the fifteen of Quat_MulV and shares the
+ * SIMD kernels of Matrix_MulDirs. Assumes a unit quaternion, as Quat_MulV. */
+static void Quat_ToRotation (Quat const* q, Matrix* out) {
+  Vec3f x; Quat_GetAxisX(q, &x);
+  Vec3f y; Quat_GetAxisY(q, &y);
+  Vec3f z; Quat_GetAxisZ(q, &z);
+  Matrix_SetFromBasis(out, &x, &y, &z);
+}
+
+void Quat_RotateVectors (Quat const* q, Vec3f* out, Vec3f const* in, int count) {
+  Matrix rotation;
+  Quat_ToRotation(q, &rotation);
+  Matrix_MulDirs(&rotation, out, in, count);
+}
+
+void Quat_RotateVectorsSoA (Quat const* q, float* x, float* y, float* z, int count) {
+  Matrix rotation;
+  Quat_ToRotation(q, &rotation);
+  Matrix_MulDirsSoA(&rotation, x, y, z, count);
+}
+
 void Quat_Normalize (Quat const* q, Quat* out) {
   float mag = Sqrt(q->x*q->x + q->y*q->y + q->z*q->z + q->w*q->w);
   Assert(mag != 0.0f);
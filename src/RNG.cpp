@@ -1,3 +1,4 @@
+#include "FastMath.h"
 #include "Hash.h"
 #include "PhxMemory.h"
 #include "RNG.h"
@@ -10,21 +11,78 @@
 #include "Vec3.h"
 #include "Vec4.h"
 
+#if defined(__SSE2__) || defined(_M_X64)
+  #define RNG_SSE 1
+  #include <emmintrin.h>
+#else
+  #define RNG_SSE 0
+#endif
+
 /* TODO : Rigorous testing of Xoroshiro128 & my implementation thereof. */
 
+/* NOTE : Generator 0 is the scalar sequence, 1 through RNG_LANES the bulk
+ *        lanes. Lanes are jumped into place from 'base' on first use, so
+ *        that RNGs which never fill an array don't pay for it. */
+#define RNG_LANES 4
+#define RNG_STREAM_BLOCKS (1 + RNG_LANES)
+#define RNG_CHUNK 256
+
+struct RNGState {
+  uint64 s0[RNG_STREAM_BLOCKS];
+  uint64 s1[RNG_STREAM_BLOCKS];
+  uint64 base[2];
+  bool lanesReady;
+};
+
 struct RNG {
   uint64 seed;
-  uint64 state[2];
+  RNGState state;
+  RNGState origin;
 };
 
 inline static uint64 RNG_Next64 (RNG* self) {
-	return Random_Xoroshiro128(self->state[0], self->state[1]);
+	return Random_Xoroshiro128(self->state.s0[0], self->state.s1[0]);
 }
 
 inline static uint32 RNG_Next32 (RNG* self) {
   return (uint32)(RNG_Next64(self) & 0xFFFFFFFFU);
 }
 
+/* Advance a Xoroshiro128 generator by 2^64 draws. */
+static void RNG_JumpGenerator (uint64* s0, uint64* s1) {
+  static uint64 const kJump[] = {
+    UINT64_C(0xBEAC0467EBA5FACB),
+    UINT64_C(0xD86B048B86AA9922) };
+
+  uint64 j0 = 0;
+  uint64 j1 = 0;
+  for (int i = 0; i < 2; ++i) {
+    for (int b = 0; b < 64; ++b) {
+      if (kJump[i] & (UINT64_C(1) << b)) {
+        j0 ^= *s0;
+        j1 ^= *s1;
+      }
+      Random_Xoroshiro128(*s0, *s1);
+    }
+  }
+  *s0 = j0;
+  *s1 = j1;
+}
+
+static void RNG_PrepareLanes (RNG* self) {
+  RNGState* st = &self->state;
+  if (st->lanesReady)
+    return;
+  uint64 s0 = st->base[0];
+  uint64 s1 = st->base[1];
+  for (int i = 1; i <= RNG_LANES; ++i) {
+    RNG_JumpGenerator(&s0, &s1);
+    st->s0[i] = s0;
+    st->s1[i] = s1;
+  }
+  st->lanesReady = true;
+}
+
 /* Seed Xoroshiro with SM64. */
 inline static void RNG_Init (RNG* self) {
   uint64 seed = self->seed;
@@ -33,10 +91,14 @@ inline static void RNG_Init (RNG* self) {
    *        Rigorous investigation needed. */
   for (int i = 0; i < 64; ++i)
     seed = Random_SplitMix64(seed);
-  self->state[0] = Random_SplitMix64(seed);
-  self->state[1] = Random_SplitMix64(seed);
+  self->state.s0[0] = Random_SplitMix64(seed);
+  self->state.s1[0] = Random_SplitMix64(seed);
   for (int i = 0; i < 64; ++i)
     RNG_Next64(self);
+  self->state.base[0] = self->state.s0[0];
+  self->state.base[1] = self->state.s1[0];
+  self->state.lanesReady = false;
+  self->origin = self->state;
 }
 
 RNG* RNG_Create (uint64 seed) {
@@ -58,8 +120,30 @@ void RNG_Free (RNG* self) {
   MemFree(self);
 }
 
+void RNG_Jump (RNG* self) {
+  RNGState* st = &self->state;
+  for (int i = 0; i < RNG_STREAM_BLOCKS; ++i) {
+    RNG_JumpGenerator(st->s0, st->s1);
+    if (st->lanesReady) {
+      for (int j = 1; j <= RNG_LANES; ++j)
+        RNG_JumpGenerator(st->s0 + j, st->s1 + j);
+    } else {
+      RNG_JumpGenerator(st->base, st->base + 1);
+    }
+  }
+}
+
 void RNG_Rewind (RNG* self) {
-  RNG_Init(self);
+  self->state = self->origin;
+}
+
+RNG* RNG_Split (RNG* self) {
+  RNG* split = MemNew(RNG);
+  split->seed = self->seed;
+  split->state = self->state;
+  split->origin = self->state;
+  RNG_Jump(self);
+  return split;
 }
 
 bool RNG_Chance (RNG* self, double probability) {
@@ -229,3 +313,155 @@ void RNG_GetQuat (RNG* self, Quat* out) {
   out->z = (float)(p1.y * s);
   out->w = (float)p0.x;
 }
+
+/* --- Bulk Generation ------------------------------------------------------ */
+
+/* Each step of the four lanes yields a group of eight 32-bit words: the low
+ * then high half of lane 1's output, then lane 2's, and so on. The SSE path
+ * steps two lanes per register and stores the same little-endian layout. */
+
+#if RNG_SSE
+
+#define RNG_ROTL(x, k) \
+  _mm_or_si128(_mm_slli_epi64(x, k), _mm_srli_epi64(x, 64 - (k)))
+
+#define RNG_STEP(s0, s1) {                                                     \
+  s1 = _mm_xor_si128(s1, s0);                                                  \
+  s0 = _mm_xor_si128(_mm_xor_si128(RNG_ROTL(s0, 55), s1), _mm_slli_epi64(s1, 14)); \
+  s1 = RNG_ROTL(s1, 36);                                                       \
+}
+
+static void RNG_FillGroups (RNGState* st, uint32* out, int groups) {
+  __m128i a0 = _mm_loadu_si128((__m128i const*)(st->s0 + 1));
+  __m128i a1 = _mm_loadu_si128((__m128i const*)(st->s1 + 1));
+  __m128i b0 = _mm_loadu_si128((__m128i const*)(st->s0 + 3));
+  __m128i b1 = _mm_loadu_si128((__m128i const*)(st->s1 + 3));
+  for (int i = 0; i < groups; ++i) {
+    _mm_storeu_si128((__m128i*)(out + 8 * i + 0), _mm_add_epi64(a0, a1));
+    _mm_storeu_si128((__m128i*)(out + 8 * i + 4), _mm_add_epi64(b0, b1));
+    RNG_STEP(a0, a1);
+    RNG_STEP(b0, b1);
+  }
+  _mm_storeu_si128((__m128i*)(st->s0 + 1), a0);
+  _mm_storeu_si128((__m128i*)(st->s1 + 1), a1);
+  _mm_storeu_si128((__m128i*)(st->s0 + 3), b0);
+  _mm_storeu_si128((__m128i*)(st->s1 + 3), b1);
+}
+
+#undef RNG_STEP
+#undef RNG_ROTL
+
+/* out[i] = lower + scale * (bits[i] >> 8) * 2^-24 */
+static void RNG_ToFloats (
+  uint32 const* bits, float* out, int count, float lower, float scale)
+{
+  __m128 vLower = _mm_set1_ps(lower);
+  __m128 vScale = _mm_set1_ps(scale * (1.0f / 16777216.0f));
+  int i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128i u = _mm_srli_epi32(_mm_loadu_si128((__m128i const*)(bits + i)), 8);
+    __m128 f = _mm_add_ps(vLower, _mm_mul_ps(vScale, _mm_cvtepi32_ps(u)));
+    _mm_storeu_ps(out + i, f);
+  }
+  for (; i < count; ++i)
+    out[i] = lower + scale * (1.0f / 16777216.0f) * (float)(int32)(bits[i] >> 8);
+}
+
+#else
+
+static void RNG_FillGroups (RNGState* st, uint32* out, int groups) {
+  for (int i = 0; i < groups; ++i) {
+    for (int j = 1; j <= RNG_LANES; ++j) {
+      uint64 r = Random_Xoroshiro128(st->s0[j], st->s1[j]);
+      out[8 * i + 2 * j - 2] = (uint32)(r & 0xFFFFFFFFU);
+      out[8 * i + 2 * j - 1] = (uint32)(r >> 32);
+    }
+  }
+}
+
+static void RNG_ToFloats (
+  uint32 const* bits, float* out, int count, float lower, float scale)
+{
+  for (int i = 0; i < count; ++i)
+    out[i] = lower + scale * (1.0f / 16777216.0f) * (float)(int32)(bits[i] >> 8);
+}
+
+#endif
+
+void RNG_Fill32 (RNG* self, uint32* out, int count) {
+  RNG_PrepareLanes(self);
+  int groups = count / 8;
+  RNG_FillGroups(&self->state, out, groups);
+  if (count > 8 * groups) {
+    uint32 tail[8];
+    RNG_FillGroups(&self->state, tail, 1);
+    MemCpy(out + 8 * groups, tail, sizeof(uint32) * (count - 8 * groups));
+  }
+}
+
+void RNG_FillUniform (RNG* self, float* out, int count) {
+  RNG_FillUniformRange(self, out, count, 0.0f, 1.0f);
+}
+
+void RNG_FillUniformRange (RNG* self, float* out, int count, float lower, float upper) {
+  uint32 bits[RNG_CHUNK];
+  for (int i = 0; i < count; i += RNG_CHUNK) {
+    int n = Min(count - i, RNG_CHUNK);
+    RNG_Fill32(self, bits, n);
+    RNG_ToFloats(bits, out + i, n, lower, upper - lower);
+  }
+}
+
+/* NOTE : Unlike their scalar counterparts, the vector distributions below
+ *        are sampled analytically rather than by rejection, so that every
+ *        output consumes a fixed number of draws. Trig and log come from
+ *        FastMath, which is within a few float ulps of libm. */
+
+/* Box-Muller, using both outputs of each pair. */
+void RNG_FillGaussian (RNG* self, float* out, int count) {
+  float u[RNG_CHUNK];
+  for (int i = 0; i < count; i += RNG_CHUNK) {
+    int n = Min(count - i, RNG_CHUNK);
+    RNG_FillUniform(self, u, (n + 1) & ~1);
+    for (int j = 0; j < n; j += 2) {
+      float r = Sqrt(-2.0f * FastLog(1.0f - u[j]));
+      float angle = Tau * u[j + 1];
+      out[i + j] = r * FastCos(angle);
+      if (j + 1 < n)
+        out[i + j + 1] = r * FastSin(angle);
+    }
+  }
+}
+
+/* Uniform z and azimuth (Archimedes). */
+void RNG_FillDir3 (RNG* self, Vec3f* out, int count) {
+  float u[2 * (RNG_CHUNK / 2)];
+  for (int i = 0; i < count; i += RNG_CHUNK / 2) {
+    int n = Min(count - i, RNG_CHUNK / 2);
+    RNG_FillUniform(self, u, 2 * n);
+    for (int j = 0; j < n; ++j) {
+      float z = 1.0f - 2.0f * u[2 * j];
+      float r = Sqrt(Max(0.0f, 1.0f - z * z));
+      float angle = Tau * u[2 * j + 1];
+      out[i + j] = Vec3f_Create(r * FastCos(angle), r * FastSin(angle), z);
+    }
+  }
+}
+
+/* A uniform direction scaled by the largest of three uniforms, which has the
+ * same r^3 distribution as the cube root of one, at a fraction of the cost. */
+void RNG_FillSphere (RNG* self, Vec3f* out, int count) {
+  float u[5 * (RNG_CHUNK / 8)];
+  for (int i = 0; i < count; i += RNG_CHUNK / 8) {
+    int n = Min(count - i, RNG_CHUNK / 8);
+    RNG_FillUniform(self, u, 5 * n);
+    for (int j = 0; j < n; ++j) {
+      float const* uj = u + 5 * j;
+      float z = 1.0f - 2.0f * uj[0];
+      float r = Sqrt(Max(0.0f, 1.0f - z * z));
+      float angle = Tau * uj[1];
+      float radius = Max(uj[2], Max(uj[3], uj[4]));
+      out[i + j] = Vec3f_Muls(Vec3f_Create(r * FastCos(angle), r * FastSin(angle), z), radius);
+    }
+  }
+}
@@ -1,4 +1,5 @@
 #include "ArrayList.h"
+#include "HashMap.h"
 #include "Matrix.h"
 #include "PhxMemory.h"
 #include "OpenGL.h"
@@ -9,6 +10,7 @@
 #include "ShaderState.h"
 #include "ShaderVar.h"
 #include "ShaderVarType.h"
+#include "StrIntern.h"
 #include "StrMap.h"
 #include "PhxString.h"
 #include "Tex1D.h"
@@ -29,6 +31,7 @@ static cstr versionString = "#version 130\n";
 struct ShaderVar {
   ShaderVarType type;
   cstr name;
+  uint32 id;
   int index;
 };
 
@@ -40,6 +43,7 @@ struct Shader {
   uint program;
   uint texIndex;
   ArrayList(ShaderVar, vars);
+  HashMap* uniforms;
 };
 
 static Shader* current = 0;
@@ -48,12 +52,22 @@ static StrMap* cache = 0;
 static cstr GLSL_Load(cstr path, Shader*);
 static cstr GLSL_Preprocess(cstr code, Shader*);
 
-static int GetUniformIndex (Shader* self, cstr name, bool mustSucceed = false) {
+/* Uniform locations are cached per shader by interned name ID. Values are
+ * stored offset by 2 so that a missing uniform (-1) is still non-null. */
+static int GetUniformIndex (Shader* self, uint32 id, bool mustSucceed = false) {
   if (!self)
     Fatal("GetUniformIndex: No shader is bound");
-  int index = glGetUniformLocation(self->program, name);
+  void* cached = HashMap_GetRaw(self->uniforms, id);
+  int index;
+  if (cached) {
+    index = (int)(size_t)cached - 2;
+  } else {
+    index = glGetUniformLocation(self->program, Str_GetInterned(id));
+    HashMap_SetRaw(self->uniforms, id, (void*)(size_t)(index + 2));
+  }
   if (index == -1 && mustSucceed)
-    Fatal("GetUniformIndex: Shader <%s> has no variable <%s>", self->name, name);
+    Fatal("GetUniformIndex: Shader <%s> has no variable <%s>",
+      self->name, Str_GetInterned(id));
   return index;
 }
 
@@ -119,7 +133,7 @@ static cstr GLSL_Load (cstr name, Shader* self) {
     return (cstr)cached;
   cstr rawCode = Resource_LoadCstr(ResourceType_Shader, name);
   cstr code = StrReplace(rawCode, "\r\n", "\n");
-  StrFree(rawCode);
+  MemFree(rawCode);
   code = GLSL_Preprocess(code, self);
   /* BUG : Disable GLSL caching until preprocessor cache works. */
   // StrMap_Set(cache, name, (void*)code);
@@ -155,7 +169,8 @@ static cstr GLSL_Preprocess (cstr code, Shader* self) {
       if (var.type == ShaderVarType_None)
         Fatal("GLSL_Preprocess: Unknown shader variable type <%s> "
               "in directive:\n  %s", varType, line);
-      var.name = StrDup(varName);
+      var.name = Str_Intern(varName);
+      var.id = Str_GetInternId(var.name);
       var.index = -1;
       ArrayList_Append(self->vars, var);
     } else {
@@ -186,6 +201,7 @@ Shader* Shader_Create (cstr vs, cstr fs) {
   Shader* self = MemNew(Shader);
   RefCounted_Init(self);
   ArrayList_Init(self->vars);
+  self->uniforms = HashMap_Create(0, 16);
   vs = GLSL_Preprocess(StrDup(vs), self);
   fs = GLSL_Preprocess(StrDup(fs), self);
   self->vs = CreateGLShader(vs, GL_VERTEX_SHADER);
@@ -200,9 +216,11 @@ Shader* Shader_Create (cstr vs, cstr fs) {
 }
 
 Shader* Shader_Load (cstr vName, cstr fName) {
+  MEMTAG_BEGIN(MemTag_Render);
   Shader* self = MemNew(Shader);
   RefCounted_Init(self);
   ArrayList_Init(self->vars);
+  self->uniforms = HashMap_Create(0, 16);
   cstr vs = GLSL_Load(vName, self);
   cstr fs = GLSL_Load(fName, self);
   self->vs = CreateGLShader(vs, GL_VERTEX_SHADER);
@@ -211,6 +229,7 @@ Shader* Shader_Load (cstr vName, cstr fName) {
   self->texIndex = 1;
   self->name = StrFormat("[vs: %s , fs: %s]", vName, fName);
   Shader_BindVariables(self);
+  MEMTAG_END;
   return self;
 }
 
@@ -224,6 +243,7 @@ void Shader_Free (Shader* self) {
     GLCALL(glDeleteShader(self->fs))
     GLCALL(glDeleteProgram(self->program))
     ArrayList_Free(self->vars);
+    HashMap_Free(self->uniforms);
     StrFree(self->name);
     MemFree(self);
   }
@@ -245,7 +265,7 @@ void Shader_Start (Shader* self) {
   for (int i = 0; i < ArrayList_GetSize(self->vars); ++i) {
     ShaderVar* var = ArrayList_GetPtr(self->vars, i);
     if (var->index < 0) continue;
-    void* pValue = ShaderVar_Get(var->name, var->type);
+    void* pValue = ShaderVar_GetId(var->id, var->type);
     if (!pValue)
       Fatal("Shader_Start: Shader variable stack does not contain variable <%s>", var->name);
 
@@ -308,7 +328,7 @@ void Shader_Stop (Shader*) {
 }
 
 static void ShaderCache_FreeElem (cstr, void* data) {
-  free(data);
+  StrFree((cstr)data);
 }
 
 void Shader_ClearCache () {
@@ -336,7 +356,11 @@ bool Shader_HasVariable (Shader* self, cstr name) {
 /* --- Variable Binding ----------------------------------------------------- */
 
 void Shader_SetFloat (cstr name, float value) {
-  GLCALL(glUniform1f(GetUniformIndex(current, name), value))
+  Shader_SetFloatId(Str_InternId(name), value);
+}
+
+void Shader_SetFloatId (uint32 id, float value) {
+  GLCALL(glUniform1f(GetUniformIndex(current, id), value))
 }
 
 void Shader_ISetFloat (int index, float value) {
@@ -344,7 +368,11 @@ void Shader_ISetFloat (int index, float value) {
 }
 
 void Shader_SetFloat2 (cstr name, float x, float y) {
-  GLCALL(glUniform2f(GetUniformIndex(current, name), x, y))
+  Shader_SetFloat2Id(Str_InternId(name), x, y);
+}
+
+void Shader_SetFloat2Id (uint32 id, float x, float y) {
+  GLCALL(glUniform2f(GetUniformIndex(current, id), x, y))
 }
 
 void Shader_ISetFloat2 (int index, float x, float y) {
@@ -352,7 +380,11 @@ void Shader_ISetFloat2 (int index, float x, float y) {
 }
 
 void Shader_SetFloat3 (cstr name, float x, float y, float z) {
-  GLCALL(glUniform3f(GetUniformIndex(current, name), x, y, z))
+  Shader_SetFloat3Id(Str_InternId(name), x, y, z);
+}
+
+void Shader_SetFloat3Id (uint32 id, float x, float y, float z) {
+  GLCALL(glUniform3f(GetUniformIndex(current, id), x, y, z))
 }
 
 void Shader_ISetFloat3 (int index, float x, float y, float z) {
@@ -360,7 +392,11 @@ void Shader_ISetFloat3 (int index, float x, float y, float z) {
 }
 
 void Shader_SetFloat4 (cstr name, float x, float y, float z, float w) {
-  GLCALL(glUniform4f(GetUniformIndex(current, name), x, y, z, w))
+  Shader_SetFloat4Id(Str_InternId(name), x, y, z, w);
+}
+
+void Shader_SetFloat4Id (uint32 id, float x, float y, float z, float w) {
+  GLCALL(glUniform4f(GetUniformIndex(current, id), x, y, z, w))
 }
 
 void Shader_ISetFloat4 (int index, float x, float y, float z, float w) {
@@ -368,7 +404,11 @@ void Shader_ISetFloat4 (int index, float x, float y, float z, float w) {
 }
 
 void Shader_SetInt (cstr name, int value) {
-  GLCALL(glUniform1i(GetUniformIndex(current, name), value))
+  Shader_SetIntId(Str_InternId(name), value);
+}
+
+void Shader_SetIntId (uint32 id, int value) {
+  GLCALL(glUniform1i(GetUniformIndex(current, id), value))
 }
 
 void Shader_ISetInt (int index, int value) {
@@ -376,11 +416,19 @@ void Shader_ISetInt (int index, int value) {
 }
 
 void Shader_SetMatrix (cstr name, Matrix* value) {
-  GLCALL(glUniformMatrix4fv(GetUniformIndex(current, name), 1, true, (float*)value))
+  Shader_SetMatrixId(Str_InternId(name), value);
+}
+
+void Shader_SetMatrixId (uint32 id, Matrix* value) {
+  GLCALL(glUniformMatrix4fv(GetUniformIndex(current, id), 1, true, (float*)value))
 }
 
 void Shader_SetMatrixT (cstr name, Matrix* value) {
-  GLCALL(glUniformMatrix4fv(GetUniformIndex(current, name), 1, false, (float*)value))
+  Shader_SetMatrixTId(Str_InternId(name), value);
+}
+
+void Shader_SetMatrixTId (uint32 id, Matrix* value) {
+  GLCALL(glUniformMatrix4fv(GetUniformIndex(current, id), 1, false, (float*)value))
 }
 
 void Shader_ISetMatrix (int index, Matrix* value) {
@@ -392,7 +440,11 @@ void Shader_ISetMatrixT (int index, Matrix* value) {
 }
 
 void Shader_SetTex1D (cstr name, Tex1D* value) {
-  GLCALL(glUniform1i(GetUniformIndex(current, name), current->texIndex))
+  Shader_SetTex1DId(Str_InternId(name), value);
+}
+
+void Shader_SetTex1DId (uint32 id, Tex1D* value) {
+  GLCALL(glUniform1i(GetUniformIndex(current, id), current->texIndex))
   GLCALL(glActiveTexture(GL_TEXTURE0 + current->texIndex++))
   GLCALL(glBindTexture(GL_TEXTURE_1D, Tex1D_GetHandle(value)))
   GLCALL(glActiveTexture(GL_TEXTURE0))
@@ -406,7 +458,11 @@ void Shader_ISetTex1D (int index, Tex1D* value) {
 }
 
 void Shader_SetTex2D (cstr name, Tex2D* value) {
-  GLCALL(glUniform1i(GetUniformIndex(current, name), current->texIndex))
+  Shader_SetTex2DId(Str_InternId(name), value);
+}
+
+void Shader_SetTex2DId (uint32 id, Tex2D* value) {
+  GLCALL(glUniform1i(GetUniformIndex(current, id), current->texIndex))
   GLCALL(glActiveTexture(GL_TEXTURE0 + current->texIndex++))
   GLCALL(glBindTexture(GL_TEXTURE_2D, Tex2D_GetHandle(value)))
   GLCALL(glActiveTexture(GL_TEXTURE0))
@@ -420,7 +476,11 @@ void Shader_ISetTex2D (int index, Tex2D* value) {
 }
 
 void Shader_SetTex3D (cstr name, Tex3D* value) {
-  GLCALL(glUniform1i(GetUniformIndex(current, name), current->texIndex))
+  Shader_SetTex3DId(Str_InternId(name), value);
+}
+
+void Shader_SetTex3DId (uint32 id, Tex3D* value) {
+  GLCALL(glUniform1i(GetUniformIndex(current, id), current->texIndex))
   GLCALL(glActiveTexture(GL_TEXTURE0 + current->texIndex++))
   GLCALL(glBindTexture(GL_TEXTURE_3D, Tex3D_GetHandle(value)))
   GLCALL(glActiveTexture(GL_TEXTURE0))
@@ -434,7 +494,11 @@ void Shader_ISetTex3D (int index, Tex3D* value) {
 }
 
 void Shader_SetTexCube (cstr name, TexCube* value) {
-  GLCALL(glUniform1i(GetUniformIndex(current, name), current->texIndex))
+  Shader_SetTexCubeId(Str_InternId(name), value);
+}
+
+void Shader_SetTexCubeId (uint32 id, TexCube* value) {
+  GLCALL(glUniform1i(GetUniformIndex(current, id), current->texIndex))
   GLCALL(glActiveTexture(GL_TEXTURE0 + current->texIndex++))
   GLCALL(glBindTexture(GL_TEXTURE_CUBE_MAP, TexCube_GetHandle(value)))
   GLCALL(glActiveTexture(GL_TEXTURE0))
@@ -1,8 +1,9 @@
+#include "ArrayList.h"
 #include "Matrix.h"
 #include "PhxMemory.h"
 #include "ShaderVar.h"
 #include "ShaderVarType.h"
-#include "StrMap.h"
+#include "StrIntern.h"
 #include "Vec2.h"
 #include "Vec3.h"
 #include "Vec4.h"
@@ -17,32 +18,39 @@ struct VarStack {
   void* data;
 };
 
-static StrMap* varMap = 0;
+/* Stacks are indexed by the interned ID of the variable name, so binding
+ * automatic variables in Shader_Start involves no string hashing. */
+struct VarTable {
+  ArrayList(VarStack*, stack);
+} static varTable;
 
-inline static VarStack* ShaderVar_GetStack (cstr var, ShaderVarType type) {
-  VarStack* self = (VarStack*)StrMap_Get(varMap, var);
+inline static VarStack* ShaderVar_GetStackId (uint32 id, ShaderVarType type) {
+  VarStack* self = id < (uint32)varTable.stack_size ? varTable.stack_data[id] : 0;
   if (!self) {
     if (!type)
       return 0;
+    while ((uint32)varTable.stack_size <= id)
+      ArrayList_Append(varTable.stack, 0);
     self = MemNew(VarStack);
     self->type = type;
     self->size = 0;
     self->capacity = DEFAULT_CAPACITY;
     self->elemSize = ShaderVarType_GetSize(type);
     self->data = MemAlloc(self->capacity * self->elemSize);
-    StrMap_Set(varMap, var, self);
+    varTable.stack_data[id] = self;
   }
 
   if (type && self->type != type)
     Fatal("ShaderVar_GetStack: Attempting to get stack of type <%s>"
           " for shader variable <%s> when existing stack has type <%s>",
-          ShaderVarType_GetName(type), var, ShaderVarType_GetName(self->type));
+          ShaderVarType_GetName(type), Str_GetInterned(id),
+          ShaderVarType_GetName(self->type));
 
   return self;
 }
 
-inline static void ShaderVar_Push (cstr var, ShaderVarType type, void const* value) {
-  VarStack* self = ShaderVar_GetStack(var, type);
+inline static void ShaderVar_Push (uint32 id, ShaderVarType type, void const* value) {
+  VarStack* self = ShaderVar_GetStackId(id, type);
   if (self->size == self->capacity) {
     self->capacity *= 2;
     self->data = MemRealloc(self->data, self->capacity * self->elemSize);
@@ -52,74 +60,131 @@ inline static void ShaderVar_Push (cstr var, ShaderVarType type, void const* val
 }
 
 void ShaderVar_Init () {
-  varMap = StrMap_Create(16);
+  ArrayList_Init(varTable.stack);
+}
+
+static void ShaderVar_FreeStack (VarStack* self) {
+  if (!self) return;
+  MemFree(self->data);
+  MemFree(self);
 }
 
 void ShaderVar_Free () {
-  StrMap_Free(varMap);
-  varMap = 0;
+  ArrayList_FreeEx(varTable.stack, ShaderVar_FreeStack);
+  ArrayList_Init(varTable.stack);
 }
 
 void* ShaderVar_Get (cstr name, ShaderVarType type) {
-  VarStack* self = ShaderVar_GetStack(name, 0);
+  return ShaderVar_GetId(Str_InternId(name), type);
+}
+
+void* ShaderVar_GetId (uint32 id, ShaderVarType type) {
+  VarStack* self = ShaderVar_GetStackId(id, 0);
   if (!self || self->size == 0)
     return 0;
   if (type && self->type != type)
     Fatal("ShaderVar_Get: Attempting to get variable <%s> with type <%s> when"
           " existing stack has type <%s>",
-          name, ShaderVarType_GetName(type), ShaderVarType_GetName(self->type));
+          Str_GetInterned(id), ShaderVarType_GetName(type),
+          ShaderVarType_GetName(self->type));
   return (char*)self->data + self->elemSize * (self->size - 1);
 }
 
 void ShaderVar_PushFloat (cstr name, float x) {
-  ShaderVar_Push(name, ShaderVarType_Float, &x);
+  ShaderVar_PushFloatId(Str_InternId(name), x);
+}
+
+void ShaderVar_PushFloatId (uint32 id, float x) {
+  ShaderVar_Push(id, ShaderVarType_Float, &x);
 }
 
 void ShaderVar_PushFloat2 (cstr name, float x, float y) {
+  ShaderVar_PushFloat2Id(Str_InternId(name), x, y);
+}
+
+void ShaderVar_PushFloat2Id (uint32 id, float x, float y) {
   Vec2f value = { x, y };
-  ShaderVar_Push(name, ShaderVarType_Float2, &value);
+  ShaderVar_Push(id, ShaderVarType_Float2, &value);
 }
 
 void ShaderVar_PushFloat3 (cstr name, float x, float y, float z) {
+  ShaderVar_PushFloat3Id(Str_InternId(name), x, y, z);
+}
+
+void ShaderVar_PushFloat3Id (uint32 id, float x, float y, float z) {
   Vec3f value = { x, y, z };
-  ShaderVar_Push(name, ShaderVarType_Float3, &value);
+  ShaderVar_Push(id, ShaderVarType_Float3, &value);
 }
 
 void ShaderVar_PushFloat4 (cstr name, float x, float y, float z, float w) {
+  ShaderVar_PushFloat4Id(Str_InternId(name), x, y, z, w);
+}
+
+void ShaderVar_PushFloat4Id (uint32 id, float x, float y, float z, float w) {
   Vec4f value = { x, y, z, w };
-  ShaderVar_Push(name, ShaderVarType_Float4, &value);
+  ShaderVar_Push(id, ShaderVarType_Float4, &value);
 }
 
 void ShaderVar_PushInt (cstr name, int x) {
+  ShaderVar_PushIntId(Str_InternId(name), x);
+}
+
+void ShaderVar_PushIntId (uint32 id, int x) {
   int32 value = (int32)x;
-  ShaderVar_Push(name, ShaderVarType_Int, &value);
+  ShaderVar_Push(id, ShaderVarType_Int, &value);
 }
 
 void ShaderVar_PushMatrix (cstr name, Matrix* x) {
-  ShaderVar_Push(name, ShaderVarType_Matrix, &x);
+  ShaderVar_PushMatrixId(Str_InternId(name), x);
+}
+
+void ShaderVar_PushMatrixId (uint32 id, Matrix* x) {
+  ShaderVar_Push(id, ShaderVarType_Matrix, &x);
 }
 
 void ShaderVar_PushTex1D (cstr name, Tex1D* x) {
-  ShaderVar_Push(name, ShaderVarType_Tex1D, &x);
+  ShaderVar_PushTex1DId(Str_InternId(name), x);
+}
+
+void ShaderVar_PushTex1DId (uint32 id, Tex1D* x) {
+  ShaderVar_Push(id, ShaderVarType_Tex1D, &x);
 }
 
 void ShaderVar_PushTex2D (cstr name, Tex2D* x) {
-  ShaderVar_Push(name, ShaderVarType_Tex2D, &x);
+  ShaderVar_PushTex2DId(Str_InternId(name), x);
+}
+
+void ShaderVar_PushTex2DId (uint32 id, Tex2D* x) {
+  ShaderVar_Push(id, ShaderVarType_Tex2D, &x);
 }
 
 void ShaderVar_PushTex3D (cstr name, Tex3D* x) {
-  ShaderVar_Push(name, ShaderVarType_Tex3D, &x);
+  ShaderVar_PushTex3DId(Str_InternId(name), x);
+}
+
+void ShaderVar_PushTex3DId (uint32 id, Tex3D* x) {
+  ShaderVar_Push(id, ShaderVarType_Tex3D, &x);
 }
 
 void ShaderVar_PushTexCube (cstr name, TexCube* x) {
-  ShaderVar_Push(name, ShaderVarType_TexCube, &x);
+  ShaderVar_PushTexCubeId(Str_InternId(name), x);
+}
+
+void ShaderVar_PushTexCubeId (uint32 id, TexCube* x) {
+  ShaderVar_Push(id, ShaderVarType_TexCube, &x);
 }
 
 void ShaderVar_Pop (cstr name) {
-  VarStack* self = ShaderVar_GetStack(name, 0);
+  ShaderVar_PopId(Str_InternId(name));
+}
+
+void ShaderVar_PopId (uint32 id) {
+  VarStack* self = ShaderVar_GetStackId(id, 0);
   if (!self)
-    Fatal("ShaderVar_Pop: Attempting to pop nonexistent stack <%s>", name);
+    Fatal("ShaderVar_Pop: Attempting to pop nonexistent stack <%s>",
+      Str_GetInterned(id));
   if (self->size == 0)
-    Fatal("ShaderVar_Pop: Attempting to pop empty stack <%s>", name);
+    Fatal("ShaderVar_Pop: Attempting to pop empty stack <%s>",
+      Str_GetInterned(id));
   self->size--;
 }
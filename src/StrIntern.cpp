@@ -0,0 +1,121 @@
+#include "ArrayList.h"
+#include "Hash.h"
+#include "MemArena.h"
+#include "PhxMemory.h"
+#include "PhxString.h"
+#include "SDL.h"
+#include "StrIntern.h"
+
+/* NOTE : Each string is stored in the arena directly after its header, so
+ *        the ID of an interned pointer is found without a lookup. The table
+ *        is open-addressed with linear probing; entries are never removed, so
+ *        no tombstones are needed. */
+
+#define CHUNK_SIZE 0x10000
+#define MIN_CAPACITY 256
+
+struct InternHeader {
+  uint64 hash;
+  uint32 id;
+  uint32 len;
+};
+
+struct StrIntern {
+  SDL_SpinLock lock;
+  MemArena* arena;
+  InternHeader** table;
+  uint32 capacity;
+  ArrayList(InternHeader*, entry);
+} static self;
+
+inline static cstr Str_GetData (InternHeader* header) {
+  return (cstr)(header + 1);
+}
+
+/* Must be called with the lock held. */
+static void Str_GrowTable () {
+  InternHeader** oldTable = self.table;
+  uint32 oldCapacity = self.capacity;
+
+  self.capacity = oldCapacity ? 2 * oldCapacity : MIN_CAPACITY;
+  self.table = MemNewArrayZero(InternHeader*, self.capacity);
+  uint32 mask = self.capacity - 1;
+  for (uint32 i = 0; i < oldCapacity; ++i) {
+    InternHeader* header = oldTable[i];
+    if (!header) continue;
+    uint32 slot = (uint32)header->hash & mask;
+    while (self.table[slot])
+      slot = (slot + 1) & mask;
+    self.table[slot] = header;
+  }
+  MemFree(oldTable);
+}
+
+static InternHeader* Str_InternHeader (cstr s) {
+  uint32 len = (uint32)StrLen(s);
+  uint64 hash = Hash_XX64(s, (int)len, 0x0ULL);
+
+  SDL_AtomicLock(&self.lock);
+  IF_UNLIKELY (!self.arena) {
+    self.arena = MemArena_Create(CHUNK_SIZE);
+    ArrayList_Init(self.entry);
+    Str_GrowTable();
+  }
+
+  uint32 mask = self.capacity - 1;
+  uint32 slot = (uint32)hash & mask;
+  for (InternHeader* header; (header = self.table[slot]); slot = (slot + 1) & mask) {
+    if (header->hash == hash && header->len == len &&
+        memcmp(Str_GetData(header), s, len) == 0) {
+      SDL_AtomicUnlock(&self.lock);
+      return header;
+    }
+  }
+
+  InternHeader* header = (InternHeader*)MemArena_Alloc(self.arena,
+    (uint32)sizeof(InternHeader) + len + 1);
+  header->hash = hash;
+  header->id = (uint32)self.entry_size + 1;
+  header->len = len;
+  MemCpy(header + 1, s, len + 1);
+  self.table[slot] = header;
+  ArrayList_Append(self.entry, header);
+
+  /* Keep the load factor at or below 1/2. */
+  if (2 * (uint32)self.entry_size > self.capacity)
+    Str_GrowTable();
+
+  SDL_AtomicUnlock(&self.lock);
+  return header;
+}
+
+cstr Str_Intern (cstr s) {
+  if (!s) return 0;
+  return Str_GetData(Str_InternHeader(s));
+}
+
+uint32 Str_InternId (cstr s) {
+  if (!s) return 0;
+  return Str_InternHeader(s)->id;
+}
+
+uint32 Str_GetInternCount () {
+  SDL_AtomicLock(&self.lock);
+  uint32 count = (uint32)self.entry_size;
+  SDL_AtomicUnlock(&self.lock);
+  return count;
+}
+
+uint32 Str_GetInternId (cstr interned) {
+  if (!interned) return 0;
+  return ((InternHeader const*)interned - 1)->id;
+}
+
+cstr Str_GetInterned (uint32 id) {
+  SDL_AtomicLock(&self.lock);
+  if (id == 0 || id > (uint32)self.entry_size)
+    Fatal("Str_GetInterned: Invalid string ID %u", id);
+  cstr s = Str_GetData(self.entry_data[id - 1]);
+  SDL_AtomicUnlock(&self.lock);
+  return s;
+}
@@ -3,79 +3,105 @@
 #include "StrMap.h"
 #include "PhxString.h"
 
-/* TODO : More rigorous tests for this structure, which has been the victim
- *        of some pretty serious implementation bugs in the past. */
+/* NOTE : Open addressing with linear probing in Robin Hood order (see
+ *        HashMap.cpp). Every slot caches the full 64-bit hash of its key, so
+ *        probing compares hashes and only calls StrEqual on a hash match.
+ *        Growing never rehashes a string. An empty slot has a null key. */
+
+#define MIN_CAPACITY 8
 
 struct Node {
+  uint64 hash;
   cstr key;
-  Node* next;
   void* value;
 };
 
 struct StrMap {
   uint32 capacity;
   uint32 size;
+  uint32 mask;
   Node* data;
 };
 
 struct StrMapIter {
   StrMap* map;
-  Node* node;
   uint32 slot;
 };
 
-inline static uint64 Hash (cstr key) {
-  return Hash_XX64(key, StrLen(key), 0x0ULL);
-}
+inline static uint32 StrMap_Distance (StrMap* self, uint32 index, uint64 hash) {
+  return (index - (uint32)hash) & self->mask;
+}
+
+static void StrMap_Init (StrMap* self, uint32 capacity) {
+  uint32 c = MIN_CAPACITY;
+  while (c < capacity)
+    c <<= 1;
+  self->capacity = c;
+  self->size = 0;
+  self->mask = c - 1;
+  self->data = MemNewArrayZero(Node, c);
+}
+
+/* Inserts a node whose key is known not to be in the map. The key is taken
+ * over, not copied. */
+static void StrMap_Insert (StrMap* self, Node node) {
+  uint32 index = (uint32)node.hash & self->mask;
+  uint32 distance = 0;
+  for (;;) {
+    Node* slot = self->data + index;
+    if (!slot->key) {
+      *slot = node;
+      self->size++;
+      return;
+    }
 
-inline static Node* StrMap_GetBucket (StrMap* self, cstr key) {
-  return self->data + (Hash(key) % self->capacity);
-}
+    uint32 slotDistance = StrMap_Distance(self, index, slot->hash);
+    if (slotDistance < distance) {
+      Node displaced = *slot;
+      *slot = node;
+      node = displaced;
+      distance = slotDistance;
+    }
 
-static void StrMap_Grow (StrMap* self) {
-  StrMap newMap = { self->capacity * 2, 0, 0 };
-  newMap.data = MemNewArrayZero(Node, newMap.capacity);
+    index = (index + 1) & self->mask;
+    distance++;
+  }
+}
 
-  for (uint32 i = 0; i < self->capacity; ++i) {
-    Node* node = self->data + i;
+static Node* StrMap_Find (StrMap* self, cstr key, uint64 hash) {
+  uint32 index = (uint32)hash & self->mask;
+  for (uint32 distance = 0;; ++distance) {
+    Node* node = self->data + index;
     if (!node->key)
-      continue;
-    StrMap_Set(&newMap, node->key, node->value);
-    StrFree(node->key);
-    node = node->next;
-    while (node) {
-      Node* next = node->next;
-      StrMap_Set(&newMap, node->key, node->value);
-      StrFree(node->key);
-      MemFree(node);
-      node = next;
-    }
+      return 0;
+    if (node->hash == hash && StrEqual(node->key, key))
+      return node;
+    if (distance > StrMap_Distance(self, index, node->hash))
+      return 0;
+    index = (index + 1) & self->mask;
   }
+}
 
-  MemFree(self->data);
-  *self = newMap;
+static void StrMap_Grow (StrMap* self) {
+  Node* data = self->data;
+  uint32 capacity = self->capacity;
+  StrMap_Init(self, 2 * capacity);
+  for (uint32 i = 0; i < capacity; ++i)
+    if (data[i].key)
+      StrMap_Insert(self, data[i]);
+  MemFree(data);
 }
 
 StrMap* StrMap_Create (uint32 capacity) {
-  StrMap* self = MemNewZero(StrMap);
-  self->capacity = capacity;
-  self->data = MemNewArrayZero(Node, capacity);
+  StrMap* self = MemNew(StrMap);
+  StrMap_Init(self, capacity);
   return self;
 }
 
 void StrMap_Free (StrMap* self) {
-  for (uint32 i = 0; i < self->capacity; ++i) {
-    Node* node = self->data + i;
-    if (!node->key) continue;
-    StrFree(node->key);
-    node = node->next;
-    while (node) {
-      Node* next = node->next;
-      StrFree(node->key);
-      MemFree(node);
-      node = next;
-    }
-  }
+  for (uint32 i = 0; i < self->capacity; ++i)
+    if (self->data[i].key)
+      StrFree(self->data[i].key);
   MemFree(self->data);
   MemFree(self);
 }
@@ -86,29 +112,22 @@ void StrMap_FreeEx (StrMap* self, void (*freeFn)(cstr, void*)) {
     if (!node->key) continue;
     freeFn(node->key, node->value);
     StrFree(node->key);
-    node = node->next;
-    while (node) {
-      Node* next = node->next;
-      freeFn(node->key, node->value);
-      StrFree(node->key);
-      MemFree(node);
-      node = next;
-    }
   }
   MemFree(self->data);
   MemFree(self);
 }
 
+uint64 StrMap_Hash (cstr key) {
+  return Hash_XX64(key, (int)StrLen(key), 0x0ULL);
+}
+
 void* StrMap_Get (StrMap* self, cstr key) {
-  Node* node = StrMap_GetBucket(self, key);
-  if (!node->key)
-    return 0;
-  while (node) {
-    if (StrEqual(node->key, key))
-      return node->value;
-    node = node->next;
-  }
-  return 0;
+  return StrMap_GetHashed(self, key, StrMap_Hash(key));
+}
+
+void* StrMap_GetHashed (StrMap* self, cstr key, uint64 hash) {
+  Node* node = StrMap_Find(self, key, hash);
+  return node ? node->value : 0;
 }
 
 uint32 StrMap_GetSize (StrMap* self) {
@@ -116,62 +135,46 @@ uint32 StrMap_GetSize (StrMap* self) {
 }
 
 void StrMap_Remove (StrMap* self, cstr key) {
-  Node** prev = 0;
-  Node* node = StrMap_GetBucket(self, key);
-
-  while (node && node->key) {
-    if (StrEqual(node->key, key)) {
-      StrFree(node->key);
-      Node* next = node->next;
-      if (next) {
-        node->key = next->key;
-        node->next = next->next;
-        node->value = next->value;
-        MemFree(next);
-      } else {
-        node->key = 0;
-        node->value = 0;
-      }
-
-      if (prev)
-        *prev = next;
-      return;
-    }
-
-    prev = &node->next;
-    node = node->next;
+  StrMap_RemoveHashed(self, key, StrMap_Hash(key));
+}
+
+void StrMap_RemoveHashed (StrMap* self, cstr key, uint64 hash) {
+  Node* node = StrMap_Find(self, key, hash);
+  if (!node)
+    Fatal("StrMap_Remove: Map does not contain key <%s>", key);
+  StrFree(node->key);
+
+  /* Backward-shift the run that follows so no probe sequence is broken. */
+  uint32 index = (uint32)(node - self->data);
+  for (;;) {
+    uint32 next = (index + 1) & self->mask;
+    Node* nextNode = self->data + next;
+    if (!nextNode->key || StrMap_Distance(self, next, nextNode->hash) == 0)
+      break;
+    self->data[index] = *nextNode;
+    index = next;
   }
 
-  Fatal("StrMap_Remove: Map does not contain key <%s>", key);
+  MemZero(self->data + index, sizeof(Node));
+  self->size--;
 }
 
 void StrMap_Set (StrMap* self, cstr key, void* value) {
-  self->size++;
-  if (3 * self->capacity < 4 * self->size)
-    StrMap_Grow(self);
+  StrMap_SetHashed(self, key, StrMap_Hash(key), value);
+}
 
-  Node* node = StrMap_GetBucket(self, key);
-  if (!node->key) {
-    node->key = StrDup(key);
+void StrMap_SetHashed (StrMap* self, cstr key, uint64 hash, void* value) {
+  Node* node = StrMap_Find(self, key, hash);
+  if (node) {
     node->value = value;
     return;
   }
 
-  Node** prev = 0;
-  while (node) {
-    if (StrEqual(node->key, key)) {
-      node->value = value;
-      return;
-    }
-    prev = &node->next;
-    node =  node->next;
-  }
+  if (4 * (self->size + 1) > 3 * self->capacity)
+    StrMap_Grow(self);
 
-  node = MemNew(Node);
-  node->key = StrDup(key);
-  node->value = value;
-  node->next = 0;
-  *prev = node;
+  Node newNode = { hash, StrDup(key), value };
+  StrMap_Insert(self, newNode);
 }
 
 #include <stdio.h>
@@ -186,11 +189,9 @@ void StrMap_Dump (StrMap* self) {
   for (uint32 i = 0; i < self->capacity; ++i) {
     Node* node = self->data + i;
     if (!node->key) continue;
-    printf("  [%03i]:\n", i);
-    while (node) {
-      printf("    (%lx) %s -> %p\n", Hash(node->key), node->key, node->value);
-      node = node->next;
-    }
+    printf("  [%03i] +%u (%llx) %s -> %p\n",
+      i, StrMap_Distance(self, i, node->hash),
+      (unsigned long long)node->hash, node->key, node->value);
   }
 }
 
@@ -198,16 +199,8 @@ StrMapIter* StrMap_Iterate (StrMap* self) {
   StrMapIter* it = MemNew(StrMapIter);
   it->map = self;
   it->slot = 0;
-  it->node = 0;
-
-  for (uint32 i = 0; i < self->capacity; ++i) {
-    Node* node = self->data + i;
-    if (!node->key) continue;
-    it->slot = i;
-    it->node = node;
-    break;
-  }
-
+  while (it->slot < self->capacity && !self->data[it->slot].key)
+    it->slot++;
   return it;
 }
 
@@ -217,26 +210,19 @@ void StrMapIter_Free (StrMapIter* self) {
 
 void StrMapIter_Advance (StrMapIter* it) {
   StrMap* self = it->map;
-  it->node = it->node->next;
-  if (it->node) return;
   it->slot++;
-  for (uint32 i = it->slot; i < self->capacity; ++i) {
-    Node* node = self->data + i;
-    if (!node->key) continue;
-    it->slot = i;
-    it->node = node;
-    break;
-  }
+  while (it->slot < self->capacity && !self->data[it->slot].key)
+    it->slot++;
 }
 
 bool StrMapIter_HasMore (StrMapIter* it) {
-  return it->node != 0;
+  return it->slot < it->map->capacity;
 }
 
 cstr StrMapIter_GetKey (StrMapIter* it) {
-  return it->node->key;
+  return it->map->data[it->slot].key;
 }
 
 void* StrMapIter_GetValue (StrMapIter* it) {
-  return it->node->value;
+  return it->map->data[it->slot].value;
 }
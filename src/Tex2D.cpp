@@ -186,6 +186,7 @@ void Tex2D_GetSizeLevel (Tex2D* self, Vec2i* out, int level) {
 }
 
 Tex2D* Tex2D_Load (cstr name) {
+  MEMTAG_BEGIN(MemTag_Render);
   cstr path = Resource_GetPath(ResourceType_Tex2D, name);
   int sx, sy, components = 4;
   uchar* data = Tex2D_LoadRaw(path, &sx, &sy, &components);
@@ -205,6 +206,7 @@ Tex2D* Tex2D_Load (cstr name) {
   GLCALL(glBindTexture(GL_TEXTURE_2D, 0))
 
   MemFree(data);
+  MEMTAG_END;
   return self;
 }
 
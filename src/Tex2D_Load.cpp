@@ -1,10 +1,15 @@
 #include "Common.h"
+#include "PhxMemory.h"
 #include "Tex2D.h"
 
 #pragma warning(push)
 #pragma warning(disable:4242)
 #pragma warning(disable:4244)
 //https://github.com/nothings/stb/issues/334
+/* Callers release the result of Tex2D_LoadRaw with MemFree. */
+#define STBI_MALLOC(size)           MemAlloc(size)
+#define STBI_REALLOC(ptr, newSize)  MemRealloc(ptr, newSize)
+#define STBI_FREE(ptr)              MemFree(ptr)
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb/stb_image.h"
 #pragma warning(pop)
@@ -102,6 +102,7 @@ void TexCube_Free (TexCube* self) {
 }
 
 TexCube* TexCube_Load (cstr path) {
+  MEMTAG_BEGIN(MemTag_Render);
   TexCube* self = MemNew(TexCube);
   GLCALL(glGenTextures(1, &self->handle))
   GLCALL(glBindTexture(GL_TEXTURE_CUBE_MAP, self->handle))
@@ -136,12 +137,13 @@ TexCube* TexCube_Load (cstr path) {
     }
 
     GLCALL(glTexImage2D(kFaces[i].face, 0, self->format, self->size, self->size, 0, dataLayout, GL_UNSIGNED_BYTE, data))
-    MemFree(facePath);
+    StrFree(facePath);
     MemFree(data);
   }
 
   TexCube_InitParameters();
   GLCALL(glBindTexture(GL_TEXTURE_CUBE_MAP, 0))
+  MEMTAG_END;
   return self;
 }
 
@@ -283,7 +285,7 @@ void TexCube_SaveLevel (TexCube* self, cstr path, int level) {
     cstr facePath = StrAdd3(path, kFaceExt[i], ".png");
     GLCALL(glGetTexImage(face, level, GL_RGBA, GL_UNSIGNED_BYTE, buffer))
     Tex2D_Save_Png(facePath, size, size, 4, buffer);
-    MemFree(facePath);
+    StrFree(facePath);
   }
   MemFree(buffer);
   GLCALL(glBindTexture(GL_TEXTURE_CUBE_MAP, 0))
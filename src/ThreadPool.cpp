@@ -1,7 +1,10 @@
 #include "PhxMemory.h"
+#include "Profiler.h"
 #include "SDL.h"
 #include "ThreadPool.h"
 
+#include <stdio.h>
+
 struct ThreadData {
   SDL_Thread* handle;
   ThreadPoolFn fn;
@@ -12,6 +15,9 @@ struct ThreadData {
 
 static int ThreadPool_Dispatch (void* data) {
   ThreadData* td = (ThreadData*)data;
+  char name[32];
+  snprintf(name, sizeof(name), "ThreadPool %d", td->index);
+  Profiler_SetThreadName(name);
   return td->fn(td->index, td->threads, td->data);
 };
 
@@ -5,6 +5,7 @@
 #include "MemPool.h"
 #include "RenderState.h"
 #include "Shader.h"
+#include "StrIntern.h"
 #include "Tex2D.h"
 #include "UIRenderer.h"
 #include "Vec2.h"
@@ -111,12 +112,19 @@ static void UIRenderer_DrawLayer (UIRendererLayer const* self) {
 
   if (self->panelList) {
     static Shader* shader = 0;
-    if (!shader)
+    static uint32 padding, innerAlpha, bevel, size, color;
+    if (!shader) {
       shader = Shader_Load("vertex/ui", "fragment/ui/panel");
+      padding = Str_InternId("padding");
+      innerAlpha = Str_InternId("innerAlpha");
+      bevel = Str_InternId("bevel");
+      size = Str_InternId("size");
+      color = Str_InternId("color");
+    }
 
     const float pad = 64.0f;
     Shader_Start(shader);
-    Shader_SetFloat("padding", pad);
+    Shader_SetFloatId(padding, pad);
 
     for (UIRendererPanel const* e = self->panelList; e; e = e->next) {
       float x = e->pos.x - pad;
@@ -124,10 +132,10 @@ static void UIRenderer_DrawLayer (UIRendererLayer const* self) {
       float sx = e->size.x + 2.0f * pad;
       float sy = e->size.y + 2.0f * pad;
 
-      Shader_SetFloat("innerAlpha", e->innerAlpha);
-      Shader_SetFloat("bevel", e->bevel);
-      Shader_SetFloat2("size", sx, sy);
-      Shader_SetFloat4("color", UNPACK4(e->color));
+      Shader_SetFloatId(innerAlpha, e->innerAlpha);
+      Shader_SetFloatId(bevel, e->bevel);
+      Shader_SetFloat2Id(size, sx, sy);
+      Shader_SetFloat4Id(color, UNPACK4(e->color));
       Draw_Rect(x, y, sx, sy);
     }
 
@@ -1,3 +1,4 @@
+#include "Engine.h"
 #include "PhxMemory.h"
 #include "OpenGL.h"
 #include "SDL.h"
@@ -13,6 +14,8 @@ struct Window {
 };
 
 Window* Window_Create (cstr title, int x, int y, int sx, int sy, WindowMode mode) {
+  if (Engine_IsHeadless())
+    Fatal("Window_Create: Windows are unavailable in headless mode");
   Window* self = MemNew(Window);
   mode |= SDL_WINDOW_OPENGL;
   self->handle = SDL_CreateWindow(title, x, y, sx, sy, mode);